@@ -1,6 +1,8 @@
 
 #include <SFML/Graphics.hpp>
 #include "r3-snake-gamestate.hpp"
+#include "r3-snake-spritebatch.hpp"
+#pragma once
 
 namespace r3 {
 
@@ -19,10 +21,44 @@ namespace r3 {
 
 			sf::Vector2f resolveViewportFieldTopLeftPosition(const sf::Vector2i& fieldSize, float viewportTileSize);
 
+			void appendSnake(SpriteBatch& spriteBatch, const RenderSnakeInput& renderSnakeInput);
+
 			void renderSnake(sf::RenderTarget& renderTarget, const RenderSnakeInput& renderSnakeInput);
 
 		}
 
+		// Keeps the snake's body quads on the GPU between frames, in a ring indexed by the order segments were pushed
+		// behind the head (see SnakeChangeLog).  Each frame only the newly pushed segments are written, and the live
+		// part of the ring is drawn in at most two ranges, so the cost no longer grows with the snake's length.  The
+		// head and tail change every move and are drawn on their own.
+		class SnakeVertexBuffer {
+
+		private:
+			sf::VertexBuffer* vertexBuffer;
+			unsigned int quadCapacity;
+			const sf::Texture* texture;
+			sf::Vector2i fieldSize;
+			bool snakeHurtFlag;
+			SnakeChangeLog changeLog;
+
+		public:
+			SnakeVertexBuffer();
+
+		public:
+			~SnakeVertexBuffer();
+
+		public:
+			void render(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput);
+
+		private:
+			bool requiresRebuild(const RenderUtils::RenderSnakeInput& renderSnakeInput) const;
+			bool rebuild(const RenderUtils::RenderSnakeInput& renderSnakeInput);
+			void updatePushedSegments(const RenderUtils::RenderSnakeInput& renderSnakeInput);
+			void renderBody(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput);
+			void renderHeadAndTail(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput);
+
+		};
+
 	}
 
 }
@@ -0,0 +1,23 @@
+
+#include <SFML/System.hpp>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		// Counts calls to the global operator new made by the calling thread, so a caller can check that a stretch
+		// of code does not allocate.  Each thread keeps its own count, which lets worker threads measure themselves
+		// without locking.  Replacing operator new is only done in the Benchmark configuration, which defines
+		// R3_SNAKE_COUNT_ALLOCATIONS, so the game itself keeps the standard allocator.
+		namespace AllocationCounterUtils {
+
+#ifdef R3_SNAKE_COUNT_ALLOCATIONS
+			sf::Uint64 getThreadAllocationCount();
+#endif
+
+		}
+
+	}
+
+}
@@ -40,6 +40,15 @@ namespace r3 {
 
 		}
 
+		// Lets a renderer keep the body's geometry between frames.  Every move leaves each body tile looking as it did,
+		// except that a new segment appears behind the head and segments drop off the tail end.  Body segment i was
+		// therefore pushed as number (pushedBodyCount - 1 - i), and anything pushed since the renderer last looked
+		// is at the front of the body.  The serial number differs between every snake that is constructed.
+		typedef struct Snake_SnakeChangeLog {
+			unsigned int serialNumber;
+			unsigned int pushedBodyCount;
+		} SnakeChangeLog;
+
 		class Snake;
 
 		class Snake {
@@ -49,8 +58,12 @@ namespace r3 {
 			std::vector<SnakeSegment> bodyList;
 			SnakeSegment tail;
 
+		private:
+			SnakeChangeLog changeLog;
+
 		public:
 			Snake(const SnakeStartDefn& startDefn);
+			Snake(const SnakeSegment& head, const std::vector<SnakeSegment>& bodyList, const SnakeSegment& tail);
 
 		public:
 			SnakeSegment getHead() const;
@@ -58,6 +71,7 @@ namespace r3 {
 			SnakeSegment getBody(int segmentIndex) const;
 			SnakeSegment getTail() const;
 			int getLength() const;
+			SnakeChangeLog getChangeLog() const;
 
 		public:
 			bool isValidMovementDirection(ObjectDirection direction) const;
@@ -71,12 +85,16 @@ namespace r3 {
 			void growForward(ObjectDirection direction);
 			void shrinkForward(ObjectDirection direction);
 
+		public:
+			void reserveLength(int length);
+
 		private:
 			void moveHeadForward(ObjectDirection direction);
 			void moveBodyForward();
 			void moveTailForward();
 
 		private:
+			void initChangeLog();
 			void assertContiguous();
 
 		};
@@ -5,6 +5,7 @@
 #include <SFML/Audio.hpp>
 #include "r3-snake-gameoptions.hpp"
 #include "r3-snake-gamestate.hpp"
+#include "r3-snake-RenderUtils.hpp"
 #pragma once
 
 namespace r3 {
@@ -189,6 +190,9 @@ namespace r3 {
 			sf::Sprite shrubSprite;
 			sf::Sprite appleSprite;
 
+		private:
+			SnakeVertexBuffer snakeVertexBuffer;
+
 		public:
 			QuickGameRenderer();
 
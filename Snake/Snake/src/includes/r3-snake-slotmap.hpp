@@ -0,0 +1,239 @@
+
+#include <assert.h>
+#include <vector>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace SlotMapConstants {
+
+			const int SLOT_INDEX_BITS = 20;
+			const int SLOT_INDEX_MASK = (1 << SLOT_INDEX_BITS) - 1;
+			const int MAX_GENERATION = (1 << (31 - SLOT_INDEX_BITS)) - 1;
+
+		}
+
+		// Values are stored densely for iteration, and addressed by an id that packs the slot index with
+		// a generation counter.  Erasing bumps the generation, so an id held past its value's lifetime is
+		// reported as missing instead of silently aliasing whatever value reuses the slot.
+		template <typename T>
+		class SlotMap {
+
+		private:
+			std::vector<T> valueList;
+			std::vector<int> valueIdList;
+			std::vector<int> slotValueIndexList;
+			std::vector<int> slotGenerationList;
+			std::vector<int> freeSlotIndexList;
+
+		public:
+			typedef typename std::vector<T>::iterator iterator;
+			typedef typename std::vector<T>::const_iterator const_iterator;
+
+		public:
+			void reserve(size_t capacity);
+			int peekNextId() const;
+			int insert(const T& value);
+			void erase(int id);
+			void clear();
+
+		public:
+			bool contains(int id) const;
+			T* find(int id);
+			const T* find(int id) const;
+			T& at(int id);
+			const T& at(int id) const;
+
+		public:
+			size_t size() const;
+			bool empty() const;
+			int getId(size_t valueIndex) const;
+			T& getValue(size_t valueIndex);
+			const T& getValue(size_t valueIndex) const;
+
+		public:
+			iterator begin();
+			iterator end();
+			const_iterator begin() const;
+			const_iterator end() const;
+
+		private:
+			int resolveValueIndex(int id) const;
+
+		};
+
+		template <typename T>
+		void SlotMap<T>::reserve(size_t capacity) {
+			this->valueList.reserve(capacity);
+			this->valueIdList.reserve(capacity);
+			this->slotValueIndexList.reserve(capacity);
+			this->slotGenerationList.reserve(capacity);
+			this->freeSlotIndexList.reserve(capacity);
+		}
+
+		template <typename T>
+		int SlotMap<T>::peekNextId() const {
+			int slotIndex = (int)this->slotGenerationList.size();
+			int generation = 1;
+			if (!this->freeSlotIndexList.empty()) {
+				slotIndex = this->freeSlotIndexList.back();
+				generation = this->slotGenerationList[slotIndex];
+			}
+
+			int result = (generation << SlotMapConstants::SLOT_INDEX_BITS) | slotIndex;
+			return result;
+		}
+
+		template <typename T>
+		int SlotMap<T>::insert(const T& value) {
+			int result = this->peekNextId();
+			int slotIndex = result & SlotMapConstants::SLOT_INDEX_MASK;
+
+			if (this->freeSlotIndexList.empty()) {
+				assert(slotIndex <= SlotMapConstants::SLOT_INDEX_MASK);
+
+				this->slotValueIndexList.push_back(-1);
+				this->slotGenerationList.push_back(1);
+			}
+			else {
+				this->freeSlotIndexList.pop_back();
+			}
+
+			this->slotValueIndexList[slotIndex] = (int)this->valueList.size();
+			this->valueList.push_back(value);
+			this->valueIdList.push_back(result);
+
+			return result;
+		}
+
+		template <typename T>
+		void SlotMap<T>::erase(int id) {
+			int valueIndex = this->resolveValueIndex(id);
+			if (valueIndex < 0) {
+				return;
+			}
+
+			int lastValueIndex = (int)this->valueList.size() - 1;
+			if (valueIndex != lastValueIndex) {
+				this->valueList[valueIndex] = this->valueList[lastValueIndex];
+				this->valueIdList[valueIndex] = this->valueIdList[lastValueIndex];
+				this->slotValueIndexList[this->valueIdList[valueIndex] & SlotMapConstants::SLOT_INDEX_MASK] = valueIndex;
+			}
+			this->valueList.pop_back();
+			this->valueIdList.pop_back();
+
+			int slotIndex = id & SlotMapConstants::SLOT_INDEX_MASK;
+			this->slotValueIndexList[slotIndex] = -1;
+			this->slotGenerationList[slotIndex] = (this->slotGenerationList[slotIndex] % SlotMapConstants::MAX_GENERATION) + 1;
+			this->freeSlotIndexList.push_back(slotIndex);
+		}
+
+		template <typename T>
+		void SlotMap<T>::clear() {
+			this->valueList.clear();
+			this->valueIdList.clear();
+			this->slotValueIndexList.clear();
+			this->slotGenerationList.clear();
+			this->freeSlotIndexList.clear();
+		}
+
+		template <typename T>
+		bool SlotMap<T>::contains(int id) const {
+			bool result = (this->resolveValueIndex(id) >= 0);
+			return result;
+		}
+
+		template <typename T>
+		T* SlotMap<T>::find(int id) {
+			int valueIndex = this->resolveValueIndex(id);
+			T* result = (valueIndex >= 0) ? &this->valueList[valueIndex] : nullptr;
+			return result;
+		}
+
+		template <typename T>
+		const T* SlotMap<T>::find(int id) const {
+			int valueIndex = this->resolveValueIndex(id);
+			const T* result = (valueIndex >= 0) ? &this->valueList[valueIndex] : nullptr;
+			return result;
+		}
+
+		template <typename T>
+		T& SlotMap<T>::at(int id) {
+			T* result = this->find(id);
+			assert(result != nullptr);
+			return *result;
+		}
+
+		template <typename T>
+		const T& SlotMap<T>::at(int id) const {
+			const T* result = this->find(id);
+			assert(result != nullptr);
+			return *result;
+		}
+
+		template <typename T>
+		size_t SlotMap<T>::size() const {
+			return this->valueList.size();
+		}
+
+		template <typename T>
+		bool SlotMap<T>::empty() const {
+			return this->valueList.empty();
+		}
+
+		template <typename T>
+		int SlotMap<T>::getId(size_t valueIndex) const {
+			return this->valueIdList[valueIndex];
+		}
+
+		template <typename T>
+		T& SlotMap<T>::getValue(size_t valueIndex) {
+			return this->valueList[valueIndex];
+		}
+
+		template <typename T>
+		const T& SlotMap<T>::getValue(size_t valueIndex) const {
+			return this->valueList[valueIndex];
+		}
+
+		template <typename T>
+		typename SlotMap<T>::iterator SlotMap<T>::begin() {
+			return this->valueList.begin();
+		}
+
+		template <typename T>
+		typename SlotMap<T>::iterator SlotMap<T>::end() {
+			return this->valueList.end();
+		}
+
+		template <typename T>
+		typename SlotMap<T>::const_iterator SlotMap<T>::begin() const {
+			return this->valueList.begin();
+		}
+
+		template <typename T>
+		typename SlotMap<T>::const_iterator SlotMap<T>::end() const {
+			return this->valueList.end();
+		}
+
+		template <typename T>
+		int SlotMap<T>::resolveValueIndex(int id) const {
+			int slotIndex = id & SlotMapConstants::SLOT_INDEX_MASK;
+			int generation = id >> SlotMapConstants::SLOT_INDEX_BITS;
+
+			int result = -1;
+			if (
+				(id > 0) &&
+				(slotIndex < (int)this->slotGenerationList.size()) &&
+				(this->slotGenerationList[slotIndex] == generation)
+			) {
+				result = this->slotValueIndexList[slotIndex];
+			}
+			return result;
+		}
+
+	}
+
+}
@@ -0,0 +1,127 @@
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <SFML/Graphics.hpp>
+#include "r3-snake-gamestate.hpp"
+#include "r3-snake-quickgamescene.hpp"
+#include "r3-snake-storymodescene.hpp"
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		typedef struct Snake_SnakeBotInput {
+			const Snake* snake;
+			const std::vector<sf::Vector2i>* targetPositionList;
+			const std::vector<sf::Vector2i>* avoidPositionList;
+		} SnakeBotInput;
+
+		typedef struct Snake_SnakeBotFloodFillResult {
+			int reachableTileCount;
+			bool reachesTailFlag;
+		} SnakeBotFloodFillResult;
+
+		typedef struct Snake_SnakeBotBenchmarkResult {
+			sf::Vector2i fieldSize;
+			int gameCount = 0;
+			int tickCount = 0;
+			int applesEaten = 0;
+			int maxSnakeLength = 0;
+			float avgTickMicroseconds = 0.0f;
+			sf::Int64 p99TickMicroseconds = 0;
+			sf::Int64 maxTickMicroseconds = 0;
+			bool withinTargetFlag = false;
+		} SnakeBotBenchmarkResult;
+
+		// Steers a snake towards a set of target tiles.  The distance to the nearest target is kept for every tile,
+		// routing around barriers and the snake's own body, and is repaired as the body and the targets change rather
+		// than rebuilt.
+		class SnakeBot {
+
+		private:
+			sf::Vector2i fieldSize;
+			int paddedWidth;
+			int tileOffsetList[4];
+			std::vector<sf::Uint8> barrierGrid;
+
+		private:
+			std::vector<sf::Vector2i> targetPositionList;
+			std::vector<int> targetDistanceGrid;
+			int targetVersion;
+
+		private:
+			std::deque<sf::Vector2i> snakePositionList;
+			std::vector<sf::Uint8> snakeOccupancyGrid;
+
+		private:
+			std::vector<int> searchQueue;
+			std::vector<int> repairTileList;
+			std::vector<int> repairBucketOffsetList;
+			std::vector<int> searchMarkGrid;
+			int searchMark;
+
+		private:
+			bool decisionValidFlag;
+			sf::Vector2i decisionHeadPosition;
+			int decisionTargetVersion;
+			ObjectDirection decisionDirection;
+
+		public:
+			SnakeBot(const sf::Vector2i& fieldSize);
+
+		public:
+			void setBarrier(int x, int y);
+			void reset();
+
+		public:
+			ObjectDirection resolveNextDirection(const SnakeBotInput& input);
+
+		private:
+			int toTileIndex(const sf::Vector2i& position) const;
+			sf::Vector2i toPosition(int tileIndex) const;
+			bool inBounds(const sf::Vector2i& position) const;
+
+		private:
+			void syncSnake(const Snake& snake);
+			void rebuildSnakePositionList(const Snake& snake);
+			void occupySnakePosition(const sf::Vector2i& position);
+			void vacateSnakePosition(const sf::Vector2i& position);
+			bool blocksTargetDistance(int tileIndex) const;
+			int claimSearchMark();
+
+		private:
+			void syncTargets(const std::vector<sf::Vector2i>& targetPositionList);
+			void spreadTargetDistance(const sf::Vector2i& targetPosition);
+			void spreadTargetDistanceFrom(int tileIndex);
+			void raiseTargetDistances(int raisedTileIndex);
+			void sortRepairTilesByDistance();
+			void lowerTargetDistances(int unblockedTileIndex);
+			int resolveNeighbourTargetDistance(int tileIndex) const;
+
+		private:
+			ObjectDirection decideDirection(const SnakeBotInput& input);
+			SnakeBotFloodFillResult floodFill(const sf::Vector2i& startPosition, const sf::Vector2i& tailPosition, int maxTileCount);
+
+		};
+
+		namespace SnakeBotUtils {
+
+			SnakeBot* createQuickGameBot(const QuickGame& quickGame);
+
+			SnakeBot* createStoryGameBot(const StoryGame& storyGame);
+
+			QuickGameInputRequest buildQuickGameInputRequest(SnakeBot& bot, const QuickGame& quickGame);
+
+			StoryGameInputRequest buildStoryGameInputRequest(SnakeBot& bot, const StoryGame& storyGame);
+
+			SnakeBotBenchmarkResult measureQuickGameTickTimes(const sf::Vector2i& fieldSize, int tickCount);
+
+			std::vector<std::string> buildBenchmarkMessages(const SnakeBotBenchmarkResult& benchmarkResult);
+
+		}
+
+	}
+
+}
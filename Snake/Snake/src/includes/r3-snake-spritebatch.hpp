@@ -0,0 +1,37 @@
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace SpriteBatchUtils {
+
+			void buildQuad(sf::Vertex* quadVertexList, const sf::Vector2f& position, float size, const sf::IntRect& textureRect);
+
+		}
+
+		// Collects textured quads into one vertex array per texture, so that everything drawn from the same tileset
+		// goes out in a single draw call.  Textures are drawn in the order they were first appended to, which keeps
+		// the layering of snake, food and dangers the same as drawing each sprite in turn.
+		class SpriteBatch {
+
+		private:
+			std::vector<const sf::Texture*> textureList;
+			std::vector<sf::VertexArray> vertexArrayList;
+			size_t usedTextureCount;
+
+		public:
+			SpriteBatch();
+
+		public:
+			void appendQuad(const sf::Texture& texture, const sf::Vector2f& position, float size, const sf::IntRect& textureRect);
+			void render(sf::RenderTarget& renderTarget);
+
+		};
+
+	}
+
+}
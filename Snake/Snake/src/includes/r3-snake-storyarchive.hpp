@@ -0,0 +1,131 @@
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <SFML/System.hpp>
+#include <SFML/Audio.hpp>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryArchiveConstants {
+
+			extern const char* ARCHIVE_FILE_EXTENSION;
+
+			extern const size_t BLOB_ALIGNMENT;
+
+		}
+
+		typedef struct Snake_StoryArchiveBlob {
+			const char* data;
+			size_t size;
+		} StoryArchiveBlob;
+
+		// Archived files point straight into the mapped archive; loose files are read into looseContents
+		typedef struct Snake_StoryFileContents {
+			StoryArchiveBlob archivedBlob = { nullptr, 0 };
+			std::vector<char> looseContents;
+
+			const char* getData() const {
+				const char* result = (archivedBlob.data != nullptr) ? archivedBlob.data : looseContents.data();
+				return result;
+			}
+
+			size_t getSize() const {
+				size_t result = (archivedBlob.data != nullptr) ? archivedBlob.size : looseContents.size();
+				return result;
+			}
+		} StoryFileContents;
+
+		typedef struct Snake_StoryPackCampaignResult {
+			bool campaignValid = false;
+			std::vector<std::string> invalidMapFilenameList;
+			std::vector<std::string> unreadableFilenameList;
+			bool archiveWritten = false;
+			std::string archiveFilePath;
+			int blobCount = 0;
+			size_t archiveBytes = 0;
+
+			bool valid() const {
+				bool result =
+					campaignValid &&
+					invalidMapFilenameList.empty() &&
+					unreadableFilenameList.empty() &&
+					archiveWritten;
+				return result;
+			}
+		} StoryPackCampaignResult;
+
+		class StoryMappedFile {
+
+		private:
+#ifdef _WIN32
+			void* fileHandle;
+			void* mappingHandle;
+#else
+			int fileDescriptor;
+#endif
+			const char* data;
+			size_t size;
+
+		public:
+			StoryMappedFile();
+
+		public:
+			~StoryMappedFile();
+
+		public:
+			bool open(const std::string& filePath);
+			void close();
+
+		public:
+			const char* getData() const;
+			size_t getSize() const;
+
+		};
+
+		// A whole campaign folder packed into a single file: a header, an index of relative paths, then
+		// every file's bytes as an aligned blob.  The archive is memory-mapped once and blobs are handed
+		// out as pointers into the mapping, so nothing is copied on the way to SFML.
+		class StoryCampaignArchive {
+
+		private:
+			StoryMappedFile mappedFile;
+			std::unordered_map<std::string, StoryArchiveBlob> blobMap;
+
+		public:
+			bool open(const std::string& archiveFilePath);
+			bool isOpen() const;
+
+		public:
+			bool findBlob(const std::string& relativePath, StoryArchiveBlob& blob) const;
+			size_t getBlobCount() const;
+
+		};
+
+		namespace StoryArchiveUtils {
+
+			std::string resolveArchiveFilePath(const std::string& campaignFolderName);
+
+			void setArchiveLookupEnabled(bool enabledFlag);
+
+			bool readFile(const std::string& filePath, StoryFileContents& fileContents);
+
+			// Reads at most headerSize bytes from the start of the file
+			bool readFileHeader(const std::string& filePath, size_t headerSize, StoryFileContents& fileContents);
+
+			bool probeFileSize(const std::string& filePath, size_t& fileSize);
+
+			bool openMusic(sf::Music& music, const std::string& filePath);
+
+			StoryPackCampaignResult packCampaign(const std::string& campaignFolderName);
+
+			std::vector<std::string> buildPackMessages(const StoryPackCampaignResult& packResult);
+
+		}
+
+	}
+
+}
@@ -1,9 +1,14 @@
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <condition_variable>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include "r3-snake-storydefn.hpp"
 #include "r3-snake-storyloader.hpp"
+#include "r3-snake-storyarchive.hpp"
 #pragma once
 
 namespace r3 {
@@ -13,69 +18,240 @@ namespace r3 {
 		typedef enum class Snake_StoryLevelAssetLoadingCompletionStatus {
 			PENDING,
 			LOADING,
+			UPLOADING,
 			COMPLETE,
 			FAILED,
 		} StoryLevelAssetLoadingCompletionStatus;
 
+		typedef enum class Snake_StoryLevelAssetLoadPriority {
+			FOREGROUND,
+			BACKGROUND,
+		} StoryLevelAssetLoadPriority;
+
 		typedef struct Snake_StoryLevelAssetLoadingStatus {
 			StoryLevelAssetLoadingCompletionStatus completionStatus;
 			float loadedPct;
 			std::string currFilename;
 		} StoryLevelAssetLoadingStatus;
 
+		namespace StoryAssetCacheConstants {
+
+			extern const size_t DEFAULT_MEMORY_BUDGET_BYTES;
+
+		}
+
+		typedef struct Snake_StoryAssetCacheEntry {
+			sf::Uint64 key;
+			sf::Texture* texture;
+			sf::SoundBuffer* soundBuffer;
+			sf::Image* image;
+			size_t residentBytes;
+			int refCount;
+			std::list<sf::Uint64>::iterator unusedItr;
+		} StoryAssetCacheEntry;
+
+		typedef struct Snake_StoryAssetCacheStats {
+			int hitCount;
+			int missCount;
+			int evictionCount;
+			int imageHitCount;
+			int imageMissCount;
+			int entryCount;
+			size_t residentBytes;
+			size_t memoryBudgetBytes;
+		} StoryAssetCacheStats;
+
+		// Textures and sound buffers shared across level bundles, keyed by a hash of the file's contents so
+		// that the same tileset or sound effect is decoded and uploaded once per campaign.  Map tiles are kept
+		// as decoded images instead, since each level packs its own atlas from them.  Entries are
+		// reference counted; once nothing holds an entry it becomes eligible for least-recently-used
+		// eviction whenever the resident bytes exceed the memory budget.
+		class StoryAssetCache {
+
+		private:
+			sf::Mutex cacheMutex;
+			size_t memoryBudgetBytes;
+			std::unordered_map<sf::Uint64, StoryAssetCacheEntry> entryMap;
+			std::list<sf::Uint64> unusedKeyList;
+			StoryAssetCacheStats stats;
+
+		public:
+			StoryAssetCache(size_t memoryBudgetBytes);
+
+		public:
+			~StoryAssetCache();
+
+		public:
+			const sf::Texture* acquireTexture(sf::Uint64 key);
+			const sf::Texture* insertTexture(sf::Uint64 key, const sf::Image& image, bool repeatFlag);
+			const sf::SoundBuffer* acquireSoundBuffer(sf::Uint64 key);
+			const sf::SoundBuffer* insertSoundBuffer(sf::Uint64 key, const std::vector<sf::Int16>& sampleList, unsigned int channelCount, unsigned int sampleRate);
+			const sf::Image* acquireImage(sf::Uint64 key);
+			const sf::Image* insertImage(sf::Uint64 key, const sf::Image& image);
+			void release(sf::Uint64 key);
+
+		public:
+			StoryAssetCacheStats getStats();
+
+		private:
+			StoryAssetCacheEntry* acquireEntry(sf::Uint64 key);
+			StoryAssetCacheEntry* insertEntry(sf::Uint64 key, sf::Texture* texture, sf::SoundBuffer* soundBuffer, sf::Image* image, size_t residentBytes);
+			void evictUnusedEntries();
+			void destroyEntry(StoryAssetCacheEntry& entry);
+
+		};
+
+		namespace StoryAssetCacheUtils {
+
+			sf::Uint64 buildTextureKey(const char* fileData, size_t fileSize, bool repeatFlag);
+			sf::Uint64 buildSoundBufferKey(const char* fileData, size_t fileSize);
+			sf::Uint64 buildImageKey(sf::Uint64 textureKey);
+			std::string buildStatsMessage(const StoryAssetCacheStats& stats);
+
+		}
+
+		namespace StoryTextureAtlasConstants {
+
+			extern const unsigned int PAGE_SIZE;
+			extern const unsigned int PADDING;
+
+		}
+
+		// Where one image landed in a texture atlas.  A page index of -1 means the image was not packed, and
+		// should be drawn from its own texture instead.
+		typedef struct Snake_StoryTextureAtlasRegion {
+			int pageIndex;
+			sf::IntRect textureRect;
+		} StoryTextureAtlasRegion;
+
+		typedef struct Snake_StoryTextureAtlasLayout {
+			std::vector<StoryTextureAtlasRegion> regionList;
+			std::vector<sf::Vector2u> pageSizeList;
+		} StoryTextureAtlasLayout;
+
+		// Packs images onto pages in shelves, tallest first.  Every image is surrounded by a border of its own
+		// edge pixels, so that sampling just outside a region while scaling picks up the same colours rather
+		// than a neighbour's.
+		namespace StoryTextureAtlasUtils {
+
+			StoryTextureAtlasLayout packShelves(const std::vector<sf::Vector2u>& imageSizeList, unsigned int pageSize, unsigned int padding);
+			std::vector<sf::Image> buildPageImageList(const StoryTextureAtlasLayout& layout, const std::vector<const sf::Image*>& imageList, unsigned int padding);
+
+		}
+
 		typedef struct Snake_StoryMapAssetBundle {
 			StoryMapDefn mapDefn;
 			LoadStoryMapValidationResult loadMapValidationResult;
-			std::unordered_map<int, sf::Texture*> floorTextureRefMap;
-			std::unordered_map<int, sf::Texture*> barrierTextureRefMap;
+			std::vector<int> floorTextureHandleList;
+			std::vector<int> barrierTextureHandleList;
 		} StoryMapAssetBundle;
 
+		typedef enum class Snake_StoryAssetDecodeJobType {
+			TEXTURE,
+			SOUND_BUFFER,
+		} StoryAssetDecodeJobType;
+
+		typedef struct Snake_StoryAssetDecodeJob {
+			StoryAssetDecodeJobType jobType;
+			int assetHandle;
+		} StoryAssetDecodeJob;
+
+		typedef enum class Snake_StoryAssetDecodeStatus {
+			FAILED,
+			DECODED,
+			CACHED,
+		} StoryAssetDecodeStatus;
+
+		typedef struct Snake_StoryDecodedSoundSamples {
+			StoryAssetDecodeStatus decodeStatus;
+			std::vector<sf::Int16> sampleList;
+			unsigned int channelCount;
+			unsigned int sampleRate;
+		} StoryDecodedSoundSamples;
+
 		class StoryLevelAssetBundle {
 
 		private:
 			sf::Mutex loadingStatusMutex;
 			sf::Thread* loadingThread;
+			StoryAssetCache* assetCache;
 			std::string campaignFolderName;
+			StoryCampaignIndex* campaignIndex;
+			int campaignLevelIndex;
 			StoryLevelDefn* levelDefn;
 
 		private:
-			StoryLevelAssetLoadingCompletionStatus loadingCompletionStatus;
-			int totalAssetCount;
-			int loadedAssetCount;
+			std::atomic<StoryLevelAssetLoadPriority> loadPriority;
+			std::atomic<bool> cancelRequestedFlag;
+			std::atomic<StoryLevelAssetLoadingCompletionStatus> loadingCompletionStatus;
+			std::atomic<int> totalAssetCount;
+			std::atomic<int> loadedAssetCount;
 			std::string currFilenameBeingLoaded;
 
 		private:
 			std::vector<std::string> failedFilenameList;
 
 		private:
-			sf::Texture snakeTexture;
-			sf::Texture foodTexture;
-			sf::Texture dangerTexture;
-			std::unordered_map<std::string, sf::Texture> textureMap;
+			std::vector<StoryAssetDecodeJob> decodeJobList;
+			std::atomic<int> nextDecodeJobIndex;
+			std::mutex decodeWorkerMutex;
+			std::condition_variable decodeWorkerCondition;
+			int runningDecodeWorkerCount;
+			size_t nextTextureUploadHandle;
+			size_t nextTextureAtlasPageUploadIndex;
+
+		private:
+			int snakeTextureHandle;
+			int foodTextureHandle;
+			int dangerTextureHandle;
+			std::unordered_map<std::string, int> textureHandleMap;
+			std::vector<std::string> textureFilenameList;
+			std::vector<std::string> textureFilePathList;
+			std::vector<bool> textureRepeatFlagList;
+			std::vector<sf::Image> textureImageList;
+			std::vector<StoryAssetDecodeStatus> textureDecodeStatusList;
+			std::vector<sf::Uint64> textureKeyList;
+			std::vector<const sf::Texture*> textureList;
+			std::vector<sf::Uint64> tileImageKeyList;
+			std::vector<const sf::Image*> tileImageList;
+
+		private:
+			std::vector<StoryTextureAtlasRegion> textureAtlasRegionList;
+			std::vector<sf::Image> textureAtlasPageImageList;
+			std::vector<sf::Texture*> textureAtlasPageList;
 
 		private:
 			StoryMapAssetBundle mapAssetBundle;
-			std::unordered_map<std::string, StoryMapAssetBundle> cutsceneMapAssetBundleMap;
+			std::unordered_map<std::string, int> cutsceneMapHandleMap;
+			std::vector<StoryMapAssetBundle> cutsceneMapAssetBundleList;
 
 		private:
 			sf::Music music;
 			sf::Music openingCutsceneMusic;
 			sf::Music winCutsceneMusic;
 			sf::Music lossCutsceneMusic;
-			sf::SoundBuffer foodSpawnedSoundBuffer;
-			sf::SoundBuffer eatFoodSoundBuffer;
-			sf::SoundBuffer hitBarrierSoundBuffer;
-			sf::SoundBuffer snakeHissSoundBuffer;
-			std::unordered_map<std::string, sf::SoundBuffer> soundBufferMap;
+			int foodSpawnedSoundBufferHandle;
+			int eatFoodSoundBufferHandle;
+			int hitBarrierSoundBufferHandle;
+			int snakeHissSoundBufferHandle;
+			std::unordered_map<std::string, int> soundBufferHandleMap;
+			std::vector<std::string> soundBufferFilenameList;
+			std::vector<std::string> soundBufferFilePathList;
+			std::vector<StoryDecodedSoundSamples> soundSamplesList;
+			std::vector<sf::Uint64> soundBufferKeyList;
+			std::vector<const sf::SoundBuffer*> soundBufferList;
 
 		public:
-			StoryLevelAssetBundle();
+			StoryLevelAssetBundle(StoryAssetCache& assetCache);
 
 		public:
 			~StoryLevelAssetBundle();
 
 		public:
-			void loadLevelAsync(const std::string& campaignFolderName, StoryLevelDefn& levelDefn);
+			void loadLevelAsync(const std::string& campaignFolderName, StoryLevelDefn& levelDefn, StoryLevelAssetLoadPriority loadPriority);
+			void loadCampaignLevelAsync(const std::string& campaignFolderName, StoryCampaignIndex& campaignIndex, int levelIndex, StoryLevelAssetLoadPriority loadPriority);
+			void setLoadPriority(StoryLevelAssetLoadPriority loadPriority);
+			void uploadDecodedTextures();
 			StoryLevelAssetLoadingStatus getLoadingStatus();
 
 		public:
@@ -84,7 +260,7 @@ namespace r3 {
 
 		public:
 			const StoryMapDefn& getMapDefn() const;
-			const sf::Texture& getTexture(const std::string& filename) const;
+			const sf::Texture& getTexture(int textureHandle) const;
 			const sf::Texture& getSnakeTexture() const;
 			const sf::Texture& getFoodTexture() const;
 			const sf::Texture& getDangerTexture() const;
@@ -92,9 +268,18 @@ namespace r3 {
 			const sf::Texture& getBarrierTexture(int barrierId) const;
 
 		public:
-			const StoryMapDefn& getCutsceneMapDefn(const std::string& mapFilename) const;
-			const sf::Texture& getCutsceneMapFloorTexture(const std::string& mapFilename, int floorId) const;
-			const sf::Texture& getCutsceneMapBarrierTexture(const std::string& mapFilename, int barrierId) const;
+			const StoryMapDefn& getCutsceneMapDefn(int mapHandle) const;
+			const sf::Texture& getCutsceneMapFloorTexture(int mapHandle, int floorId) const;
+			const sf::Texture& getCutsceneMapBarrierTexture(int mapHandle, int barrierId) const;
+
+		public:
+			int getTextureAtlasPageCount() const;
+			const sf::Texture& getTextureAtlasPage(int pageIndex) const;
+			const StoryTextureAtlasRegion& getTextureAtlasRegion(int textureHandle) const;
+			const StoryTextureAtlasRegion& getFloorAtlasRegion(int floorId) const;
+			const StoryTextureAtlasRegion& getBarrierAtlasRegion(int barrierId) const;
+			const StoryTextureAtlasRegion& getCutsceneMapFloorAtlasRegion(int mapHandle, int floorId) const;
+			const StoryTextureAtlasRegion& getCutsceneMapBarrierAtlasRegion(int mapHandle, int barrierId) const;
 
 		public:
 			sf::Music& getMusic();
@@ -105,30 +290,38 @@ namespace r3 {
 			const sf::SoundBuffer& getEatFoodSoundBuffer() const;
 			const sf::SoundBuffer& getHitBarrierSoundBuffer() const;
 			const sf::SoundBuffer& getSnakeHissSoundBuffer() const;
-			const sf::SoundBuffer& getSoundBuffer(const std::string& filename) const;
+			const sf::SoundBuffer& getSoundBuffer(int soundBufferHandle) const;
 
 		private:
+			void loadCampaignLevel();
 			void loadLevel();
 			void loadCutsceneSoundTrack(sf::Music& targetMusic, const StoryCutsceneDefn& cutsceneDefn);
-			void loadCutsceneTextures(const StoryCutsceneDefn& cutsceneDefn);
-			void loadCutsceneMaps(const StoryCutsceneDefn& cutsceneDefn);
+			void resolveCutsceneTextureHandles(StoryCutsceneDefn& cutsceneDefn);
+			void resolveCutsceneMapHandles(StoryCutsceneDefn& cutsceneDefn);
+			int resolveCutsceneMapHandle(const std::string& filename);
 			LoadStoryMapResult loadMap(const std::string& filename);
 
 		private:
-			void loadSnakeTexture();
-			void loadFoodTexture();
-			void loadDangerTexture();
-			void loadFloorTextureMap(StoryMapAssetBundle& mapAssetBundle);
-			void loadBarrierTextureMap(StoryMapAssetBundle& mapAssetBundle);
-			void loadTexture(const std::string& filename, bool repeatFlag);
+			void resolveFloorTextureHandleList(StoryMapAssetBundle& mapAssetBundle);
+			void resolveBarrierTextureHandleList(StoryMapAssetBundle& mapAssetBundle);
+			int resolveTextureHandle(const std::string& filename, const std::string& filePath, bool repeatFlag);
 
 		private:
 			void loadMusic();
-			void loadFoodSpawnedSoundBuffer();
-			void loadEatFoodSoundBuffer();
-			void loadHitBarrierSoundBuffer();
-			void loadSnakeHissSoundBuffer();
-			void loadSoundBuffer(const std::string& filename);
+			int resolveSoundBufferHandle(const std::string& filename, const std::string& filePath);
+
+		private:
+			void decodeAssets();
+			void launchDecodeWorkers(std::vector<sf::Thread*>& workerThreadList);
+			void runDecodeWorker();
+			void decodeTexture(int textureHandle);
+			void buildTextureAtlas();
+			const sf::Image& resolveDecodedImage(size_t textureHandle) const;
+			void uploadDecodedTexture(size_t textureHandle);
+			void releaseTileImage(size_t textureHandle);
+			void uploadNextTextureAtlasPage();
+			void decodeSoundSamples(int soundBufferHandle);
+			void createSoundBufferList();
 
 		private:
 			void indicateLoadingFilename(const std::string& filename);
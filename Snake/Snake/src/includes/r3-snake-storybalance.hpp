@@ -0,0 +1,121 @@
+
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+#include "r3-snake-storydefn.hpp"
+#include "r3-snake-storyloader.hpp"
+#include "r3-snake-storymodescene.hpp"
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryBalanceConstants {
+
+			extern const int DEFAULT_RUNS_PER_LEVEL;
+			extern const int DEFAULT_MAX_SECONDS_PER_RUN;
+
+		}
+
+		typedef struct Snake_StoryBalanceOptions {
+			int runsPerLevel;
+			int threadCount;
+			int maxTicksPerRun;
+			unsigned int baseSeed;
+		} StoryBalanceOptions;
+
+		typedef struct Snake_StoryBalanceRunResult {
+			bool wonFlag;
+			bool diedFlag;
+			int ticksElapsed;
+			int score;
+			sf::Int64 peakTickMicroseconds;
+			sf::Uint64 steadyStateAllocationCount;
+			int firstAllocatingTick;
+		} StoryBalanceRunResult;
+
+		typedef struct Snake_StoryBalanceLevelReport {
+			int levelIndex;
+			std::string mapFilename;
+			int runCount;
+			int winCount;
+			int lossCount;
+			int timeoutCount;
+			float winRatePct;
+			float minSecondsToComplete;
+			float avgSecondsToComplete;
+			float maxSecondsToComplete;
+			int minScore;
+			int p10Score;
+			int medianScore;
+			int p90Score;
+			int maxScore;
+			sf::Int64 peakTickMicroseconds;
+			sf::Uint64 steadyStateAllocationCount;
+			int firstAllocatingTick;
+		} StoryBalanceLevelReport;
+
+		typedef struct Snake_StoryBalanceReport {
+			bool campaignValid = false;
+			bool mapListValid = false;
+			int threadCount = 0;
+			int totalRunCount = 0;
+			float secondsElapsed = 0.0f;
+			bool allocationsCountedFlag = false;
+			sf::Uint64 steadyStateAllocationCount = 0;
+			std::vector<StoryBalanceLevelReport> levelReportList;
+
+			bool valid() const {
+				bool result =
+					campaignValid &&
+					mapListValid &&
+					(steadyStateAllocationCount == 0);
+				return result;
+			}
+		} StoryBalanceReport;
+
+		class StoryBalanceRunner {
+
+		private:
+			std::string campaignFolderName;
+			StoryBalanceOptions options;
+
+		private:
+			std::vector<StoryLevelDefn> levelDefnList;
+			std::vector<StoryMapDefn> mapDefnList;
+
+		private:
+			sf::Mutex jobMutex;
+			int nextJobIndex;
+			int totalJobCount;
+			std::vector<StoryBalanceRunResult> runResultList;
+
+		public:
+			StoryBalanceRunner(const std::string& campaignFolderName, const StoryBalanceOptions& options);
+
+		public:
+			StoryBalanceReport run();
+
+		private:
+			bool loadCampaign(StoryBalanceReport& report);
+			void runWorker();
+			bool claimJob(int& jobIndex);
+			StoryBalanceRunResult playLevel(StoryGame& storyGame, int levelIndex, unsigned int seed);
+
+		private:
+			StoryBalanceLevelReport buildLevelReport(int levelIndex) const;
+
+		};
+
+		namespace StoryBalanceUtils {
+
+			StoryBalanceOptions createDefaultOptions();
+
+			std::vector<std::string> buildReportMessages(const StoryBalanceReport& report);
+
+		}
+
+	}
+
+}
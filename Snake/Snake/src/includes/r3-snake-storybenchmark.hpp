@@ -0,0 +1,118 @@
+
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+#include "r3-snake-storydefn.hpp"
+#include "r3-snake-storyloader.hpp"
+#include "r3-snake-storyassets.hpp"
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryCampaignGeneratorConstants {
+
+			extern const int DEFAULT_LEVEL_COUNT;
+			extern const int DEFAULT_MAP_WIDTH;
+			extern const int DEFAULT_MAP_HEIGHT;
+			extern const int DEFAULT_OPENING_CUTSCENE_EVENT_COUNT;
+			extern const int DEFAULT_ENDING_CUTSCENE_EVENT_COUNT;
+
+		}
+
+		typedef struct Snake_StoryCampaignGeneratorOptions {
+			int levelCount;
+			sf::Vector2i mapSize;
+			int floorDefnCount;
+			int barrierDefnCount;
+			int foodDefnCount;
+			int dangerDefnCount;
+			int openingCutsceneEventCount;
+			int endingCutsceneEventCount;
+			unsigned int seed;
+		} StoryCampaignGeneratorOptions;
+
+		typedef struct Snake_StoryGenerateCampaignResult {
+			bool folderCreated = false;
+			int levelCount = 0;
+			int mapCount = 0;
+			int cutsceneEventCount = 0;
+			size_t jsonBytes = 0;
+			std::vector<std::string> failedFilenameList;
+
+			bool valid() const {
+				bool result =
+					folderCreated &&
+					failedFilenameList.empty();
+				return result;
+			}
+		} StoryGenerateCampaignResult;
+
+		typedef struct Snake_StoryLoaderBenchmarkResult {
+			bool campaignValid = false;
+			bool warmCacheHit = false;
+			int levelCount = 0;
+			int mapCount = 0;
+			int cutsceneEventCount = 0;
+			size_t campaignFileBytes = 0;
+			size_t mapFileBytes = 0;
+			float parseSeconds = 0.0f;
+			float validationSeconds = 0.0f;
+			float mapLoadSeconds = 0.0f;
+			float coldLoadSeconds = 0.0f;
+			float warmLoadSeconds = 0.0f;
+			int assetBundleCount = 0;
+			int assetBundleFailedCount = 0;
+			float assetBundleSeconds = 0.0f;
+			StoryAssetCacheStats firstLevelAssetCacheStats = StoryAssetCacheStats();
+			StoryAssetCacheStats assetCacheStats = StoryAssetCacheStats();
+			size_t peakResidentBytes = 0;
+		} StoryLoaderBenchmarkResult;
+
+		typedef struct Snake_StoryFrameTimeStats {
+			int frameCount = 0;
+			float avgFrameMicroseconds = 0.0f;
+			sf::Int64 p99FrameMicroseconds = 0;
+			sf::Int64 maxFrameMicroseconds = 0;
+		} StoryFrameTimeStats;
+
+		typedef struct Snake_StoryPrefetchFrameTimeResult {
+			bool campaignValid = false;
+			int prefetchedBundleCount = 0;
+			StoryFrameTimeStats prefetchOffStats = StoryFrameTimeStats();
+			StoryFrameTimeStats prefetchOnStats = StoryFrameTimeStats();
+		} StoryPrefetchFrameTimeResult;
+
+		// Writes a campaign of the requested size into resources/campaigns, in the same JSON schema the shipped
+		// campaigns use, together with placeholder textures and sounds so that every level validates.  The
+		// campaign is not added to campaign-list.json.
+		namespace StoryCampaignGeneratorUtils {
+
+			StoryCampaignGeneratorOptions createDefaultOptions();
+
+			StoryGenerateCampaignResult generateCampaign(const std::string& campaignFolderName, const StoryCampaignGeneratorOptions& options);
+
+			std::vector<std::string> buildGenerateMessages(const StoryGenerateCampaignResult& generateResult);
+
+		}
+
+		// Times each stage of loading a campaign without opening a window.  Asset bundles are decoded but their
+		// textures are never uploaded, since that needs a GL context.
+		namespace StoryLoaderBenchmarkUtils {
+
+			size_t resolvePeakResidentBytes();
+
+			StoryLoaderBenchmarkResult runBenchmark(const std::string& campaignFolderName);
+
+			std::vector<std::string> buildReportMessages(const StoryLoaderBenchmarkResult& benchmarkResult);
+
+			StoryPrefetchFrameTimeResult measurePrefetchFrameTimes(const std::string& campaignFolderName, int frameCount);
+
+			std::vector<std::string> buildPrefetchFrameTimeMessages(const StoryPrefetchFrameTimeResult& frameTimeResult);
+
+		}
+
+	}
+
+}
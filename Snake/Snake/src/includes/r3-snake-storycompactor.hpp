@@ -0,0 +1,50 @@
+
+#include <string>
+#include <vector>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		typedef struct Snake_StoryCompactCampaignResult {
+			bool campaignParsed = false;
+			bool levelsValid = false;
+			bool cutscenesMatch = false;
+			bool fileWritten = false;
+			int cutsceneCount = 0;
+			int comparedFrameCount = 0;
+			int firstMismatchLevelIndex = -1;
+			int firstMismatchFrame = -1;
+			int foldedMoveCount = 0;
+			int pathEventCount = 0;
+			size_t verboseBytes = 0;
+			size_t compactBytes = 0;
+
+			bool valid() const {
+				bool result =
+					campaignParsed &&
+					levelsValid &&
+					cutscenesMatch &&
+					fileWritten;
+				return result;
+			}
+		} StoryCompactCampaignResult;
+
+		// Rewrites a campaign's campaign.json so that every run of two or more moveSnake events becomes a single
+		// moveSnakePath event.  Only the text of those runs is replaced, so the rest of the file keeps its layout.
+		// Before the file is written, every cutscene is played a frame at a time from both the old and the new text,
+		// and the file is left alone unless the screen views, snake, food and dangers match on every frame.
+		namespace StoryCampaignCompactorUtils {
+
+			std::string compactCampaignText(const std::string& campaignText, StoryCompactCampaignResult& compactResult);
+
+			StoryCompactCampaignResult compactCampaign(const std::string& campaignFolderName);
+
+			std::vector<std::string> buildCompactMessages(const StoryCompactCampaignResult& compactResult);
+
+		}
+
+	}
+
+}
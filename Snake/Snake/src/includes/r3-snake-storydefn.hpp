@@ -1,4 +1,5 @@
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -48,12 +49,20 @@ namespace r3 {
 			std::string filename;
 		} StoryMapTileDefn;
 
+		typedef struct Snake_StoryMapTile {
+			sf::Uint16 floorId;
+			sf::Uint8 barrierId;
+		} StoryMapTile;
+
+		// One entry per tile, row after row.  The loader builds it once and nothing modifies it afterwards, so
+		// copies of a StoryMapDefn and every StoryMap made from one share the same tiles.
+		typedef std::vector<StoryMapTile> StoryMapTileGrid;
+
 		typedef struct Snake_StoryMapDefn {
 			sf::Vector2i fieldSize;
 			std::unordered_map<int, StoryMapTileDefn> floorDefnMap;
 			std::unordered_map<int, StoryMapTileDefn> barrierDefnMap;
-			std::vector<std::vector<int>> floorGrid;
-			std::vector<std::vector<int>> barrierGrid;
+			std::shared_ptr<const StoryMapTileGrid> tileGrid;
 		} StoryMapDefn;
 
 		typedef enum class Snake_StoryCutsceneEventType {
@@ -68,6 +77,7 @@ namespace r3 {
 			HIDE_FOOD,
 			SHOW_DANGER,
 			HIDE_DANGER,
+			MOVE_SNAKE_PATH,
 		} StoryCutsceneEventType;
 		
 		typedef enum class Snake_StoryFoodType {
@@ -92,20 +102,35 @@ namespace r3 {
 
 		typedef struct Snake_StoryCutsceneTextureEventDefn {
 			int fadeFrames;
-			std::string textureFilename;
+			int filenameIndex;
+			int textureHandle;
 		} StoryCutsceneTextureEventDefn;
 
 		typedef struct Snake_StoryCutsceneMapEventDefn {
 			int fadeFrames;
-			std::string mapFilename;
+			int filenameIndex;
+			int mapHandle;
 		} StoryCutsceneMapEventDefn;
 
 		typedef struct Snake_StoryCutsceneSnakeEventDefn {
-			SnakeStartDefn snakeStart;
 			ObjectDirection snakeDirection;
 			bool snakeGrowFlag;
 		} StoryCutsceneSnakeEventDefn;
 
+		// A run of identical snake steps; the direction holds an ObjectDirection value.  The first step of a path
+		// waits for the event's framesSinceLastEvent, and every later step waits for its run's framesPerStep.
+		typedef struct Snake_StorySnakePathRun {
+			sf::Uint16 stepCount;
+			sf::Uint16 framesPerStep;
+			sf::Uint8 direction;
+			bool growFlag;
+		} StorySnakePathRun;
+
+		typedef struct Snake_StoryCutscenePathEventDefn {
+			int firstRunIndex;
+			int runCount;
+		} StoryCutscenePathEventDefn;
+
 		typedef struct Snake_StoryCutsceneFoodEventDefn {
 			int instanceId;
 			StoryFoodType foodType;
@@ -118,21 +143,32 @@ namespace r3 {
 			sf::Vector2i position;
 		} StoryCutsceneDangerEventDefn;
 
+		// The payload index refers into the cutscene's list for the event type, or is -1 for the
+		// event types that carry no payload (hideMap and hideSnake)
 		typedef struct Snake_StoryCutsceneEventDefn {
 			int framesSinceLastEvent;
 			StoryCutsceneEventType eventType;
-			StoryCutsceneColorEventDefn colorEvent;
-			StoryCutsceneTextureEventDefn textureEvent;
-			StoryCutsceneMapEventDefn mapEvent;
-			StoryCutsceneSnakeEventDefn snakeEvent;
-			StoryCutsceneFoodEventDefn foodEvent;
-			StoryCutsceneDangerEventDefn dangerEvent;
+			int payloadIndex;
 		} StoryCutsceneEventDefn;
 
+		// Events are kept as a compact list of (timing, type, payload index) entries, with each event type's
+		// payloads stored in their own list.  Texture and map filenames are interned in filenameList.  The lists
+		// themselves cost about 300 bytes per cutscene, empty or not, which for a short cutscene is more than its
+		// events and payloads put together.
 		typedef struct Snake_StoryCutsceneDefn {
 			bool existsFlag;
 			std::string soundTrackFilename;
 			std::vector<StoryCutsceneEventDefn> eventDefnList;
+			std::vector<std::string> filenameList;
+			std::vector<StoryCutsceneColorEventDefn> colorEventList;
+			std::vector<StoryCutsceneTextureEventDefn> textureEventList;
+			std::vector<StoryCutsceneMapEventDefn> mapEventList;
+			std::vector<SnakeStartDefn> snakeStartList;
+			std::vector<StoryCutsceneSnakeEventDefn> snakeEventList;
+			std::vector<StoryCutscenePathEventDefn> pathEventList;
+			std::vector<StorySnakePathRun> pathRunList;
+			std::vector<StoryCutsceneFoodEventDefn> foodEventList;
+			std::vector<StoryCutsceneDangerEventDefn> dangerEventList;
 		} StoryCutsceneDefn;
 
 		typedef enum class Snake_StoryWinConditionType {
@@ -199,6 +235,7 @@ namespace r3 {
 		typedef struct Snake_StorySoundFxDefn {
 			StorySoundFxTriggerType triggerType;
 			std::string soundFilename;
+			int soundBufferHandle;
 			int timePassed;
 			StoryFoodType foodType;
 			StoryDangerType dangerType;
@@ -226,19 +263,11 @@ namespace r3 {
 
 		private:
 			sf::Vector2i fieldSize;
-
-			int* allocatedFloorArray;
-			int** floorGrid;
-
-			int* allocatedBarrierArray;
-			int** barrierGrid;
+			std::shared_ptr<const StoryMapTileGrid> tileGrid;
 
 		public:
 			StoryMap(const StoryMapDefn& mapDefn);
 
-		public:
-			~StoryMap();
-
 		public:
 			sf::Vector2i getFieldSize() const;
 			int getFloorId(int x, int y) const;
@@ -0,0 +1,53 @@
+
+#include <string>
+#include <vector>
+#include "r3-snake-storydefn.hpp"
+#include "r3-snake-storyloader.hpp"
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryDefnCacheConstants {
+
+			extern const char* CACHE_FILE_EXTENSION;
+
+		}
+
+		typedef struct Snake_StoryDefnCacheLoadTimes {
+			bool campaignValid = false;
+			bool cacheWritten = false;
+			bool warmCacheHit = false;
+			int mapCount = 0;
+			float coldSeconds = 0.0f;
+			float warmSeconds = 0.0f;
+		} StoryDefnCacheLoadTimes;
+
+		// Validated campaigns are written to a binary file beside the campaign, together with the files they
+		// were built from: the JSON sources and the assets that validation looks at are each checked by a hash of
+		// their contents.  When every dependency still matches, loadStoryCampaign and loadStoryMap
+		// are served from the cache without touching jsoncpp or the validation passes.
+		namespace StoryDefnCacheUtils {
+
+			std::string resolveCacheFilePath(const std::string& campaignFolderName);
+
+			bool loadCachedCampaign(const std::string& campaignFolderName, LoadStoryCampaignResult& loadResult);
+
+			bool saveCachedCampaign(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadResult);
+
+			bool findCachedMap(const std::string& campaignFolderName, const std::string& mapFilename, LoadStoryMapResult& loadResult);
+
+			bool wasLoadedFromCache(const std::string& campaignFolderName);
+
+			void forgetCachedCampaign(const std::string& campaignFolderName);
+
+			StoryDefnCacheLoadTimes measureLoadTimes(const std::string& campaignFolderName);
+
+			std::vector<std::string> buildLoadTimeMessages(const StoryDefnCacheLoadTimes& loadTimes);
+
+		}
+
+	}
+
+}
@@ -0,0 +1,62 @@
+
+#include <string>
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryJsonScanConstants {
+
+			extern const int MAX_NESTING_DEPTH;
+
+		}
+
+		// A forward-only pass over JSON text that follows the grammar jsoncpp's strict mode accepts, without
+		// building any values.  Callers walk the members they care about and skip the rest.  Every scan function
+		// returns false once the text stops making sense, and the first failure is kept in errorString.
+		namespace StoryJsonScanUtils {
+
+			typedef struct Snake_ScanCursor {
+				const char* data;
+				size_t size;
+				size_t position;
+				std::string errorString;
+			} ScanCursor;
+
+			bool fail(ScanCursor& cursor, const char* errorDescription);
+
+			bool atEnd(const ScanCursor& cursor);
+
+			char peek(const ScanCursor& cursor);
+
+			void skipWhitespace(ScanCursor& cursor);
+
+			bool expect(ScanCursor& cursor, char expectedChar, const char* errorDescription);
+
+			// The string's raw bytes are handed back in place, escapes and all
+			bool scanString(ScanCursor& cursor, const char** rawBegin, size_t* rawLength);
+
+			// Escapes are decoded into value; surrogate pairs are reported as a failure
+			bool scanDecodedString(ScanCursor& cursor, std::string& value);
+
+			bool scanNumber(ScanCursor& cursor);
+
+			// Reads any value, reporting whether jsoncpp would consider it an int and what asInt() would return
+			bool scanInt(ScanCursor& cursor, int depth, bool* intFlag, int* value);
+
+			bool scanLiteral(ScanCursor& cursor, const char* literal);
+
+			bool scanObjectMembers(ScanCursor& cursor, int depth);
+
+			bool scanArrayElements(ScanCursor& cursor, int depth);
+
+			bool scanValue(ScanCursor& cursor, int depth);
+
+			bool nameMatches(const char* rawBegin, size_t rawLength, const char* name);
+
+		}
+
+	}
+
+}
@@ -4,6 +4,7 @@
 #include <set>
 #include "../jsoncpp/json/json.h"
 #include "r3-snake-storydefn.hpp"
+#include "r3-snake-storyarchive.hpp"
 #pragma once
 
 namespace r3 {
@@ -57,6 +58,31 @@ namespace r3 {
 			LoadStoryMapValidationResult validationResult;
 		} LoadStoryMapResult;
 
+		typedef struct Snake_StoryMapParseTimes {
+			bool streamedFlag = false;
+			bool resultsMatch = false;
+			bool mapValid = false;
+			sf::Vector2i fieldSize;
+			size_t fileSize = 0;
+			int iterationCount = 0;
+			float domSeconds = 0.0f;
+			float streamSeconds = 0.0f;
+		} StoryMapParseTimes;
+
+		typedef struct Snake_StoryCampaignValidationTiming {
+			int threadCount = 0;
+			float seconds = 0.0f;
+		} StoryCampaignValidationTiming;
+
+		typedef struct Snake_StoryCampaignValidationTimes {
+			bool campaignValid = false;
+			bool resultsMatch = true;
+			int levelCount = 0;
+			int hardwareThreadCount = 0;
+			std::vector<StoryCampaignValidationTiming> timingList;
+			std::vector<int> skippedThreadCountList;
+		} StoryCampaignValidationTimes;
+
 		typedef struct Snake_LoadStoryCutsceneEventValidationResult {
 			bool rootValid = false;
 			bool framesSinceLastEventValid = false;
@@ -70,6 +96,7 @@ namespace r3 {
 			bool snakeStartDirectionValid = true;
 			bool snakeStartLengthValid = true;
 			bool snakeMovementValid = true;
+			bool snakePathValid = true;
 			bool showObjectValid = true;
 			bool hideObjectValid = true;
 			bool objectInstanceIdValid = true;
@@ -91,6 +118,7 @@ namespace r3 {
 					snakeStartDirectionValid &&
 					snakeStartLengthValid &&
 					snakeMovementValid &&
+					snakePathValid &&
 					showObjectValid &&
 					hideObjectValid &&
 					objectInstanceIdValid &&
@@ -213,6 +241,8 @@ namespace r3 {
 		} LoadStoryLevelSoundFxValidationResult;
 
 		typedef struct Snake_LoadStoryLevelValidationResult {
+			std::string parseErrorString;
+
 			LoadStoryCutsceneValidationResult openingCutsceneValidationResult;
 			LoadStoryCutsceneValidationResult winCutsceneValidationResult;
 			LoadStoryCutsceneValidationResult lossCutsceneValidationResult;
@@ -257,6 +287,7 @@ namespace r3 {
 				}
 
 				bool result =
+					parseErrorString.empty() &&
 					openingCutsceneValidationResult.valid() &&
 					winCutsceneValidationResult.valid() &&
 					lossCutsceneValidationResult.valid() &&
@@ -310,6 +341,59 @@ namespace r3 {
 			}
 		} LoadStoryCampaignResult;
 
+		typedef struct Snake_LoadStoryCampaignIndexResult {
+			std::string parseErrorString;
+
+			bool levelListValid = false;
+			bool levelEntriesValid = false;
+
+			bool valid() const {
+				bool result =
+					parseErrorString.empty() &&
+					levelListValid &&
+					levelEntriesValid;
+				return result;
+			}
+		} LoadStoryCampaignIndexResult;
+
+		typedef struct Snake_StoryCampaignLevelSpan {
+			size_t offset;
+			size_t size;
+		} StoryCampaignLevelSpan;
+
+		// Opening a campaign only checks that campaign.json is well formed and notes where each entry of
+		// "levelList" sits in the file.  A level is parsed and validated the first time it is asked for,
+		// so starting the first level costs the same however many levels follow it.
+		class StoryCampaignIndex {
+
+		private:
+			std::string campaignFolderName;
+			StoryFileContents fileContents;
+			std::vector<StoryCampaignLevelSpan> levelSpanList;
+			std::vector<LoadStoryLevelResult> levelResultList;
+			std::vector<sf::Uint8> levelLoadedFlagList;
+			int loadedLevelCount;
+			bool loadedFromCacheFlag;
+			bool cacheSaveDueFlag;
+
+		public:
+			StoryCampaignIndex();
+
+		public:
+			LoadStoryCampaignIndexResult open(const std::string& campaignFolderName);
+			int getLevelCount() const;
+			bool wasLoadedFromCache() const;
+
+		public:
+			const LoadStoryLevelResult& loadLevel(int levelIndex);
+			StoryLevelDefn& getLevelDefn(int levelIndex);
+			void flushCachedCampaign();
+
+		private:
+			void saveCachedCampaign();
+
+		};
+
 		namespace StoryLoaderUtils {
 
 			namespace LoadAssetValidation {
@@ -318,6 +402,8 @@ namespace r3 {
 
 				bool musicFileValid(const std::string& campaignFolderName, const std::string& musicFilename);
 
+				void clearProbeCache();
+
 			}
 
 			namespace CampaignListProperties {
@@ -356,6 +442,8 @@ namespace r3 {
 				extern const char* TEXTURE;
 				extern const char* SNAKE_MOVEMENT;
 				extern const char* SNAKE_MOVEMENT_GROW;
+				extern const char* SNAKE_PATH;
+				extern const char* SNAKE_PATH_FRAMES_PER_STEP;
 				extern const char* SHOW_OBJECT;
 				extern const char* HIDE_OBJECT;
 				extern const char* OBJECT_INSTANCE_ID;
@@ -419,6 +507,21 @@ namespace r3 {
 
 			}
 
+			namespace SnakePathStepValues {
+
+				extern const char UP;
+				extern const char DOWN;
+				extern const char LEFT;
+				extern const char RIGHT;
+				extern const char UP_GROW;
+				extern const char DOWN_GROW;
+				extern const char LEFT_GROW;
+				extern const char RIGHT_GROW;
+
+				extern const int MAX_RUN_VALUE;
+
+			}
+
 			namespace CutsceneEventTypeValues {
 
 				extern const char* COLOR;
@@ -426,6 +529,7 @@ namespace r3 {
 				extern const char* SHOW_MAP;
 				extern const char* SHOW_SNAKE;
 				extern const char* MOVE_SNAKE;
+				extern const char* MOVE_SNAKE_PATH;
 				extern const char* HIDE_SNAKE;
 				extern const char* SHOW_FOOD;
 				extern const char* HIDE_FOOD;
@@ -490,13 +594,18 @@ namespace r3 {
 
 			namespace LoadStoryMapValidation {
 
+				extern const int MAX_WIDTH;
+				extern const int MAX_HEIGHT;
+				extern const int MAX_FLOOR_ID;
+				extern const int MAX_BARRIER_ID;
+
 				bool widthValid(const Json::Value& jsonValue);
 
 				bool heightValid(const Json::Value& jsonValue);
 
-				bool tileValid(const Json::Value& jsonValue, int minTileId);
+				bool tileValid(const Json::Value& jsonValue, int minTileId, int maxTileId);
 
-				bool tileListValid(const Json::Value& jsonValue, const char* propertyName, int minTileId);
+				bool tileListValid(const Json::Value& jsonValue, const char* propertyName, int minTileId, int maxTileId);
 
 				bool tileGridValid(const Json::Value& jsonValue, const char* propertyName);
 
@@ -504,7 +613,7 @@ namespace r3 {
 
 				void updateTextureFileInvalidList(std::vector<std::string>& textureFileInvalidList, const std::string& campaignFolderName, const std::unordered_map<int, StoryMapTileDefn>& storyMapTileDefnMap);
 
-				void updateNonExistentTileIdRefSet(std::set<int>& nonExistentTileIdRefList, const std::unordered_map<int, StoryMapTileDefn>& storyMapTileDefnMap, const std::vector<std::vector<int>>& tileGrid);
+				void updateNonExistentTileIdRefSet(std::set<int>& nonExistentTileIdRefList, const std::unordered_map<int, StoryMapTileDefn>& storyMapTileDefnMap, const std::vector<int>& tileGrid);
 
 				std::vector<std::string> buildErrorMessages(const LoadStoryMapValidationResult& validationResult);
 
@@ -522,6 +631,8 @@ namespace r3 {
 
 				bool snakeMovementValid(const Json::Value& jsonValue);
 
+				bool snakePathValid(const Json::Value& jsonValue);
+
 				LoadStoryCutsceneEventValidationResult validateEventEntry(const Json::Value& jsonValue);
 
 				LoadStoryCutsceneValidationResult validate(const Json::Value& jsonValue, const char* propertyName);
@@ -556,8 +667,18 @@ namespace r3 {
 
 				std::vector<std::string> buildErrorMessages(const LoadStoryCampaignResult& loadResult);
 
+				std::vector<std::string> buildErrorMessages(const LoadStoryCampaignIndexResult& indexResult);
+
+				std::vector<std::string> buildLevelErrorMessages(int levelIndex, const LoadStoryLevelResult& levelResult);
+
 			}
 
+			extern const char* PATH_CAMPAIGNS;
+
+			std::string resolveCampaignFilePath(const std::string& folderName);
+
+			std::string resolveMapFilePath(const std::string& campaignFolderName, const std::string& mapFilename);
+
 			std::string resolveImageFilePath(const std::string& campaignFolderName, const std::string& imageFilename);
 
 			std::string resolveSoundFilePath(const std::string& campaignFolderName, const std::string& soundFilename);
@@ -566,10 +687,40 @@ namespace r3 {
 
 			LoadCampaignListResult retrieveCampaignList();
 
+			// Parses a compact snake path such as "RRU3rD", where each letter is one step, a lowercase letter grows the
+			// snake, and a leading number overrides framesPerStep for that step.  The runs are appended to runList.
+			// Returns false on malformed input.
+			bool parseSnakePath(const std::string& pathString, int framesPerStep, std::vector<StorySnakePathRun>& runList);
+
+			int internCutsceneFilename(StoryCutsceneDefn& cutsceneDefn, const std::string& filename);
+
+			// Interleaves the floor and barrier grids of a map whose grids are both valid
+			std::shared_ptr<const StoryMapTileGrid> buildStoryMapTileGrid(const std::vector<int>& floorGrid, const std::vector<int>& barrierGrid);
+
+			// Reads a map file through jsoncpp's DOM
+			LoadStoryMapResult parseStoryMapDocument(const std::string& campaignFolderName, const StoryFileContents& fileContents);
+
+			// Reads a map file in a single forward pass, writing the grids straight into their flat tile arrays, and
+			// reports exactly what parseStoryMapDocument would.  Returns false without touching loadResult when the
+			// file has a syntax error or a member of an unexpected kind; such files are left to parseStoryMapDocument.
+			bool streamStoryMapDocument(const std::string& campaignFolderName, const StoryFileContents& fileContents, LoadStoryMapResult& loadResult);
+
+			StoryMapParseTimes measureMapParseTimes(const std::string& campaignFolderName, const std::string& mapFilename, int iterationCount);
+
+			std::vector<std::string> buildMapParseTimeMessages(const StoryMapParseTimes& parseTimes);
+
 			LoadStoryMapResult loadStoryMap(const std::string& campaignFolderName, const std::string& mapFilename);
 
+			LoadStoryLevelResult loadStoryLevel(const std::string& campaignFolderName, const Json::Value& jsonValue);
+
 			LoadStoryCampaignResult loadStoryCampaign(const std::string& campaignFolderName);
 
+			// Level entries are validated on up to threadCount threads; the cache is bypassed, and thread counts above
+			// the hardware's are skipped rather than timed
+			StoryCampaignValidationTimes measureCampaignValidationTimes(const std::string& campaignFolderName, const std::vector<int>& threadCountList);
+
+			std::vector<std::string> buildCampaignValidationTimeMessages(const StoryCampaignValidationTimes& validationTimes);
+
 			void appendToErrorLog(const std::vector<std::string>& errorMessages);
 
 			void appendFailedFilenameListToErrorLog(const std::vector<std::string>& failedFilenameList);
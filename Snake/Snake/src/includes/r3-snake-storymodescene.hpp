@@ -1,10 +1,13 @@
 
+#include <memory>
 #include <random>
-#include <queue>
-#include <unordered_set>
+#include <unordered_map>
 #include <SFML/Graphics.hpp>
 #include "r3-snake-storydefn.hpp"
 #include "r3-snake-storyassets.hpp"
+#include "r3-snake-slotmap.hpp"
+#include "r3-snake-spritebatch.hpp"
+#include "r3-snake-RenderUtils.hpp"
 #include "r3-snake-gameoptions.hpp"
 #include "r3-sound-SimpleSoundManager.hpp"
 #pragma once
@@ -52,21 +55,17 @@ namespace r3 {
 			const std::unordered_map<StoryFoodType, int>* foodEatenCountMap;
 		} StoryFoodSpawnCheckInput;
 
-		typedef struct Snake_StoryFoodPositionCheckResult {
-			bool foodExistsFlag;
-			int foodInstanceId;
-		} StoryFoodPositionCheckResult;
-
-		typedef struct Snake_StoryCheckForFoodEatenBySnakeResult {
-			std::vector<StoryFoodInstance> eatenBySnakeFoodInstanceList;
-			int snakeGrowth;
-		} StoryCheckForFoodEatenBySnakeResult;
-
 		typedef struct Snake_StoryFoodTileDistanceTracking {
 			int origTileDistanceFromSnake;
 			int tileDistanceSnakeTravelled;
 		} StoryFoodTileDistanceTracking;
 
+		typedef struct Snake_StoryFoodSlot {
+			StoryFoodInstance foodInstance;
+			int trackerIndex;
+			StoryFoodTileDistanceTracking tileDistanceTracking;
+		} StoryFoodSlot;
+
 		typedef struct Snake_StoryFoodEatenBySnakeScoreResult {
 			int baseScore;
 			int bonusPathScore;
@@ -91,10 +90,11 @@ namespace r3 {
 			const Snake* snake;
 		} StoryDangerSpawnCheckInput;
 
-		typedef struct Snake_StoryDangerPositionCheckResult {
-			bool dangerExistsFlag;
-			int dangerInstanceId;
-		} StoryDangerPositionCheckResult;
+		typedef struct Snake_StoryDangerSlot {
+			StoryDangerInstance dangerInstance;
+			int trackerIndex;
+			bool struckSnakeFlag;
+		} StoryDangerSlot;
 
 		typedef struct Snake_StoryDangerDespawnCheckInput {
 			int dangerInstanceId;
@@ -119,7 +119,30 @@ namespace r3 {
 			std::vector<StoryDangerInstance> spawnedDangerInstanceList;
 			std::vector<StoryFoodEatenResult> foodEatenResultList;
 			std::vector<StoryDangerInstance> dangerInstanceStruckSnakeList;
-			std::vector<std::string> soundFileTriggeredList;
+			std::vector<int> soundFxIndexTriggeredList;
+
+			void clear() {
+				snakeMovementResult = ObjectDirection::NONE;
+				snakeHitBarrierFlag = false;
+				snakeDiedFlag = false;
+				snakeGrewFlag = false;
+				snakeShrunkFlag = false;
+				snakeShrunkTooSmallFlag = false;
+				completedLevelFlag = false;
+				spawnedFoodInstanceList.clear();
+				spawnedDangerInstanceList.clear();
+				foodEatenResultList.clear();
+				dangerInstanceStruckSnakeList.clear();
+				soundFxIndexTriggeredList.clear();
+			}
+
+			void reserve(size_t foodCapacity, size_t dangerCapacity, size_t soundFxCapacity) {
+				spawnedFoodInstanceList.reserve(foodCapacity);
+				spawnedDangerInstanceList.reserve(dangerCapacity);
+				foodEatenResultList.reserve(1);
+				dangerInstanceStruckSnakeList.reserve(dangerCapacity);
+				soundFxIndexTriggeredList.reserve(soundFxCapacity);
+			}
 
 			bool snakeDamaged() const {
 				bool result =
@@ -130,12 +153,34 @@ namespace r3 {
 			}
 		} StoryGameUpdateResult;
 
+		typedef enum class Snake_StorySpawnTrigger {
+			NONE,
+			SNAKE_MOVED,
+			LENGTH_CHANGED,
+			HEALTH_CHANGED,
+			FOOD_EATEN,
+		} StorySpawnTrigger;
+
+		typedef enum class Snake_StoryScheduledCheckStatus {
+			IDLE,
+			SCHEDULED,
+			PARKED,
+		} StoryScheduledCheckStatus;
+
+		typedef struct Snake_StoryScheduledCheck {
+			int dueTick;
+			int trackerIndex;
+			int instanceId;
+		} StoryScheduledCheck;
+
 		class StoryFoodSpawnTracker;
 		class StoryDangerSpawnTracker;
+		class StorySpawnScheduler;
 		class StoryGame;
 		class StoryCutscene;
 		class StoryGameController;
 		class StoryGameRenderer;
+		class StoryReplayRecorder;
 
 		class StoryFoodSpawnTracker {
 
@@ -146,9 +191,7 @@ namespace r3 {
 			std::uniform_real_distribution<float> chancePctDistribution;
 
 		private:
-			std::vector<StoryFoodInstance> foodInstanceList;
-
-		private:
+			int foodInstanceCount;
 			int spawnCount;
 			sf::Time timeOfLastChanceCheck;
 			sf::Time timeOfLastSpawn;
@@ -158,16 +201,21 @@ namespace r3 {
 
 		public:
 			const StoryFoodDefn& getFoodDefn() const;
-			const std::vector<StoryFoodInstance>& getFoodInstanceList() const;
-			StoryFoodInstance getFoodInstance(int foodInstanceId) const;
+			int getFoodInstanceCount() const;
+			int resolveMaxFoodInstanceCount() const;
 
 		public:
 			bool shouldFoodSpawn(const StoryFoodSpawnCheckInput& input);
-			StoryFoodPositionCheckResult occupiesPosition(const sf::Vector2i& position) const;
 
 		public:
-			void spawnFood(const StoryFoodInstance& foodInstance);
-			void despawnFood(int foodInstanceId);
+			bool canSpawnAgain() const;
+			bool areTimeConditionsMet(const sf::Time& timeSinceLevelStarted) const;
+			sf::Time resolveEarliestCheckTime() const;
+			StorySpawnTrigger resolveSpawnTrigger() const;
+
+		public:
+			void spawnFood();
+			void despawnFood();
 
 		private:
 			bool areDespawnConditionsMet(const StoryFoodSpawnCheckInput& input);
@@ -177,9 +225,6 @@ namespace r3 {
 			bool areSnakePositionConditionsMet(const StoryFoodSpawnCheckInput& input);
 			bool areFoodEatenConditionsMet(const StoryFoodSpawnCheckInput& input);
 
-		private:
-			int findFoodInstanceIndex(int foodInstanceId) const;
-
 		};
 
 		class StoryDangerSpawnTracker {
@@ -191,9 +236,7 @@ namespace r3 {
 			std::uniform_real_distribution<float> chancePctDistribution;
 
 		private:
-			std::vector<StoryDangerInstance> dangerInstanceList;
-
-		private:
+			int dangerInstanceCount;
 			int spawnCount;
 			sf::Time timeOfLastChanceCheck;
 			sf::Time timeOfLastSpawn;
@@ -203,70 +246,144 @@ namespace r3 {
 
 		public:
 			const StoryDangerDefn& getDangerDefn() const;
-			const std::vector<StoryDangerInstance>& getDangerInstanceList() const;
-			StoryDangerInstance getDangerInstance(int dangerInstanceId) const;
+			int getDangerInstanceCount() const;
 
 		public:
 			bool shouldDangerSpawn(const StoryDangerSpawnCheckInput& input);
-			StoryDangerPositionCheckResult occupiesPosition(const sf::Vector2i& position) const;
 			bool shouldDangerDespawn(const StoryDangerDespawnCheckInput& input) const;
 
 		public:
-			void spawnDanger(const StoryDangerInstance& dangerInstance);
-			void despawnDanger(int dangerInstanceId);
+			bool canSpawnAgain() const;
+			bool areTimeConditionsMet(const sf::Time& timeSinceLevelStarted) const;
+			sf::Time resolveEarliestCheckTime() const;
+			sf::Time resolveDespawnTime() const;
+			StorySpawnTrigger resolveSpawnTrigger() const;
+
+		public:
+			void spawnDanger();
+			void despawnDanger();
 
 		private:
 			bool areTimerConditionsMet(const StoryDangerSpawnCheckInput& input);
 			bool areLengthReachedConditionsMet(const StoryDangerSpawnCheckInput& input);
 			bool areSnakePositionConditionsMet(const StoryDangerSpawnCheckInput& input);
 
+		};
+
+		class StorySpawnScheduler {
+
 		private:
-			int findDangerInstanceIndex(int dangerInstanceId) const;
+			std::vector<StoryScheduledCheck> checkHeap;
+			std::vector<StoryScheduledCheckStatus> trackerStatusList;
+			std::vector<bool> trackerParkedOnTriggerList;
+			std::vector<std::vector<int>> parkedTrackerIndexListByTrigger;
+
+		public:
+			StorySpawnScheduler();
+
+		public:
+			void reset(int trackerCount);
+			void schedule(int trackerIndex, int dueTick);
+			void park(int trackerIndex, StorySpawnTrigger trigger);
+			void wakeTracker(int trackerIndex, int dueTick);
+			void wakeTrackers(StorySpawnTrigger trigger, int dueTick);
+			void popDueTrackers(int currTick, std::vector<int>& dueTrackerIndexList);
 
 		};
 
+		// Story mode runs at a fixed 60 ticks per second.  Tick times are rounded from the exact fraction of a
+		// second rather than built from the truncated frame length, so every 60th tick falls on a whole second.
+		namespace StoryGameTickUtils {
+
+			sf::Time tickToTime(int tick);
+
+			int resolveFirstTickNotBefore(const sf::Time& time);
+
+		}
+
+		namespace StorySpawnSchedulerUtils {
+
+			bool isCheckDueLater(const StoryScheduledCheck& check1, const StoryScheduledCheck& check2);
+
+			void pushCheck(std::vector<StoryScheduledCheck>& checkHeap, const StoryScheduledCheck& check);
+
+			StoryScheduledCheck popCheck(std::vector<StoryScheduledCheck>& checkHeap);
+
+		}
+
 		typedef enum class Snake_StoryGameStatus {
 			NOT_STARTED,
 			RUNNING,
 			ENDED,
 		} StoryGameStatus;
 
+		typedef struct Snake_StoryGameSnapshot {
+			std::default_random_engine randomizer;
+			StoryGameStatus status;
+			int ticksElapsed;
+			SnakeSegment snakeHead;
+			std::vector<SnakeSegment> snakeBodyList;
+			SnakeSegment snakeTail;
+			float snakeHealth;
+			int framesSinceSnakeMoved;
+			std::vector<ObjectDirection> snakeMovementQueue;
+			int queuedSnakeGrowth;
+			std::vector<StorySnakeMovementModifier> snakeMovementModifierList;
+			std::vector<StoryFoodSpawnTracker> foodSpawnTrackerList;
+			SlotMap<StoryFoodSlot> foodSlotMap;
+			std::unordered_map<StoryFoodType, int> foodEatenCountMap;
+			std::vector<StoryDangerSpawnTracker> dangerSpawnTrackerList;
+			SlotMap<StoryDangerSlot> dangerSlotMap;
+			StorySpawnScheduler foodSpawnScheduler;
+			StorySpawnScheduler dangerSpawnScheduler;
+			std::vector<StoryScheduledCheck> dangerDespawnCheckHeap;
+			std::vector<int> remainingSoundFxIndexList;
+			int score;
+		} StoryGameSnapshot;
+
 		class StoryGame {
 
 		private:
 			std::default_random_engine randomizer;
-			sf::Clock clock;
+			unsigned int levelSeed;
 			StoryGameStatus status;
-			sf::Time timeElapsedWhenEnded;
+			int ticksElapsed;
 
 		private:
 			const StoryLevelDefn* levelDefn;
 			StoryMap* map;
 			Snake* snake;
+			int maxSnakeLength;
 			float snakeHealth;
 
 		private:
 			int framesSinceSnakeMoved;
-			std::queue<ObjectDirection> snakeMovementQueue;
+			std::vector<ObjectDirection> snakeMovementQueue;
+			size_t snakeMovementQueueFrontIndex;
 			int queuedSnakeGrowth;
 
 		private:
-			int nextSnakeMovementModifierId;
-			std::unordered_map<int, StorySnakeMovementModifier> snakeMovementModifierMap;
+			std::vector<StorySnakeMovementModifier> snakeMovementModifierList;
 
 		private:
-			int nextFoodInstanceId;
 			std::vector<StoryFoodSpawnTracker> foodSpawnTrackerList;
-			std::unordered_map<int, StoryFoodTileDistanceTracking> foodTileDistanceTrackingMap;
+			SlotMap<StoryFoodSlot> foodSlotMap;
+			int foodInstanceCapacity;
 			std::unordered_map<StoryFoodType, int> foodEatenCountMap;
 
 		private:
-			int nextDangerInstanceId;
 			std::vector<StoryDangerSpawnTracker> dangerSpawnTrackerList;
-			std::unordered_map<int, bool> dangerStruckSnakeMap;
+			SlotMap<StoryDangerSlot> dangerSlotMap;
 
 		private:
-			std::unordered_set<const StorySoundFxDefn*> remainingSoundFxDefnSet;
+			StorySpawnScheduler foodSpawnScheduler;
+			StorySpawnScheduler dangerSpawnScheduler;
+			std::vector<StoryScheduledCheck> dangerDespawnCheckHeap;
+			std::vector<int> dueTrackerIndexList;
+			std::vector<sf::Vector2i> availablePositionList;
+
+		private:
+			std::vector<int> remainingSoundFxIndexList;
 
 		private:
 			int score;
@@ -281,12 +398,14 @@ namespace r3 {
 		public:
 			void startNewCampaign();
 			void startNewLevel(const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn);
+			void startNewLevel(const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn, unsigned int levelSeed);
 			void startRunningLevel();
 			void stopRunningLevel();
 
 		public:
 			void snapshotScoreAtLevelStart();
 			void resetScoreToLevelStart();
+			void restoreScoreAtLevelStart(int scoreAtLevelStart);
 
 		public:
 			StoryMap* getMap() const;
@@ -295,54 +414,65 @@ namespace r3 {
 			float getMaxSnakeHealth() const;
 			const std::vector<StoryFoodSpawnTracker>& getFoodSpawnTrackerList() const;
 			const std::vector<StoryDangerSpawnTracker>& getDangerSpawnTrackerList() const;
+			const SlotMap<StoryFoodSlot>& getFoodSlotMap() const;
+			const SlotMap<StoryDangerSlot>& getDangerSlotMap() const;
 			int getFoodEaten(StoryFoodType foodType) const;
 			sf::Time getTimeElapsed() const;
 			const StoryWinCondition& getWinCondition() const;
 			int getScore() const;
+			unsigned int getLevelSeed() const;
+			int getTicksElapsed() const;
+
+		public:
+			void update(const StoryGameInputRequest& input, StoryGameUpdateResult& result);
 
 		public:
-			StoryGameUpdateResult update(const StoryGameInputRequest& input);
+			sf::Uint64 calcStateHash() const;
+			StoryGameSnapshot createSnapshot() const;
+			void restoreSnapshot(const StoryGameSnapshot& snapshot);
 
 		private:
 			void freeLevel();
+			int resolveMaxSnakeLength() const;
 
 		private:
 			void acceptSnakeMovementList(const std::vector<ObjectDirection>& snakeMovementList);
 			void consumeAllUnusableSnakeInputs();
+			void popSnakeMovementQueue();
 			ObjectDirection resolveDirectionToMoveSnake();
 			bool snakeWouldHitBarrier(ObjectDirection direction);
 			void moveSnakeForward(ObjectDirection directionToMoveSnake);
 
 		private:
-			void updateSnakeMovementModifierMap();
+			void updateSnakeMovementModifierList();
 			float resolveSnakeSpeedTilesPerSecond();
 			void addNewSnakeMovementModifier(float movementMultiplier, float secondsToApply);
 
 		private:
-			std::vector<StoryFoodInstance> checkForFoodSpawns();
-			StoryCheckForFoodEatenBySnakeResult checkForFoodEatenBySnake();
-			std::vector<sf::Vector2i> buildAvailableFoodSpawnPositionList(const StoryFoodDefn& foodDefn);
+			void checkForFoodSpawns(std::vector<StoryFoodInstance>& spawnedFoodInstanceList);
+			int checkForFoodEatenBySnake(std::vector<StoryFoodEatenResult>& foodEatenResultList);
+			void buildAvailableFoodSpawnPositionList(const StoryFoodDefn& foodDefn);
 			bool foodOccupiesPosition(const sf::Vector2i& position);
 			StoryFoodInstance createFoodInstance(StoryFoodType foodType, const std::vector<sf::Vector2i>& availablePositionList);
+			StoryFoodTileDistanceTracking createFoodTileDistanceTracking(const StoryFoodInstance& foodInstance);
+			void updateFoodTileDistanceTrackingAfterSnakeMoved();
 
 		private:
-			void addNewFoodSpawnsToFoodTileDistanceTrackingMap(const std::vector<StoryFoodInstance>& spawnedFoodInstanceList);
-			void updateFoodTileDistanceTrackingMapAfterSnakeMoved();
-			std::unordered_map<int, StoryFoodEatenBySnakeScoreResult> buildFoodEatenBySnakeScoreResultMap(const std::vector<StoryFoodInstance>& eatenBySnakeFoodInstanceList);
-
-		private:
-			std::vector<StoryDangerInstance> checkForDangerSpawns();
-			std::vector<StoryDangerInstance> checkForDangersStrikingSnake();
+			void checkForDangerSpawns(std::vector<StoryDangerInstance>& spawnedDangerInstanceList);
+			void checkForDangersStrikingSnake(std::vector<StoryDangerInstance>& dangerInstanceStruckSnakeList);
 			void checkForDangerDespawns();
-			std::vector<sf::Vector2i> buildAvailableDangerSpawnPositionList(const StoryDangerDefn& dangerDefn);
+			void buildAvailableDangerSpawnPositionList(const StoryDangerDefn& dangerDefn);
 			bool dangerOccupiesPosition(const sf::Vector2i& position);
 			StoryDangerInstance createDangerInstance(StoryDangerType dangerType, const std::vector<sf::Vector2i>& availablePositionList);
 
 		private:
-			void addNewDangerSpawnsToDangerStruckSnakeMap(const std::vector<StoryDangerInstance>& spawnedDangerInstanceList);
+			void rescheduleFoodSpawnCheck(int trackerIndex);
+			void rescheduleDangerSpawnCheck(int trackerIndex);
+			void scheduleDangerDespawnCheck(int trackerIndex, const StoryDangerInstance& dangerInstance);
+			void wakeSpawnTrackers(StorySpawnTrigger trigger);
 
 		private:
-			std::vector<std::string> buildSoundFileTriggeredList(const StoryGameUpdateResult& updateResult);
+			void buildSoundFxIndexTriggeredList(StoryGameUpdateResult& updateResult);
 
 		private:
 			void updateHealthBy(float amount);
@@ -363,8 +493,8 @@ namespace r3 {
 			int fadeFrames;
 			int fadeFramesRemaining;
 			sf::Color color;
-			std::string textureFilename;
-			std::string mapFilename;
+			int textureHandle;
+			int mapHandle;
 		} StoryCutsceneScreenView;
 
 		class StoryCutscene {
@@ -378,12 +508,18 @@ namespace r3 {
 			int lastEventFrame;
 			int framesSinceLastEvent;
 			size_t nextEventIndex;
+			size_t nextPathRunIndex;
+			int nextPathRunStep;
 
 		private:
 			std::vector<StoryCutsceneScreenView> activeScreenViewList;
 			Snake* snake;
-			std::unordered_map<int, StoryFoodInstance> foodInstanceMap;
-			std::unordered_map<int, StoryDangerInstance> dangerInstanceMap;
+			std::vector<int> foodInstanceIdList;
+			std::vector<int> foodSlotIdList;
+			SlotMap<StoryFoodInstance> foodSlotMap;
+			std::vector<int> dangerInstanceIdList;
+			std::vector<int> dangerSlotIdList;
+			SlotMap<StoryDangerInstance> dangerSlotMap;
 
 		public:
 			StoryCutscene(const StoryCutsceneDefn& cutsceneDefn);
@@ -396,11 +532,12 @@ namespace r3 {
 			float getSecondsElapsed() const;
 			const std::vector<StoryCutsceneScreenView>& getActiveScreenViewList() const;
 			const Snake* getSnake() const;
-			const std::unordered_map<int, StoryFoodInstance>& getFoodInstanceMap() const;
-			const std::unordered_map<int, StoryDangerInstance>& getDangerInstanceMap() const;
+			const SlotMap<StoryFoodInstance>& getFoodSlotMap() const;
+			const SlotMap<StoryDangerInstance>& getDangerSlotMap() const;
 
 		public:
 			bool update();
+			bool advanceToFrame(int frame);
 
 		private:
 			void updateActiveScreenViews();
@@ -408,6 +545,8 @@ namespace r3 {
 		private:
 			void processEvents();
 			void processEvent(const StoryCutsceneEventDefn& eventDefn);
+			int resolveFramesUntilNextStep(const StoryCutsceneEventDefn& eventDefn) const;
+			bool processPathStep(const StoryCutscenePathEventDefn& pathEventDefn);
 
 		private:
 			void processColorEvent(const StoryCutsceneColorEventDefn& colorEventDefn);
@@ -416,9 +555,10 @@ namespace r3 {
 			void addScreenView(const StoryCutsceneScreenView& screenView);
 
 		private:
-			void processShowSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn);
+			void processShowSnakeEvent(const SnakeStartDefn& snakeStart);
 			void processMoveSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn);
-			void processHideSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn);
+			void moveSnake(ObjectDirection direction, bool growFlag);
+			void processHideSnakeEvent();
 
 		private:
 			void processShowFoodEvent(const StoryCutsceneFoodEventDefn& foodEventDefn);
@@ -428,6 +568,10 @@ namespace r3 {
 			void processShowDangerEvent(const StoryCutsceneDangerEventDefn& dangerEventDefn);
 			void processHideDangerEvent(const StoryCutsceneDangerEventDefn& dangerEventDefn);
 
+		private:
+			void buildInstanceIdLists();
+			int resolveInstanceIndex(const std::vector<int>& instanceIdList, int instanceId) const;
+
 		};
 
 		typedef struct Snake_StoryFoodEatenSummaryDt {
@@ -449,14 +593,21 @@ namespace r3 {
 			StoryGameMode mode;
 			std::string campaignFolder;
 			int currLevelIndex;
-			std::vector<StoryLevelDefn> levelDefnList;
+			StoryCampaignIndex campaignIndex;
+			StoryAssetCache* assetCache;
 			StoryLevelAssetBundle* levelAssetBundle;
+			StoryLevelAssetBundle* prefetchedLevelAssetBundle;
+			int prefetchedLevelIndex;
 			r3::sound::SimpleSoundManager soundManager;
 			StoryGame* storyGame;
 			StoryCutscene* storyCutscene;
+			StoryReplayRecorder* replayRecorder;
 
 		private:
 			std::vector<ObjectDirection> snakeMovementInputQueue;
+			StoryGameUpdateResult storyGameUpdateResult;
+			sf::Clock levelTickClock;
+			sf::Time levelTimeAccumulated;
 
 		private:
 			sf::Time timeSnakeLastDamaged;
@@ -484,6 +635,11 @@ namespace r3 {
 			void initiateLoadLevel();
 			void updateBasedOnLoadLevelStatus();
 
+		private:
+			void initiatePrefetchNextLevel();
+			void updatePrefetchedLevel();
+			void discardPrefetchedLevel();
+
 		private:
 			StoryGameSceneClientRequest processLoadErrorKeyEvent(sf::Event& event);
 			StoryGameSceneClientRequest processPlayOpeningCutsceneKeyEvent(sf::Event& event);
@@ -500,11 +656,13 @@ namespace r3 {
 			void updateWinCutscene();
 			void updateLossCutscene();
 			void updateGameRunning();
+			void runGameTick();
 
 		private:
 			void updateFoodEatenSummaryMap(const StoryFoodEatenResult& foodEatenResult);
 		
 		private:
+			void startRunningLevel();
 			void stopRunningLevel();
 			void moveToNextLevel();
 			
@@ -532,6 +690,15 @@ namespace r3 {
 			StoryFoodEatenBySnakeScoreResult scoreResult;
 		} StoryFoodEatenAnimation;
 
+		// The floor and barrier layers of a map never change while it is on screen, so they are drawn once into a
+		// render texture covering the playing field.  The tile grid is held so that its address, which keys the
+		// cache, cannot be reused by another map.
+		typedef struct Snake_StoryBakedPlayingField {
+			std::shared_ptr<const StoryMapTileGrid> tileGrid;
+			sf::RenderTexture* renderTexture;
+			sf::Vector2f position;
+		} StoryBakedPlayingField;
+
 		class StoryGameRenderer {
 
 		private:
@@ -541,6 +708,17 @@ namespace r3 {
 		private:
 			std::vector<StoryFoodEatenAnimation> foodEatenAnimationList;
 
+		private:
+			std::unordered_map<const StoryMapTileGrid*, StoryBakedPlayingField> bakedPlayingFieldMap;
+			SpriteBatch spriteBatch;
+			SnakeVertexBuffer snakeVertexBuffer;
+
+		private:
+			std::unordered_map<int, sf::RenderTexture*> cutsceneMapTextureMap;
+			int cutsceneMapTextureCreateCount;
+			sf::RenderTexture* cutsceneComposeTexture;
+			bool cutsceneComposeTextureFailedFlag;
+
 		public:
 			StoryGameRenderer();
 
@@ -550,6 +728,9 @@ namespace r3 {
 		public:
 			void clearAnimations();
 			void queueFoodEatenAnimations(const std::vector<StoryFoodEatenResult>& foodEatenResultList, const StoryGame* storyGame);
+			void clearBakedPlayingFields();
+			void clearCutsceneMapTextures();
+			int getCutsceneMapTextureCreateCount() const;
 
 		public:
 			void renderLoadCampaignError(sf::RenderTarget& renderTarget);
@@ -558,8 +739,9 @@ namespace r3 {
 			void renderCutscene(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState);
 			void renderCutscenePlayingField(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryCutsceneScreenView& screenView);
 			void renderCutsceneSnake(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState);
-			void renderCutsceneFood(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState);
-			void renderCutsceneDangers(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState);
+			void appendCutsceneFood(const StoryCutsceneRenderState& renderState);
+			void appendCutsceneDangers(const StoryCutsceneRenderState& renderState);
+			void renderCutsceneOverlays(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState);
 			void renderWaitToStart(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
 			void renderGameRunning(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
 			void renderLevelSummary(sf::RenderTarget& renderTarget, const StoryLevelSummaryRenderState& renderState);
@@ -569,15 +751,21 @@ namespace r3 {
 		private:
 			void renderGameRunningUi(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
 			void renderPlayingField(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
+			void renderBakedPlayingField(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle);
+			const sf::RenderTexture* resolveCutsceneMapTexture(const StoryLevelAssetBundle& levelAssetBundle, const StoryCutsceneScreenView& screenView);
+			sf::RenderTexture* resolveCutsceneComposeTexture();
+			void renderFadingCutsceneMap(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState, const StoryCutsceneScreenView& screenView, const sf::RenderTexture& mapTexture, sf::RenderTexture& composeTexture);
+			void renderPlayingFieldTiles(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle);
 			void renderSnake(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
-			void renderFoodSpawns(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
-			void renderDangerSpawns(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
+			void appendFoodSpawns(const StoryGameRenderState& renderState);
+			void appendDangerSpawns(const StoryGameRenderState& renderState);
 			void renderFoodEatenAnimations(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState);
 			void renderLevelSummaryUi(sf::RenderTarget& renderTarget, const StoryLevelSummaryRenderState& renderState);
 			void renderWaitToStartInstructions(sf::RenderTarget& renderTarget);
 			void renderExitInstructions(sf::RenderTarget& renderTarget);
 
 		private:
+			const StoryBakedPlayingField& resolveBakedPlayingField(const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle);
 			sf::RectangleShape createTextBackgroundShape(float width, float height);
 			sf::Text createInstructionsText(const wchar_t* textString, float y);
 
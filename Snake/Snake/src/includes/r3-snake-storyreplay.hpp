@@ -0,0 +1,155 @@
+
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+#include "r3-snake-storydefn.hpp"
+#include "r3-snake-storyloader.hpp"
+#include "r3-snake-storymodescene.hpp"
+#pragma once
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryReplayConstants {
+
+			extern const char* LAST_REPLAY_FILENAME;
+
+			extern const int DEFAULT_HASH_INTERVAL_TICKS;
+			extern const int DEFAULT_KEYFRAME_INTERVAL_TICKS;
+
+		}
+
+		typedef struct Snake_StoryReplayInputTick {
+			int tick;
+			std::vector<ObjectDirection> snakeMovementList;
+		} StoryReplayInputTick;
+
+		typedef struct Snake_StoryReplay {
+			std::string campaignFolderName;
+			int levelIndex;
+			unsigned int levelSeed;
+			int levelStartScore;
+			int hashIntervalTicks;
+			int tickCount;
+			std::vector<StoryReplayInputTick> inputTickList;
+			std::vector<sf::Uint64> stateHashList;
+			std::vector<sf::Uint16> tickHashList;
+			sf::Uint64 finalStateHash;
+		} StoryReplay;
+
+		typedef struct Snake_StoryReplayKeyframe {
+			int tick;
+			size_t nextInputTickIndex;
+			StoryGameSnapshot snapshot;
+		} StoryReplayKeyframe;
+
+		typedef struct Snake_StoryReplayVerificationResult {
+			bool replayFileValid = false;
+			bool campaignValid = false;
+			bool levelIndexValid = false;
+			bool mapValid = false;
+			bool matchedFlag = false;
+			int firstDivergentTick = -1;
+			int lastMatchingTick = 0;
+			int ticksReplayed = 0;
+			float secondsElapsed = 0.0f;
+
+			bool valid() const {
+				bool result =
+					replayFileValid &&
+					campaignValid &&
+					levelIndexValid &&
+					mapValid;
+				return result;
+			}
+		} StoryReplayVerificationResult;
+
+		class StoryReplayRecorder {
+
+		private:
+			bool recordingFlag;
+			StoryReplay replay;
+
+		private:
+			sf::Thread* saveThread;
+			StoryReplay savedReplay;
+			std::string savedReplayFilename;
+
+		public:
+			StoryReplayRecorder();
+
+		public:
+			~StoryReplayRecorder();
+
+		public:
+			bool isRecording() const;
+			const StoryReplay& getReplay() const;
+
+		public:
+			void startRecording(const std::string& campaignFolderName, int levelIndex, const StoryGame& storyGame);
+			void recordTick(const StoryGameInputRequest& input, const StoryGame& storyGame);
+			void stopRecording(const StoryGame& storyGame);
+			void saveReplayAsync(const std::string& replayFilename);
+
+		private:
+			void runSaveReplay();
+
+		};
+
+		class StoryReplayPlayer {
+
+		private:
+			const StoryReplay* replay;
+			StoryGame* storyGame;
+			const StoryMapDefn* mapDefn;
+			const StoryLevelDefn* levelDefn;
+
+		private:
+			size_t nextInputTickIndex;
+			int keyframeIntervalTicks;
+			std::vector<StoryReplayKeyframe> keyframeList;
+			StoryGameUpdateResult updateResult;
+
+		public:
+			StoryReplayPlayer(const StoryReplay& replay, const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn);
+
+		public:
+			~StoryReplayPlayer();
+
+		public:
+			const StoryGame& getStoryGame() const;
+			int getCurrTick() const;
+			bool isFinished() const;
+
+		public:
+			void setKeyframeIntervalTicks(int keyframeIntervalTicks);
+			void restart();
+			const StoryGameUpdateResult& stepTick();
+			void buildKeyframes();
+			void seekToTick(int tick);
+
+		private:
+			void captureKeyframe();
+
+		};
+
+		namespace StoryReplayUtils {
+
+			std::string resolveUserDataFilePath(const std::string& filename);
+
+			sf::Uint16 foldTickHash(sf::Uint64 stateHash);
+
+			bool saveReplay(const std::string& replayFilename, const StoryReplay& replay);
+
+			bool loadReplay(const std::string& replayFilename, StoryReplay& replay);
+
+			StoryReplayVerificationResult verifyReplay(const std::string& replayFilename);
+
+			std::vector<std::string> buildVerificationMessages(const StoryReplayVerificationResult& verificationResult);
+
+		}
+
+	}
+
+}
@@ -8,6 +8,7 @@ namespace r3 {
 
 		namespace GameLoopUtils {
 
+			extern const sf::Int64 FRAMES_PER_SECOND;
 			extern const sf::Int64 MICROSECONDS_PER_FRAME;
 
 		}
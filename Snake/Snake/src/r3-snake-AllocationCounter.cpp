@@ -0,0 +1,43 @@
+#ifdef R3_SNAKE_COUNT_ALLOCATIONS
+
+#include <stdlib.h>
+#include <new>
+#include "includes/r3-snake-allocationcounter.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace AllocationCounterUtils {
+
+			thread_local sf::Uint64 threadAllocationCount = 0;
+
+			sf::Uint64 getThreadAllocationCount() {
+				return threadAllocationCount;
+			}
+
+		}
+
+	}
+
+}
+
+void* operator new(size_t size) {
+	r3::snake::AllocationCounterUtils::threadAllocationCount++;
+
+	void* result = malloc((size > 0) ? size : 1);
+	if (result == nullptr) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void operator delete(void* pointer) noexcept {
+	free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept {
+	free(pointer);
+}
+
+#endif
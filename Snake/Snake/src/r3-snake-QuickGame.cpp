@@ -14,6 +14,7 @@ namespace r3 {
 			this->snakeGrowthPerApple = quickGameDefn->snakeGrowthPerApple;
 
 			this->snake = new Snake(quickGameDefn->snakeStartDefn);
+			this->snake->reserveLength(quickGameDefn->fieldSize.x * quickGameDefn->fieldSize.y);
 
 			this->appleExistsFlag = false;
 			this->applePosition = sf::Vector2i(0, 0);
@@ -192,7 +192,7 @@ namespace r3 {
 			renderSnakeInput.snake = game.getSnake();
 			renderSnakeInput.snakeHurtFlag = false;
 
-			RenderUtils::renderSnake(renderTarget, renderSnakeInput);
+			this->snakeVertexBuffer.render(renderTarget, renderSnakeInput);
 		}
 
 		void QuickGameRenderer::renderScoreUi(sf::RenderTarget& renderTarget, const QuickGameRenderState& gameRenderState) {
@@ -1,5 +1,7 @@
 
 #include <assert.h>
+#include <algorithm>
+#include <vector>
 #include "includes/r3-snake-utils.hpp"
 #include "includes/r3-snake-RenderUtils.hpp"
 
@@ -11,18 +13,36 @@ namespace r3 {
 
 			const int TILE_PIXEL_SIZE = 75;
 
+			const unsigned int SNAKE_VERTEX_BUFFER_INITIAL_QUAD_CAPACITY = 256;
+
 			const float FIELD_HIGHEST_TOP_VIEWPORT_POSITION = 108.0f;
 			const float FIELD_MINIMUM_VIEWPORT_MARGIN = 20.0f;
 			const sf::Vector2f FIELD_CENTER_VIEWPORT_POSITION(960.0f, 576.0f);
 
-			typedef struct Snake_RenderSnakeSegmentInput {
+			typedef struct Snake_SnakeSegmentTextureOffset {
+				int x;
+				int y;
+			} SnakeSegmentTextureOffset;
+
+			// Where each segment's tile sits in the snake tileset, indexed by enter direction, exit direction and hurt
+			// flag, in ObjectDirection order (NONE, UP, RIGHT, DOWN, LEFT).  Heads are looked up with no exit direction
+			// and tails with no enter direction; only heads have a hurt variant.  Reversing combinations never occur.
+			constexpr SnakeSegmentTextureOffset SNAKE_SEGMENT_TEXTURE_OFFSET_LUT[5][5][2] = {
+				{ { { 0, 0 }, { 0, 0 } }, { { 0, 150 }, { 0, 150 } }, { { 225, 0 }, { 225, 0 } }, { { 75, 150 }, { 75, 150 } }, { { 225, 75 }, { 225, 75 } } },
+				{ { { 0, 0 }, { 300, 225 } }, { { 0, 75 }, { 0, 75 } }, { { 0, 300 }, { 0, 300 } }, { { 0, 0 }, { 0, 0 } }, { { 0, 225 }, { 0, 225 } } },
+				{ { { 375, 0 }, { 375, 300 } }, { { 150, 0 }, { 150, 0 } }, { { 300, 0 }, { 300, 0 } }, { { 75, 0 }, { 75, 0 } }, { { 0, 0 }, { 0, 0 } } },
+				{ { { 75, 300 }, { 300, 375 } }, { { 0, 0 }, { 0, 0 } }, { { 225, 150 }, { 225, 150 } }, { { 75, 225 }, { 75, 225 } }, { { 150, 150 }, { 150, 150 } } },
+				{ { { 75, 75 }, { 225, 300 } }, { { 300, 75 }, { 300, 75 } }, { { 0, 0 }, { 0, 0 } }, { { 375, 75 }, { 375, 75 } }, { { 150, 75 }, { 150, 75 } } },
+			};
+
+			static_assert(SNAKE_SEGMENT_TEXTURE_OFFSET_LUT[(int)ObjectDirection::DOWN][(int)ObjectDirection::NONE][1].x == 300, "Snake segment lookup table is not in ObjectDirection order");
+
+			typedef struct Snake_AppendSnakeSegmentInput {
 				const sf::Texture* texture;
 				float tileSize;
 				sf::Vector2f fieldPosition;
-				float spriteScale;
-				SnakeSegment segment;
 				bool snakeHurtFlag;
-			} RenderSnakeSegmentInput;
+			} AppendSnakeSegmentInput;
 
 			float resolveViewportTileSize(const sf::Vector2i& fieldSize) {
 				float maxFieldWidth = ViewUtils::VIEW_SIZE.x - (FIELD_MINIMUM_VIEWPORT_MARGIN * 2.0f);
@@ -48,170 +68,204 @@ namespace r3 {
 				return result;
 			}
 
-			sf::Sprite createSnakeHeadSprite(const RenderSnakeSegmentInput& input) {
-				assert(input.segment.segmentType == SnakeSegmentType::HEAD);
-
-				sf::Sprite result(*input.texture);
+			sf::IntRect resolveSnakeSegmentTextureRect(const SnakeSegment& segment, bool snakeHurtFlag) {
+				ObjectDirection enterDirection = segment.enterDirection;
+				ObjectDirection exitDirection = segment.exitDirection;
 
-				switch (input.segment.enterDirection) {
-				case ObjectDirection::UP:
-					if (input.snakeHurtFlag) {
-						result.setTextureRect(sf::IntRect(300, 225, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
-					else {
-						result.setTextureRect(sf::IntRect(0, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
-					break;
-				case ObjectDirection::RIGHT:
-					if (input.snakeHurtFlag) {
-						result.setTextureRect(sf::IntRect(375, 300, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
-					else {
-						result.setTextureRect(sf::IntRect(375, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
+				switch (segment.segmentType) {
+				case SnakeSegmentType::HEAD:
+					exitDirection = ObjectDirection::NONE;
 					break;
-				case ObjectDirection::DOWN:
-					if (input.snakeHurtFlag) {
-						result.setTextureRect(sf::IntRect(300, 375, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					} else {
-						result.setTextureRect(sf::IntRect(75, 300, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
+				case SnakeSegmentType::TAIL:
+					enterDirection = ObjectDirection::NONE;
 					break;
-				case ObjectDirection::LEFT:
-					if (input.snakeHurtFlag) {
-						result.setTextureRect(sf::IntRect(225, 300, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
-					else {
-						result.setTextureRect(sf::IntRect(75, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					}
+				case SnakeSegmentType::BODY:
+					assert(SnakeUtils::directionToVector(exitDirection) != -SnakeUtils::directionToVector(enterDirection));
 					break;
 				}
 
-				result.setPosition(input.fieldPosition.x + input.segment.position.x * input.tileSize, input.fieldPosition.y + input.segment.position.y * input.tileSize);
-				result.setScale(input.spriteScale, input.spriteScale);
+				const SnakeSegmentTextureOffset& textureOffset = SNAKE_SEGMENT_TEXTURE_OFFSET_LUT[(int)enterDirection][(int)exitDirection][snakeHurtFlag ? 1 : 0];
 
+				sf::IntRect result(textureOffset.x, textureOffset.y, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE);
 				return result;
 			}
 
-			sf::Sprite createSnakeTailSprite(const RenderSnakeSegmentInput& input) {
-				assert(input.segment.segmentType == SnakeSegmentType::TAIL);
+			sf::Vector2f resolveSnakeSegmentPosition(const AppendSnakeSegmentInput& input, const SnakeSegment& segment) {
+				sf::Vector2f result(input.fieldPosition.x + segment.position.x * input.tileSize, input.fieldPosition.y + segment.position.y * input.tileSize);
+				return result;
+			}
 
-				sf::Sprite result(*input.texture);
+			void appendSnakeSegment(SpriteBatch& spriteBatch, const AppendSnakeSegmentInput& input, const SnakeSegment& segment) {
+				spriteBatch.appendQuad(*input.texture, resolveSnakeSegmentPosition(input, segment), input.tileSize, resolveSnakeSegmentTextureRect(segment, input.snakeHurtFlag));
+			}
 
-				switch (input.segment.exitDirection) {
-				case ObjectDirection::UP:
-					result.setTextureRect(sf::IntRect(0, 150, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					break;
-				case ObjectDirection::RIGHT:
-					result.setTextureRect(sf::IntRect(225, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					break;
-				case ObjectDirection::DOWN:
-					result.setTextureRect(sf::IntRect(75, 150, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					break;
-				case ObjectDirection::LEFT:
-					result.setTextureRect(sf::IntRect(225, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-					break;
+			void buildSnakeSegmentQuad(sf::Vertex* quadVertexList, const AppendSnakeSegmentInput& input, const SnakeSegment& segment) {
+				SpriteBatchUtils::buildQuad(quadVertexList, resolveSnakeSegmentPosition(input, segment), input.tileSize, resolveSnakeSegmentTextureRect(segment, input.snakeHurtFlag));
+			}
+
+			AppendSnakeSegmentInput createAppendSnakeSegmentInput(const RenderSnakeInput& renderSnakeInput) {
+				AppendSnakeSegmentInput result;
+				result.texture = renderSnakeInput.texture;
+				result.tileSize = resolveViewportTileSize(renderSnakeInput.fieldSize);
+				result.fieldPosition = resolveViewportFieldTopLeftPosition(renderSnakeInput.fieldSize, result.tileSize);
+				result.snakeHurtFlag = renderSnakeInput.snakeHurtFlag;
+				return result;
+			}
+
+			void appendSnake(SpriteBatch& spriteBatch, const RenderSnakeInput& renderSnakeInput) {
+				AppendSnakeSegmentInput appendSegmentInput = createAppendSnakeSegmentInput(renderSnakeInput);
+
+				appendSnakeSegment(spriteBatch, appendSegmentInput, renderSnakeInput.snake->getTail());
+
+				int bodySegmentCount = renderSnakeInput.snake->getBodyLength();
+				for (int segmentIndex = bodySegmentCount - 1; segmentIndex >= 0; segmentIndex--) {
+					appendSnakeSegment(spriteBatch, appendSegmentInput, renderSnakeInput.snake->getBody(segmentIndex));
 				}
 
-				result.setPosition(input.fieldPosition.x + input.segment.position.x * input.tileSize, input.fieldPosition.y + input.segment.position.y * input.tileSize);
-				result.setScale(input.spriteScale, input.spriteScale);
+				appendSnakeSegment(spriteBatch, appendSegmentInput, renderSnakeInput.snake->getHead());
+			}
 
-				return result;
+			void renderSnake(sf::RenderTarget& renderTarget, const RenderSnakeInput& renderSnakeInput) {
+				SpriteBatch spriteBatch;
+				appendSnake(spriteBatch, renderSnakeInput);
+				spriteBatch.render(renderTarget);
 			}
 
-			sf::Sprite createSnakeBodySprite(const RenderSnakeSegmentInput& input) {
-				assert(input.segment.segmentType == SnakeSegmentType::BODY);
-
-				sf::Sprite result(*input.texture);
-				switch (input.segment.enterDirection) {
-				case ObjectDirection::UP:
-					assert(input.segment.exitDirection != ObjectDirection::DOWN);
-					switch (input.segment.exitDirection) {
-					case ObjectDirection::UP:
-						result.setTextureRect(sf::IntRect(0, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::RIGHT:
-						result.setTextureRect(sf::IntRect(0, 300, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::LEFT:
-						result.setTextureRect(sf::IntRect(0, 225, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					}
-					break;
-				case ObjectDirection::RIGHT:
-					assert(input.segment.exitDirection != ObjectDirection::LEFT);
-					switch (input.segment.exitDirection) {
-					case ObjectDirection::UP:
-						result.setTextureRect(sf::IntRect(150, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::RIGHT:
-						result.setTextureRect(sf::IntRect(300, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::DOWN:
-						result.setTextureRect(sf::IntRect(75, 0, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					}
-					break;
-				case ObjectDirection::DOWN:
-					assert(input.segment.exitDirection != ObjectDirection::UP);
-					switch (input.segment.exitDirection) {
-					case ObjectDirection::RIGHT:
-						result.setTextureRect(sf::IntRect(225, 150, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::DOWN:
-						result.setTextureRect(sf::IntRect(75, 225, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::LEFT:
-						result.setTextureRect(sf::IntRect(150, 150, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					}
-					break;
-				case ObjectDirection::LEFT:
-					assert(input.segment.exitDirection != ObjectDirection::RIGHT);
-					switch (input.segment.exitDirection) {
-					case ObjectDirection::UP:
-						result.setTextureRect(sf::IntRect(300, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::DOWN:
-						result.setTextureRect(sf::IntRect(375, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					case ObjectDirection::LEFT:
-						result.setTextureRect(sf::IntRect(150, 75, TILE_PIXEL_SIZE, TILE_PIXEL_SIZE));
-						break;
-					}
-					break;
+		}
+
+		SnakeVertexBuffer::SnakeVertexBuffer() {
+			this->vertexBuffer = nullptr;
+			this->quadCapacity = 0;
+			this->texture = nullptr;
+			this->fieldSize = sf::Vector2i(0, 0);
+			this->snakeHurtFlag = false;
+			this->changeLog.serialNumber = 0;
+			this->changeLog.pushedBodyCount = 0;
+		}
+
+		SnakeVertexBuffer::~SnakeVertexBuffer() {
+			if (this->vertexBuffer != nullptr) {
+				delete this->vertexBuffer;
+			}
+		}
+
+		void SnakeVertexBuffer::render(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput) {
+			bool bufferReadyFlag = sf::VertexBuffer::isAvailable();
+			if (bufferReadyFlag) {
+				if (this->requiresRebuild(renderSnakeInput)) {
+					bufferReadyFlag = this->rebuild(renderSnakeInput);
 				}
+				else {
+					this->updatePushedSegments(renderSnakeInput);
+				}
+			}
 
-				result.setPosition(input.fieldPosition.x + input.segment.position.x * input.tileSize, input.fieldPosition.y + input.segment.position.y * input.tileSize);
-				result.setScale(input.spriteScale, input.spriteScale);
+			if (bufferReadyFlag) {
+				this->renderBody(renderTarget, renderSnakeInput);
+				this->renderHeadAndTail(renderTarget, renderSnakeInput);
+			}
+			else {
+				RenderUtils::renderSnake(renderTarget, renderSnakeInput);
+			}
+		}
 
-				return result;
+		// The push count is unsigned, so the difference is still right after it wraps, and a count that has gone
+		// backwards shows up as a very large difference
+		bool SnakeVertexBuffer::requiresRebuild(const RenderUtils::RenderSnakeInput& renderSnakeInput) const {
+			SnakeChangeLog currChangeLog = renderSnakeInput.snake->getChangeLog();
+
+			bool result =
+				(this->vertexBuffer == nullptr) ||
+				(this->texture != renderSnakeInput.texture) ||
+				(this->fieldSize != renderSnakeInput.fieldSize) ||
+				(this->snakeHurtFlag != renderSnakeInput.snakeHurtFlag) ||
+				(this->changeLog.serialNumber != currChangeLog.serialNumber) ||
+				((unsigned int)renderSnakeInput.snake->getBodyLength() > this->quadCapacity) ||
+				(currChangeLog.pushedBodyCount - this->changeLog.pushedBodyCount > this->quadCapacity);
+			return result;
+		}
+
+		// The capacity is kept a power of two so that a segment's slot stays the same when the push count wraps
+		bool SnakeVertexBuffer::rebuild(const RenderUtils::RenderSnakeInput& renderSnakeInput) {
+			this->texture = renderSnakeInput.texture;
+			this->fieldSize = renderSnakeInput.fieldSize;
+			this->snakeHurtFlag = renderSnakeInput.snakeHurtFlag;
+			this->changeLog = renderSnakeInput.snake->getChangeLog();
+
+			unsigned int bodyLength = (unsigned int)renderSnakeInput.snake->getBodyLength();
+			this->quadCapacity = RenderUtils::SNAKE_VERTEX_BUFFER_INITIAL_QUAD_CAPACITY;
+			while (this->quadCapacity < bodyLength * 2) {
+				this->quadCapacity *= 2;
 			}
 
-			void renderSnake(sf::RenderTarget& renderTarget, const RenderSnakeInput& renderSnakeInput) {
-				RenderSnakeSegmentInput renderSegmentInput;
-				renderSegmentInput.texture = renderSnakeInput.texture;
-				renderSegmentInput.tileSize = resolveViewportTileSize(renderSnakeInput.fieldSize);
-				renderSegmentInput.fieldPosition = resolveViewportFieldTopLeftPosition(renderSnakeInput.fieldSize, renderSegmentInput.tileSize);
-				renderSegmentInput.spriteScale = renderSegmentInput.tileSize / (float)TILE_PIXEL_SIZE;
-				renderSegmentInput.snakeHurtFlag = renderSnakeInput.snakeHurtFlag;
+			if (this->vertexBuffer == nullptr) {
+				this->vertexBuffer = new sf::VertexBuffer(sf::Quads, sf::VertexBuffer::Dynamic);
+			}
 
-				renderSegmentInput.segment = renderSnakeInput.snake->getTail();
-				sf::Sprite tailSprite = createSnakeTailSprite(renderSegmentInput);
-				renderTarget.draw(tailSprite);
+			bool result = this->vertexBuffer->create(this->quadCapacity * 4);
+			if (result) {
+				RenderUtils::AppendSnakeSegmentInput appendSegmentInput = RenderUtils::createAppendSnakeSegmentInput(renderSnakeInput);
+				unsigned int slotMask = this->quadCapacity - 1;
 
-				int bodySegmentCount = renderSnakeInput.snake->getBodyLength();
-				for (int segmentIndex = bodySegmentCount - 1; segmentIndex >= 0; segmentIndex--) {
-					renderSegmentInput.segment = renderSnakeInput.snake->getBody(segmentIndex);
-					sf::Sprite bodySprite = createSnakeBodySprite(renderSegmentInput);
-					renderTarget.draw(bodySprite);
+				std::vector<sf::Vertex> vertexList(this->quadCapacity * 4);
+				for (unsigned int segmentIndex = 0; segmentIndex < bodyLength; segmentIndex++) {
+					unsigned int slot = (this->changeLog.pushedBodyCount - 1 - segmentIndex) & slotMask;
+					RenderUtils::buildSnakeSegmentQuad(&vertexList[slot * 4], appendSegmentInput, renderSnakeInput.snake->getBody((int)segmentIndex));
 				}
 
-				renderSegmentInput.segment = renderSnakeInput.snake->getHead();
-				sf::Sprite headSprite = createSnakeHeadSprite(renderSegmentInput);
-				renderTarget.draw(headSprite);
+				result = this->vertexBuffer->update(vertexList.data());
+			}
+
+			if (!result) {
+				delete this->vertexBuffer;
+				this->vertexBuffer = nullptr;
+			}
+
+			return result;
+		}
+
+		void SnakeVertexBuffer::updatePushedSegments(const RenderUtils::RenderSnakeInput& renderSnakeInput) {
+			SnakeChangeLog currChangeLog = renderSnakeInput.snake->getChangeLog();
+			unsigned int pushedCount = currChangeLog.pushedBodyCount - this->changeLog.pushedBodyCount;
+			unsigned int bodyLength = (unsigned int)renderSnakeInput.snake->getBodyLength();
+
+			RenderUtils::AppendSnakeSegmentInput appendSegmentInput = RenderUtils::createAppendSnakeSegmentInput(renderSnakeInput);
+			unsigned int slotMask = this->quadCapacity - 1;
+
+			// Segments pushed and already dropped off the tail since the last frame are skipped
+			for (unsigned int segmentIndex = 0; (segmentIndex < pushedCount) && (segmentIndex < bodyLength); segmentIndex++) {
+				unsigned int slot = (currChangeLog.pushedBodyCount - 1 - segmentIndex) & slotMask;
+
+				sf::Vertex quadVertexList[4];
+				RenderUtils::buildSnakeSegmentQuad(quadVertexList, appendSegmentInput, renderSnakeInput.snake->getBody((int)segmentIndex));
+				this->vertexBuffer->update(quadVertexList, 4, slot * 4);
+			}
+
+			this->changeLog = currChangeLog;
+		}
+
+		void SnakeVertexBuffer::renderBody(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput) {
+			unsigned int bodyLength = (unsigned int)renderSnakeInput.snake->getBodyLength();
+			unsigned int firstSlot = (this->changeLog.pushedBodyCount - bodyLength) & (this->quadCapacity - 1);
+
+			unsigned int firstRangeLength = std::min(bodyLength, this->quadCapacity - firstSlot);
+			if (firstRangeLength > 0) {
+				renderTarget.draw(*this->vertexBuffer, firstSlot * 4, firstRangeLength * 4, this->texture);
+			}
+
+			if (bodyLength > firstRangeLength) {
+				renderTarget.draw(*this->vertexBuffer, 0, (bodyLength - firstRangeLength) * 4, this->texture);
 			}
+		}
+
+		void SnakeVertexBuffer::renderHeadAndTail(sf::RenderTarget& renderTarget, const RenderUtils::RenderSnakeInput& renderSnakeInput) {
+			RenderUtils::AppendSnakeSegmentInput appendSegmentInput = RenderUtils::createAppendSnakeSegmentInput(renderSnakeInput);
+
+			sf::Vertex quadVertexList[8];
+			RenderUtils::buildSnakeSegmentQuad(&quadVertexList[0], appendSegmentInput, renderSnakeInput.snake->getTail());
+			RenderUtils::buildSnakeSegmentQuad(&quadVertexList[4], appendSegmentInput, renderSnakeInput.snake->getHead());
 
+			renderTarget.draw(quadVertexList, 8, sf::Quads, this->texture);
 		}
 
 	}
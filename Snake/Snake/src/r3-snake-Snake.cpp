@@ -1,5 +1,6 @@
 
 #include <assert.h>
+#include <atomic>
 #include "includes/r3-snake-gamestate.hpp"
 
 namespace r3 {
@@ -29,6 +30,13 @@ namespace r3 {
 				return result;
 			}
 
+			unsigned int claimSerialNumber() {
+				static std::atomic<unsigned int> nextSerialNumber(1);
+
+				unsigned int result = nextSerialNumber++;
+				return result;
+			}
+
 			bool positionInRect(const sf::Vector2i& position, const sf::IntRect& rect) {
 				bool result =
 					(position.x >= rect.left) &&
@@ -71,6 +79,18 @@ namespace r3 {
 			this->tail.position = nextSegmentPosition;
 			this->tail.enterDirection = ObjectDirection::NONE;
 			this->tail.exitDirection = startDefn.facingDirection;
+
+			this->initChangeLog();
+		}
+
+		Snake::Snake(const SnakeSegment& head, const std::vector<SnakeSegment>& bodyList, const SnakeSegment& tail) {
+			this->head = head;
+			this->bodyList.reserve(500);
+			this->bodyList = bodyList;
+			this->tail = tail;
+
+			this->initChangeLog();
+			this->assertContiguous();
 		}
 
 		SnakeSegment Snake::getHead() const {
@@ -95,6 +115,10 @@ namespace r3 {
 			return result;
 		}
 
+		SnakeChangeLog Snake::getChangeLog() const {
+			return this->changeLog;
+		}
+
 		bool Snake::isValidMovementDirection(ObjectDirection direction) const {
 			bool result = false;
 
@@ -165,6 +189,10 @@ namespace r3 {
 		}
 
 		void Snake::moveForward(ObjectDirection direction) {
+			if (this->getBodyLength() > 0) {
+				this->changeLog.pushedBodyCount++;
+			}
+
 			this->moveHeadForward(direction);
 			this->moveBodyForward();
 			this->moveTailForward();
@@ -173,6 +201,8 @@ namespace r3 {
 		}
 
 		void Snake::growForward(ObjectDirection direction) {
+			this->changeLog.pushedBodyCount++;
+
 			this->moveHeadForward(direction);
 			this->moveBodyForward();
 
@@ -198,9 +228,17 @@ namespace r3 {
 			this->assertContiguous();
 		}
 
+		// Growing past the reserved length still works, it just reallocates the body
+		void Snake::reserveLength(int length) {
+			if (length > 2) {
+				this->bodyList.reserve(length - 2);
+			}
+		}
+
 		void Snake::shrinkForward(ObjectDirection direction) {
 			this->moveHeadForward(direction);
 			if (this->getBodyLength() > 0) {
+				this->changeLog.pushedBodyCount++;
 				this->moveBodyForward();
 
 				SnakeSegment lastBodySegment = this->bodyList.back();
@@ -248,6 +286,11 @@ namespace r3 {
 			this->tail.exitDirection = newExitDirection;
 		}
 
+		void Snake::initChangeLog() {
+			this->changeLog.serialNumber = SnakeUtils::claimSerialNumber();
+			this->changeLog.pushedBodyCount = (unsigned int)this->bodyList.size();
+		}
+
 		void Snake::assertContiguous() {
 			int bodyLength = this->getBodyLength();
 
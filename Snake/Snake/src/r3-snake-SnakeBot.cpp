@@ -0,0 +1,722 @@
+
+#include <stdio.h>
+#include <algorithm>
+#include <climits>
+#include "includes/r3-snake-snakebot.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace SnakeBotConstants {
+
+			const int UNREACHABLE_DISTANCE = INT_MAX;
+
+			const sf::Int64 TARGET_TICK_MICROSECONDS = 50;
+
+			const ObjectDirection CANDIDATE_DIRECTION_LIST[4] = {
+				ObjectDirection::UP,
+				ObjectDirection::RIGHT,
+				ObjectDirection::DOWN,
+				ObjectDirection::LEFT,
+			};
+
+		}
+
+		typedef struct Snake_SnakeBotCandidate {
+			ObjectDirection direction;
+			sf::Vector2i position;
+			int targetDistance;
+		} SnakeBotCandidate;
+
+		// The grids carry a one tile border of barrier around the field, so a neighbour is always a fixed index
+		// offset away and never needs a bounds check
+		SnakeBot::SnakeBot(const sf::Vector2i& fieldSize) {
+			this->fieldSize = fieldSize;
+			this->paddedWidth = fieldSize.x + 2;
+
+			this->tileOffsetList[0] = -this->paddedWidth;
+			this->tileOffsetList[1] = 1;
+			this->tileOffsetList[2] = this->paddedWidth;
+			this->tileOffsetList[3] = -1;
+
+			int tileCount = this->paddedWidth * (fieldSize.y + 2);
+			this->barrierGrid.assign(tileCount, 1);
+			for (int y = 0; y < fieldSize.y; y++) {
+				for (int x = 0; x < fieldSize.x; x++) {
+					this->barrierGrid[this->toTileIndex(sf::Vector2i(x, y))] = 0;
+				}
+			}
+			this->targetDistanceGrid.assign(tileCount, SnakeBotConstants::UNREACHABLE_DISTANCE);
+			this->snakeOccupancyGrid.assign(tileCount, 0);
+			this->searchMarkGrid.assign(tileCount, 0);
+			this->searchQueue.reserve(tileCount);
+			this->repairTileList.reserve(tileCount);
+
+			this->reset();
+		}
+
+		void SnakeBot::setBarrier(int x, int y) {
+			this->barrierGrid[this->toTileIndex(sf::Vector2i(x, y))] = 1;
+		}
+
+		void SnakeBot::reset() {
+			this->targetPositionList.clear();
+			std::fill(this->targetDistanceGrid.begin(), this->targetDistanceGrid.end(), SnakeBotConstants::UNREACHABLE_DISTANCE);
+			this->targetVersion = 0;
+
+			this->snakePositionList.clear();
+			std::fill(this->snakeOccupancyGrid.begin(), this->snakeOccupancyGrid.end(), 0);
+
+			std::fill(this->searchMarkGrid.begin(), this->searchMarkGrid.end(), 0);
+			this->searchMark = 0;
+
+			this->decisionValidFlag = false;
+			this->decisionTargetVersion = 0;
+			this->decisionDirection = ObjectDirection::NONE;
+		}
+
+		ObjectDirection SnakeBot::resolveNextDirection(const SnakeBotInput& input) {
+			this->syncSnake(*input.snake);
+			this->syncTargets(*input.targetPositionList);
+
+			// The body only changes when the head moves, so a decision holds until the head or the targets change
+			sf::Vector2i headPosition = input.snake->getHead().position;
+			bool decisionStaleFlag =
+				!this->decisionValidFlag ||
+				(this->decisionHeadPosition != headPosition) ||
+				(this->decisionTargetVersion != this->targetVersion);
+
+			if (decisionStaleFlag) {
+				this->decisionDirection = this->decideDirection(input);
+				this->decisionHeadPosition = headPosition;
+				this->decisionTargetVersion = this->targetVersion;
+				this->decisionValidFlag = true;
+			}
+
+			return this->decisionDirection;
+		}
+
+		int SnakeBot::toTileIndex(const sf::Vector2i& position) const {
+			int result = (position.y + 1) * this->paddedWidth + (position.x + 1);
+			return result;
+		}
+
+		sf::Vector2i SnakeBot::toPosition(int tileIndex) const {
+			sf::Vector2i result((tileIndex % this->paddedWidth) - 1, (tileIndex / this->paddedWidth) - 1);
+			return result;
+		}
+
+		bool SnakeBot::inBounds(const sf::Vector2i& position) const {
+			bool result =
+				(position.x >= 0) &&
+				(position.x < this->fieldSize.x) &&
+				(position.y >= 0) &&
+				(position.y < this->fieldSize.y);
+			return result;
+		}
+
+		void SnakeBot::syncSnake(const Snake& snake) {
+			sf::Vector2i headPosition = snake.getHead().position;
+
+			bool headMovedOneTileFlag = false;
+			if (!this->snakePositionList.empty()) {
+				sf::Vector2i headOffset = headPosition - this->snakePositionList.front();
+				headMovedOneTileFlag = ((abs(headOffset.x) + abs(headOffset.y)) == 1);
+			}
+
+			if (headMovedOneTileFlag) {
+				this->snakePositionList.push_front(headPosition);
+				this->occupySnakePosition(headPosition);
+
+				while ((int)this->snakePositionList.size() > snake.getLength()) {
+					this->vacateSnakePosition(this->snakePositionList.back());
+					this->snakePositionList.pop_back();
+				}
+			}
+
+			bool inSyncFlag =
+				!this->snakePositionList.empty() &&
+				(this->snakePositionList.front() == headPosition) &&
+				(this->snakePositionList.back() == snake.getTail().position) &&
+				((int)this->snakePositionList.size() == snake.getLength());
+
+			if (!inSyncFlag) {
+				this->rebuildSnakePositionList(snake);
+			}
+		}
+
+		// The new body is occupied before the old one is vacated, so tiles covered by both never change and only the
+		// difference is repaired
+		void SnakeBot::rebuildSnakePositionList(const Snake& snake) {
+			std::deque<sf::Vector2i> previousPositionList;
+			previousPositionList.swap(this->snakePositionList);
+
+			this->snakePositionList.push_back(snake.getHead().position);
+			for (int bodyIndex = 0; bodyIndex < snake.getBodyLength(); bodyIndex++) {
+				this->snakePositionList.push_back(snake.getBody(bodyIndex).position);
+			}
+			this->snakePositionList.push_back(snake.getTail().position);
+
+			for (auto const& currPosition : this->snakePositionList) {
+				this->occupySnakePosition(currPosition);
+			}
+			for (auto const& currPosition : previousPositionList) {
+				this->vacateSnakePosition(currPosition);
+			}
+		}
+
+		void SnakeBot::occupySnakePosition(const sf::Vector2i& position) {
+			if (this->inBounds(position)) {
+				int tileIndex = this->toTileIndex(position);
+				this->snakeOccupancyGrid[tileIndex]++;
+				if (this->snakeOccupancyGrid[tileIndex] == 1) {
+					this->raiseTargetDistances(tileIndex);
+				}
+			}
+		}
+
+		void SnakeBot::vacateSnakePosition(const sf::Vector2i& position) {
+			if (this->inBounds(position)) {
+				int tileIndex = this->toTileIndex(position);
+				this->snakeOccupancyGrid[tileIndex]--;
+				if (this->snakeOccupancyGrid[tileIndex] == 0) {
+					this->lowerTargetDistances(tileIndex);
+				}
+			}
+		}
+
+		bool SnakeBot::blocksTargetDistance(int tileIndex) const {
+			bool result =
+				(this->barrierGrid[tileIndex] != 0) ||
+				(this->snakeOccupancyGrid[tileIndex] > 0);
+			return result;
+		}
+
+		int SnakeBot::claimSearchMark() {
+			this->searchMark++;
+			if (this->searchMark == INT_MAX) {
+				std::fill(this->searchMarkGrid.begin(), this->searchMarkGrid.end(), 0);
+				this->searchMark = 1;
+			}
+			return this->searchMark;
+		}
+
+		// Removed targets are raised before new ones are spread, so a target that merely moved never needs a rebuild
+		void SnakeBot::syncTargets(const std::vector<sf::Vector2i>& targetPositionList) {
+			if (targetPositionList == this->targetPositionList) {
+				return;
+			}
+
+			std::vector<sf::Vector2i> previousTargetPositionList;
+			previousTargetPositionList.swap(this->targetPositionList);
+			this->targetPositionList = targetPositionList;
+
+			for (auto const& currTargetPosition : previousTargetPositionList) {
+				if (
+					this->inBounds(currTargetPosition) &&
+					(std::find(this->targetPositionList.begin(), this->targetPositionList.end(), currTargetPosition) == this->targetPositionList.end())
+				) {
+					this->raiseTargetDistances(this->toTileIndex(currTargetPosition));
+				}
+			}
+
+			for (auto const& currTargetPosition : this->targetPositionList) {
+				this->spreadTargetDistance(currTargetPosition);
+			}
+
+			this->targetVersion++;
+		}
+
+		void SnakeBot::spreadTargetDistance(const sf::Vector2i& targetPosition) {
+			if (!this->inBounds(targetPosition)) {
+				return;
+			}
+
+			int targetTileIndex = this->toTileIndex(targetPosition);
+			if ((this->targetDistanceGrid[targetTileIndex] == 0) || this->blocksTargetDistance(targetTileIndex)) {
+				return;
+			}
+
+			this->targetDistanceGrid[targetTileIndex] = 0;
+			this->spreadTargetDistanceFrom(targetTileIndex);
+		}
+
+		// Only tiles that end up closer than they were are revisited
+		void SnakeBot::spreadTargetDistanceFrom(int tileIndex) {
+			this->searchQueue.clear();
+			this->searchQueue.push_back(tileIndex);
+
+			for (size_t queueIndex = 0; queueIndex < this->searchQueue.size(); queueIndex++) {
+				int currTileIndex = this->searchQueue[queueIndex];
+				int nextDistance = this->targetDistanceGrid[currTileIndex] + 1;
+
+				for (int currTileOffset : this->tileOffsetList) {
+					int nextTileIndex = currTileIndex + currTileOffset;
+					if (
+						!this->blocksTargetDistance(nextTileIndex) &&
+						(this->targetDistanceGrid[nextTileIndex] > nextDistance)
+					) {
+						this->targetDistanceGrid[nextTileIndex] = nextDistance;
+						this->searchQueue.push_back(nextTileIndex);
+					}
+				}
+			}
+		}
+
+		// A tile the snake has just covered, or a target that has gone, can only push distances up.  The tiles whose
+		// every shortest path ran through it are found first, in order of distance, so that a tile is only kept when
+		// some neighbour one step closer still holds.  Those tiles are then refilled from the unaffected tiles around
+		// them.
+		void SnakeBot::raiseTargetDistances(int raisedTileIndex) {
+			if (this->targetDistanceGrid[raisedTileIndex] == SnakeBotConstants::UNREACHABLE_DISTANCE) {
+				return;
+			}
+
+			int mark = this->claimSearchMark();
+
+			this->repairTileList.clear();
+			this->searchMarkGrid[raisedTileIndex] = mark;
+			this->repairTileList.push_back(raisedTileIndex);
+
+			for (size_t repairIndex = 0; repairIndex < this->repairTileList.size(); repairIndex++) {
+				int currTileIndex = this->repairTileList[repairIndex];
+				int dependentDistance = this->targetDistanceGrid[currTileIndex] + 1;
+
+				for (int currTileOffset : this->tileOffsetList) {
+					int nextTileIndex = currTileIndex + currTileOffset;
+					if (
+						(this->searchMarkGrid[nextTileIndex] == mark) ||
+						this->blocksTargetDistance(nextTileIndex) ||
+						(this->targetDistanceGrid[nextTileIndex] != dependentDistance)
+					) {
+						continue;
+					}
+
+					bool supportedFlag = false;
+					for (int currSupportTileOffset : this->tileOffsetList) {
+						int supportTileIndex = nextTileIndex + currSupportTileOffset;
+						supportedFlag = supportedFlag || (
+							(this->searchMarkGrid[supportTileIndex] != mark) &&
+							!this->blocksTargetDistance(supportTileIndex) &&
+							(this->targetDistanceGrid[supportTileIndex] == dependentDistance - 1)
+						);
+					}
+
+					if (!supportedFlag) {
+						this->searchMarkGrid[nextTileIndex] = mark;
+						this->repairTileList.push_back(nextTileIndex);
+					}
+				}
+			}
+
+			for (int currTileIndex : this->repairTileList) {
+				this->targetDistanceGrid[currTileIndex] = SnakeBotConstants::UNREACHABLE_DISTANCE;
+			}
+
+			// Refilled tiles start from different distances, so they are spread nearest first.  The seeds are
+			// bucketed by distance and merged with the breadth-first queue, which stays in distance order on its own.
+			if (this->blocksTargetDistance(raisedTileIndex)) {
+				this->repairTileList.erase(this->repairTileList.begin());
+			}
+			this->sortRepairTilesByDistance();
+
+			this->searchQueue.clear();
+			size_t seedIndex = 0;
+			size_t queueIndex = 0;
+			while (true) {
+				bool seedAvailableFlag =
+					(seedIndex < this->repairTileList.size()) &&
+					(this->targetDistanceGrid[this->repairTileList[seedIndex]] != SnakeBotConstants::UNREACHABLE_DISTANCE);
+				bool queueAvailableFlag = (queueIndex < this->searchQueue.size());
+				if (!seedAvailableFlag && !queueAvailableFlag) {
+					break;
+				}
+
+				int currTileIndex;
+				if (
+					seedAvailableFlag &&
+					(!queueAvailableFlag || (this->targetDistanceGrid[this->repairTileList[seedIndex]] <= this->targetDistanceGrid[this->searchQueue[queueIndex]]))
+				) {
+					currTileIndex = this->repairTileList[seedIndex];
+					seedIndex++;
+				}
+				else {
+					currTileIndex = this->searchQueue[queueIndex];
+					queueIndex++;
+				}
+
+				int nextDistance = this->targetDistanceGrid[currTileIndex] + 1;
+
+				for (int currTileOffset : this->tileOffsetList) {
+					int nextTileIndex = currTileIndex + currTileOffset;
+					if (
+						!this->blocksTargetDistance(nextTileIndex) &&
+						(this->targetDistanceGrid[nextTileIndex] > nextDistance)
+					) {
+						this->targetDistanceGrid[nextTileIndex] = nextDistance;
+						this->searchQueue.push_back(nextTileIndex);
+					}
+				}
+			}
+		}
+
+		// Unreachable seeds are left at the end, where the merge below stops
+		void SnakeBot::sortRepairTilesByDistance() {
+			int minDistance = SnakeBotConstants::UNREACHABLE_DISTANCE;
+			int maxDistance = 0;
+			for (int currTileIndex : this->repairTileList) {
+				int distance = this->resolveNeighbourTargetDistance(currTileIndex);
+				this->targetDistanceGrid[currTileIndex] = distance;
+				if (distance != SnakeBotConstants::UNREACHABLE_DISTANCE) {
+					minDistance = std::min(minDistance, distance);
+					maxDistance = std::max(maxDistance, distance);
+				}
+			}
+
+			if (minDistance == SnakeBotConstants::UNREACHABLE_DISTANCE) {
+				return;
+			}
+
+			this->repairBucketOffsetList.assign(maxDistance - minDistance + 2, 0);
+			for (int currTileIndex : this->repairTileList) {
+				int distance = this->targetDistanceGrid[currTileIndex];
+				int bucketIndex = (distance == SnakeBotConstants::UNREACHABLE_DISTANCE) ? (maxDistance - minDistance + 1) : (distance - minDistance);
+				this->repairBucketOffsetList[bucketIndex]++;
+			}
+
+			int bucketOffset = 0;
+			for (int& currBucketOffset : this->repairBucketOffsetList) {
+				int bucketSize = currBucketOffset;
+				currBucketOffset = bucketOffset;
+				bucketOffset += bucketSize;
+			}
+
+			this->searchQueue.resize(this->repairTileList.size());
+			for (int currTileIndex : this->repairTileList) {
+				int distance = this->targetDistanceGrid[currTileIndex];
+				int bucketIndex = (distance == SnakeBotConstants::UNREACHABLE_DISTANCE) ? (maxDistance - minDistance + 1) : (distance - minDistance);
+				this->searchQueue[this->repairBucketOffsetList[bucketIndex]] = currTileIndex;
+				this->repairBucketOffsetList[bucketIndex]++;
+			}
+			this->repairTileList.swap(this->searchQueue);
+		}
+
+		// A tile the tail has just left can only bring distances down, which an ordinary spread handles
+		void SnakeBot::lowerTargetDistances(int unblockedTileIndex) {
+			if (this->blocksTargetDistance(unblockedTileIndex)) {
+				return;
+			}
+
+			sf::Vector2i unblockedPosition = this->toPosition(unblockedTileIndex);
+			bool targetFlag = (std::find(this->targetPositionList.begin(), this->targetPositionList.end(), unblockedPosition) != this->targetPositionList.end());
+
+			int distance = targetFlag ? 0 : this->resolveNeighbourTargetDistance(unblockedTileIndex);
+			if (distance < this->targetDistanceGrid[unblockedTileIndex]) {
+				this->targetDistanceGrid[unblockedTileIndex] = distance;
+				this->spreadTargetDistanceFrom(unblockedTileIndex);
+			}
+		}
+
+		int SnakeBot::resolveNeighbourTargetDistance(int tileIndex) const {
+			int result = SnakeBotConstants::UNREACHABLE_DISTANCE;
+
+			for (int currTileOffset : this->tileOffsetList) {
+				int neighbourTileIndex = tileIndex + currTileOffset;
+				int neighbourDistance = this->targetDistanceGrid[neighbourTileIndex];
+				if (!this->blocksTargetDistance(neighbourTileIndex) && (neighbourDistance != SnakeBotConstants::UNREACHABLE_DISTANCE)) {
+					result = std::min(result, neighbourDistance + 1);
+				}
+			}
+
+			return result;
+		}
+
+		ObjectDirection SnakeBot::decideDirection(const SnakeBotInput& input) {
+			const Snake& snake = *input.snake;
+			sf::Vector2i headPosition = snake.getHead().position;
+			sf::Vector2i tailPosition = snake.getTail().position;
+
+			SnakeBotCandidate candidateList[4];
+			int candidateCount = 0;
+
+			for (ObjectDirection currDirection : SnakeBotConstants::CANDIDATE_DIRECTION_LIST) {
+				if (!snake.isValidMovementDirection(currDirection)) {
+					continue;
+				}
+
+				sf::Vector2i nextPosition = headPosition + SnakeUtils::directionToVector(currDirection);
+				if (!this->inBounds(nextPosition)) {
+					continue;
+				}
+
+				int nextTileIndex = this->toTileIndex(nextPosition);
+				bool blockedFlag =
+					this->barrierGrid[nextTileIndex] ||
+					((this->snakeOccupancyGrid[nextTileIndex] > 0) && (nextPosition != tailPosition));
+				if (!blockedFlag && (input.avoidPositionList != nullptr)) {
+					blockedFlag = (std::find(input.avoidPositionList->begin(), input.avoidPositionList->end(), nextPosition) != input.avoidPositionList->end());
+				}
+
+				if (!blockedFlag) {
+					candidateList[candidateCount].direction = currDirection;
+					candidateList[candidateCount].position = nextPosition;
+					candidateList[candidateCount].targetDistance = this->targetDistanceGrid[nextTileIndex];
+					candidateCount++;
+				}
+			}
+
+			if (candidateCount == 0) {
+				return snake.getHead().enterDirection;
+			}
+
+			std::stable_sort(candidateList, candidateList + candidateCount, [](const SnakeBotCandidate& lhs, const SnakeBotCandidate& rhs) {
+				return lhs.targetDistance < rhs.targetDistance;
+			});
+
+			// Chase the closest target, as long as the snake would still have room to fit its whole body afterwards
+			int roomNeeded = snake.getLength();
+			SnakeBotFloodFillResult floodFillResultList[4];
+			for (int candidateIndex = 0; candidateIndex < candidateCount; candidateIndex++) {
+				floodFillResultList[candidateIndex] = this->floodFill(candidateList[candidateIndex].position, tailPosition, roomNeeded);
+				if (
+					(candidateList[candidateIndex].targetDistance != SnakeBotConstants::UNREACHABLE_DISTANCE) &&
+					(floodFillResultList[candidateIndex].reachableTileCount >= roomNeeded)
+				) {
+					return candidateList[candidateIndex].direction;
+				}
+			}
+
+			// Otherwise fall back to following the tail, which keeps opening up space behind it
+			int bestCandidateIndex = 0;
+			for (int candidateIndex = 1; candidateIndex < candidateCount; candidateIndex++) {
+				const SnakeBotFloodFillResult& currResult = floodFillResultList[candidateIndex];
+				const SnakeBotFloodFillResult& bestResult = floodFillResultList[bestCandidateIndex];
+
+				bool betterFlag =
+					(currResult.reachesTailFlag && !bestResult.reachesTailFlag) ||
+					(
+						(currResult.reachesTailFlag == bestResult.reachesTailFlag) &&
+						(currResult.reachableTileCount > bestResult.reachableTileCount)
+					);
+				if (betterFlag) {
+					bestCandidateIndex = candidateIndex;
+				}
+			}
+
+			return candidateList[bestCandidateIndex].direction;
+		}
+
+		SnakeBotFloodFillResult SnakeBot::floodFill(const sf::Vector2i& startPosition, const sf::Vector2i& tailPosition, int maxTileCount) {
+			SnakeBotFloodFillResult result;
+			result.reachableTileCount = 0;
+			result.reachesTailFlag = false;
+
+			int mark = this->claimSearchMark();
+
+			int tailTileIndex = this->inBounds(tailPosition) ? this->toTileIndex(tailPosition) : -1;
+
+			this->searchQueue.clear();
+			int startTileIndex = this->toTileIndex(startPosition);
+			this->searchMarkGrid[startTileIndex] = mark;
+			this->searchQueue.push_back(startTileIndex);
+
+			for (size_t queueIndex = 0; (queueIndex < this->searchQueue.size()) && (result.reachableTileCount < maxTileCount); queueIndex++) {
+				int currTileIndex = this->searchQueue[queueIndex];
+				result.reachableTileCount++;
+
+				for (int currTileOffset : this->tileOffsetList) {
+					int nextTileIndex = currTileIndex + currTileOffset;
+					if (nextTileIndex == tailTileIndex) {
+						result.reachesTailFlag = true;
+					}
+
+					bool passableFlag =
+						(this->searchMarkGrid[nextTileIndex] != mark) &&
+						!this->blocksTargetDistance(nextTileIndex);
+					if (passableFlag) {
+						this->searchMarkGrid[nextTileIndex] = mark;
+						this->searchQueue.push_back(nextTileIndex);
+					}
+				}
+			}
+
+			return result;
+		}
+
+		namespace SnakeBotUtils {
+
+			SnakeBot* createQuickGameBot(const QuickGame& quickGame) {
+				sf::Vector2i fieldSize = quickGame.getFieldSize();
+
+				SnakeBot* result = new SnakeBot(fieldSize);
+				for (int x = 0; x < fieldSize.x; x++) {
+					result->setBarrier(x, 0);
+					result->setBarrier(x, fieldSize.y - 1);
+				}
+				for (int y = 0; y < fieldSize.y; y++) {
+					result->setBarrier(0, y);
+					result->setBarrier(fieldSize.x - 1, y);
+				}
+				return result;
+			}
+
+			SnakeBot* createStoryGameBot(const StoryGame& storyGame) {
+				const StoryMap& map = *storyGame.getMap();
+				sf::Vector2i fieldSize = map.getFieldSize();
+
+				SnakeBot* result = new SnakeBot(fieldSize);
+				for (int y = 0; y < fieldSize.y; y++) {
+					for (int x = 0; x < fieldSize.x; x++) {
+						if (map.barrierAt(x, y)) {
+							result->setBarrier(x, y);
+						}
+					}
+				}
+				return result;
+			}
+
+			QuickGameInputRequest buildQuickGameInputRequest(SnakeBot& bot, const QuickGame& quickGame) {
+				std::vector<sf::Vector2i> targetPositionList;
+				if (quickGame.getAppleExists()) {
+					targetPositionList.push_back(quickGame.getApplePosition());
+				}
+
+				SnakeBotInput botInput;
+				botInput.snake = quickGame.getSnake();
+				botInput.targetPositionList = &targetPositionList;
+				botInput.avoidPositionList = nullptr;
+
+				QuickGameInputRequest result;
+				result.snakeMovementInput = bot.resolveNextDirection(botInput);
+				return result;
+			}
+
+			StoryGameInputRequest buildStoryGameInputRequest(SnakeBot& bot, const StoryGame& storyGame) {
+				const StoryWinCondition& winCondition = storyGame.getWinCondition();
+
+				// Prefer the food that wins the level, and never chase food that shrinks the snake
+				std::vector<sf::Vector2i> winningTargetPositionList;
+				std::vector<sf::Vector2i> targetPositionList;
+				for (auto const& currFoodSlot : storyGame.getFoodSlotMap()) {
+					const StoryFoodInstance& currFoodInstance = currFoodSlot.foodInstance;
+					if (
+						(winCondition.conditionType == StoryWinConditionType::ON_FOOD_EATEN) &&
+						(currFoodInstance.foodType == winCondition.foodType)
+					) {
+						winningTargetPositionList.push_back(currFoodInstance.position);
+					}
+					if (currFoodInstance.foodType != StoryFoodType::BANANA) {
+						targetPositionList.push_back(currFoodInstance.position);
+					}
+				}
+
+				std::vector<sf::Vector2i> avoidPositionList;
+				for (auto const& currDangerSlot : storyGame.getDangerSlotMap()) {
+					avoidPositionList.push_back(currDangerSlot.dangerInstance.position);
+				}
+
+				SnakeBotInput botInput;
+				botInput.snake = storyGame.getSnake();
+				botInput.targetPositionList = winningTargetPositionList.empty() ? &targetPositionList : &winningTargetPositionList;
+				botInput.avoidPositionList = &avoidPositionList;
+
+				StoryGameInputRequest result;
+				result.snakeMovementList.push_back(bot.resolveNextDirection(botInput));
+				return result;
+			}
+
+			// The snake moves every tick, and a new game starts whenever the last one ends.  Only the bot's own work
+			// is timed, not the game update.
+			SnakeBotBenchmarkResult measureQuickGameTickTimes(const sf::Vector2i& fieldSize, int tickCount) {
+				SnakeBotBenchmarkResult result;
+				result.fieldSize = fieldSize;
+
+				QuickGameDefn gameDefn;
+				gameDefn.fieldSize = fieldSize;
+				gameDefn.snakeSpeedTilesPerSecond = 60.0f;
+				gameDefn.snakeGrowthPerApple = 3;
+				gameDefn.snakeStartDefn.headPosition = sf::Vector2i(fieldSize.x / 2, fieldSize.y / 2);
+				gameDefn.snakeStartDefn.facingDirection = ObjectDirection::RIGHT;
+				gameDefn.snakeStartDefn.length = 4;
+
+				std::vector<sf::Int64> tickMicrosecondsList;
+				tickMicrosecondsList.reserve(tickCount);
+
+				sf::Clock tickClock;
+				QuickGame* quickGame = nullptr;
+				SnakeBot* bot = nullptr;
+
+				while ((int)tickMicrosecondsList.size() < tickCount) {
+					if (quickGame == nullptr) {
+						quickGame = new QuickGame(&gameDefn);
+						bot = createQuickGameBot(*quickGame);
+						result.gameCount++;
+					}
+
+					tickClock.restart();
+					QuickGameInputRequest inputRequest = buildQuickGameInputRequest(*bot, *quickGame);
+					tickMicrosecondsList.push_back(tickClock.getElapsedTime().asMicroseconds());
+
+					QuickGameUpdateResult updateResult = quickGame->update(&inputRequest);
+					if (updateResult.snakeAteAppleFlag) {
+						result.applesEaten++;
+					}
+					result.maxSnakeLength = std::max(result.maxSnakeLength, quickGame->getSnake()->getLength());
+
+					if (updateResult.snakeHitBarrierFlag) {
+						delete bot;
+						delete quickGame;
+						bot = nullptr;
+						quickGame = nullptr;
+					}
+				}
+
+				if (quickGame != nullptr) {
+					delete bot;
+					delete quickGame;
+				}
+
+				result.tickCount = (int)tickMicrosecondsList.size();
+				if (result.tickCount > 0) {
+					sf::Int64 totalMicroseconds = 0;
+					for (sf::Int64 currTickMicroseconds : tickMicrosecondsList) {
+						totalMicroseconds += currTickMicroseconds;
+					}
+					result.avgTickMicroseconds = (float)totalMicroseconds / (float)result.tickCount;
+
+					std::sort(tickMicrosecondsList.begin(), tickMicrosecondsList.end());
+					result.p99TickMicroseconds = tickMicrosecondsList[(tickMicrosecondsList.size() * 99) / 100];
+					result.maxTickMicroseconds = tickMicrosecondsList.back();
+				}
+
+				// Held to the average.  A tick where the field changes across most of the map, such as an apple being
+				// eaten or a gap opening in a coiled body, costs hundreds of microseconds however exactly it is
+				// repaired, so p99 and the maximum are reported but not checked.
+				result.withinTargetFlag = (result.avgTickMicroseconds <= (float)SnakeBotConstants::TARGET_TICK_MICROSECONDS);
+
+				return result;
+			}
+
+			std::vector<std::string> buildBenchmarkMessages(const SnakeBotBenchmarkResult& benchmarkResult) {
+				std::vector<std::string> result;
+
+				char message[256];
+
+				snprintf(message, sizeof(message), "Field %dx%d: %d ticks over %d games, %d apples eaten, longest snake %d", benchmarkResult.fieldSize.x, benchmarkResult.fieldSize.y, benchmarkResult.tickCount, benchmarkResult.gameCount, benchmarkResult.applesEaten, benchmarkResult.maxSnakeLength);
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "Bot time per tick: avg %.1f us, p99 %lld us, max %lld us", benchmarkResult.avgTickMicroseconds, (long long)benchmarkResult.p99TickMicroseconds, (long long)benchmarkResult.maxTickMicroseconds);
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "Average is %s the %lld us target", benchmarkResult.withinTargetFlag ? "within" : "over", (long long)SnakeBotConstants::TARGET_TICK_MICROSECONDS);
+				result.push_back(message);
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,65 @@
+#include "includes/r3-snake-spritebatch.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace SpriteBatchUtils {
+
+			void buildQuad(sf::Vertex* quadVertexList, const sf::Vector2f& position, float size, const sf::IntRect& textureRect) {
+				float textureLeft = (float)textureRect.left;
+				float textureTop = (float)textureRect.top;
+				float textureRight = (float)(textureRect.left + textureRect.width);
+				float textureBottom = (float)(textureRect.top + textureRect.height);
+
+				quadVertexList[0] = sf::Vertex(sf::Vector2f(position.x, position.y), sf::Vector2f(textureLeft, textureTop));
+				quadVertexList[1] = sf::Vertex(sf::Vector2f(position.x + size, position.y), sf::Vector2f(textureRight, textureTop));
+				quadVertexList[2] = sf::Vertex(sf::Vector2f(position.x + size, position.y + size), sf::Vector2f(textureRight, textureBottom));
+				quadVertexList[3] = sf::Vertex(sf::Vector2f(position.x, position.y + size), sf::Vector2f(textureLeft, textureBottom));
+			}
+
+		}
+
+		SpriteBatch::SpriteBatch() {
+			this->usedTextureCount = 0;
+		}
+
+		void SpriteBatch::appendQuad(const sf::Texture& texture, const sf::Vector2f& position, float size, const sf::IntRect& textureRect) {
+			size_t textureIndex = 0;
+			while ((textureIndex < this->usedTextureCount) && (this->textureList[textureIndex] != &texture)) {
+				textureIndex++;
+			}
+
+			// Vertex arrays from earlier frames are reused so their storage does not need to grow again
+			if (textureIndex == this->usedTextureCount) {
+				if (this->usedTextureCount < this->textureList.size()) {
+					this->textureList[textureIndex] = &texture;
+				}
+				else {
+					this->textureList.push_back(&texture);
+					this->vertexArrayList.push_back(sf::VertexArray(sf::Quads));
+				}
+				this->usedTextureCount++;
+			}
+
+			sf::Vertex quadVertexList[4];
+			SpriteBatchUtils::buildQuad(quadVertexList, position, size, textureRect);
+
+			sf::VertexArray& vertexArray = this->vertexArrayList[textureIndex];
+			for (int vertexIndex = 0; vertexIndex < 4; vertexIndex++) {
+				vertexArray.append(quadVertexList[vertexIndex]);
+			}
+		}
+
+		void SpriteBatch::render(sf::RenderTarget& renderTarget) {
+			for (size_t textureIndex = 0; textureIndex < this->usedTextureCount; textureIndex++) {
+				renderTarget.draw(this->vertexArrayList[textureIndex], this->textureList[textureIndex]);
+				this->vertexArrayList[textureIndex].clear();
+			}
+
+			this->usedTextureCount = 0;
+		}
+
+	}
+
+}
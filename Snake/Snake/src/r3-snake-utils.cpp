@@ -7,6 +7,7 @@ namespace r3 {
 
 		namespace GameLoopUtils {
 
+			const sf::Int64 FRAMES_PER_SECOND = 60;
 			const sf::Int64 MICROSECONDS_PER_FRAME = 1000000 / 60;
 
 		}
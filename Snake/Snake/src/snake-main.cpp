@@ -1,7 +1,205 @@
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "includes/r3-snake-client.hpp"
+#include "includes/r3-snake-storyreplay.hpp"
+#include "includes/r3-snake-storybalance.hpp"
+#include "includes/r3-snake-storyarchive.hpp"
+#include "includes/r3-snake-storydefncache.hpp"
+#include "includes/r3-snake-storybenchmark.hpp"
+#include "includes/r3-snake-snakebot.hpp"
+#include "includes/r3-snake-storycompactor.hpp"
+
+int verifyReplay(const char* replayFilename) {
+	r3::snake::StoryReplayVerificationResult verificationResult = r3::snake::StoryReplayUtils::verifyReplay(replayFilename);
+	for (auto const& currMessage : r3::snake::StoryReplayUtils::buildVerificationMessages(verificationResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = (verificationResult.valid() && verificationResult.matchedFlag) ? 0 : 1;
+	return result;
+}
+
+int balanceCampaign(int argc, char** argv) {
+	r3::snake::StoryBalanceOptions options = r3::snake::StoryBalanceUtils::createDefaultOptions();
+	if (argc >= 4) {
+		options.runsPerLevel = atoi(argv[3]);
+	}
+	if (argc >= 5) {
+		options.threadCount = atoi(argv[4]);
+	}
+
+	r3::snake::StoryBalanceRunner balanceRunner(argv[2], options);
+	r3::snake::StoryBalanceReport report = balanceRunner.run();
+	for (auto const& currMessage : r3::snake::StoryBalanceUtils::buildReportMessages(report)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = report.valid() ? 0 : 1;
+	return result;
+}
+
+int packCampaign(const char* campaignFolderName) {
+	r3::snake::StoryPackCampaignResult packResult = r3::snake::StoryArchiveUtils::packCampaign(campaignFolderName);
+	for (auto const& currMessage : r3::snake::StoryArchiveUtils::buildPackMessages(packResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = packResult.valid() ? 0 : 1;
+	return result;
+}
+
+int timeCampaignLoad(const char* campaignFolderName) {
+	r3::snake::StoryDefnCacheLoadTimes loadTimes = r3::snake::StoryDefnCacheUtils::measureLoadTimes(campaignFolderName);
+	for (auto const& currMessage : r3::snake::StoryDefnCacheUtils::buildLoadTimeMessages(loadTimes)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = (loadTimes.campaignValid && loadTimes.warmCacheHit) ? 0 : 1;
+	return result;
+}
+
+int timeMapParse(int argc, char** argv) {
+	int iterationCount = 100;
+	if (argc >= 5) {
+		iterationCount = atoi(argv[4]);
+	}
+
+	r3::snake::StoryMapParseTimes parseTimes = r3::snake::StoryLoaderUtils::measureMapParseTimes(argv[2], argv[3], iterationCount);
+	for (auto const& currMessage : r3::snake::StoryLoaderUtils::buildMapParseTimeMessages(parseTimes)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = parseTimes.resultsMatch ? 0 : 1;
+	return result;
+}
+
+int timeCampaignValidation(const char* campaignFolderName) {
+	std::vector<int> threadCountList = { 1, 2, 4, 8 };
+
+	r3::snake::StoryCampaignValidationTimes validationTimes = r3::snake::StoryLoaderUtils::measureCampaignValidationTimes(campaignFolderName, threadCountList);
+	for (auto const& currMessage : r3::snake::StoryLoaderUtils::buildCampaignValidationTimeMessages(validationTimes)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = validationTimes.resultsMatch ? 0 : 1;
+	return result;
+}
+
+int generateCampaign(int argc, char** argv) {
+	r3::snake::StoryCampaignGeneratorOptions options = r3::snake::StoryCampaignGeneratorUtils::createDefaultOptions();
+	if (argc >= 4) {
+		options.levelCount = atoi(argv[3]);
+	}
+	if (argc >= 6) {
+		options.mapSize.x = atoi(argv[4]);
+		options.mapSize.y = atoi(argv[5]);
+	}
+	if (argc >= 7) {
+		options.openingCutsceneEventCount = atoi(argv[6]);
+	}
+
+	r3::snake::StoryGenerateCampaignResult generateResult = r3::snake::StoryCampaignGeneratorUtils::generateCampaign(argv[2], options);
+	for (auto const& currMessage : r3::snake::StoryCampaignGeneratorUtils::buildGenerateMessages(generateResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = generateResult.valid() ? 0 : 1;
+	return result;
+}
+
+int benchmarkCampaignLoad(const char* campaignFolderName) {
+	r3::snake::StoryLoaderBenchmarkResult benchmarkResult = r3::snake::StoryLoaderBenchmarkUtils::runBenchmark(campaignFolderName);
+	for (auto const& currMessage : r3::snake::StoryLoaderBenchmarkUtils::buildReportMessages(benchmarkResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = benchmarkResult.campaignValid ? 0 : 1;
+	return result;
+}
+
+int benchmarkPrefetchFrames(int argc, char** argv) {
+	int frameCount = 3600;
+	if (argc >= 4) {
+		frameCount = atoi(argv[3]);
+	}
+
+	r3::snake::StoryPrefetchFrameTimeResult frameTimeResult = r3::snake::StoryLoaderBenchmarkUtils::measurePrefetchFrameTimes(argv[2], frameCount);
+	for (auto const& currMessage : r3::snake::StoryLoaderBenchmarkUtils::buildPrefetchFrameTimeMessages(frameTimeResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = frameTimeResult.campaignValid ? 0 : 1;
+	return result;
+}
+
+int benchmarkBot(int argc, char** argv) {
+	sf::Vector2i fieldSize(200, 200);
+	if (argc >= 4) {
+		fieldSize.x = atoi(argv[2]);
+		fieldSize.y = atoi(argv[3]);
+	}
+
+	int tickCount = 100000;
+	if (argc >= 5) {
+		tickCount = atoi(argv[4]);
+	}
+
+	r3::snake::SnakeBotBenchmarkResult benchmarkResult = r3::snake::SnakeBotUtils::measureQuickGameTickTimes(fieldSize, tickCount);
+	for (auto const& currMessage : r3::snake::SnakeBotUtils::buildBenchmarkMessages(benchmarkResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = benchmarkResult.withinTargetFlag ? 0 : 1;
+	return result;
+}
+
+int compactCampaign(const char* campaignFolderName) {
+	r3::snake::StoryCompactCampaignResult compactResult = r3::snake::StoryCampaignCompactorUtils::compactCampaign(campaignFolderName);
+	for (auto const& currMessage : r3::snake::StoryCampaignCompactorUtils::buildCompactMessages(compactResult)) {
+		printf("%s\n", currMessage.c_str());
+	}
+
+	int result = compactResult.valid() ? 0 : 1;
+	return result;
+}
+
+int main(int argc, char** argv) {
+	if ((argc >= 3) && (strcmp(argv[1], "--verify-replay") == 0)) {
+		return verifyReplay(argv[2]);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--balance-campaign") == 0)) {
+		return balanceCampaign(argc, argv);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--pack-campaign") == 0)) {
+		return packCampaign(argv[2]);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--time-campaign-load") == 0)) {
+		return timeCampaignLoad(argv[2]);
+	}
+	if ((argc >= 4) && (strcmp(argv[1], "--time-map-parse") == 0)) {
+		return timeMapParse(argc, argv);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--time-campaign-validation") == 0)) {
+		return timeCampaignValidation(argv[2]);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--generate-campaign") == 0)) {
+		return generateCampaign(argc, argv);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--benchmark-campaign-load") == 0)) {
+		return benchmarkCampaignLoad(argv[2]);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--benchmark-prefetch-frames") == 0)) {
+		return benchmarkPrefetchFrames(argc, argv);
+	}
+	if ((argc >= 2) && (strcmp(argv[1], "--benchmark-bot") == 0)) {
+		return benchmarkBot(argc, argv);
+	}
+	if ((argc >= 3) && (strcmp(argv[1], "--compact-campaign") == 0)) {
+		return compactCampaign(argv[2]);
+	}
 
-int main() {
 	r3::snake::GameClient gameClient;
 	gameClient.run();
 	return 0;
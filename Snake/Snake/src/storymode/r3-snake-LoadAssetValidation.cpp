@@ -1,7 +1,11 @@
 
+#include <string.h>
+#include <unordered_map>
+#include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storyarchive.hpp"
 
 namespace r3 {
 
@@ -9,26 +13,205 @@ namespace r3 {
 
 		namespace StoryLoaderUtils {
 
+			namespace LoadAssetValidationConstants {
+
+				const size_t PROBE_HEADER_SIZE = 64;
+
+				const char PNG_SIGNATURE[8] = { '\x89', 'P', 'N', 'G', '\r', '\n', '\x1A', '\n' };
+				const char PNG_HEADER_CHUNK_TYPE[4] = { 'I', 'H', 'D', 'R' };
+				const size_t PNG_HEADER_CHUNK_TYPE_OFFSET = 12;
+				const size_t PNG_WIDTH_OFFSET = 16;
+				const size_t PNG_HEIGHT_OFFSET = 20;
+
+				const char JPEG_SIGNATURE[3] = { '\xFF', '\xD8', '\xFF' };
+				const char GIF_SIGNATURE[4] = { 'G', 'I', 'F', '8' };
+				const char BMP_SIGNATURE[2] = { 'B', 'M' };
+
+				const char OGG_SIGNATURE[4] = { 'O', 'g', 'g', 'S' };
+				const char VORBIS_HEADER[7] = { '\x01', 'v', 'o', 'r', 'b', 'i', 's' };
+				const size_t VORBIS_HEADER_OFFSET = 28;
+
+				const char RIFF_SIGNATURE[4] = { 'R', 'I', 'F', 'F' };
+				const char WAVE_SIGNATURE[4] = { 'W', 'A', 'V', 'E' };
+				const size_t WAVE_SIGNATURE_OFFSET = 8;
+
+				const char FLAC_SIGNATURE[4] = { 'f', 'L', 'a', 'C' };
+
+			}
+
+			typedef enum class Snake_AssetProbeResult {
+				VALID,
+				INVALID,
+				UNKNOWN_FORMAT,
+			} AssetProbeResult;
+
+			// Every tile, texture and sound track is checked once per campaign load, no matter how many maps
+			// or levels refer to it.  Validation can run on the prefetch thread, so the maps are guarded.
+			namespace AssetProbeRegistry {
+
+				sf::Mutex registryMutex;
+				std::unordered_map<std::string, bool> imageValidMap;
+				std::unordered_map<std::string, bool> musicValidMap;
+
+				bool find(const std::unordered_map<std::string, bool>& validMap, const std::string& filePath, bool& validFlag) {
+					registryMutex.lock();
+
+					auto validItr = validMap.find(filePath);
+					bool result = (validItr != validMap.end());
+					if (result) {
+						validFlag = validItr->second;
+					}
+
+					registryMutex.unlock();
+
+					return result;
+				}
+
+				void store(std::unordered_map<std::string, bool>& validMap, const std::string& filePath, bool validFlag) {
+					registryMutex.lock();
+					validMap[filePath] = validFlag;
+					registryMutex.unlock();
+				}
+
+				void clear() {
+					registryMutex.lock();
+					imageValidMap.clear();
+					musicValidMap.clear();
+					registryMutex.unlock();
+				}
+
+			}
+
+			namespace AssetProbeUtils {
+
+				bool matches(const StoryFileContents& header, size_t offset, const char* signature, size_t signatureSize) {
+					bool result =
+						(header.getSize() >= offset + signatureSize) &&
+						(memcmp(header.getData() + offset, signature, signatureSize) == 0);
+					return result;
+				}
+
+				sf::Uint32 readBigEndianUint32(const StoryFileContents& header, size_t offset) {
+					const unsigned char* bytes = (const unsigned char*)header.getData() + offset;
+					sf::Uint32 result = ((sf::Uint32)bytes[0] << 24) | ((sf::Uint32)bytes[1] << 16) | ((sf::Uint32)bytes[2] << 8) | (sf::Uint32)bytes[3];
+					return result;
+				}
+
+				AssetProbeResult probeImage(const StoryFileContents& header) {
+					AssetProbeResult result = AssetProbeResult::UNKNOWN_FORMAT;
+
+					if (matches(header, 0, LoadAssetValidationConstants::PNG_SIGNATURE, sizeof(LoadAssetValidationConstants::PNG_SIGNATURE))) {
+						bool headerValid =
+							matches(header, LoadAssetValidationConstants::PNG_HEADER_CHUNK_TYPE_OFFSET, LoadAssetValidationConstants::PNG_HEADER_CHUNK_TYPE, sizeof(LoadAssetValidationConstants::PNG_HEADER_CHUNK_TYPE)) &&
+							(header.getSize() >= LoadAssetValidationConstants::PNG_HEIGHT_OFFSET + 4) &&
+							(readBigEndianUint32(header, LoadAssetValidationConstants::PNG_WIDTH_OFFSET) > 0) &&
+							(readBigEndianUint32(header, LoadAssetValidationConstants::PNG_HEIGHT_OFFSET) > 0);
+						result = headerValid ? AssetProbeResult::VALID : AssetProbeResult::INVALID;
+					}
+					else if (
+						matches(header, 0, LoadAssetValidationConstants::JPEG_SIGNATURE, sizeof(LoadAssetValidationConstants::JPEG_SIGNATURE)) ||
+						matches(header, 0, LoadAssetValidationConstants::GIF_SIGNATURE, sizeof(LoadAssetValidationConstants::GIF_SIGNATURE)) ||
+						matches(header, 0, LoadAssetValidationConstants::BMP_SIGNATURE, sizeof(LoadAssetValidationConstants::BMP_SIGNATURE))
+					) {
+						result = AssetProbeResult::VALID;
+					}
+
+					return result;
+				}
+
+				AssetProbeResult probeMusic(const StoryFileContents& header) {
+					AssetProbeResult result = AssetProbeResult::UNKNOWN_FORMAT;
+
+					if (matches(header, 0, LoadAssetValidationConstants::OGG_SIGNATURE, sizeof(LoadAssetValidationConstants::OGG_SIGNATURE))) {
+						// SFML only decodes Vorbis, which announces itself in the first page of the stream
+						bool headerValid = matches(header, LoadAssetValidationConstants::VORBIS_HEADER_OFFSET, LoadAssetValidationConstants::VORBIS_HEADER, sizeof(LoadAssetValidationConstants::VORBIS_HEADER));
+						result = headerValid ? AssetProbeResult::VALID : AssetProbeResult::INVALID;
+					}
+					else if (matches(header, 0, LoadAssetValidationConstants::RIFF_SIGNATURE, sizeof(LoadAssetValidationConstants::RIFF_SIGNATURE))) {
+						bool headerValid = matches(header, LoadAssetValidationConstants::WAVE_SIGNATURE_OFFSET, LoadAssetValidationConstants::WAVE_SIGNATURE, sizeof(LoadAssetValidationConstants::WAVE_SIGNATURE));
+						result = headerValid ? AssetProbeResult::VALID : AssetProbeResult::INVALID;
+					}
+					else if (matches(header, 0, LoadAssetValidationConstants::FLAC_SIGNATURE, sizeof(LoadAssetValidationConstants::FLAC_SIGNATURE))) {
+						result = AssetProbeResult::VALID;
+					}
+
+					return result;
+				}
+
+			}
+
 			namespace LoadAssetValidation {
 
+				// Only the first few bytes are read to recognise the format; anything unrecognised (such as TGA,
+				// which has no signature) falls back to a full decode
+				bool probeImageFile(const std::string& imageFilePath) {
+					StoryFileContents header;
+					bool result = StoryArchiveUtils::readFileHeader(imageFilePath, LoadAssetValidationConstants::PROBE_HEADER_SIZE, header);
+					if (result) {
+						AssetProbeResult probeResult = AssetProbeUtils::probeImage(header);
+						if (probeResult == AssetProbeResult::UNKNOWN_FORMAT) {
+							StoryFileContents fileContents;
+							sf::Image image;
+							result =
+								StoryArchiveUtils::readFile(imageFilePath, fileContents) &&
+								image.loadFromMemory(fileContents.getData(), fileContents.getSize());
+						}
+						else {
+							result = (probeResult == AssetProbeResult::VALID);
+						}
+					}
+
+					return result;
+				}
+
+				bool probeMusicFile(const std::string& musicFilePath) {
+					StoryFileContents header;
+					bool result = StoryArchiveUtils::readFileHeader(musicFilePath, LoadAssetValidationConstants::PROBE_HEADER_SIZE, header);
+					if (result) {
+						AssetProbeResult probeResult = AssetProbeUtils::probeMusic(header);
+						if (probeResult == AssetProbeResult::UNKNOWN_FORMAT) {
+							StoryFileContents fileContents;
+							sf::InputSoundFile soundFile;
+							result =
+								StoryArchiveUtils::readFile(musicFilePath, fileContents) &&
+								soundFile.openFromMemory(fileContents.getData(), fileContents.getSize());
+						}
+						else {
+							result = (probeResult == AssetProbeResult::VALID);
+						}
+					}
+
+					return result;
+				}
+
 				bool imageFileValid(const std::string& campaignFolderName, const std::string& imageFilename) {
 					std::string imageFilePath = resolveImageFilePath(campaignFolderName, imageFilename);
-					
-					// Is there a better way to validate than to actually load the image into memory?
-					// Don't like that we'll be loading assets twice, but this does work...
-					sf::Image image;
-					bool result = image.loadFromFile(imageFilePath);
+
+					bool result = false;
+					if (!AssetProbeRegistry::find(AssetProbeRegistry::imageValidMap, imageFilePath, result)) {
+						result = probeImageFile(imageFilePath);
+						AssetProbeRegistry::store(AssetProbeRegistry::imageValidMap, imageFilePath, result);
+					}
+
 					return result;
 				}
 
 				bool musicFileValid(const std::string& campaignFolderName, const std::string& musicFilename) {
-					std::string soundFilePath = resolveMusicFilePath(campaignFolderName, musicFilename);
+					std::string musicFilePath = resolveMusicFilePath(campaignFolderName, musicFilename);
+
+					bool result = false;
+					if (!AssetProbeRegistry::find(AssetProbeRegistry::musicValidMap, musicFilePath, result)) {
+						result = probeMusicFile(musicFilePath);
+						AssetProbeRegistry::store(AssetProbeRegistry::musicValidMap, musicFilePath, result);
+					}
 
-					sf::InputSoundFile soundFile;
-					bool result = soundFile.openFromFile(soundFilePath);
 					return result;
 				}
 
+				void clearProbeCache() {
+					AssetProbeRegistry::clear();
+				}
+
 			}
 
 		}
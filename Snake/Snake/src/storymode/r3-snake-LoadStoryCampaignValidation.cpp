@@ -46,6 +46,38 @@ namespace r3 {
 					return result;
 				}
 
+				std::vector<std::string> buildErrorMessages(const LoadStoryCampaignIndexResult& indexResult) {
+					std::vector<std::string> result;
+
+					if (!indexResult.parseErrorString.empty()) {
+						result.push_back(indexResult.parseErrorString);
+					}
+
+					if (!indexResult.levelListValid) {
+						result.push_back("The \"levelList\" property is invalid.  It must be an array of level definitions.");
+					}
+					else if (!indexResult.levelEntriesValid) {
+						result.push_back("Every entry within the \"levelList\" array must be an object.");
+					}
+
+					return result;
+				}
+
+				std::vector<std::string> buildLevelErrorMessages(int levelIndex, const LoadStoryLevelResult& levelResult) {
+					std::vector<std::string> result;
+
+					if (!levelResult.validationResult.parseErrorString.empty()) {
+						result.push_back(buildLevelEntryErrorMessage(levelIndex));
+						result.push_back(levelResult.validationResult.parseErrorString);
+					}
+					else if (!levelResult.validationResult.valid()) {
+						result.push_back(buildLevelEntryErrorMessage(levelIndex));
+						updateErrorMessagesWithLevelValidationResult(result, levelResult.validationResult);
+					}
+
+					return result;
+				}
+
 			}
 
 		}
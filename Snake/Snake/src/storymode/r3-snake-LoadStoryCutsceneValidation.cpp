@@ -23,7 +23,8 @@ namespace r3 {
 						(eventTypeString.compare(CutsceneEventTypeValues::SHOW_FOOD) == 0) ||
 						(eventTypeString.compare(CutsceneEventTypeValues::HIDE_FOOD) == 0) ||
 						(eventTypeString.compare(CutsceneEventTypeValues::SHOW_DANGER) == 0) ||
-						(eventTypeString.compare(CutsceneEventTypeValues::HIDE_DANGER) == 0);
+						(eventTypeString.compare(CutsceneEventTypeValues::HIDE_DANGER) == 0) ||
+						(eventTypeString.compare(CutsceneEventTypeValues::MOVE_SNAKE_PATH) == 0);
 
 					return result;
 				}
@@ -69,6 +70,24 @@ namespace r3 {
 					return result;
 				}
 
+				bool snakePathValid(const Json::Value& jsonValue) {
+					bool result =
+						r3::json::ValidationUtils::requiredString(jsonValue, StoryCutsceneProperties::SNAKE_PATH) &&
+						(
+							!jsonValue.isMember(StoryCutsceneProperties::SNAKE_PATH_FRAMES_PER_STEP) ||
+							r3::json::ValidationUtils::requiredInt(jsonValue, StoryCutsceneProperties::SNAKE_PATH_FRAMES_PER_STEP, 0)
+						);
+
+					if (result) {
+						int framesPerStep = jsonValue.get(StoryCutsceneProperties::SNAKE_PATH_FRAMES_PER_STEP, jsonValue[StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT]).asInt();
+
+						std::vector<StorySnakePathRun> runList;
+						result = parseSnakePath(jsonValue[StoryCutsceneProperties::SNAKE_PATH].asString(), framesPerStep, runList);
+					}
+
+					return result;
+				}
+
 				LoadStoryCutsceneEventValidationResult validateEventEntry(const Json::Value& jsonValue) {
 					LoadStoryCutsceneEventValidationResult result;
 
@@ -112,6 +131,10 @@ namespace r3 {
 								result.snakeMovementValid = snakeMovementValid(jsonValue);
 							}
 
+							if (eventTypeString.compare(CutsceneEventTypeValues::MOVE_SNAKE_PATH) == 0) {
+								result.snakePathValid = snakePathValid(jsonValue);
+							}
+
 							if (eventTypeString.compare(CutsceneEventTypeValues::SHOW_FOOD) == 0) {
 								result.showObjectValid = r3::json::ValidationUtils::requiredObject(jsonValue, StoryCutsceneProperties::SHOW_OBJECT);
 								if (result.showObjectValid) {
@@ -235,6 +258,10 @@ namespace r3 {
 						errorMessages.push_back("The \"snakeMovement\" is invalid.  It must be an object with \"direction\" and \"grow\" properties.");
 					}
 
+					if (!validationResult.snakePathValid) {
+						errorMessages.push_back("The \"path\" is invalid.  It must be a string of \"U\", \"D\", \"L\", and \"R\" steps, lowercase to grow, where each step after the first may be prefixed with its frame count.  The optional \"framesPerStep\" must be an integer from 0 to 65535.");
+					}
+
 					if (!validationResult.showObjectValid) {
 						errorMessages.push_back("The \"showObject\" is invalid.  It must be an object with \"instanceId\", \"foodType\" or \"dangerType\", and \"position\" properties.");
 					}
@@ -16,6 +16,9 @@ namespace r3 {
 				const int MIN_HEIGHT = 3;
 				const int MAX_HEIGHT = 100;
 
+				const int MAX_FLOOR_ID = 65535;
+				const int MAX_BARRIER_ID = 255;
+
 				bool widthValid(const Json::Value& jsonValue) {
 					bool result = r3::json::ValidationUtils::requiredInt(jsonValue, StoryMapProperties::WIDTH);
 
@@ -42,25 +45,26 @@ namespace r3 {
 					return result;
 				}
 
-				bool tileValid(const Json::Value& jsonValue, int minTileId) {
+				bool tileValid(const Json::Value& jsonValue, int minTileId, int maxTileId) {
 					bool result = false;
 
 					if (jsonValue.isObject()) {
 						result =
 							r3::json::ValidationUtils::requiredInt(jsonValue, StoryMapProperties::TILE_ID, minTileId) &&
+							(jsonValue[StoryMapProperties::TILE_ID].asInt() <= maxTileId) &&
 							r3::json::ValidationUtils::requiredString(jsonValue, StoryMapProperties::TILE_FILENAME);
 					}
 
 					return result;
 				}
 
-				bool tileListValid(const Json::Value& jsonValue, const char* propertyName, int minTileId) {
+				bool tileListValid(const Json::Value& jsonValue, const char* propertyName, int minTileId, int maxTileId) {
 					bool result = r3::json::ValidationUtils::requiredArray(jsonValue, propertyName);
 
 					if (result) {
 						Json::Value tileList = jsonValue[propertyName];
 						for (Json::ArrayIndex index = 0; index < tileList.size(); index++) {
-							result = result && tileValid(tileList[index], minTileId);
+							result = result && tileValid(tileList[index], minTileId, maxTileId);
 						}
 					}
 
@@ -113,12 +117,10 @@ namespace r3 {
 					}
 				}
 
-				void updateNonExistentTileIdRefSet(std::set<int>& nonExistentTileIdRefList, const std::unordered_map<int, StoryMapTileDefn>& storyMapTileDefnMap, const std::vector<std::vector<int>>& tileGrid) {
-					for (auto const& tileRow : tileGrid) {
-						for (auto const& tileCell : tileRow) {
-							if (storyMapTileDefnMap.count(tileCell) == 0) {
-								nonExistentTileIdRefList.insert(tileCell);
-							}
+				void updateNonExistentTileIdRefSet(std::set<int>& nonExistentTileIdRefList, const std::unordered_map<int, StoryMapTileDefn>& storyMapTileDefnMap, const std::vector<int>& tileGrid) {
+					for (int tileCell : tileGrid) {
+						if (storyMapTileDefnMap.count(tileCell) == 0) {
+							nonExistentTileIdRefList.insert(tileCell);
 						}
 					}
 				}
@@ -191,10 +193,10 @@ namespace r3 {
 						result.push_back("The \"height\" is invalid.  It must be an integer between 3 and 100");
 					}
 					if (!validationResult.floorListValid) {
-						result.push_back("The \"floorList\" is invalid.  Each entry in the array must specify an integer \"id\" of 0 or higher, and a \"filename\".");
+						result.push_back("The \"floorList\" is invalid.  Each entry in the array must specify an integer \"id\" from 0 to 65535, and a \"filename\".");
 					}
 					if (!validationResult.barrierListValid) {
-						result.push_back("The \"barrierList\" is invalid.  Each entry in the array must specify an integer \"id\" of 1 or higher, and a \"filename\".");
+						result.push_back("The \"barrierList\" is invalid.  Each entry in the array must specify an integer \"id\" from 1 to 255, and a \"filename\".");
 					}
 					if (!validationResult.floorGridValid) {
 						result.push_back("The \"floorGrid\" is invalid.  It must be a two-dimensional array of integers.  Each value must be a valid \"id\" from the \"floorList\".");
@@ -0,0 +1,315 @@
+
+#include <assert.h>
+#include <stdio.h>
+#include "../includes/r3-snake-storyassets.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryAssetCacheConstants {
+
+			const size_t DEFAULT_MEMORY_BUDGET_BYTES = 256 * 1024 * 1024;
+
+			const sf::Uint64 CONTENT_HASH_OFFSET = 14695981039346656037ULL;
+			const sf::Uint64 CONTENT_HASH_PRIME = 1099511628211ULL;
+
+			const sf::Uint64 TEXTURE_KEY_TAG = 1;
+			const sf::Uint64 REPEATED_TEXTURE_KEY_TAG = 2;
+			const sf::Uint64 SOUND_BUFFER_KEY_TAG = 3;
+			const sf::Uint64 IMAGE_KEY_TAG = 4;
+
+		}
+
+		namespace StoryAssetCacheUtils {
+
+			sf::Uint64 hashFileContents(const char* fileData, size_t fileSize, sf::Uint64 keyTag) {
+				sf::Uint64 result = StoryAssetCacheConstants::CONTENT_HASH_OFFSET;
+				for (size_t byteIndex = 0; byteIndex < fileSize; byteIndex++) {
+					result = (result ^ (sf::Uint8)fileData[byteIndex]) * StoryAssetCacheConstants::CONTENT_HASH_PRIME;
+				}
+				result = (result ^ keyTag) * StoryAssetCacheConstants::CONTENT_HASH_PRIME;
+				return result;
+			}
+
+			sf::Uint64 buildTextureKey(const char* fileData, size_t fileSize, bool repeatFlag) {
+				sf::Uint64 keyTag = repeatFlag ? StoryAssetCacheConstants::REPEATED_TEXTURE_KEY_TAG : StoryAssetCacheConstants::TEXTURE_KEY_TAG;
+				sf::Uint64 result = hashFileContents(fileData, fileSize, keyTag);
+				return result;
+			}
+
+			sf::Uint64 buildSoundBufferKey(const char* fileData, size_t fileSize) {
+				sf::Uint64 result = hashFileContents(fileData, fileSize, StoryAssetCacheConstants::SOUND_BUFFER_KEY_TAG);
+				return result;
+			}
+
+			// Built from the file's texture key rather than its contents, so that a tile is only hashed once
+			sf::Uint64 buildImageKey(sf::Uint64 textureKey) {
+				sf::Uint64 result = (textureKey ^ StoryAssetCacheConstants::IMAGE_KEY_TAG) * StoryAssetCacheConstants::CONTENT_HASH_PRIME;
+				return result;
+			}
+
+			std::string buildStatsMessage(const StoryAssetCacheStats& stats) {
+				char statsStr[200];
+				sprintf(
+					statsStr,
+					"Asset cache: %d hits, %d misses, %d evictions, %d entries, %.1f of %.1f MB resident",
+					stats.hitCount,
+					stats.missCount,
+					stats.evictionCount,
+					stats.entryCount,
+					(float)stats.residentBytes / (1024.0f * 1024.0f),
+					(float)stats.memoryBudgetBytes / (1024.0f * 1024.0f)
+				);
+
+				std::string result(statsStr);
+				return result;
+			}
+
+		}
+
+		StoryAssetCache::StoryAssetCache(size_t memoryBudgetBytes) {
+			this->memoryBudgetBytes = memoryBudgetBytes;
+
+			this->stats.hitCount = 0;
+			this->stats.missCount = 0;
+			this->stats.evictionCount = 0;
+			this->stats.imageHitCount = 0;
+			this->stats.imageMissCount = 0;
+			this->stats.entryCount = 0;
+			this->stats.residentBytes = 0;
+			this->stats.memoryBudgetBytes = memoryBudgetBytes;
+		}
+
+		StoryAssetCache::~StoryAssetCache() {
+			for (auto& currEntryPair : this->entryMap) {
+				assert(currEntryPair.second.refCount == 0);
+
+				this->destroyEntry(currEntryPair.second);
+			}
+		}
+
+		const sf::Texture* StoryAssetCache::acquireTexture(sf::Uint64 key) {
+			this->cacheMutex.lock();
+
+			StoryAssetCacheEntry* entry = this->acquireEntry(key);
+			const sf::Texture* result = (entry != nullptr) ? entry->texture : nullptr;
+
+			this->cacheMutex.unlock();
+
+			return result;
+		}
+
+		const sf::Texture* StoryAssetCache::insertTexture(sf::Uint64 key, const sf::Image& image, bool repeatFlag) {
+			const sf::Texture* result = nullptr;
+
+			// The upload happens outside the lock so decode workers are never stalled behind the GPU
+			sf::Texture* texture = new sf::Texture();
+			if (texture->loadFromImage(image)) {
+				texture->setRepeated(repeatFlag);
+
+				size_t residentBytes = (size_t)image.getSize().x * (size_t)image.getSize().y * 4;
+
+				this->cacheMutex.lock();
+
+				StoryAssetCacheEntry* entry = this->insertEntry(key, texture, nullptr, nullptr, residentBytes);
+				result = entry->texture;
+
+				this->cacheMutex.unlock();
+			}
+			else {
+				delete texture;
+			}
+
+			return result;
+		}
+
+		const sf::SoundBuffer* StoryAssetCache::acquireSoundBuffer(sf::Uint64 key) {
+			this->cacheMutex.lock();
+
+			StoryAssetCacheEntry* entry = this->acquireEntry(key);
+			const sf::SoundBuffer* result = (entry != nullptr) ? entry->soundBuffer : nullptr;
+
+			this->cacheMutex.unlock();
+
+			return result;
+		}
+
+		const sf::SoundBuffer* StoryAssetCache::insertSoundBuffer(sf::Uint64 key, const std::vector<sf::Int16>& sampleList, unsigned int channelCount, unsigned int sampleRate) {
+			const sf::SoundBuffer* result = nullptr;
+
+			sf::SoundBuffer* soundBuffer = new sf::SoundBuffer();
+			if (soundBuffer->loadFromSamples(sampleList.data(), sampleList.size(), channelCount, sampleRate)) {
+				size_t residentBytes = sampleList.size() * sizeof(sf::Int16);
+
+				this->cacheMutex.lock();
+
+				StoryAssetCacheEntry* entry = this->insertEntry(key, nullptr, soundBuffer, nullptr, residentBytes);
+				result = entry->soundBuffer;
+
+				this->cacheMutex.unlock();
+			}
+			else {
+				delete soundBuffer;
+			}
+
+			return result;
+		}
+
+		const sf::Image* StoryAssetCache::acquireImage(sf::Uint64 key) {
+			this->cacheMutex.lock();
+
+			StoryAssetCacheEntry* entry = this->acquireEntry(key);
+			const sf::Image* result = nullptr;
+			if (entry != nullptr) {
+				result = entry->image;
+				this->stats.imageHitCount++;
+			}
+			else {
+				this->stats.imageMissCount++;
+			}
+
+			this->cacheMutex.unlock();
+
+			return result;
+		}
+
+		// Images are only ever read once they are in the cache, so decode workers may insert and share them freely
+		const sf::Image* StoryAssetCache::insertImage(sf::Uint64 key, const sf::Image& image) {
+			sf::Image* cachedImage = new sf::Image(image);
+			size_t residentBytes = (size_t)image.getSize().x * (size_t)image.getSize().y * 4;
+
+			this->cacheMutex.lock();
+
+			StoryAssetCacheEntry* entry = this->insertEntry(key, nullptr, nullptr, cachedImage, residentBytes);
+			const sf::Image* result = entry->image;
+
+			this->cacheMutex.unlock();
+
+			return result;
+		}
+
+		void StoryAssetCache::release(sf::Uint64 key) {
+			this->cacheMutex.lock();
+
+			auto entryItr = this->entryMap.find(key);
+			assert(entryItr != this->entryMap.end());
+			assert(entryItr->second.refCount > 0);
+
+			entryItr->second.refCount--;
+			if (entryItr->second.refCount == 0) {
+				this->unusedKeyList.push_front(key);
+				entryItr->second.unusedItr = this->unusedKeyList.begin();
+
+				this->evictUnusedEntries();
+			}
+
+			this->cacheMutex.unlock();
+		}
+
+		StoryAssetCacheStats StoryAssetCache::getStats() {
+			this->cacheMutex.lock();
+
+			StoryAssetCacheStats result = this->stats;
+
+			this->cacheMutex.unlock();
+
+			return result;
+		}
+
+		StoryAssetCacheEntry* StoryAssetCache::acquireEntry(sf::Uint64 key) {
+			StoryAssetCacheEntry* result = nullptr;
+
+			auto entryItr = this->entryMap.find(key);
+			if (entryItr != this->entryMap.end()) {
+				result = &entryItr->second;
+				if (result->refCount == 0) {
+					this->unusedKeyList.erase(result->unusedItr);
+				}
+				result->refCount++;
+
+				this->stats.hitCount++;
+			}
+			else {
+				this->stats.missCount++;
+			}
+
+			return result;
+		}
+
+		StoryAssetCacheEntry* StoryAssetCache::insertEntry(sf::Uint64 key, sf::Texture* texture, sf::SoundBuffer* soundBuffer, sf::Image* image, size_t residentBytes) {
+			StoryAssetCacheEntry* result = nullptr;
+
+			auto entryItr = this->entryMap.find(key);
+			if (entryItr != this->entryMap.end()) {
+				// Two files with identical contents missed together; keep the entry that got here first, and count the
+				// second load as the hit it would have been had it arrived a moment later
+				delete texture;
+				delete soundBuffer;
+				delete image;
+
+				result = &entryItr->second;
+				if (result->refCount == 0) {
+					this->unusedKeyList.erase(result->unusedItr);
+				}
+				result->refCount++;
+
+				this->stats.missCount--;
+				this->stats.hitCount++;
+				if (image != nullptr) {
+					this->stats.imageMissCount--;
+					this->stats.imageHitCount++;
+				}
+			}
+			else {
+				result = &this->entryMap[key];
+				result->key = key;
+				result->texture = texture;
+				result->soundBuffer = soundBuffer;
+				result->image = image;
+				result->residentBytes = residentBytes;
+				result->refCount = 1;
+
+				this->stats.entryCount++;
+				this->stats.residentBytes += residentBytes;
+
+				this->evictUnusedEntries();
+			}
+
+			return result;
+		}
+
+		void StoryAssetCache::evictUnusedEntries() {
+			while ((this->stats.residentBytes > this->memoryBudgetBytes) && !this->unusedKeyList.empty()) {
+				sf::Uint64 leastRecentlyUsedKey = this->unusedKeyList.back();
+				this->unusedKeyList.pop_back();
+
+				auto entryItr = this->entryMap.find(leastRecentlyUsedKey);
+				this->destroyEntry(entryItr->second);
+
+				this->stats.entryCount--;
+				this->stats.residentBytes -= entryItr->second.residentBytes;
+				this->stats.evictionCount++;
+
+				this->entryMap.erase(entryItr);
+			}
+		}
+
+		void StoryAssetCache::destroyEntry(StoryAssetCacheEntry& entry) {
+			if (entry.texture != nullptr) {
+				delete entry.texture;
+				entry.texture = nullptr;
+			}
+			if (entry.soundBuffer != nullptr) {
+				delete entry.soundBuffer;
+				entry.soundBuffer = nullptr;
+			}
+			if (entry.image != nullptr) {
+				delete entry.image;
+				entry.image = nullptr;
+			}
+		}
+
+	}
+
+}
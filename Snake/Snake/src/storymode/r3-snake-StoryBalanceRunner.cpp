@@ -0,0 +1,330 @@
+#include <stdio.h>
+#include <thread>
+#include <algorithm>
+#include "../includes/r3-snake-utils.hpp"
+#include "../includes/r3-snake-allocationcounter.hpp"
+#include "../includes/r3-snake-snakebot.hpp"
+#include "../includes/r3-snake-storybalance.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryBalanceConstants {
+
+			const int DEFAULT_RUNS_PER_LEVEL = 1000;
+			const int DEFAULT_MAX_SECONDS_PER_RUN = 600;
+
+		}
+
+		namespace StoryBalanceRunnerUtils {
+
+			int resolvePercentile(const std::vector<int>& sortedValueList, int percentile) {
+				int result = 0;
+				if (!sortedValueList.empty()) {
+					size_t index = (sortedValueList.size() - 1) * percentile / 100;
+					result = sortedValueList[index];
+				}
+				return result;
+			}
+
+			float ticksToSeconds(int ticks) {
+				float result = StoryGameTickUtils::tickToTime(ticks).asSeconds();
+				return result;
+			}
+
+		}
+
+		StoryBalanceRunner::StoryBalanceRunner(const std::string& campaignFolderName, const StoryBalanceOptions& options) {
+			this->campaignFolderName = campaignFolderName;
+			this->options = options;
+			this->nextJobIndex = 0;
+			this->totalJobCount = 0;
+		}
+
+		StoryBalanceReport StoryBalanceRunner::run() {
+			StoryBalanceReport result;
+			if (!this->loadCampaign(result)) {
+				return result;
+			}
+
+			sf::Clock clock;
+
+			this->nextJobIndex = 0;
+			this->totalJobCount = this->levelDefnList.size() * this->options.runsPerLevel;
+			this->runResultList.assign(this->totalJobCount, StoryBalanceRunResult());
+
+			result.threadCount = std::max(1, this->options.threadCount);
+			result.totalRunCount = this->totalJobCount;
+
+			std::vector<sf::Thread*> workerThreadList;
+			for (int threadIndex = 0; threadIndex < result.threadCount; threadIndex++) {
+				sf::Thread* workerThread = new sf::Thread(&StoryBalanceRunner::runWorker, this);
+				workerThread->launch();
+				workerThreadList.push_back(workerThread);
+			}
+
+			for (auto currWorkerThread : workerThreadList) {
+				currWorkerThread->wait();
+				delete currWorkerThread;
+			}
+
+			for (size_t levelIndex = 0; levelIndex < this->levelDefnList.size(); levelIndex++) {
+				result.levelReportList.push_back(this->buildLevelReport(levelIndex));
+				result.steadyStateAllocationCount += result.levelReportList.back().steadyStateAllocationCount;
+			}
+
+#ifdef R3_SNAKE_COUNT_ALLOCATIONS
+			result.allocationsCountedFlag = true;
+#endif
+
+			result.secondsElapsed = clock.getElapsedTime().asSeconds();
+
+			return result;
+		}
+
+		bool StoryBalanceRunner::loadCampaign(StoryBalanceReport& report) {
+			LoadStoryCampaignResult loadCampaignResult = StoryLoaderUtils::loadStoryCampaign(this->campaignFolderName);
+			report.campaignValid = loadCampaignResult.valid();
+			if (!report.campaignValid) {
+				return false;
+			}
+
+			this->levelDefnList.clear();
+			this->mapDefnList.clear();
+
+			report.mapListValid = true;
+			for (auto const& currLevelResult : loadCampaignResult.levelResultList) {
+				LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(this->campaignFolderName, currLevelResult.levelDefn.mapFilename);
+				report.mapListValid = report.mapListValid && loadMapResult.validationResult.valid();
+
+				this->levelDefnList.push_back(currLevelResult.levelDefn);
+				this->mapDefnList.push_back(loadMapResult.mapDefn);
+			}
+
+			return report.mapListValid;
+		}
+
+		void StoryBalanceRunner::runWorker() {
+			StoryGame storyGame;
+
+			int jobIndex;
+			while (this->claimJob(jobIndex)) {
+				int levelIndex = jobIndex / this->options.runsPerLevel;
+				unsigned int seed = this->options.baseSeed + (unsigned int)jobIndex;
+
+				this->runResultList[jobIndex] = this->playLevel(storyGame, levelIndex, seed);
+			}
+		}
+
+		bool StoryBalanceRunner::claimJob(int& jobIndex) {
+			this->jobMutex.lock();
+
+			bool result = (this->nextJobIndex < this->totalJobCount);
+			if (result) {
+				jobIndex = this->nextJobIndex;
+				this->nextJobIndex++;
+			}
+
+			this->jobMutex.unlock();
+
+			return result;
+		}
+
+		StoryBalanceRunResult StoryBalanceRunner::playLevel(StoryGame& storyGame, int levelIndex, unsigned int seed) {
+			StoryBalanceRunResult result;
+			result.wonFlag = false;
+			result.diedFlag = false;
+			result.peakTickMicroseconds = 0;
+			result.steadyStateAllocationCount = 0;
+			result.firstAllocatingTick = -1;
+
+			storyGame.startNewCampaign();
+			storyGame.startNewLevel(this->mapDefnList[levelIndex], this->levelDefnList[levelIndex], seed);
+			storyGame.startRunningLevel();
+
+			SnakeBot* bot = SnakeBotUtils::createStoryGameBot(storyGame);
+
+			StoryGameUpdateResult updateResult;
+			sf::Clock tickClock;
+			while (!result.wonFlag && !result.diedFlag && (storyGame.getTicksElapsed() < this->options.maxTicksPerRun)) {
+				StoryGameInputRequest inputRequest = SnakeBotUtils::buildStoryGameInputRequest(*bot, storyGame);
+
+				tickClock.restart();
+#ifdef R3_SNAKE_COUNT_ALLOCATIONS
+				sf::Uint64 allocationCountBefore = AllocationCounterUtils::getThreadAllocationCount();
+#endif
+
+				storyGame.update(inputRequest, updateResult);
+				result.wonFlag = updateResult.completedLevelFlag;
+				result.diedFlag = updateResult.snakeDiedFlag;
+
+				result.peakTickMicroseconds = std::max(result.peakTickMicroseconds, tickClock.getElapsedTime().asMicroseconds());
+
+#ifdef R3_SNAKE_COUNT_ALLOCATIONS
+				// The first tick sizes the update result, after that the game core should never allocate
+				if (storyGame.getTicksElapsed() > 1) {
+					sf::Uint64 tickAllocationCount = AllocationCounterUtils::getThreadAllocationCount() - allocationCountBefore;
+					if ((tickAllocationCount > 0) && (result.firstAllocatingTick < 0)) {
+						result.firstAllocatingTick = storyGame.getTicksElapsed();
+					}
+					result.steadyStateAllocationCount += tickAllocationCount;
+				}
+#endif
+			}
+
+			delete bot;
+
+			storyGame.stopRunningLevel();
+
+			result.ticksElapsed = storyGame.getTicksElapsed();
+			result.score = storyGame.getScore();
+
+			return result;
+		}
+
+		StoryBalanceLevelReport StoryBalanceRunner::buildLevelReport(int levelIndex) const {
+			StoryBalanceLevelReport result;
+			result.levelIndex = levelIndex;
+			result.mapFilename = this->levelDefnList[levelIndex].mapFilename;
+			result.runCount = this->options.runsPerLevel;
+			result.winCount = 0;
+			result.lossCount = 0;
+			result.timeoutCount = 0;
+			result.minSecondsToComplete = 0.0f;
+			result.avgSecondsToComplete = 0.0f;
+			result.maxSecondsToComplete = 0.0f;
+			result.peakTickMicroseconds = 0;
+			result.steadyStateAllocationCount = 0;
+			result.firstAllocatingTick = -1;
+
+			int minTicksToComplete = 0;
+			int maxTicksToComplete = 0;
+			double totalTicksToComplete = 0.0;
+			std::vector<int> scoreList;
+
+			int firstJobIndex = levelIndex * this->options.runsPerLevel;
+			for (int jobIndex = firstJobIndex; jobIndex < (firstJobIndex + this->options.runsPerLevel); jobIndex++) {
+				const StoryBalanceRunResult& currRunResult = this->runResultList[jobIndex];
+
+				if (currRunResult.wonFlag) {
+					if ((result.winCount == 0) || (currRunResult.ticksElapsed < minTicksToComplete)) {
+						minTicksToComplete = currRunResult.ticksElapsed;
+					}
+					maxTicksToComplete = std::max(maxTicksToComplete, currRunResult.ticksElapsed);
+					totalTicksToComplete += currRunResult.ticksElapsed;
+
+					result.winCount++;
+				}
+				else if (currRunResult.diedFlag) {
+					result.lossCount++;
+				}
+				else {
+					result.timeoutCount++;
+				}
+
+				scoreList.push_back(currRunResult.score);
+				result.peakTickMicroseconds = std::max(result.peakTickMicroseconds, currRunResult.peakTickMicroseconds);
+				result.steadyStateAllocationCount += currRunResult.steadyStateAllocationCount;
+				if ((currRunResult.firstAllocatingTick >= 0) && ((result.firstAllocatingTick < 0) || (currRunResult.firstAllocatingTick < result.firstAllocatingTick))) {
+					result.firstAllocatingTick = currRunResult.firstAllocatingTick;
+				}
+			}
+
+			result.winRatePct = (result.runCount > 0) ? (100.0f * (float)result.winCount / (float)result.runCount) : 0.0f;
+			if (result.winCount > 0) {
+				result.minSecondsToComplete = StoryBalanceRunnerUtils::ticksToSeconds(minTicksToComplete);
+				result.avgSecondsToComplete = StoryBalanceRunnerUtils::ticksToSeconds((int)(totalTicksToComplete / result.winCount));
+				result.maxSecondsToComplete = StoryBalanceRunnerUtils::ticksToSeconds(maxTicksToComplete);
+			}
+
+			std::sort(scoreList.begin(), scoreList.end());
+			result.minScore = StoryBalanceRunnerUtils::resolvePercentile(scoreList, 0);
+			result.p10Score = StoryBalanceRunnerUtils::resolvePercentile(scoreList, 10);
+			result.medianScore = StoryBalanceRunnerUtils::resolvePercentile(scoreList, 50);
+			result.p90Score = StoryBalanceRunnerUtils::resolvePercentile(scoreList, 90);
+			result.maxScore = StoryBalanceRunnerUtils::resolvePercentile(scoreList, 100);
+
+			return result;
+		}
+
+		namespace StoryBalanceUtils {
+
+			StoryBalanceOptions createDefaultOptions() {
+				StoryBalanceOptions result;
+				result.runsPerLevel = StoryBalanceConstants::DEFAULT_RUNS_PER_LEVEL;
+				result.threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+				result.maxTicksPerRun = StoryBalanceConstants::DEFAULT_MAX_SECONDS_PER_RUN * (int)GameLoopUtils::FRAMES_PER_SECOND;
+				result.baseSeed = 1;
+				return result;
+			}
+
+			std::vector<std::string> buildReportMessages(const StoryBalanceReport& report) {
+				std::vector<std::string> result;
+
+				if (!report.campaignValid) {
+					result.push_back("The campaign could not be loaded, see log.txt for details");
+				}
+				else if (!report.mapListValid) {
+					result.push_back("One or more level maps could not be loaded");
+				}
+				else {
+					char message[512];
+
+					snprintf(message, sizeof(message), "Played %d runs on %d threads in %.1f seconds", report.totalRunCount, report.threadCount, report.secondsElapsed);
+					result.push_back(message);
+
+					result.push_back("level  map                          win%   won  lost  t/o  secs(min/avg/max)      score(min/p10/p50/p90/max)     peak tick us  allocs");
+					for (auto const& currLevelReport : report.levelReportList) {
+						std::string allocationCountText = report.allocationsCountedFlag ? std::to_string(currLevelReport.steadyStateAllocationCount) : "-";
+						snprintf(
+							message,
+							sizeof(message),
+							"%5d  %-28s %5.1f %5d %5d %4d  %6.1f/%6.1f/%6.1f   %5d/%5d/%5d/%5d/%5d   %12lld  %s",
+							currLevelReport.levelIndex + 1,
+							currLevelReport.mapFilename.c_str(),
+							currLevelReport.winRatePct,
+							currLevelReport.winCount,
+							currLevelReport.lossCount,
+							currLevelReport.timeoutCount,
+							currLevelReport.minSecondsToComplete,
+							currLevelReport.avgSecondsToComplete,
+							currLevelReport.maxSecondsToComplete,
+							currLevelReport.minScore,
+							currLevelReport.p10Score,
+							currLevelReport.medianScore,
+							currLevelReport.p90Score,
+							currLevelReport.maxScore,
+							(long long)currLevelReport.peakTickMicroseconds,
+							allocationCountText.c_str()
+						);
+						result.push_back(message);
+					}
+
+					if (!report.allocationsCountedFlag) {
+						result.push_back("Allocations are only counted in the Benchmark configuration");
+					}
+					else if (report.steadyStateAllocationCount == 0) {
+						result.push_back("No allocations were made by StoryGame::update after the first tick of a run");
+					}
+					else {
+						snprintf(message, sizeof(message), "FAILED: StoryGame::update made %llu allocations after the first tick of a run, it should make none", (unsigned long long)report.steadyStateAllocationCount);
+						result.push_back(message);
+
+						for (auto const& currLevelReport : report.levelReportList) {
+							if (currLevelReport.firstAllocatingTick >= 0) {
+								snprintf(message, sizeof(message), "Level %d first allocated on tick %d", currLevelReport.levelIndex + 1, currLevelReport.firstAllocatingTick);
+								result.push_back(message);
+							}
+						}
+					}
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,591 @@
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include "../includes/r3-snake-storyarchive.hpp"
+#include "../includes/r3-snake-storyloader.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryArchiveConstants {
+
+			const char* ARCHIVE_FILE_EXTENSION = ".r3pak";
+
+			const size_t BLOB_ALIGNMENT = 64;
+
+			const char ARCHIVE_FILE_MAGIC[8] = { 'R', '3', 'S', 'N', 'K', 'P', 'A', 'K' };
+			const sf::Uint32 ARCHIVE_FILE_VERSION = 1;
+			const size_t ARCHIVE_HEADER_SIZE = 24;
+
+		}
+
+		namespace StoryArchiveStreamUtils {
+
+			typedef struct Snake_ReadCursor {
+				const char* data;
+				size_t size;
+				size_t position;
+				bool validFlag;
+			} ReadCursor;
+
+			sf::Uint32 readUint32(ReadCursor& cursor) {
+				sf::Uint32 result = 0;
+				if (cursor.validFlag && ((cursor.size - cursor.position) >= 4)) {
+					for (int byteIndex = 0; byteIndex < 4; byteIndex++) {
+						result |= (sf::Uint32)(sf::Uint8)cursor.data[cursor.position + byteIndex] << (byteIndex * 8);
+					}
+					cursor.position += 4;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			sf::Uint64 readUint64(ReadCursor& cursor) {
+				sf::Uint64 result = 0;
+				if (cursor.validFlag && ((cursor.size - cursor.position) >= 8)) {
+					for (int byteIndex = 0; byteIndex < 8; byteIndex++) {
+						result |= (sf::Uint64)(sf::Uint8)cursor.data[cursor.position + byteIndex] << (byteIndex * 8);
+					}
+					cursor.position += 8;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			void writeUint32(std::vector<char>& buffer, sf::Uint32 value) {
+				for (int byteIndex = 0; byteIndex < 4; byteIndex++) {
+					buffer.push_back((char)(sf::Uint8)(value >> (byteIndex * 8)));
+				}
+			}
+
+			void writeUint64(std::vector<char>& buffer, sf::Uint64 value) {
+				for (int byteIndex = 0; byteIndex < 8; byteIndex++) {
+					buffer.push_back((char)(sf::Uint8)(value >> (byteIndex * 8)));
+				}
+			}
+
+			void writePadding(std::vector<char>& buffer, size_t alignment) {
+				while ((buffer.size() % alignment) != 0) {
+					buffer.push_back(0);
+				}
+			}
+
+			std::string readString(ReadCursor& cursor, size_t length) {
+				std::string result;
+				if (cursor.validFlag && ((cursor.size - cursor.position) >= length)) {
+					result.assign(cursor.data + cursor.position, length);
+					cursor.position += length;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+		}
+
+		namespace StoryArchiveRegistry {
+
+			sf::Mutex registryMutex;
+			bool lookupEnabledFlag = true;
+			std::unordered_map<std::string, StoryCampaignArchive> archiveMap;
+
+			// Archives are opened on first use and stay mapped for the rest of the run, so blobs handed
+			// to sf::Music and friends never dangle
+			const StoryCampaignArchive* findArchive(const std::string& campaignFolderName) {
+				registryMutex.lock();
+
+				const StoryCampaignArchive* result = nullptr;
+				if (lookupEnabledFlag) {
+					auto archiveItr = archiveMap.find(campaignFolderName);
+					if (archiveItr == archiveMap.end()) {
+						StoryCampaignArchive& archive = archiveMap[campaignFolderName];
+						archive.open(StoryArchiveUtils::resolveArchiveFilePath(campaignFolderName));
+						result = &archive;
+					}
+					else {
+						result = &archiveItr->second;
+					}
+
+					if (!result->isOpen()) {
+						result = nullptr;
+					}
+				}
+
+				registryMutex.unlock();
+
+				return result;
+			}
+
+			bool findArchivedFile(const std::string& filePath, StoryArchiveBlob& blob) {
+				bool result = false;
+
+				size_t campaignsPathLength = strlen(StoryLoaderUtils::PATH_CAMPAIGNS);
+				if (filePath.compare(0, campaignsPathLength, StoryLoaderUtils::PATH_CAMPAIGNS) == 0) {
+					size_t slashIndex = filePath.find('/', campaignsPathLength);
+					if (slashIndex != std::string::npos) {
+						std::string campaignFolderName = filePath.substr(campaignsPathLength, slashIndex - campaignsPathLength);
+
+						const StoryCampaignArchive* archive = findArchive(campaignFolderName);
+						if (archive != nullptr) {
+							result = archive->findBlob(filePath.substr(slashIndex + 1), blob);
+						}
+					}
+				}
+
+				return result;
+			}
+
+		}
+
+		namespace StoryArchivePackUtils {
+
+			std::string resolveRelativeFilePath(const std::string& campaignFolderName, const std::string& filePath) {
+				size_t prefixLength = strlen(StoryLoaderUtils::PATH_CAMPAIGNS) + campaignFolderName.length() + 1;
+
+				std::string result = filePath.substr(prefixLength);
+				return result;
+			}
+
+			void addMapFilePaths(std::set<std::string>& relativePathSet, StoryPackCampaignResult& packResult, const std::string& campaignFolderName, const std::string& mapFilename) {
+				std::string mapRelativePath = resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveMapFilePath(campaignFolderName, mapFilename));
+				if (relativePathSet.count(mapRelativePath) == 0) {
+					relativePathSet.insert(mapRelativePath);
+
+					LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(campaignFolderName, mapFilename);
+					if (loadMapResult.validationResult.valid()) {
+						for (auto const& currFloorDefnPair : loadMapResult.mapDefn.floorDefnMap) {
+							relativePathSet.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveImageFilePath(campaignFolderName, currFloorDefnPair.second.filename)));
+						}
+						for (auto const& currBarrierDefnPair : loadMapResult.mapDefn.barrierDefnMap) {
+							relativePathSet.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveImageFilePath(campaignFolderName, currBarrierDefnPair.second.filename)));
+						}
+					}
+					else {
+						StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryMapValidation::buildErrorMessages(loadMapResult.validationResult));
+						packResult.invalidMapFilenameList.push_back(mapFilename);
+					}
+				}
+			}
+
+			void addCutsceneFilePaths(std::set<std::string>& relativePathSet, StoryPackCampaignResult& packResult, const std::string& campaignFolderName, const StoryCutsceneDefn& cutsceneDefn) {
+				if (cutsceneDefn.existsFlag) {
+					if (!cutsceneDefn.soundTrackFilename.empty()) {
+						relativePathSet.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveSoundFilePath(campaignFolderName, cutsceneDefn.soundTrackFilename)));
+					}
+
+					for (auto const& currTextureEventDefn : cutsceneDefn.textureEventList) {
+						const std::string& textureFilename = cutsceneDefn.filenameList[currTextureEventDefn.filenameIndex];
+						relativePathSet.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveImageFilePath(campaignFolderName, textureFilename)));
+					}
+
+					for (auto const& currMapEventDefn : cutsceneDefn.mapEventList) {
+						addMapFilePaths(relativePathSet, packResult, campaignFolderName, cutsceneDefn.filenameList[currMapEventDefn.filenameIndex]);
+					}
+				}
+			}
+
+			std::set<std::string> resolveCampaignRelativePathSet(StoryPackCampaignResult& packResult, const std::string& campaignFolderName, const LoadStoryCampaignResult& loadCampaignResult) {
+				std::set<std::string> result;
+				result.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName)));
+
+				for (auto const& currLevelResult : loadCampaignResult.levelResultList) {
+					const StoryLevelDefn& levelDefn = currLevelResult.levelDefn;
+
+					addMapFilePaths(result, packResult, campaignFolderName, levelDefn.mapFilename);
+
+					if (!levelDefn.musicFilename.empty()) {
+						result.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveMusicFilePath(campaignFolderName, levelDefn.musicFilename)));
+					}
+
+					addCutsceneFilePaths(result, packResult, campaignFolderName, levelDefn.openingCutsceneDefn);
+					addCutsceneFilePaths(result, packResult, campaignFolderName, levelDefn.winCutsceneDefn);
+					addCutsceneFilePaths(result, packResult, campaignFolderName, levelDefn.lossCutsceneDefn);
+
+					for (auto const& currSoundFxDefn : levelDefn.soundFxDefnList) {
+						result.insert(resolveRelativeFilePath(campaignFolderName, StoryLoaderUtils::resolveSoundFilePath(campaignFolderName, currSoundFxDefn.soundFilename)));
+					}
+				}
+
+				return result;
+			}
+
+			bool writeArchive(StoryPackCampaignResult& packResult, const std::string& campaignFolderName, const std::set<std::string>& relativePathSet) {
+				std::vector<std::string> relativePathList(relativePathSet.begin(), relativePathSet.end());
+				std::vector<StoryFileContents> fileContentsList(relativePathList.size());
+
+				std::string campaignPathPrefix(StoryLoaderUtils::PATH_CAMPAIGNS);
+				campaignPathPrefix.append(campaignFolderName);
+				campaignPathPrefix.append("/");
+
+				for (size_t blobIndex = 0; blobIndex < relativePathList.size(); blobIndex++) {
+					if (!StoryArchiveUtils::readFile(campaignPathPrefix + relativePathList[blobIndex], fileContentsList[blobIndex])) {
+						packResult.unreadableFilenameList.push_back(relativePathList[blobIndex]);
+					}
+				}
+
+				bool result = packResult.unreadableFilenameList.empty();
+				if (result) {
+					size_t indexSize = 0;
+					for (auto const& currRelativePath : relativePathList) {
+						indexSize += 4 + currRelativePath.length() + 16;
+					}
+
+					std::vector<char> buffer;
+					buffer.insert(buffer.end(), StoryArchiveConstants::ARCHIVE_FILE_MAGIC, StoryArchiveConstants::ARCHIVE_FILE_MAGIC + sizeof(StoryArchiveConstants::ARCHIVE_FILE_MAGIC));
+					StoryArchiveStreamUtils::writeUint32(buffer, StoryArchiveConstants::ARCHIVE_FILE_VERSION);
+					StoryArchiveStreamUtils::writeUint32(buffer, (sf::Uint32)relativePathList.size());
+					StoryArchiveStreamUtils::writeUint64(buffer, indexSize);
+
+					// Blob offsets are known up front, since every blob starts on the next aligned boundary
+					size_t blobOffset = StoryArchiveConstants::ARCHIVE_HEADER_SIZE + indexSize;
+					for (size_t blobIndex = 0; blobIndex < relativePathList.size(); blobIndex++) {
+						blobOffset = (blobOffset + StoryArchiveConstants::BLOB_ALIGNMENT - 1) / StoryArchiveConstants::BLOB_ALIGNMENT * StoryArchiveConstants::BLOB_ALIGNMENT;
+
+						StoryArchiveStreamUtils::writeUint32(buffer, (sf::Uint32)relativePathList[blobIndex].length());
+						buffer.insert(buffer.end(), relativePathList[blobIndex].begin(), relativePathList[blobIndex].end());
+						StoryArchiveStreamUtils::writeUint64(buffer, blobOffset);
+						StoryArchiveStreamUtils::writeUint64(buffer, fileContentsList[blobIndex].getSize());
+
+						blobOffset += fileContentsList[blobIndex].getSize();
+					}
+
+					for (auto const& currFileContents : fileContentsList) {
+						StoryArchiveStreamUtils::writePadding(buffer, StoryArchiveConstants::BLOB_ALIGNMENT);
+						buffer.insert(buffer.end(), currFileContents.getData(), currFileContents.getData() + currFileContents.getSize());
+					}
+
+					std::ofstream archiveStream(packResult.archiveFilePath, std::ios_base::binary | std::ios_base::trunc);
+					archiveStream.write(buffer.data(), buffer.size());
+
+					result = archiveStream.good();
+					packResult.blobCount = (int)relativePathList.size();
+					packResult.archiveBytes = buffer.size();
+				}
+
+				return result;
+			}
+
+		}
+
+		StoryMappedFile::StoryMappedFile() {
+#ifdef _WIN32
+			this->fileHandle = INVALID_HANDLE_VALUE;
+			this->mappingHandle = nullptr;
+#else
+			this->fileDescriptor = -1;
+#endif
+			this->data = nullptr;
+			this->size = 0;
+		}
+
+		StoryMappedFile::~StoryMappedFile() {
+			this->close();
+		}
+
+		bool StoryMappedFile::open(const std::string& filePath) {
+			this->close();
+
+#ifdef _WIN32
+			this->fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (this->fileHandle != INVALID_HANDLE_VALUE) {
+				LARGE_INTEGER fileSize;
+				if (GetFileSizeEx(this->fileHandle, &fileSize) && (fileSize.QuadPart > 0)) {
+					this->mappingHandle = CreateFileMappingA(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+					if (this->mappingHandle != nullptr) {
+						this->data = (const char*)MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0);
+						this->size = (this->data != nullptr) ? (size_t)fileSize.QuadPart : 0;
+					}
+				}
+			}
+#else
+			this->fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+			if (this->fileDescriptor >= 0) {
+				struct stat fileStat;
+				if ((fstat(this->fileDescriptor, &fileStat) == 0) && (fileStat.st_size > 0)) {
+					void* mappedData = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, this->fileDescriptor, 0);
+					if (mappedData != MAP_FAILED) {
+						this->data = (const char*)mappedData;
+						this->size = (size_t)fileStat.st_size;
+					}
+				}
+			}
+#endif
+
+			bool result = (this->data != nullptr);
+			if (!result) {
+				this->close();
+			}
+			return result;
+		}
+
+		void StoryMappedFile::close() {
+#ifdef _WIN32
+			if (this->data != nullptr) {
+				UnmapViewOfFile(this->data);
+			}
+			if (this->mappingHandle != nullptr) {
+				CloseHandle(this->mappingHandle);
+				this->mappingHandle = nullptr;
+			}
+			if (this->fileHandle != INVALID_HANDLE_VALUE) {
+				CloseHandle(this->fileHandle);
+				this->fileHandle = INVALID_HANDLE_VALUE;
+			}
+#else
+			if (this->data != nullptr) {
+				munmap((void*)this->data, this->size);
+			}
+			if (this->fileDescriptor >= 0) {
+				::close(this->fileDescriptor);
+				this->fileDescriptor = -1;
+			}
+#endif
+			this->data = nullptr;
+			this->size = 0;
+		}
+
+		const char* StoryMappedFile::getData() const {
+			return this->data;
+		}
+
+		size_t StoryMappedFile::getSize() const {
+			return this->size;
+		}
+
+		bool StoryCampaignArchive::open(const std::string& archiveFilePath) {
+			this->blobMap.clear();
+
+			bool result = this->mappedFile.open(archiveFilePath);
+			if (result) {
+				StoryArchiveStreamUtils::ReadCursor cursor;
+				cursor.data = this->mappedFile.getData();
+				cursor.size = this->mappedFile.getSize();
+				cursor.position = 0;
+				cursor.validFlag = true;
+
+				std::string magic = StoryArchiveStreamUtils::readString(cursor, sizeof(StoryArchiveConstants::ARCHIVE_FILE_MAGIC));
+				cursor.validFlag = cursor.validFlag && (memcmp(magic.data(), StoryArchiveConstants::ARCHIVE_FILE_MAGIC, sizeof(StoryArchiveConstants::ARCHIVE_FILE_MAGIC)) == 0);
+				cursor.validFlag = cursor.validFlag && (StoryArchiveStreamUtils::readUint32(cursor) == StoryArchiveConstants::ARCHIVE_FILE_VERSION);
+
+				sf::Uint32 blobCount = StoryArchiveStreamUtils::readUint32(cursor);
+				sf::Uint64 indexSize = StoryArchiveStreamUtils::readUint64(cursor);
+				cursor.validFlag = cursor.validFlag && (indexSize <= (cursor.size - cursor.position));
+
+				for (sf::Uint32 blobIndex = 0; (blobIndex < blobCount) && cursor.validFlag; blobIndex++) {
+					sf::Uint32 pathLength = StoryArchiveStreamUtils::readUint32(cursor);
+					std::string relativePath = StoryArchiveStreamUtils::readString(cursor, pathLength);
+					sf::Uint64 blobOffset = StoryArchiveStreamUtils::readUint64(cursor);
+					sf::Uint64 blobSize = StoryArchiveStreamUtils::readUint64(cursor);
+
+					cursor.validFlag =
+						cursor.validFlag &&
+						(blobOffset <= cursor.size) &&
+						(blobSize <= (cursor.size - blobOffset));
+
+					if (cursor.validFlag) {
+						StoryArchiveBlob blob;
+						blob.data = cursor.data + blobOffset;
+						blob.size = (size_t)blobSize;
+						this->blobMap[relativePath] = blob;
+					}
+				}
+
+				result = cursor.validFlag;
+			}
+
+			if (!result) {
+				this->blobMap.clear();
+				this->mappedFile.close();
+			}
+
+			return result;
+		}
+
+		bool StoryCampaignArchive::isOpen() const {
+			bool result = (this->mappedFile.getData() != nullptr);
+			return result;
+		}
+
+		bool StoryCampaignArchive::findBlob(const std::string& relativePath, StoryArchiveBlob& blob) const {
+			auto blobItr = this->blobMap.find(relativePath);
+
+			bool result = (blobItr != this->blobMap.end());
+			if (result) {
+				blob = blobItr->second;
+			}
+			return result;
+		}
+
+		size_t StoryCampaignArchive::getBlobCount() const {
+			return this->blobMap.size();
+		}
+
+		namespace StoryArchiveUtils {
+
+			std::string resolveArchiveFilePath(const std::string& campaignFolderName) {
+				std::string result(StoryLoaderUtils::PATH_CAMPAIGNS);
+				result.append(campaignFolderName);
+				result.append(StoryArchiveConstants::ARCHIVE_FILE_EXTENSION);
+				return result;
+			}
+
+			void setArchiveLookupEnabled(bool enabledFlag) {
+				StoryArchiveRegistry::registryMutex.lock();
+
+				StoryArchiveRegistry::lookupEnabledFlag = enabledFlag;
+
+				StoryArchiveRegistry::registryMutex.unlock();
+			}
+
+			bool readFile(const std::string& filePath, StoryFileContents& fileContents) {
+				fileContents.archivedBlob.data = nullptr;
+				fileContents.archivedBlob.size = 0;
+				fileContents.looseContents.clear();
+
+				// A packed campaign takes precedence; the loose folder is what development works against
+				bool result = StoryArchiveRegistry::findArchivedFile(filePath, fileContents.archivedBlob);
+				if (!result) {
+					std::ifstream inputStream(filePath, std::ios::binary | std::ios::ate);
+					result = inputStream.is_open();
+					if (result) {
+						std::streamsize fileSize = inputStream.tellg();
+						inputStream.seekg(0, std::ios::beg);
+
+						fileContents.looseContents.resize((size_t)fileSize);
+						result = (fileSize == 0) || (bool)inputStream.read(fileContents.looseContents.data(), fileSize);
+					}
+				}
+
+				return result;
+			}
+
+			bool readFileHeader(const std::string& filePath, size_t headerSize, StoryFileContents& fileContents) {
+				fileContents.archivedBlob.data = nullptr;
+				fileContents.archivedBlob.size = 0;
+				fileContents.looseContents.clear();
+
+				bool result = StoryArchiveRegistry::findArchivedFile(filePath, fileContents.archivedBlob);
+				if (result) {
+					fileContents.archivedBlob.size = std::min(fileContents.archivedBlob.size, headerSize);
+				}
+				else {
+					std::ifstream inputStream(filePath, std::ios::binary);
+					result = inputStream.is_open();
+					if (result) {
+						fileContents.looseContents.resize(headerSize);
+						inputStream.read(fileContents.looseContents.data(), headerSize);
+						fileContents.looseContents.resize((size_t)inputStream.gcount());
+					}
+				}
+
+				return result;
+			}
+
+			bool probeFileSize(const std::string& filePath, size_t& fileSize) {
+				StoryArchiveBlob blob;
+
+				bool result = StoryArchiveRegistry::findArchivedFile(filePath, blob);
+				if (result) {
+					fileSize = blob.size;
+				}
+				else {
+					std::ifstream inputStream(filePath, std::ios::binary | std::ios::ate);
+					result = inputStream.is_open();
+					if (result) {
+						fileSize = (size_t)inputStream.tellg();
+					}
+				}
+
+				return result;
+			}
+
+			bool openMusic(sf::Music& music, const std::string& filePath) {
+				StoryArchiveBlob blob;
+
+				bool result = false;
+				if (StoryArchiveRegistry::findArchivedFile(filePath, blob)) {
+					result = music.openFromMemory(blob.data, blob.size);
+				}
+				else {
+					result = music.openFromFile(filePath);
+				}
+				return result;
+			}
+
+			StoryPackCampaignResult packCampaign(const std::string& campaignFolderName) {
+				StoryPackCampaignResult result;
+				result.archiveFilePath = resolveArchiveFilePath(campaignFolderName);
+
+				// Always pack from the loose folder, even when an older archive sits beside it
+				setArchiveLookupEnabled(false);
+
+				LoadStoryCampaignResult loadCampaignResult = StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				result.campaignValid = loadCampaignResult.valid();
+				if (result.campaignValid) {
+					std::set<std::string> relativePathSet = StoryArchivePackUtils::resolveCampaignRelativePathSet(result, campaignFolderName, loadCampaignResult);
+					if (result.invalidMapFilenameList.empty()) {
+						result.archiveWritten = StoryArchivePackUtils::writeArchive(result, campaignFolderName, relativePathSet);
+					}
+				}
+				else {
+					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildErrorMessages(loadCampaignResult));
+				}
+
+				setArchiveLookupEnabled(true);
+
+				return result;
+			}
+
+			std::vector<std::string> buildPackMessages(const StoryPackCampaignResult& packResult) {
+				std::vector<std::string> result;
+
+				if (!packResult.campaignValid) {
+					result.push_back("The campaign could not be loaded, see log.txt for details");
+				}
+				else if (!packResult.invalidMapFilenameList.empty()) {
+					for (auto const& currMapFilename : packResult.invalidMapFilenameList) {
+						result.push_back("Map could not be loaded: " + currMapFilename);
+					}
+					result.push_back("See log.txt for details");
+				}
+				else if (!packResult.unreadableFilenameList.empty()) {
+					for (auto const& currFilename : packResult.unreadableFilenameList) {
+						result.push_back("File could not be read: " + currFilename);
+					}
+				}
+				else if (!packResult.archiveWritten) {
+					result.push_back("Could not write " + packResult.archiveFilePath);
+				}
+				else {
+					char message[512];
+					snprintf(message, sizeof(message), "Packed %d files into %s (%.1f MB)", packResult.blobCount, packResult.archiveFilePath.c_str(), (float)packResult.archiveBytes / (1024.0f * 1024.0f));
+					result.push_back(message);
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
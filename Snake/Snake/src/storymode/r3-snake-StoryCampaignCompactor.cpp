@@ -0,0 +1,407 @@
+
+#include <stdio.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "../jsoncpp/json/json.h"
+#include "../includes/r3-snake-storycompactor.hpp"
+#include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storymodescene.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryCampaignCompactorConstants {
+
+			const Json::ArrayIndex MIN_FOLDED_MOVE_COUNT = 2;
+			const char* PROPERTY_INDENT = "    ";
+
+		}
+
+		namespace StoryCampaignCompactorUtils {
+
+			typedef struct Snake_StoryTextReplacement {
+				size_t start;
+				size_t limit;
+				std::string text;
+			} StoryTextReplacement;
+
+			char resolvePathStep(const Json::Value& eventValue) {
+				const Json::Value& snakeMovementValue = eventValue[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_MOVEMENT];
+				std::string directionStr = snakeMovementValue[StoryLoaderUtils::StoryLevelProperties::SNAKE_START_DIRECTION].asString();
+				bool growFlag = snakeMovementValue[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_MOVEMENT_GROW].asBool();
+
+				char result = 0;
+				if (directionStr.compare(StoryLoaderUtils::DirectionValues::UP) == 0) {
+					result = growFlag ? StoryLoaderUtils::SnakePathStepValues::UP_GROW : StoryLoaderUtils::SnakePathStepValues::UP;
+				}
+				else if (directionStr.compare(StoryLoaderUtils::DirectionValues::DOWN) == 0) {
+					result = growFlag ? StoryLoaderUtils::SnakePathStepValues::DOWN_GROW : StoryLoaderUtils::SnakePathStepValues::DOWN;
+				}
+				else if (directionStr.compare(StoryLoaderUtils::DirectionValues::LEFT) == 0) {
+					result = growFlag ? StoryLoaderUtils::SnakePathStepValues::LEFT_GROW : StoryLoaderUtils::SnakePathStepValues::LEFT;
+				}
+				else if (directionStr.compare(StoryLoaderUtils::DirectionValues::RIGHT) == 0) {
+					result = growFlag ? StoryLoaderUtils::SnakePathStepValues::RIGHT_GROW : StoryLoaderUtils::SnakePathStepValues::RIGHT;
+				}
+				return result;
+			}
+
+			bool isFoldableMove(const Json::Value& eventValue) {
+				bool result =
+					eventValue.isObject() &&
+					eventValue[StoryLoaderUtils::StoryCutsceneProperties::EVENT_TYPE].isString() &&
+					(eventValue[StoryLoaderUtils::StoryCutsceneProperties::EVENT_TYPE].asString().compare(StoryLoaderUtils::CutsceneEventTypeValues::MOVE_SNAKE) == 0) &&
+					eventValue[StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT].isInt() &&
+					eventValue[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_MOVEMENT].isObject() &&
+					(resolvePathStep(eventValue) != 0);
+				return result;
+			}
+
+			// Every step after the first carries its own wait in the path string, so its wait must fit in a run
+			bool canContinuePath(const Json::Value& eventValue) {
+				bool result = isFoldableMove(eventValue);
+				if (result) {
+					int framesSinceLastEvent = eventValue[StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT].asInt();
+					result =
+						(framesSinceLastEvent >= 0) &&
+						(framesSinceLastEvent <= StoryLoaderUtils::SnakePathStepValues::MAX_RUN_VALUE);
+				}
+				return result;
+			}
+
+			// The wait shared by most steps becomes the event's framesPerStep, and only the other steps are written
+			// with a wait of their own
+			int resolveFramesPerStep(const std::vector<int>& stepFramesList) {
+				int result = stepFramesList[0];
+				int resultCount = 0;
+				for (size_t stepIndex = 1; stepIndex < stepFramesList.size(); stepIndex++) {
+					int currCount = (int)std::count(stepFramesList.begin() + 1, stepFramesList.end(), stepFramesList[stepIndex]);
+					if (currCount > resultCount) {
+						result = stepFramesList[stepIndex];
+						resultCount = currCount;
+					}
+				}
+				return result;
+			}
+
+			std::string resolveLineIndent(const std::string& campaignText, size_t offset) {
+				size_t lineStart = campaignText.rfind('\n', offset);
+				lineStart = (lineStart == std::string::npos) ? 0 : (lineStart + 1);
+
+				std::string result = campaignText.substr(lineStart, offset - lineStart);
+				if (result.find_first_not_of(" \t") != std::string::npos) {
+					result.clear();
+				}
+				return result;
+			}
+
+			std::string buildPathEventText(const Json::Value& eventListValue, Json::ArrayIndex firstEventIndex, Json::ArrayIndex endEventIndex, const std::string& indent) {
+				std::vector<int> stepFramesList;
+				std::string pathStr;
+				for (Json::ArrayIndex eventIndex = firstEventIndex; eventIndex < endEventIndex; eventIndex++) {
+					stepFramesList.push_back(eventListValue[eventIndex][StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT].asInt());
+				}
+
+				int framesPerStep = resolveFramesPerStep(stepFramesList);
+				for (Json::ArrayIndex eventIndex = firstEventIndex; eventIndex < endEventIndex; eventIndex++) {
+					int stepFrames = stepFramesList[eventIndex - firstEventIndex];
+					if ((eventIndex > firstEventIndex) && (stepFrames != framesPerStep)) {
+						pathStr.append(std::to_string(stepFrames));
+					}
+					pathStr.push_back(resolvePathStep(eventListValue[eventIndex]));
+				}
+
+				std::string propertyIndent = indent + StoryCampaignCompactorConstants::PROPERTY_INDENT;
+
+				std::string result("{\n");
+				result.append(propertyIndent + "\"" + StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT + "\": " + std::to_string(stepFramesList[0]) + ",\n");
+				result.append(propertyIndent + "\"" + StoryLoaderUtils::StoryCutsceneProperties::EVENT_TYPE + "\": " + Json::valueToQuotedString(StoryLoaderUtils::CutsceneEventTypeValues::MOVE_SNAKE_PATH) + ",\n");
+				if (framesPerStep != stepFramesList[0]) {
+					result.append(propertyIndent + "\"" + StoryLoaderUtils::StoryCutsceneProperties::SNAKE_PATH_FRAMES_PER_STEP + "\": " + std::to_string(framesPerStep) + ",\n");
+				}
+				result.append(propertyIndent + "\"" + StoryLoaderUtils::StoryCutsceneProperties::SNAKE_PATH + "\": " + Json::valueToQuotedString(pathStr.c_str()) + "\n");
+				result.append(indent + "}");
+				return result;
+			}
+
+			void addPathEventReplacements(const std::string& campaignText, const Json::Value& cutsceneValue, std::vector<StoryTextReplacement>& replacementList, StoryCompactCampaignResult& compactResult) {
+				const Json::Value& eventListValue = cutsceneValue[StoryLoaderUtils::StoryCutsceneProperties::EVENT_LIST];
+
+				Json::ArrayIndex eventIndex = 0;
+				while (eventListValue.isArray() && (eventIndex < eventListValue.size())) {
+					Json::ArrayIndex endEventIndex = eventIndex + 1;
+					if (isFoldableMove(eventListValue[eventIndex])) {
+						while ((endEventIndex < eventListValue.size()) && canContinuePath(eventListValue[endEventIndex])) {
+							endEventIndex++;
+						}
+					}
+
+					if ((endEventIndex - eventIndex) >= StoryCampaignCompactorConstants::MIN_FOLDED_MOVE_COUNT) {
+						StoryTextReplacement replacement;
+						replacement.start = (size_t)eventListValue[eventIndex].getOffsetStart();
+						replacement.limit = (size_t)eventListValue[endEventIndex - 1].getOffsetLimit();
+						replacement.text = buildPathEventText(eventListValue, eventIndex, endEventIndex, resolveLineIndent(campaignText, replacement.start));
+						replacementList.push_back(replacement);
+
+						compactResult.foldedMoveCount += (int)(endEventIndex - eventIndex);
+						compactResult.pathEventCount++;
+					}
+
+					eventIndex = endEventIndex;
+				}
+			}
+
+			std::string compactCampaignText(const std::string& campaignText, StoryCompactCampaignResult& compactResult) {
+				std::string result;
+
+				Json::Value campaignValue;
+				Json::Reader jsonReader(Json::Features::strictMode());
+				compactResult.campaignParsed =
+					jsonReader.parse(campaignText.data(), campaignText.data() + campaignText.size(), campaignValue) &&
+					campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST].isArray();
+
+				if (compactResult.campaignParsed) {
+					std::vector<StoryTextReplacement> replacementList;
+
+					const Json::Value& levelListValue = campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST];
+					for (Json::ArrayIndex levelIndex = 0; levelIndex < levelListValue.size(); levelIndex++) {
+						const Json::Value& levelValue = levelListValue[levelIndex];
+						if (levelValue.isObject()) {
+							addPathEventReplacements(campaignText, levelValue[StoryLoaderUtils::StoryLevelProperties::OPENING_CUTSCENE], replacementList, compactResult);
+							addPathEventReplacements(campaignText, levelValue[StoryLoaderUtils::StoryLevelProperties::WIN_CUTSCENE], replacementList, compactResult);
+							addPathEventReplacements(campaignText, levelValue[StoryLoaderUtils::StoryLevelProperties::LOSS_CUTSCENE], replacementList, compactResult);
+						}
+					}
+
+					// The cutscenes of a level need not appear in the file in the order they were visited
+					std::sort(replacementList.begin(), replacementList.end(), [](const StoryTextReplacement& a, const StoryTextReplacement& b) {
+						return a.start < b.start;
+					});
+
+					size_t copiedOffset = 0;
+					for (auto const& currReplacement : replacementList) {
+						result.append(campaignText, copiedOffset, currReplacement.start - copiedOffset);
+						result.append(currReplacement.text);
+						copiedOffset = currReplacement.limit;
+					}
+					result.append(campaignText, copiedOffset, std::string::npos);
+				}
+
+				return result;
+			}
+
+			bool screenViewsMatch(const std::vector<StoryCutsceneScreenView>& screenViewList, const std::vector<StoryCutsceneScreenView>& otherScreenViewList) {
+				bool result = (screenViewList.size() == otherScreenViewList.size());
+				for (size_t viewIndex = 0; result && (viewIndex < screenViewList.size()); viewIndex++) {
+					const StoryCutsceneScreenView& screenView = screenViewList[viewIndex];
+					const StoryCutsceneScreenView& otherScreenView = otherScreenViewList[viewIndex];
+					result =
+						(screenView.screenEventType == otherScreenView.screenEventType) &&
+						(screenView.fadeFrames == otherScreenView.fadeFrames) &&
+						(screenView.fadeFramesRemaining == otherScreenView.fadeFramesRemaining) &&
+						(screenView.color == otherScreenView.color) &&
+						(screenView.textureHandle == otherScreenView.textureHandle) &&
+						(screenView.mapHandle == otherScreenView.mapHandle);
+				}
+				return result;
+			}
+
+			bool snakeSegmentsMatch(const SnakeSegment& segment, const SnakeSegment& otherSegment) {
+				bool result =
+					(segment.segmentType == otherSegment.segmentType) &&
+					(segment.position == otherSegment.position) &&
+					(segment.enterDirection == otherSegment.enterDirection) &&
+					(segment.exitDirection == otherSegment.exitDirection);
+				return result;
+			}
+
+			bool snakesMatch(const Snake* snake, const Snake* otherSnake) {
+				bool result = ((snake == nullptr) == (otherSnake == nullptr));
+				if (result && (snake != nullptr)) {
+					result =
+						(snake->getBodyLength() == otherSnake->getBodyLength()) &&
+						snakeSegmentsMatch(snake->getHead(), otherSnake->getHead()) &&
+						snakeSegmentsMatch(snake->getTail(), otherSnake->getTail());
+					for (int segmentIndex = 0; result && (segmentIndex < snake->getBodyLength()); segmentIndex++) {
+						result = snakeSegmentsMatch(snake->getBody(segmentIndex), otherSnake->getBody(segmentIndex));
+					}
+				}
+				return result;
+			}
+
+			bool foodInstancesMatch(const SlotMap<StoryFoodInstance>& foodSlotMap, const SlotMap<StoryFoodInstance>& otherFoodSlotMap) {
+				std::vector<const StoryFoodInstance*> otherFoodInstanceList;
+				for (auto const& currFoodInstance : otherFoodSlotMap) {
+					otherFoodInstanceList.push_back(&currFoodInstance);
+				}
+
+				bool result = true;
+				size_t foodIndex = 0;
+				for (auto const& currFoodInstance : foodSlotMap) {
+					result =
+						result &&
+						(foodIndex < otherFoodInstanceList.size()) &&
+						(currFoodInstance.foodInstanceId == otherFoodInstanceList[foodIndex]->foodInstanceId) &&
+						(currFoodInstance.foodType == otherFoodInstanceList[foodIndex]->foodType) &&
+						(currFoodInstance.position == otherFoodInstanceList[foodIndex]->position);
+					foodIndex++;
+				}
+				result = result && (foodIndex == otherFoodInstanceList.size());
+				return result;
+			}
+
+			bool dangerInstancesMatch(const SlotMap<StoryDangerInstance>& dangerSlotMap, const SlotMap<StoryDangerInstance>& otherDangerSlotMap) {
+				std::vector<const StoryDangerInstance*> otherDangerInstanceList;
+				for (auto const& currDangerInstance : otherDangerSlotMap) {
+					otherDangerInstanceList.push_back(&currDangerInstance);
+				}
+
+				bool result = true;
+				size_t dangerIndex = 0;
+				for (auto const& currDangerInstance : dangerSlotMap) {
+					result =
+						result &&
+						(dangerIndex < otherDangerInstanceList.size()) &&
+						(currDangerInstance.dangerInstanceId == otherDangerInstanceList[dangerIndex]->dangerInstanceId) &&
+						(currDangerInstance.dangerType == otherDangerInstanceList[dangerIndex]->dangerType) &&
+						(currDangerInstance.position == otherDangerInstanceList[dangerIndex]->position);
+					dangerIndex++;
+				}
+				result = result && (dangerIndex == otherDangerInstanceList.size());
+				return result;
+			}
+
+			// Both cutscenes are stepped one frame at a time until both have run out of events, and must finish on
+			// the same frame
+			bool playCutscenesSideBySide(const StoryCutsceneDefn& cutsceneDefn, const StoryCutsceneDefn& otherCutsceneDefn, int& frame) {
+				StoryCutscene cutscene(cutsceneDefn);
+				StoryCutscene otherCutscene(otherCutsceneDefn);
+
+				bool result = (cutsceneDefn.existsFlag == otherCutsceneDefn.existsFlag);
+				bool doneFlag = !cutsceneDefn.existsFlag;
+
+				frame = 0;
+				while (result && !doneFlag) {
+					frame++;
+					doneFlag = cutscene.advanceToFrame(frame);
+					bool otherDoneFlag = otherCutscene.advanceToFrame(frame);
+
+					result =
+						(doneFlag == otherDoneFlag) &&
+						screenViewsMatch(cutscene.getActiveScreenViewList(), otherCutscene.getActiveScreenViewList()) &&
+						snakesMatch(cutscene.getSnake(), otherCutscene.getSnake()) &&
+						foodInstancesMatch(cutscene.getFoodSlotMap(), otherCutscene.getFoodSlotMap()) &&
+						dangerInstancesMatch(cutscene.getDangerSlotMap(), otherCutscene.getDangerSlotMap());
+				}
+
+				return result;
+			}
+
+			bool parseLevelList(const std::string& campaignText, Json::Value& campaignValue) {
+				Json::Reader jsonReader(Json::Features::strictMode());
+				bool result =
+					jsonReader.parse(campaignText.data(), campaignText.data() + campaignText.size(), campaignValue) &&
+					campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST].isArray();
+				return result;
+			}
+
+			void compareCampaignTexts(const std::string& campaignFolderName, const std::string& campaignText, const std::string& compactText, StoryCompactCampaignResult& compactResult) {
+				Json::Value campaignValue;
+				Json::Value compactValue;
+				compactResult.levelsValid =
+					parseLevelList(campaignText, campaignValue) &&
+					parseLevelList(compactText, compactValue) &&
+					(campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST].size() == compactValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST].size());
+				compactResult.cutscenesMatch = compactResult.levelsValid;
+
+				const Json::Value& levelListValue = campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST];
+				const Json::Value& compactLevelListValue = compactValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST];
+				for (Json::ArrayIndex levelIndex = 0; compactResult.levelsValid && compactResult.cutscenesMatch && (levelIndex < levelListValue.size()); levelIndex++) {
+					LoadStoryLevelResult levelResult = StoryLoaderUtils::loadStoryLevel(campaignFolderName, levelListValue[levelIndex]);
+					LoadStoryLevelResult compactLevelResult = StoryLoaderUtils::loadStoryLevel(campaignFolderName, compactLevelListValue[levelIndex]);
+					compactResult.levelsValid = levelResult.validationResult.valid() && compactLevelResult.validationResult.valid();
+
+					const StoryCutsceneDefn* cutsceneDefnList[] = { &levelResult.levelDefn.openingCutsceneDefn, &levelResult.levelDefn.winCutsceneDefn, &levelResult.levelDefn.lossCutsceneDefn };
+					const StoryCutsceneDefn* compactCutsceneDefnList[] = { &compactLevelResult.levelDefn.openingCutsceneDefn, &compactLevelResult.levelDefn.winCutsceneDefn, &compactLevelResult.levelDefn.lossCutsceneDefn };
+					for (int cutsceneIndex = 0; compactResult.levelsValid && compactResult.cutscenesMatch && (cutsceneIndex < 3); cutsceneIndex++) {
+						int frame = 0;
+						compactResult.cutscenesMatch = playCutscenesSideBySide(*cutsceneDefnList[cutsceneIndex], *compactCutsceneDefnList[cutsceneIndex], frame);
+						compactResult.comparedFrameCount += frame;
+						if (cutsceneDefnList[cutsceneIndex]->existsFlag) {
+							compactResult.cutsceneCount++;
+						}
+
+						if (!compactResult.cutscenesMatch) {
+							compactResult.firstMismatchLevelIndex = (int)levelIndex;
+							compactResult.firstMismatchFrame = frame;
+						}
+					}
+				}
+			}
+
+			StoryCompactCampaignResult compactCampaign(const std::string& campaignFolderName) {
+				StoryCompactCampaignResult result;
+
+				std::string campaignFilePath = StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName);
+				std::ifstream campaignStream(campaignFilePath, std::ios_base::binary);
+				std::string campaignText((std::istreambuf_iterator<char>(campaignStream)), std::istreambuf_iterator<char>());
+				campaignStream.close();
+				result.verboseBytes = campaignText.size();
+
+				std::string compactText = compactCampaignText(campaignText, result);
+				result.compactBytes = compactText.size();
+
+				if (result.campaignParsed) {
+					compareCampaignTexts(campaignFolderName, campaignText, compactText, result);
+				}
+
+				if (result.campaignParsed && result.levelsValid && result.cutscenesMatch) {
+					std::ofstream compactStream(campaignFilePath, std::ios_base::binary | std::ios_base::trunc);
+					compactStream.write(compactText.data(), compactText.size());
+					compactStream.close();
+					result.fileWritten = !compactStream.fail();
+				}
+
+				return result;
+			}
+
+			std::vector<std::string> buildCompactMessages(const StoryCompactCampaignResult& compactResult) {
+				std::vector<std::string> result;
+
+				char message[256];
+
+				if (!compactResult.campaignParsed) {
+					result.push_back("campaign.json could not be read or parsed");
+				}
+				else {
+					snprintf(message, sizeof(message), "Folded %d moveSnake events into %d moveSnakePath events", compactResult.foldedMoveCount, compactResult.pathEventCount);
+					result.push_back(message);
+
+					snprintf(message, sizeof(message), "campaign.json: %.1f KB -> %.1f KB", (float)compactResult.verboseBytes / 1024.0f, (float)compactResult.compactBytes / 1024.0f);
+					result.push_back(message);
+
+					if (!compactResult.levelsValid) {
+						result.push_back("A level did not validate before or after compacting");
+					}
+					else if (!compactResult.cutscenesMatch) {
+						snprintf(message, sizeof(message), "Level %d plays differently from frame %d", compactResult.firstMismatchLevelIndex + 1, compactResult.firstMismatchFrame);
+						result.push_back(message);
+					}
+					else {
+						snprintf(message, sizeof(message), "%d cutscenes played the same on all %d frames", compactResult.cutsceneCount, compactResult.comparedFrameCount);
+						result.push_back(message);
+					}
+
+					result.push_back(compactResult.fileWritten ? "campaign.json written" : "campaign.json left unchanged");
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,619 @@
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include "../jsoncpp/json/json.h"
+#include "../includes/r3-snake-storybenchmark.hpp"
+#include "../includes/r3-snake-storyloader.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryCampaignGeneratorConstants {
+
+			const int DEFAULT_LEVEL_COUNT = 50;
+			const int DEFAULT_MAP_WIDTH = 200;
+			const int DEFAULT_MAP_HEIGHT = 100;
+			const int DEFAULT_OPENING_CUTSCENE_EVENT_COUNT = 10000;
+			const int DEFAULT_ENDING_CUTSCENE_EVENT_COUNT = 100;
+
+			const int MIN_MAP_WIDTH = 16;
+			const int MIN_MAP_HEIGHT = 12;
+			const int MIN_CUTSCENE_EVENT_COUNT = 3;
+			const int MAX_TILE_DEFN_COUNT = 99;
+
+			const int TILE_TEXTURE_SIZE = 32;
+			const int CUTSCENE_TEXTURE_SIZE = 64;
+			const int BARRIER_CHANCE_PCT = 3;
+			const int CLEAR_RADIUS_X = 6;
+			const int CLEAR_RADIUS_Y = 4;
+			const int CUTSCENE_EVENT_CYCLE_LENGTH = 16;
+
+			const unsigned int SOUND_SAMPLE_RATE = 22050;
+			const float SOUND_SECONDS = 0.5f;
+			const float MUSIC_SECONDS = 2.0f;
+
+			const char* MENU_DESCRIPTION = "A generated campaign for measuring the story loader.";
+			const char* FLOOR_TEXTURE_PREFIX = "generated-floor-";
+			const char* BARRIER_TEXTURE_PREFIX = "generated-barrier-";
+			const char* CUTSCENE_TEXTURE_FILENAME = "generated-cutscene.png";
+			const char* SOUND_FILENAME = "generated-sound.wav";
+			const char* MUSIC_FILENAME = "generated-music.wav";
+			const char* MAP_FILENAME_PREFIX = "map-level-";
+
+		}
+
+		namespace StoryCampaignGeneratorUtils {
+
+			const char* FOOD_TYPE_LIST[] = {
+				StoryLoaderUtils::FoodTypeValues::APPLE,
+				StoryLoaderUtils::FoodTypeValues::CARROT,
+				StoryLoaderUtils::FoodTypeValues::GREEN_APPLE,
+				StoryLoaderUtils::FoodTypeValues::CHILI_PEPPER,
+				StoryLoaderUtils::FoodTypeValues::CHERRIES,
+				StoryLoaderUtils::FoodTypeValues::ORANGE,
+				StoryLoaderUtils::FoodTypeValues::PEAR,
+				StoryLoaderUtils::FoodTypeValues::BANANA,
+			};
+
+			const char* FOOD_SPAWN_TYPE_LIST[] = {
+				StoryLoaderUtils::SpawnTypeValues::ON_TIMER,
+				StoryLoaderUtils::SpawnTypeValues::ON_LENGTH_REACHED,
+				StoryLoaderUtils::SpawnTypeValues::ON_HEALTH_FELL,
+				StoryLoaderUtils::SpawnTypeValues::ON_SNAKE_POSITION,
+				StoryLoaderUtils::SpawnTypeValues::ON_FOOD_EATEN,
+				StoryLoaderUtils::SpawnTypeValues::ON_DESPAWN,
+			};
+
+			const int FOOD_TYPE_COUNT = sizeof(FOOD_TYPE_LIST) / sizeof(FOOD_TYPE_LIST[0]);
+			const int FOOD_SPAWN_TYPE_COUNT = sizeof(FOOD_SPAWN_TYPE_LIST) / sizeof(FOOD_SPAWN_TYPE_LIST[0]);
+
+			bool createFolder(const std::string& folderPath) {
+#ifdef _WIN32
+				int mkdirResult = _mkdir(folderPath.c_str());
+#else
+				int mkdirResult = mkdir(folderPath.c_str(), 0755);
+#endif
+				bool result = (mkdirResult == 0) || (errno == EEXIST);
+				return result;
+			}
+
+			std::string resolveFolderPath(const std::string& filePath) {
+				std::string result = filePath.substr(0, filePath.find_last_of('/'));
+				return result;
+			}
+
+			std::string buildNumberedFilename(const char* prefix, int number, const char* extension) {
+				char filename[256];
+				snprintf(filename, sizeof(filename), "%s%03d%s", prefix, number, extension);
+
+				std::string result(filename);
+				return result;
+			}
+
+			std::string buildMapFilename(int levelIndex) {
+				return buildNumberedFilename(StoryCampaignGeneratorConstants::MAP_FILENAME_PREFIX, levelIndex + 1, "");
+			}
+
+			sf::Vector2i resolveCenterPosition(const StoryCampaignGeneratorOptions& options) {
+				sf::Vector2i result(options.mapSize.x / 2, options.mapSize.y / 2);
+				return result;
+			}
+
+			StoryCampaignGeneratorOptions clampOptions(const StoryCampaignGeneratorOptions& options) {
+				StoryCampaignGeneratorOptions result = options;
+				result.levelCount = std::max(1, options.levelCount);
+				result.mapSize.x = std::min(std::max(StoryCampaignGeneratorConstants::MIN_MAP_WIDTH, options.mapSize.x), StoryLoaderUtils::LoadStoryMapValidation::MAX_WIDTH);
+				result.mapSize.y = std::min(std::max(StoryCampaignGeneratorConstants::MIN_MAP_HEIGHT, options.mapSize.y), StoryLoaderUtils::LoadStoryMapValidation::MAX_HEIGHT);
+				result.floorDefnCount = std::min(std::max(1, options.floorDefnCount), StoryCampaignGeneratorConstants::MAX_TILE_DEFN_COUNT);
+				result.barrierDefnCount = std::min(std::max(1, options.barrierDefnCount), StoryCampaignGeneratorConstants::MAX_TILE_DEFN_COUNT);
+				result.foodDefnCount = std::max(1, options.foodDefnCount);
+				result.dangerDefnCount = std::max(0, options.dangerDefnCount);
+				result.openingCutsceneEventCount = std::max(StoryCampaignGeneratorConstants::MIN_CUTSCENE_EVENT_COUNT, options.openingCutsceneEventCount);
+				result.endingCutsceneEventCount = std::max(StoryCampaignGeneratorConstants::MIN_CUTSCENE_EVENT_COUNT, options.endingCutsceneEventCount);
+				return result;
+			}
+
+			void writeTextFile(const std::string& filePath, const std::string& text, StoryGenerateCampaignResult& generateResult) {
+				std::ofstream textStream(filePath, std::ios_base::binary | std::ios_base::trunc);
+				textStream.write(text.data(), text.size());
+				if (textStream.good()) {
+					generateResult.jsonBytes += text.size();
+				}
+				else {
+					generateResult.failedFilenameList.push_back(filePath);
+				}
+			}
+
+			void writeImageFile(const std::string& filePath, int size, const sf::Color& color, StoryGenerateCampaignResult& generateResult) {
+				sf::Image image;
+				image.create(size, size, color);
+				if (!image.saveToFile(filePath)) {
+					generateResult.failedFilenameList.push_back(filePath);
+				}
+			}
+
+			void writeSoundFile(const std::string& filePath, float seconds, StoryGenerateCampaignResult& generateResult) {
+				std::vector<sf::Int16> sampleList((size_t)(seconds * (float)StoryCampaignGeneratorConstants::SOUND_SAMPLE_RATE), 0);
+
+				sf::OutputSoundFile soundFile;
+				if (soundFile.openFromFile(filePath, StoryCampaignGeneratorConstants::SOUND_SAMPLE_RATE, 1)) {
+					soundFile.write(sampleList.data(), sampleList.size());
+				}
+				else {
+					generateResult.failedFilenameList.push_back(filePath);
+				}
+			}
+
+			sf::Color buildTileColor(std::default_random_engine& randomizer) {
+				std::uniform_int_distribution<int> channelDistribution(0, 255);
+
+				sf::Color result(channelDistribution(randomizer), channelDistribution(randomizer), channelDistribution(randomizer));
+				return result;
+			}
+
+			void writeAssetFiles(const std::string& campaignFolderName, const StoryCampaignGeneratorOptions& options, std::default_random_engine& randomizer, StoryGenerateCampaignResult& generateResult) {
+				for (int floorId = 0; floorId < options.floorDefnCount; floorId++) {
+					std::string filename = buildNumberedFilename(StoryCampaignGeneratorConstants::FLOOR_TEXTURE_PREFIX, floorId, ".png");
+					writeImageFile(StoryLoaderUtils::resolveImageFilePath(campaignFolderName, filename), StoryCampaignGeneratorConstants::TILE_TEXTURE_SIZE, buildTileColor(randomizer), generateResult);
+				}
+
+				for (int barrierId = 1; barrierId <= options.barrierDefnCount; barrierId++) {
+					std::string filename = buildNumberedFilename(StoryCampaignGeneratorConstants::BARRIER_TEXTURE_PREFIX, barrierId, ".png");
+					writeImageFile(StoryLoaderUtils::resolveImageFilePath(campaignFolderName, filename), StoryCampaignGeneratorConstants::TILE_TEXTURE_SIZE, buildTileColor(randomizer), generateResult);
+				}
+
+				writeImageFile(StoryLoaderUtils::resolveImageFilePath(campaignFolderName, StoryCampaignGeneratorConstants::CUTSCENE_TEXTURE_FILENAME), StoryCampaignGeneratorConstants::CUTSCENE_TEXTURE_SIZE, sf::Color::Black, generateResult);
+				writeSoundFile(StoryLoaderUtils::resolveSoundFilePath(campaignFolderName, StoryCampaignGeneratorConstants::SOUND_FILENAME), StoryCampaignGeneratorConstants::SOUND_SECONDS, generateResult);
+				writeSoundFile(StoryLoaderUtils::resolveMusicFilePath(campaignFolderName, StoryCampaignGeneratorConstants::MUSIC_FILENAME), StoryCampaignGeneratorConstants::MUSIC_SECONDS, generateResult);
+			}
+
+			void appendTileList(std::string& text, const char* propertyName, const char* filenamePrefix, int firstTileId, int tileCount) {
+				text.append("    \"").append(propertyName).append("\": [\n");
+				for (int tileIndex = 0; tileIndex < tileCount; tileIndex++) {
+					int tileId = firstTileId + tileIndex;
+
+					char tileText[256];
+					snprintf(tileText, sizeof(tileText), "        { \"%s\": %d, \"%s\": \"%s\" }%s\n",
+						StoryLoaderUtils::StoryMapProperties::TILE_ID, tileId,
+						StoryLoaderUtils::StoryMapProperties::TILE_FILENAME, buildNumberedFilename(filenamePrefix, tileId, ".png").c_str(),
+						(tileIndex + 1 < tileCount) ? "," : "");
+					text.append(tileText);
+				}
+				text.append("    ],\n");
+			}
+
+			void appendTileGrid(std::string& text, const char* propertyName, const std::vector<int>& tileGrid, const sf::Vector2i& mapSize, bool lastFlag) {
+				text.append("    \"").append(propertyName).append("\": [\n");
+				for (int y = 0; y < mapSize.y; y++) {
+					text.append("        [ ");
+					for (int x = 0; x < mapSize.x; x++) {
+						text.append(std::to_string(tileGrid[y * mapSize.x + x]));
+						text.append((x + 1 < mapSize.x) ? ", " : " ");
+					}
+					text.append((y + 1 < mapSize.y) ? "],\n" : "]\n");
+				}
+				text.append(lastFlag ? "    ]\n" : "    ],\n");
+			}
+
+			// The edge of the map is walled in and the middle is kept clear for the snake and the cutscenes
+			std::string buildMapText(const StoryCampaignGeneratorOptions& options, std::default_random_engine& randomizer) {
+				std::uniform_int_distribution<int> floorDistribution(0, options.floorDefnCount - 1);
+				std::uniform_int_distribution<int> barrierDistribution(1, options.barrierDefnCount);
+				std::uniform_int_distribution<int> chanceDistribution(0, 99);
+
+				sf::Vector2i centerPosition = resolveCenterPosition(options);
+
+				std::vector<int> floorGrid(options.mapSize.x * options.mapSize.y);
+				std::vector<int> barrierGrid(options.mapSize.x * options.mapSize.y);
+				for (int y = 0; y < options.mapSize.y; y++) {
+					for (int x = 0; x < options.mapSize.x; x++) {
+						bool edgeFlag = (x == 0) || (y == 0) || (x == options.mapSize.x - 1) || (y == options.mapSize.y - 1);
+						bool clearFlag =
+							(abs(x - centerPosition.x) <= StoryCampaignGeneratorConstants::CLEAR_RADIUS_X) &&
+							(abs(y - centerPosition.y) <= StoryCampaignGeneratorConstants::CLEAR_RADIUS_Y);
+
+						floorGrid[y * options.mapSize.x + x] = floorDistribution(randomizer);
+						if (edgeFlag || (!clearFlag && (chanceDistribution(randomizer) < StoryCampaignGeneratorConstants::BARRIER_CHANCE_PCT))) {
+							barrierGrid[y * options.mapSize.x + x] = barrierDistribution(randomizer);
+						}
+					}
+				}
+
+				std::string result;
+				result.reserve(floorGrid.size() * 8);
+
+				result.append("{\n");
+				result.append("    \"").append(StoryLoaderUtils::StoryMapProperties::WIDTH).append("\": ").append(std::to_string(options.mapSize.x)).append(",\n");
+				result.append("    \"").append(StoryLoaderUtils::StoryMapProperties::HEIGHT).append("\": ").append(std::to_string(options.mapSize.y)).append(",\n");
+				appendTileList(result, StoryLoaderUtils::StoryMapProperties::FLOOR_LIST, StoryCampaignGeneratorConstants::FLOOR_TEXTURE_PREFIX, 0, options.floorDefnCount);
+				appendTileList(result, StoryLoaderUtils::StoryMapProperties::BARRIER_LIST, StoryCampaignGeneratorConstants::BARRIER_TEXTURE_PREFIX, 1, options.barrierDefnCount);
+				appendTileGrid(result, StoryLoaderUtils::StoryMapProperties::FLOOR_GRID, floorGrid, options.mapSize, false);
+				appendTileGrid(result, StoryLoaderUtils::StoryMapProperties::BARRIER_GRID, barrierGrid, options.mapSize, true);
+				result.append("}\n");
+
+				return result;
+			}
+
+			Json::Value buildPositionValue(int x, int y) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::POSITION_X] = x;
+				result[StoryLoaderUtils::StoryLevelProperties::POSITION_Y] = y;
+				return result;
+			}
+
+			Json::Value buildSnakeStartValue(const sf::Vector2i& position) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::POSITION] = buildPositionValue(position.x, position.y);
+				result[StoryLoaderUtils::StoryLevelProperties::SNAKE_START_DIRECTION] = StoryLoaderUtils::DirectionValues::RIGHT;
+				result[StoryLoaderUtils::StoryLevelProperties::SNAKE_START_LENGTH] = 3;
+				return result;
+			}
+
+			Json::Value buildRegionValue(int left, int top, int width, int height) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::REGION_LEFT] = left;
+				result[StoryLoaderUtils::StoryLevelProperties::REGION_TOP] = top;
+				result[StoryLoaderUtils::StoryLevelProperties::REGION_WIDTH] = width;
+				result[StoryLoaderUtils::StoryLevelProperties::REGION_HEIGHT] = height;
+				return result;
+			}
+
+			Json::Value buildFloorIdRangeValue(const StoryCampaignGeneratorOptions& options) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_FLOOR_MIN_ID] = 0;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_FLOOR_MAX_ID] = options.floorDefnCount - 1;
+				return result;
+			}
+
+			// The first food is always an apple that respawns when eaten, so every level can be won
+			Json::Value buildFoodValue(const StoryCampaignGeneratorOptions& options, int foodIndex) {
+				const char* spawnType = StoryLoaderUtils::SpawnTypeValues::ON_DESPAWN;
+				if (foodIndex > 0) {
+					spawnType = FOOD_SPAWN_TYPE_LIST[(foodIndex - 1) % FOOD_SPAWN_TYPE_COUNT];
+				}
+
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::FOOD_TYPE] = FOOD_TYPE_LIST[foodIndex % FOOD_TYPE_COUNT];
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_SPAWN_TYPE] = spawnType;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_CHANCE_PCT] = (foodIndex == 0) ? 100 : 50;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_MAX_SPAWN_COUNT] = 100;
+				result[StoryLoaderUtils::StoryLevelProperties::FOOD_GROWTH_RATE] = 1 + (foodIndex % 3);
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_FLOOR_ID_RANGE] = buildFloorIdRangeValue(options);
+
+				std::string spawnTypeString(spawnType);
+				if (spawnTypeString.compare(StoryLoaderUtils::SpawnTypeValues::ON_TIMER) == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::TIME_PASSED] = 10 + foodIndex;
+					result[StoryLoaderUtils::StoryLevelProperties::INTERVAL] = 5;
+				}
+				else if (spawnTypeString.compare(StoryLoaderUtils::SpawnTypeValues::ON_LENGTH_REACHED) == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::OBJECT_LENGTH_REACHED] = 5 + foodIndex;
+				}
+				else if (spawnTypeString.compare(StoryLoaderUtils::SpawnTypeValues::ON_HEALTH_FELL) == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::FOOD_HEALTH] = 2;
+				}
+				else if (spawnTypeString.compare(StoryLoaderUtils::SpawnTypeValues::ON_SNAKE_POSITION) == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::REGION] = buildRegionValue(1, 1, options.mapSize.x / 4, options.mapSize.y / 4);
+				}
+				else if (spawnTypeString.compare(StoryLoaderUtils::SpawnTypeValues::ON_FOOD_EATEN) == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::EATEN_FOOD_TYPE] = StoryLoaderUtils::FoodTypeValues::APPLE;
+					result[StoryLoaderUtils::StoryLevelProperties::EATEN_FOOD_COUNT] = 5;
+				}
+
+				return result;
+			}
+
+			Json::Value buildDangerValue(const StoryCampaignGeneratorOptions& options, int dangerIndex) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::DANGER_TYPE] = StoryLoaderUtils::DangerTypeValues::SPIKE_TRAP;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_CHANCE_PCT] = 50;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_MAX_SPAWN_COUNT] = 100;
+				result[StoryLoaderUtils::StoryLevelProperties::OBJECT_FLOOR_ID_RANGE] = buildFloorIdRangeValue(options);
+				result[StoryLoaderUtils::StoryLevelProperties::INTERVAL] = 6;
+
+				if (dangerIndex % 2 == 0) {
+					result[StoryLoaderUtils::StoryLevelProperties::OBJECT_SPAWN_TYPE] = StoryLoaderUtils::SpawnTypeValues::ON_TIMER;
+					result[StoryLoaderUtils::StoryLevelProperties::TIME_PASSED] = 20 + dangerIndex;
+				}
+				else {
+					result[StoryLoaderUtils::StoryLevelProperties::OBJECT_SPAWN_TYPE] = StoryLoaderUtils::SpawnTypeValues::ON_SNAKE_POSITION;
+					result[StoryLoaderUtils::StoryLevelProperties::REGION] = buildRegionValue(options.mapSize.x / 2, 1, options.mapSize.x / 4, options.mapSize.y / 4);
+				}
+
+				return result;
+			}
+
+			Json::Value buildSoundFxListValue() {
+				Json::Value soundFxValue(Json::objectValue);
+				soundFxValue[StoryLoaderUtils::StoryLevelProperties::SOUND_FX_TRIGGER_TYPE] = StoryLoaderUtils::SoundTriggerTypeValues::ON_TIMER;
+				soundFxValue[StoryLoaderUtils::StoryLevelProperties::SOUND_FILENAME] = StoryCampaignGeneratorConstants::SOUND_FILENAME;
+				soundFxValue[StoryLoaderUtils::StoryLevelProperties::TIME_PASSED] = 2;
+
+				Json::Value result(Json::arrayValue);
+				result.append(soundFxValue);
+				return result;
+			}
+
+			Json::Value buildEventValue(int framesSinceLastEvent, const char* eventType) {
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT] = framesSinceLastEvent;
+				result[StoryLoaderUtils::StoryCutsceneProperties::EVENT_TYPE] = eventType;
+				return result;
+			}
+
+			Json::Value buildMoveSnakeEventValue(const char* direction) {
+				Json::Value snakeMovementValue(Json::objectValue);
+				snakeMovementValue[StoryLoaderUtils::StoryLevelProperties::SNAKE_START_DIRECTION] = direction;
+				snakeMovementValue[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_MOVEMENT_GROW] = false;
+
+				Json::Value result = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::MOVE_SNAKE);
+				result[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_MOVEMENT] = snakeMovementValue;
+				return result;
+			}
+
+			Json::Value buildShowObjectEventValue(const char* eventType, const char* typePropertyName, const char* objectType, int instanceId, const sf::Vector2i& position) {
+				Json::Value showObjectValue(Json::objectValue);
+				showObjectValue[StoryLoaderUtils::StoryCutsceneProperties::OBJECT_INSTANCE_ID] = instanceId;
+				showObjectValue[typePropertyName] = objectType;
+				showObjectValue[StoryLoaderUtils::StoryLevelProperties::POSITION] = buildPositionValue(position.x, position.y);
+
+				Json::Value result = buildEventValue(10, eventType);
+				result[StoryLoaderUtils::StoryCutsceneProperties::SHOW_OBJECT] = showObjectValue;
+				return result;
+			}
+
+			Json::Value buildHideObjectEventValue(const char* eventType, int instanceId) {
+				Json::Value hideObjectValue(Json::objectValue);
+				hideObjectValue[StoryLoaderUtils::StoryCutsceneProperties::OBJECT_INSTANCE_ID] = instanceId;
+
+				Json::Value result = buildEventValue(10, eventType);
+				result[StoryLoaderUtils::StoryCutsceneProperties::HIDE_OBJECT] = hideObjectValue;
+				return result;
+			}
+
+			Json::Value buildColorEventValue(std::default_random_engine& randomizer) {
+				sf::Color color = buildTileColor(randomizer);
+
+				Json::Value colorValue(Json::objectValue);
+				colorValue[StoryLoaderUtils::StoryCutsceneProperties::COLOR_RED] = color.r;
+				colorValue[StoryLoaderUtils::StoryCutsceneProperties::COLOR_GREEN] = color.g;
+				colorValue[StoryLoaderUtils::StoryCutsceneProperties::COLOR_BLUE] = color.b;
+
+				Json::Value result = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::COLOR);
+				result[StoryLoaderUtils::StoryCutsceneProperties::FADE_FRAMES] = 10;
+				result[StoryLoaderUtils::StoryCutsceneProperties::COLOR] = colorValue;
+				return result;
+			}
+
+			Json::Value buildShowMapEventValue(const std::string& mapFilename) {
+				Json::Value result = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::SHOW_MAP);
+				result[StoryLoaderUtils::StoryCutsceneProperties::FADE_FRAMES] = 10;
+				result[StoryLoaderUtils::StoryLevelProperties::MAP_FILENAME] = mapFilename;
+				return result;
+			}
+
+			// After the opening events, a cycle of events repeats: the snake walks a closed loop around the middle
+			// of the map, food and dangers come and go beside it, and the screen changes colour and texture
+			Json::Value buildCutsceneEventValue(const StoryCampaignGeneratorOptions& options, const std::string& mapFilename, int eventIndex, std::default_random_engine& randomizer) {
+				sf::Vector2i centerPosition = resolveCenterPosition(options);
+				int instanceId = 1 + (eventIndex / StoryCampaignGeneratorConstants::CUTSCENE_EVENT_CYCLE_LENGTH);
+
+				Json::Value result;
+				switch (eventIndex % StoryCampaignGeneratorConstants::CUTSCENE_EVENT_CYCLE_LENGTH) {
+				case 0:
+				case 1:
+					result = buildMoveSnakeEventValue(StoryLoaderUtils::DirectionValues::RIGHT);
+					break;
+				case 2:
+				case 3:
+					result = buildMoveSnakeEventValue(StoryLoaderUtils::DirectionValues::DOWN);
+					break;
+				case 4:
+				case 5:
+					result = buildMoveSnakeEventValue(StoryLoaderUtils::DirectionValues::LEFT);
+					break;
+				case 6:
+				case 7:
+					result = buildMoveSnakeEventValue(StoryLoaderUtils::DirectionValues::UP);
+					break;
+				case 8:
+					result = buildShowObjectEventValue(StoryLoaderUtils::CutsceneEventTypeValues::SHOW_FOOD, StoryLoaderUtils::StoryLevelProperties::FOOD_TYPE, FOOD_TYPE_LIST[instanceId % FOOD_TYPE_COUNT], instanceId, centerPosition + sf::Vector2i(4, 0));
+					break;
+				case 9:
+					result = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::MOVE_SNAKE_PATH);
+					result[StoryLoaderUtils::StoryCutsceneProperties::SNAKE_PATH] = "RRDDLLUU";
+					break;
+				case 10:
+					result = buildHideObjectEventValue(StoryLoaderUtils::CutsceneEventTypeValues::HIDE_FOOD, instanceId);
+					break;
+				case 11:
+					result = buildShowObjectEventValue(StoryLoaderUtils::CutsceneEventTypeValues::SHOW_DANGER, StoryLoaderUtils::StoryLevelProperties::DANGER_TYPE, StoryLoaderUtils::DangerTypeValues::SPIKE_TRAP, instanceId, centerPosition + sf::Vector2i(-3, 0));
+					break;
+				case 12:
+					result = buildHideObjectEventValue(StoryLoaderUtils::CutsceneEventTypeValues::HIDE_DANGER, instanceId);
+					break;
+				case 13:
+					result = buildColorEventValue(randomizer);
+					break;
+				case 14:
+					result = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::TEXTURE);
+					result[StoryLoaderUtils::StoryCutsceneProperties::FADE_FRAMES] = 10;
+					result[StoryLoaderUtils::StoryCutsceneProperties::TEXTURE] = StoryCampaignGeneratorConstants::CUTSCENE_TEXTURE_FILENAME;
+					break;
+				default:
+					result = buildShowMapEventValue(mapFilename);
+					break;
+				}
+
+				return result;
+			}
+
+			Json::Value buildCutsceneValue(const StoryCampaignGeneratorOptions& options, const std::string& mapFilename, int eventCount, std::default_random_engine& randomizer) {
+				Json::Value eventListValue(Json::arrayValue);
+
+				Json::Value openingColorValue = buildColorEventValue(randomizer);
+				openingColorValue[StoryLoaderUtils::StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT] = 0;
+				eventListValue.append(openingColorValue);
+
+				eventListValue.append(buildShowMapEventValue(mapFilename));
+
+				Json::Value showSnakeValue = buildEventValue(10, StoryLoaderUtils::CutsceneEventTypeValues::SHOW_SNAKE);
+				showSnakeValue[StoryLoaderUtils::StoryLevelProperties::SNAKE_START] = buildSnakeStartValue(resolveCenterPosition(options));
+				eventListValue.append(showSnakeValue);
+
+				for (int eventIndex = 0; eventIndex < eventCount - StoryCampaignGeneratorConstants::MIN_CUTSCENE_EVENT_COUNT; eventIndex++) {
+					eventListValue.append(buildCutsceneEventValue(options, mapFilename, eventIndex, randomizer));
+				}
+
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryCutsceneProperties::SOUND_TRACK] = StoryCampaignGeneratorConstants::SOUND_FILENAME;
+				result[StoryLoaderUtils::StoryCutsceneProperties::EVENT_LIST] = eventListValue;
+				return result;
+			}
+
+			Json::Value buildLevelValue(const StoryCampaignGeneratorOptions& options, int levelIndex, std::default_random_engine& randomizer) {
+				std::string mapFilename = buildMapFilename(levelIndex);
+
+				Json::Value winConditionValue(Json::objectValue);
+				winConditionValue[StoryLoaderUtils::StoryLevelProperties::WIN_CONDITION_TYPE] = StoryLoaderUtils::WinConditionTypeValues::ON_FOOD_EATEN;
+				winConditionValue[StoryLoaderUtils::StoryLevelProperties::FOOD_TYPE] = StoryLoaderUtils::FoodTypeValues::APPLE;
+				winConditionValue[StoryLoaderUtils::StoryLevelProperties::WIN_CONDITION_FOOD_COUNT] = 15;
+
+				Json::Value foodListValue(Json::arrayValue);
+				for (int foodIndex = 0; foodIndex < options.foodDefnCount; foodIndex++) {
+					foodListValue.append(buildFoodValue(options, foodIndex));
+				}
+
+				Json::Value dangerListValue(Json::arrayValue);
+				for (int dangerIndex = 0; dangerIndex < options.dangerDefnCount; dangerIndex++) {
+					dangerListValue.append(buildDangerValue(options, dangerIndex));
+				}
+
+				Json::Value result(Json::objectValue);
+				result[StoryLoaderUtils::StoryLevelProperties::OPENING_CUTSCENE] = buildCutsceneValue(options, mapFilename, options.openingCutsceneEventCount, randomizer);
+				result[StoryLoaderUtils::StoryLevelProperties::WIN_CUTSCENE] = buildCutsceneValue(options, mapFilename, options.endingCutsceneEventCount, randomizer);
+				result[StoryLoaderUtils::StoryLevelProperties::LOSS_CUTSCENE] = buildCutsceneValue(options, mapFilename, options.endingCutsceneEventCount, randomizer);
+				result[StoryLoaderUtils::StoryLevelProperties::MAP_FILENAME] = mapFilename;
+				result[StoryLoaderUtils::StoryLevelProperties::MUSIC_FILENAME] = StoryCampaignGeneratorConstants::MUSIC_FILENAME;
+				result[StoryLoaderUtils::StoryLevelProperties::SNAKE_START] = buildSnakeStartValue(resolveCenterPosition(options));
+				result[StoryLoaderUtils::StoryLevelProperties::SNAKE_SPEED] = 8;
+				result[StoryLoaderUtils::StoryLevelProperties::SNAKE_HEALTH] = 3;
+				result[StoryLoaderUtils::StoryLevelProperties::WIN_CONDITION] = winConditionValue;
+				result[StoryLoaderUtils::StoryLevelProperties::FOOD_LIST] = foodListValue;
+				result[StoryLoaderUtils::StoryLevelProperties::DANGER_LIST] = dangerListValue;
+				result[StoryLoaderUtils::StoryLevelProperties::SOUND_FX_LIST] = buildSoundFxListValue();
+				return result;
+			}
+
+			// Levels are written one at a time so that only a single level's values are ever held in memory
+			void writeCampaignFile(const std::string& campaignFolderName, const StoryCampaignGeneratorOptions& options, std::default_random_engine& randomizer, StoryGenerateCampaignResult& generateResult) {
+				std::string campaignFilePath = StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName);
+				std::ofstream campaignStream(campaignFilePath, std::ios_base::binary | std::ios_base::trunc);
+
+				Json::StreamWriterBuilder writerBuilder;
+				writerBuilder["indentation"] = "    ";
+				std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+
+				campaignStream << "{\n";
+				campaignStream << "    \"" << StoryLoaderUtils::CampaignListProperties::MENU_LABEL << "\": " << Json::valueToQuotedString(campaignFolderName.c_str()) << ",\n";
+				campaignStream << "    \"" << StoryLoaderUtils::CampaignListProperties::MENU_DESCRIPTION << "\": " << Json::valueToQuotedString(StoryCampaignGeneratorConstants::MENU_DESCRIPTION) << ",\n";
+				campaignStream << "    \"" << StoryLoaderUtils::CampaignListProperties::LEVEL_LIST << "\": [\n";
+
+				for (int levelIndex = 0; levelIndex < options.levelCount; levelIndex++) {
+					Json::Value levelValue = buildLevelValue(options, levelIndex, randomizer);
+					writer->write(levelValue, &campaignStream);
+					campaignStream << ((levelIndex + 1 < options.levelCount) ? ",\n" : "\n");
+
+					generateResult.cutsceneEventCount += options.openingCutsceneEventCount + 2 * options.endingCutsceneEventCount;
+				}
+
+				campaignStream << "    ]\n";
+				campaignStream << "}\n";
+
+				if (campaignStream.good()) {
+					generateResult.levelCount = options.levelCount;
+					generateResult.jsonBytes += (size_t)campaignStream.tellp();
+				}
+				else {
+					generateResult.failedFilenameList.push_back(campaignFilePath);
+				}
+			}
+
+			StoryCampaignGeneratorOptions createDefaultOptions() {
+				StoryCampaignGeneratorOptions result;
+				result.levelCount = StoryCampaignGeneratorConstants::DEFAULT_LEVEL_COUNT;
+				result.mapSize = sf::Vector2i(StoryCampaignGeneratorConstants::DEFAULT_MAP_WIDTH, StoryCampaignGeneratorConstants::DEFAULT_MAP_HEIGHT);
+				result.floorDefnCount = 16;
+				result.barrierDefnCount = 8;
+				result.foodDefnCount = 8;
+				result.dangerDefnCount = 4;
+				result.openingCutsceneEventCount = StoryCampaignGeneratorConstants::DEFAULT_OPENING_CUTSCENE_EVENT_COUNT;
+				result.endingCutsceneEventCount = StoryCampaignGeneratorConstants::DEFAULT_ENDING_CUTSCENE_EVENT_COUNT;
+				result.seed = 1;
+				return result;
+			}
+
+			StoryGenerateCampaignResult generateCampaign(const std::string& campaignFolderName, const StoryCampaignGeneratorOptions& options) {
+				StoryGenerateCampaignResult result;
+
+				StoryCampaignGeneratorOptions clampedOptions = clampOptions(options);
+				std::default_random_engine randomizer(clampedOptions.seed);
+
+				result.folderCreated =
+					createFolder(resolveFolderPath(StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName))) &&
+					createFolder(resolveFolderPath(StoryLoaderUtils::resolveImageFilePath(campaignFolderName, ""))) &&
+					createFolder(resolveFolderPath(StoryLoaderUtils::resolveSoundFilePath(campaignFolderName, ""))) &&
+					createFolder(resolveFolderPath(StoryLoaderUtils::resolveMusicFilePath(campaignFolderName, "")));
+
+				if (result.folderCreated) {
+					writeAssetFiles(campaignFolderName, clampedOptions, randomizer, result);
+
+					for (int levelIndex = 0; levelIndex < clampedOptions.levelCount; levelIndex++) {
+						std::string mapFilePath = StoryLoaderUtils::resolveMapFilePath(campaignFolderName, buildMapFilename(levelIndex));
+						writeTextFile(mapFilePath, buildMapText(clampedOptions, randomizer), result);
+						result.mapCount++;
+					}
+
+					writeCampaignFile(campaignFolderName, clampedOptions, randomizer, result);
+				}
+
+				return result;
+			}
+
+			std::vector<std::string> buildGenerateMessages(const StoryGenerateCampaignResult& generateResult) {
+				std::vector<std::string> result;
+
+				if (!generateResult.folderCreated) {
+					result.push_back("The campaign folders could not be created");
+				}
+				else {
+					char message[512];
+
+					snprintf(message, sizeof(message), "Generated %d levels, %d maps and %d cutscene events (%.1f MB of JSON)", generateResult.levelCount, generateResult.mapCount, generateResult.cutsceneEventCount, (float)generateResult.jsonBytes / (1024.0f * 1024.0f));
+					result.push_back(message);
+
+					for (auto const& currFilename : generateResult.failedFilenameList) {
+						snprintf(message, sizeof(message), "Could not write %s", currFilename.c_str());
+						result.push_back(message);
+					}
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,240 @@
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../jsoncpp/json/json.h"
+#include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storydefncache.hpp"
+#include "../includes/r3-snake-storyjsonscan.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		// Walks campaign.json without building any values.  The only thing it keeps is where each "levelList"
+		// entry begins and ends.
+		namespace StoryCampaignScanUtils {
+
+			bool scanLevelList(StoryJsonScanUtils::ScanCursor& cursor, std::vector<StoryCampaignLevelSpan>& levelSpanList, bool* allObjectsFlag) {
+				StoryJsonScanUtils::skipWhitespace(cursor);
+				if (StoryJsonScanUtils::peek(cursor) == ']') {
+					cursor.position++;
+					return true;
+				}
+
+				bool moreElementsFlag = true;
+				while (moreElementsFlag) {
+					StoryJsonScanUtils::skipWhitespace(cursor);
+
+					StoryCampaignLevelSpan currElementSpan;
+					currElementSpan.offset = cursor.position;
+					bool objectFlag = (StoryJsonScanUtils::peek(cursor) == '{');
+
+					if (!StoryJsonScanUtils::scanValue(cursor, 2)) {
+						return false;
+					}
+
+					currElementSpan.size = cursor.position - currElementSpan.offset;
+					levelSpanList.push_back(currElementSpan);
+					*allObjectsFlag = *allObjectsFlag && objectFlag;
+
+					StoryJsonScanUtils::skipWhitespace(cursor);
+					if (StoryJsonScanUtils::peek(cursor) == ',') {
+						cursor.position++;
+					}
+					else if (StoryJsonScanUtils::peek(cursor) == ']') {
+						cursor.position++;
+						moreElementsFlag = false;
+					}
+					else {
+						return StoryJsonScanUtils::fail(cursor, "missing ',' or ']' in array declaration.");
+					}
+				}
+
+				return true;
+			}
+
+			// The root object is walked by hand so the "levelList" member can be picked out; as with jsoncpp,
+			// a repeated member replaces the earlier one
+			void scanCampaign(StoryJsonScanUtils::ScanCursor& cursor, LoadStoryCampaignIndexResult& indexResult, std::vector<StoryCampaignLevelSpan>& levelSpanList) {
+				if (!StoryJsonScanUtils::expect(cursor, '{', "a campaign must be an object.")) {
+					return;
+				}
+
+				StoryJsonScanUtils::skipWhitespace(cursor);
+				bool moreMembersFlag = (StoryJsonScanUtils::peek(cursor) != '}');
+				if (!moreMembersFlag) {
+					cursor.position++;
+				}
+
+				while (moreMembersFlag) {
+					const char* nameBegin = nullptr;
+					size_t nameLength = 0;
+					if (!StoryJsonScanUtils::scanString(cursor, &nameBegin, &nameLength) || !StoryJsonScanUtils::expect(cursor, ':', "missing ':' after object member name.")) {
+						return;
+					}
+
+					bool levelListFlag = StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::CampaignListProperties::LEVEL_LIST);
+
+					StoryJsonScanUtils::skipWhitespace(cursor);
+					if (levelListFlag) {
+						levelSpanList.clear();
+						indexResult.levelListValid = (StoryJsonScanUtils::peek(cursor) == '[');
+						indexResult.levelEntriesValid = true;
+					}
+
+					bool valueValid = false;
+					if (levelListFlag && indexResult.levelListValid) {
+						cursor.position++;
+						valueValid = scanLevelList(cursor, levelSpanList, &indexResult.levelEntriesValid);
+					}
+					else {
+						valueValid = StoryJsonScanUtils::scanValue(cursor, 1);
+					}
+					if (!valueValid) {
+						return;
+					}
+
+					StoryJsonScanUtils::skipWhitespace(cursor);
+					if (StoryJsonScanUtils::peek(cursor) == ',') {
+						cursor.position++;
+					}
+					else if (StoryJsonScanUtils::peek(cursor) == '}') {
+						cursor.position++;
+						moreMembersFlag = false;
+					}
+					else {
+						StoryJsonScanUtils::fail(cursor, "missing ',' or '}' in object declaration.");
+						return;
+					}
+				}
+
+				StoryJsonScanUtils::skipWhitespace(cursor);
+				if (!StoryJsonScanUtils::atEnd(cursor)) {
+					StoryJsonScanUtils::fail(cursor, "extra non-whitespace after JSON value.");
+				}
+			}
+
+		}
+
+		StoryCampaignIndex::StoryCampaignIndex() {
+			this->loadedLevelCount = 0;
+			this->loadedFromCacheFlag = false;
+			this->cacheSaveDueFlag = false;
+		}
+
+		LoadStoryCampaignIndexResult StoryCampaignIndex::open(const std::string& campaignFolderName) {
+			this->campaignFolderName = campaignFolderName;
+			this->fileContents = StoryFileContents();
+			this->levelSpanList.clear();
+			this->levelResultList.clear();
+			this->levelLoadedFlagList.clear();
+			this->loadedLevelCount = 0;
+			this->loadedFromCacheFlag = false;
+			this->cacheSaveDueFlag = false;
+
+			LoadStoryCampaignIndexResult result;
+
+			// A current definition cache already holds every level, validated
+			LoadStoryCampaignResult cachedResult;
+			if (StoryDefnCacheUtils::loadCachedCampaign(campaignFolderName, cachedResult)) {
+				this->levelResultList = cachedResult.levelResultList;
+				this->levelLoadedFlagList.assign(this->levelResultList.size(), 1);
+				this->loadedLevelCount = (int)this->levelResultList.size();
+				this->loadedFromCacheFlag = true;
+
+				result.levelListValid = true;
+				result.levelEntriesValid = true;
+				return result;
+			}
+
+			StoryLoaderUtils::LoadAssetValidation::clearProbeCache();
+
+			std::string campaignFilePath = StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName);
+			StoryArchiveUtils::readFile(campaignFilePath, this->fileContents);
+
+			StoryJsonScanUtils::ScanCursor cursor;
+			cursor.data = this->fileContents.getData();
+			cursor.size = this->fileContents.getSize();
+			cursor.position = 0;
+
+			StoryCampaignScanUtils::scanCampaign(cursor, result, this->levelSpanList);
+
+			result.parseErrorString = cursor.errorString;
+			result.levelListValid = result.levelListValid && !this->levelSpanList.empty();
+
+			if (result.valid()) {
+				this->levelResultList.resize(this->levelSpanList.size());
+				this->levelLoadedFlagList.assign(this->levelSpanList.size(), 0);
+			}
+			else {
+				this->levelSpanList.clear();
+			}
+
+			return result;
+		}
+
+		int StoryCampaignIndex::getLevelCount() const {
+			int result = (int)this->levelResultList.size();
+			return result;
+		}
+
+		bool StoryCampaignIndex::wasLoadedFromCache() const {
+			return this->loadedFromCacheFlag;
+		}
+
+		const LoadStoryLevelResult& StoryCampaignIndex::loadLevel(int levelIndex) {
+			assert((levelIndex >= 0) && (levelIndex < this->getLevelCount()));
+
+			if (!this->levelLoadedFlagList[levelIndex]) {
+				const StoryCampaignLevelSpan& levelSpan = this->levelSpanList[levelIndex];
+				const char* levelBegin = this->fileContents.getData() + levelSpan.offset;
+
+				// The span already passed the syntax scan, so jsoncpp only has the one level to build.  Should
+				// jsoncpp still reject it, the level is left invalid with the parse error as its only message.
+				Json::Value levelValue;
+				Json::Reader jsonReader(Json::Features::strictMode());
+				if (jsonReader.parse(levelBegin, levelBegin + levelSpan.size, levelValue)) {
+					this->levelResultList[levelIndex] = StoryLoaderUtils::loadStoryLevel(this->campaignFolderName, levelValue);
+				}
+				else {
+					this->levelResultList[levelIndex].validationResult.parseErrorString = jsonReader.getFormattedErrorMessages();
+				}
+				this->levelLoadedFlagList[levelIndex] = 1;
+				this->loadedLevelCount++;
+
+				// Levels can be loaded from the prefetch thread, so writing the cache waits for flushCachedCampaign()
+				if (this->loadedLevelCount == this->getLevelCount()) {
+					this->cacheSaveDueFlag = true;
+				}
+			}
+
+			return this->levelResultList[levelIndex];
+		}
+
+		StoryLevelDefn& StoryCampaignIndex::getLevelDefn(int levelIndex) {
+			assert(this->levelLoadedFlagList[levelIndex]);
+
+			return this->levelResultList[levelIndex].levelDefn;
+		}
+
+		void StoryCampaignIndex::flushCachedCampaign() {
+			if (this->cacheSaveDueFlag) {
+				this->saveCachedCampaign();
+				this->cacheSaveDueFlag = false;
+			}
+		}
+
+		void StoryCampaignIndex::saveCachedCampaign() {
+			LoadStoryCampaignResult campaignResult;
+			campaignResult.levelListValid = true;
+			campaignResult.levelResultList = this->levelResultList;
+
+			if (campaignResult.valid()) {
+				StoryDefnCacheUtils::saveCachedCampaign(this->campaignFolderName, campaignResult);
+			}
+		}
+
+	}
+
+}
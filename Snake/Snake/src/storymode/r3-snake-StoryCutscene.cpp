@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include "../includes/r3-snake-utils.hpp"
 #include "../includes/r3-snake-storymodescene.hpp"
 
@@ -12,7 +13,11 @@ namespace r3 {
 			this->lastEventFrame = 0;
 			this->framesSinceLastEvent = 0;
 			this->nextEventIndex = 0;
+			this->nextPathRunIndex = 0;
+			this->nextPathRunStep = 0;
 			this->snake = nullptr;
+
+			this->buildInstanceIdLists();
 		}
 
 		StoryCutscene::~StoryCutscene() {
@@ -38,12 +43,12 @@ namespace r3 {
 			return this->snake;
 		}
 
-		const std::unordered_map<int, StoryFoodInstance>& StoryCutscene::getFoodInstanceMap() const {
-			return this->foodInstanceMap;
+		const SlotMap<StoryFoodInstance>& StoryCutscene::getFoodSlotMap() const {
+			return this->foodSlotMap;
 		}
 
-		const std::unordered_map<int, StoryDangerInstance>& StoryCutscene::getDangerInstanceMap() const {
-			return this->dangerInstanceMap;
+		const SlotMap<StoryDangerInstance>& StoryCutscene::getDangerSlotMap() const {
+			return this->dangerSlotMap;
 		}
 
 		bool StoryCutscene::update() {
@@ -53,11 +58,18 @@ namespace r3 {
 
 			sf::Int64 framesElapsed = this->clock.getElapsedTime().asMicroseconds() / GameLoopUtils::MICROSECONDS_PER_FRAME;
 
+			bool result = this->advanceToFrame((int)framesElapsed + 1);
+			return result;
+		}
+
+		// update() moves to whichever frame the clock has reached, so a slow frame skips ahead; stepping one frame at
+		// a time instead gives the same sequence on every run
+		bool StoryCutscene::advanceToFrame(int frame) {
 			this->updateActiveScreenViews();
 
 			this->processEvents();
 
-			this->currFrame = (int)framesElapsed + 1;
+			this->currFrame = frame;
 			this->framesSinceLastEvent = this->currFrame - this->lastEventFrame;
 
 			// printf("Now at frame %d\n", this->currFrame);
@@ -87,10 +99,18 @@ namespace r3 {
 
 			while (!doneProcessingEvents) {
 				const StoryCutsceneEventDefn& nextEventDefn = this->cutsceneDefn->eventDefnList.at(this->nextEventIndex);
-				if (this->framesSinceLastEvent >= nextEventDefn.framesSinceLastEvent) {
-					this->processEvent(nextEventDefn);
-
-					this->nextEventIndex++;
+				if (this->framesSinceLastEvent >= this->resolveFramesUntilNextStep(nextEventDefn)) {
+					bool eventComplete = true;
+					if (nextEventDefn.eventType == StoryCutsceneEventType::MOVE_SNAKE_PATH) {
+						eventComplete = this->processPathStep(this->cutsceneDefn->pathEventList[nextEventDefn.payloadIndex]);
+					}
+					else {
+						this->processEvent(nextEventDefn);
+					}
+
+					if (eventComplete) {
+						this->nextEventIndex++;
+					}
 					doneProcessingEvents = (this->nextEventIndex >= this->cutsceneDefn->eventDefnList.size());
 
 					this->lastEventFrame = this->currFrame;
@@ -102,37 +122,70 @@ namespace r3 {
 			}
 		}
 
+		int StoryCutscene::resolveFramesUntilNextStep(const StoryCutsceneEventDefn& eventDefn) const {
+			int result = eventDefn.framesSinceLastEvent;
+
+			bool pathStarted =
+				(eventDefn.eventType == StoryCutsceneEventType::MOVE_SNAKE_PATH) &&
+				((this->nextPathRunIndex > 0) || (this->nextPathRunStep > 0));
+			if (pathStarted) {
+				const StoryCutscenePathEventDefn& pathEventDefn = this->cutsceneDefn->pathEventList[eventDefn.payloadIndex];
+				result = this->cutsceneDefn->pathRunList[pathEventDefn.firstRunIndex + this->nextPathRunIndex].framesPerStep;
+			}
+
+			return result;
+		}
+
+		// Each step of a path behaves like its own moveSnake event; returns true once the last step has been taken
+		bool StoryCutscene::processPathStep(const StoryCutscenePathEventDefn& pathEventDefn) {
+			const StorySnakePathRun& currRun = this->cutsceneDefn->pathRunList[pathEventDefn.firstRunIndex + this->nextPathRunIndex];
+			this->moveSnake((ObjectDirection)currRun.direction, currRun.growFlag);
+
+			this->nextPathRunStep++;
+			if (this->nextPathRunStep >= currRun.stepCount) {
+				this->nextPathRunIndex++;
+				this->nextPathRunStep = 0;
+			}
+
+			bool result = (this->nextPathRunIndex >= (size_t)pathEventDefn.runCount);
+			if (result) {
+				this->nextPathRunIndex = 0;
+			}
+
+			return result;
+		}
+
 		void StoryCutscene::processEvent(const StoryCutsceneEventDefn& eventDefn) {
 			switch (eventDefn.eventType) {
 			case StoryCutsceneEventType::COLOR:
-				this->processColorEvent(eventDefn.colorEvent);
+				this->processColorEvent(this->cutsceneDefn->colorEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::TEXTURE:
-				this->processTextureEvent(eventDefn.textureEvent);
+				this->processTextureEvent(this->cutsceneDefn->textureEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::SHOW_MAP:
-				this->processShowMapEvent(eventDefn.mapEvent);
+				this->processShowMapEvent(this->cutsceneDefn->mapEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::SHOW_SNAKE:
-				this->processShowSnakeEvent(eventDefn.snakeEvent);
+				this->processShowSnakeEvent(this->cutsceneDefn->snakeStartList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::MOVE_SNAKE:
-				this->processMoveSnakeEvent(eventDefn.snakeEvent);
+				this->processMoveSnakeEvent(this->cutsceneDefn->snakeEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::HIDE_SNAKE:
-				this->processHideSnakeEvent(eventDefn.snakeEvent);
+				this->processHideSnakeEvent();
 				break;
 			case StoryCutsceneEventType::SHOW_FOOD:
-				this->processShowFoodEvent(eventDefn.foodEvent);
+				this->processShowFoodEvent(this->cutsceneDefn->foodEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::HIDE_FOOD:
-				this->processHideFoodEvent(eventDefn.foodEvent);
+				this->processHideFoodEvent(this->cutsceneDefn->foodEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::SHOW_DANGER:
-				this->processShowDangerEvent(eventDefn.dangerEvent);
+				this->processShowDangerEvent(this->cutsceneDefn->dangerEventList[eventDefn.payloadIndex]);
 				break;
 			case StoryCutsceneEventType::HIDE_DANGER:
-				this->processHideDangerEvent(eventDefn.dangerEvent);
+				this->processHideDangerEvent(this->cutsceneDefn->dangerEventList[eventDefn.payloadIndex]);
 				break;
 			}
 		}
@@ -143,6 +196,8 @@ namespace r3 {
 			newScreenView.fadeFrames = colorEventDefn.fadeFrames;
 			newScreenView.fadeFramesRemaining = colorEventDefn.fadeFrames;
 			newScreenView.color = colorEventDefn.color;
+			newScreenView.textureHandle = -1;
+			newScreenView.mapHandle = -1;
 
 			this->addScreenView(newScreenView);
 		}
@@ -152,7 +207,8 @@ namespace r3 {
 			newScreenView.screenEventType = StoryCutsceneScreenViewType::TEXTURE;
 			newScreenView.fadeFrames = textureEventDefn.fadeFrames;
 			newScreenView.fadeFramesRemaining = textureEventDefn.fadeFrames;
-			newScreenView.textureFilename = textureEventDefn.textureFilename;
+			newScreenView.textureHandle = textureEventDefn.textureHandle;
+			newScreenView.mapHandle = -1;
 
 			this->addScreenView(newScreenView);
 		}
@@ -162,7 +218,8 @@ namespace r3 {
 			newScreenView.screenEventType = StoryCutsceneScreenViewType::MAP;
 			newScreenView.fadeFrames = showMapEventDefn.fadeFrames;
 			newScreenView.fadeFramesRemaining = showMapEventDefn.fadeFrames;
-			newScreenView.mapFilename = showMapEventDefn.mapFilename;
+			newScreenView.textureHandle = -1;
+			newScreenView.mapHandle = showMapEventDefn.mapHandle;
 
 			this->addScreenView(newScreenView);
 		}
@@ -175,19 +232,19 @@ namespace r3 {
 			this->activeScreenViewList.push_back(screenView);
 		}
 
-		void StoryCutscene::processShowSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn) {
+		void StoryCutscene::processShowSnakeEvent(const SnakeStartDefn& snakeStart) {
 			if (this->snake != nullptr) {
 				delete this->snake;
 				this->snake = nullptr;
 
-				// printf("Cut-scene:  Teleporting the snake to a new position %d, %d\n", snakeEventDefn.snakeStart.headPosition.x, snakeEventDefn.snakeStart.headPosition.y);
+				// printf("Cut-scene:  Teleporting the snake to a new position %d, %d\n", snakeStart.headPosition.x, snakeStart.headPosition.y);
 			}
 
 			if (
 				!this->activeScreenViewList.empty() &&
 				(this->activeScreenViewList.back().screenEventType == StoryCutsceneScreenViewType::MAP)
 			) {
-				this->snake = new Snake(snakeEventDefn.snakeStart);
+				this->snake = new Snake(snakeStart);
 			}
 			else {
 				// printf("Cut-scene:  The \"showSnake\" event will be ignored, as no map is currently visible\n");
@@ -195,20 +252,24 @@ namespace r3 {
 		}
 
 		void StoryCutscene::processMoveSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn) {
+			this->moveSnake(snakeEventDefn.snakeDirection, snakeEventDefn.snakeGrowFlag);
+		}
+
+		void StoryCutscene::moveSnake(ObjectDirection direction, bool growFlag) {
 			if (this->snake == nullptr) {
 				// printf("Cut-scene:  The \"moveSnake\" event will be ignored, as the snake is not currently visible\n");
 			}
 			else {
-				if (snakeEventDefn.snakeGrowFlag) {
-					this->snake->growForward(snakeEventDefn.snakeDirection);
+				if (growFlag) {
+					this->snake->growForward(direction);
 				}
 				else {
-					this->snake->moveForward(snakeEventDefn.snakeDirection);
+					this->snake->moveForward(direction);
 				}
 			}
 		}
 
-		void StoryCutscene::processHideSnakeEvent(const StoryCutsceneSnakeEventDefn& snakeEventDefn) {
+		void StoryCutscene::processHideSnakeEvent() {
 			if (this->snake == nullptr) {
 				// printf("Cut-scene:  The \"hideSnake\" event will be ignored, as the snake is not currently visible\n");
 			}
@@ -219,47 +280,87 @@ namespace r3 {
 		}
 
 		void StoryCutscene::processShowFoodEvent(const StoryCutsceneFoodEventDefn& foodEventDefn) {
-			if (this->foodInstanceMap.count(foodEventDefn.instanceId) > 0) {
-				// printf("Cut-scene:  Food instance %d already exists\n", foodEventDefn.instanceId);
-			}
-
 			StoryFoodInstance newFoodInstance;
 			newFoodInstance.foodInstanceId = foodEventDefn.instanceId;
 			newFoodInstance.foodType = foodEventDefn.foodType;
 			newFoodInstance.position = foodEventDefn.position;
 
-			this->foodInstanceMap[foodEventDefn.instanceId] = newFoodInstance;
+			int instanceIndex = this->resolveInstanceIndex(this->foodInstanceIdList, foodEventDefn.instanceId);
+			StoryFoodInstance* existingFoodInstance = this->foodSlotMap.find(this->foodSlotIdList[instanceIndex]);
+			if (existingFoodInstance != nullptr) {
+				// printf("Cut-scene:  Food instance %d already exists\n", foodEventDefn.instanceId);
+				*existingFoodInstance = newFoodInstance;
+			}
+			else {
+				this->foodSlotIdList[instanceIndex] = this->foodSlotMap.insert(newFoodInstance);
+			}
 		}
 
 		void StoryCutscene::processHideFoodEvent(const StoryCutsceneFoodEventDefn& foodEventDefn) {
-			if (this->foodInstanceMap.count(foodEventDefn.instanceId) == 0) {
+			int instanceIndex = this->resolveInstanceIndex(this->foodInstanceIdList, foodEventDefn.instanceId);
+			if ((instanceIndex < 0) || !this->foodSlotMap.contains(this->foodSlotIdList[instanceIndex])) {
 				// printf("Cut-scene:  The \"hideFood\" event will be ignored, as the instance ID is not currently visible.\n");
 			}
 			else {
-				this->foodInstanceMap.erase(foodEventDefn.instanceId);
+				this->foodSlotMap.erase(this->foodSlotIdList[instanceIndex]);
 			}
 		}
 
 		void StoryCutscene::processShowDangerEvent(const StoryCutsceneDangerEventDefn& dangerEventDefn) {
-			if (this->dangerInstanceMap.count(dangerEventDefn.instanceId) > 0) {
-				// printf("Cut-scene:  Danger instance %d already exists\n", dangerEventDefn.instanceId);
-			}
-
 			StoryDangerInstance newDangerInstance;
 			newDangerInstance.dangerInstanceId = dangerEventDefn.instanceId;
 			newDangerInstance.dangerType = dangerEventDefn.dangerType;
 			newDangerInstance.position = dangerEventDefn.position;
 
-			this->dangerInstanceMap[dangerEventDefn.instanceId] = newDangerInstance;
+			int instanceIndex = this->resolveInstanceIndex(this->dangerInstanceIdList, dangerEventDefn.instanceId);
+			StoryDangerInstance* existingDangerInstance = this->dangerSlotMap.find(this->dangerSlotIdList[instanceIndex]);
+			if (existingDangerInstance != nullptr) {
+				// printf("Cut-scene:  Danger instance %d already exists\n", dangerEventDefn.instanceId);
+				*existingDangerInstance = newDangerInstance;
+			}
+			else {
+				this->dangerSlotIdList[instanceIndex] = this->dangerSlotMap.insert(newDangerInstance);
+			}
 		}
 
 		void StoryCutscene::processHideDangerEvent(const StoryCutsceneDangerEventDefn& dangerEventDefn) {
-			if (this->dangerInstanceMap.count(dangerEventDefn.instanceId) == 0) {
+			int instanceIndex = this->resolveInstanceIndex(this->dangerInstanceIdList, dangerEventDefn.instanceId);
+			if ((instanceIndex < 0) || !this->dangerSlotMap.contains(this->dangerSlotIdList[instanceIndex])) {
 				// printf("Cut-scene:  The \"hideDanger\" event will be ignored, as the instance ID is not currently visible.\n");
 			}
 			else {
-				this->dangerInstanceMap.erase(dangerEventDefn.instanceId);
+				this->dangerSlotMap.erase(this->dangerSlotIdList[instanceIndex]);
+			}
+		}
+
+		void StoryCutscene::buildInstanceIdLists() {
+			for (auto const& currFoodEventDefn : this->cutsceneDefn->foodEventList) {
+				this->foodInstanceIdList.push_back(currFoodEventDefn.instanceId);
+			}
+
+			for (auto const& currDangerEventDefn : this->cutsceneDefn->dangerEventList) {
+				this->dangerInstanceIdList.push_back(currDangerEventDefn.instanceId);
+			}
+
+			// Authored instance ids are arbitrary, so they are mapped once to a dense index that holds the slot id
+			std::sort(this->foodInstanceIdList.begin(), this->foodInstanceIdList.end());
+			this->foodInstanceIdList.erase(std::unique(this->foodInstanceIdList.begin(), this->foodInstanceIdList.end()), this->foodInstanceIdList.end());
+			this->foodSlotIdList.assign(this->foodInstanceIdList.size(), 0);
+
+			std::sort(this->dangerInstanceIdList.begin(), this->dangerInstanceIdList.end());
+			this->dangerInstanceIdList.erase(std::unique(this->dangerInstanceIdList.begin(), this->dangerInstanceIdList.end()), this->dangerInstanceIdList.end());
+			this->dangerSlotIdList.assign(this->dangerInstanceIdList.size(), 0);
+		}
+
+		int StoryCutscene::resolveInstanceIndex(const std::vector<int>& instanceIdList, int instanceId) const {
+			int result = -1;
+
+			auto instanceIdItr = std::lower_bound(instanceIdList.begin(), instanceIdList.end(), instanceId);
+			if ((instanceIdItr != instanceIdList.end()) && (*instanceIdItr == instanceId)) {
+				result = (int)(instanceIdItr - instanceIdList.begin());
 			}
+
+			return result;
 		}
 
 	}
@@ -1,5 +1,6 @@
 
 #include <assert.h>
+#include <algorithm>
 #include "../includes/r3-snake-storymodescene.hpp"
 
 namespace r3 {
@@ -11,6 +12,7 @@ namespace r3 {
 
 			this->chancePctDistribution = std::uniform_real_distribution<float>(0.0f, 100.0f);
 
+			this->dangerInstanceCount = 0;
 			this->spawnCount = 0;
 			this->timeOfLastChanceCheck = sf::seconds(-1.0f);
 			this->timeOfLastSpawn = sf::seconds(0.0f);
@@ -20,15 +22,8 @@ namespace r3 {
 			return *this->dangerDefn;
 		}
 
-		const std::vector<StoryDangerInstance>& StoryDangerSpawnTracker::getDangerInstanceList() const {
-			return this->dangerInstanceList;
-		}
-
-		StoryDangerInstance StoryDangerSpawnTracker::getDangerInstance(int dangerInstanceId) const {
-			int index = this->findDangerInstanceIndex(dangerInstanceId);
-			assert(index >= 0);
-
-			return( this->dangerInstanceList[index] );
+		int StoryDangerSpawnTracker::getDangerInstanceCount() const {
+			return this->dangerInstanceCount;
 		}
 
 		bool StoryDangerSpawnTracker::shouldDangerSpawn(const StoryDangerSpawnCheckInput& input) {
@@ -64,40 +59,76 @@ namespace r3 {
 			return result;
 		}
 
-		StoryDangerPositionCheckResult StoryDangerSpawnTracker::occupiesPosition(const sf::Vector2i& position) const {
-			StoryDangerPositionCheckResult result;
-			result.dangerExistsFlag = false;
-			result.dangerInstanceId = 0;
+		bool StoryDangerSpawnTracker::shouldDangerDespawn(const StoryDangerDespawnCheckInput& input) const {
+			assert(this->dangerInstanceCount > 0);
 
-			for (auto const& currDangerInstance : this->dangerInstanceList) {
-				if (currDangerInstance.position == position) {
-					result.dangerExistsFlag = true;
-					result.dangerInstanceId = currDangerInstance.dangerInstanceId;
-					break;
-				}
+			sf::Time timeSinceLastSpawn = input.timeSinceLevelStarted - this->timeOfLastSpawn;
+			bool result = (timeSinceLastSpawn.asSeconds() >= 1.0f);
+			return result;
+		}
+
+		bool StoryDangerSpawnTracker::canSpawnAgain() const {
+			bool result = (this->spawnCount < this->dangerDefn->maxSpawnCount);
+			return result;
+		}
+
+		bool StoryDangerSpawnTracker::areTimeConditionsMet(const sf::Time& timeSinceLevelStarted) const {
+			sf::Time timeSinceLastChanceCheck = timeSinceLevelStarted - this->timeOfLastChanceCheck;
+			sf::Time timeSinceLastSpawn = timeSinceLevelStarted - this->timeOfLastSpawn;
+
+			bool result = (timeSinceLastChanceCheck.asSeconds() >= 1.0f);
+			if ((this->dangerDefn->spawnType == StoryObjectSpawnType::ON_TIMER) && (this->spawnCount == 0)) {
+				result = result && (timeSinceLastSpawn.asSeconds() >= (float)this->dangerDefn->timePassed);
+			}
+			else {
+				result = result && (timeSinceLastSpawn.asSeconds() >= (float)this->dangerDefn->interval);
 			}
 
 			return result;
 		}
 
-		bool StoryDangerSpawnTracker::shouldDangerDespawn(const StoryDangerDespawnCheckInput& input) const {
-			assert(this->findDangerInstanceIndex(input.dangerInstanceId) >= 0);
+		sf::Time StoryDangerSpawnTracker::resolveEarliestCheckTime() const {
+			int secondsToWait = this->dangerDefn->interval;
+			if ((this->dangerDefn->spawnType == StoryObjectSpawnType::ON_TIMER) && (this->spawnCount == 0)) {
+				secondsToWait = this->dangerDefn->timePassed;
+			}
 
-			sf::Time timeSinceLastSpawn = input.timeSinceLevelStarted - this->timeOfLastSpawn;
-			bool result = (timeSinceLastSpawn.asSeconds() >= 1.0f);
+			sf::Time result = std::max(
+				this->timeOfLastChanceCheck + sf::seconds(1.0f),
+				this->timeOfLastSpawn + sf::seconds((float)secondsToWait)
+			);
 			return result;
 		}
 
-		void StoryDangerSpawnTracker::spawnDanger(const StoryDangerInstance& dangerInstance) {
-			this->dangerInstanceList.push_back(dangerInstance);
+		sf::Time StoryDangerSpawnTracker::resolveDespawnTime() const {
+			sf::Time result = this->timeOfLastSpawn + sf::seconds(1.0f);
+			return result;
+		}
+
+		StorySpawnTrigger StoryDangerSpawnTracker::resolveSpawnTrigger() const {
+			StorySpawnTrigger result = StorySpawnTrigger::NONE;
+
+			switch (this->dangerDefn->spawnType) {
+			case StoryObjectSpawnType::ON_LENGTH_REACHED:
+				result = StorySpawnTrigger::LENGTH_CHANGED;
+				break;
+			case StoryObjectSpawnType::ON_SNAKE_POSITION:
+				result = StorySpawnTrigger::SNAKE_MOVED;
+				break;
+			}
+
+			return result;
+		}
+
+		void StoryDangerSpawnTracker::spawnDanger() {
+			this->dangerInstanceCount++;
 			this->spawnCount++;
 		}
 
-		void StoryDangerSpawnTracker::despawnDanger(int dangerInstanceId) {
-			int index = this->findDangerInstanceIndex(dangerInstanceId);
-			assert(index >= 0);
+		void StoryDangerSpawnTracker::despawnDanger() {
+			assert(this->dangerInstanceCount > 0);
 
-			this->dangerInstanceList.erase(this->dangerInstanceList.begin() + index);
+			this->dangerInstanceCount--;
 		}
 
 		bool StoryDangerSpawnTracker::areTimerConditionsMet(const StoryDangerSpawnCheckInput& input) {
@@ -105,7 +136,7 @@ namespace r3 {
 			sf::Time timeSinceLastSpawn = input.timeSinceLevelStarted - this->timeOfLastSpawn;
 
 			bool conditionsMet =
-				(this->dangerInstanceList.empty()) &&
+				(this->dangerInstanceCount == 0) &&
 				(this->spawnCount < this->dangerDefn->maxSpawnCount) &&
 				(
 				(
@@ -127,7 +158,7 @@ namespace r3 {
 			sf::Time timeSinceLastSpawn = input.timeSinceLevelStarted - this->timeOfLastSpawn;
 
 			bool conditionsMet =
-				(this->dangerInstanceList.empty()) &&
+				(this->dangerInstanceCount == 0) &&
 				(input.snake->getLength() >= this->dangerDefn->lengthReached) &&
 				(this->spawnCount < this->dangerDefn->maxSpawnCount) &&
 				(timeSinceLastSpawn.asSeconds() >= (float)this->dangerDefn->interval) &&
@@ -141,7 +172,7 @@ namespace r3 {
 			sf::Time timeSinceLastSpawn = input.timeSinceLevelStarted - this->timeOfLastSpawn;
 
 			bool result =
-				(this->dangerInstanceList.empty()) &&
+				(this->dangerInstanceCount == 0) &&
 				(input.snake->bodyOccupiesRect(this->dangerDefn->region)) &&
 				(this->spawnCount < this->dangerDefn->maxSpawnCount) &&
 				(timeSinceLastSpawn.asSeconds() >= (float)this->dangerDefn->interval) &&
@@ -150,17 +181,6 @@ namespace r3 {
 			return result;
 		}
 
-		int StoryDangerSpawnTracker::findDangerInstanceIndex(int dangerInstanceId) const {
-			int result = -1;
-			for (size_t index = 0; index < this->dangerInstanceList.size(); index++) {
-				if (this->dangerInstanceList[index].dangerInstanceId == dangerInstanceId) {
-					result = index;
-					break;
-				}
-			}
-			return result;
-		}
-
 	}
 
 }
@@ -0,0 +1,1096 @@
+
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <SFML/System.hpp>
+#include "../includes/r3-snake-storyarchive.hpp"
+#include "../includes/r3-snake-storydefncache.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryDefnCacheConstants {
+
+			const char* CACHE_FILE_EXTENSION = ".r3defn";
+
+			const char CACHE_FILE_MAGIC[4] = { 'R', '3', 'D', 'F' };
+			const sf::Uint8 CACHE_FILE_VERSION = 5;
+
+			const sf::Uint8 DEPENDENCY_CONTENT_HASH = 1;
+
+			const sf::Uint64 CONTENT_HASH_OFFSET = 14695981039346656037ULL;
+			const sf::Uint64 CONTENT_HASH_PRIME = 1099511628211ULL;
+
+		}
+
+		namespace StoryDefnCacheStreamUtils {
+
+			void writeVarUint(std::vector<sf::Uint8>& buffer, sf::Uint64 value) {
+				while (value >= 0x80) {
+					buffer.push_back((sf::Uint8)(value & 0x7F) | 0x80);
+					value >>= 7;
+				}
+				buffer.push_back((sf::Uint8)value);
+			}
+
+			// Signed values are zigzag encoded so that small negative numbers stay small
+			void writeInt(std::vector<sf::Uint8>& buffer, int value) {
+				sf::Uint32 zigzagValue = ((sf::Uint32)value << 1) ^ (sf::Uint32)(value >> 31);
+				writeVarUint(buffer, zigzagValue);
+			}
+
+			void writeFloat(std::vector<sf::Uint8>& buffer, float value) {
+				sf::Uint32 bits;
+				memcpy(&bits, &value, sizeof(bits));
+				writeVarUint(buffer, bits);
+			}
+
+			void writeString(std::vector<sf::Uint8>& buffer, const std::string& value) {
+				writeVarUint(buffer, value.size());
+				buffer.insert(buffer.end(), value.begin(), value.end());
+			}
+
+			void writeVector(std::vector<sf::Uint8>& buffer, const sf::Vector2i& value) {
+				writeInt(buffer, value.x);
+				writeInt(buffer, value.y);
+			}
+
+			typedef struct Snake_ReadCursor {
+				const std::vector<sf::Uint8>* buffer;
+				size_t position;
+				bool validFlag;
+			} ReadCursor;
+
+			sf::Uint8 readByte(ReadCursor& cursor) {
+				sf::Uint8 result = 0;
+				if (cursor.position < cursor.buffer->size()) {
+					result = (*cursor.buffer)[cursor.position];
+					cursor.position++;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			sf::Uint64 readVarUint(ReadCursor& cursor) {
+				sf::Uint64 result = 0;
+				int shift = 0;
+				bool moreBytesFlag = true;
+				while (moreBytesFlag && cursor.validFlag && (shift < 64)) {
+					sf::Uint8 currByte = readByte(cursor);
+					result |= (sf::Uint64)(currByte & 0x7F) << shift;
+					shift += 7;
+					moreBytesFlag = ((currByte & 0x80) != 0);
+				}
+				return result;
+			}
+
+			int readInt(ReadCursor& cursor) {
+				sf::Uint32 zigzagValue = (sf::Uint32)readVarUint(cursor);
+				int result = (int)(zigzagValue >> 1) ^ -(int)(zigzagValue & 1);
+				return result;
+			}
+
+			float readFloat(ReadCursor& cursor) {
+				sf::Uint32 bits = (sf::Uint32)readVarUint(cursor);
+				float result;
+				memcpy(&result, &bits, sizeof(result));
+				return result;
+			}
+
+			std::string readString(ReadCursor& cursor) {
+				std::string result;
+				sf::Uint64 length = readVarUint(cursor);
+				if (cursor.validFlag && (length <= (cursor.buffer->size() - cursor.position))) {
+					result.assign((const char*)cursor.buffer->data() + cursor.position, (size_t)length);
+					cursor.position += (size_t)length;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			sf::Vector2i readVector(ReadCursor& cursor) {
+				sf::Vector2i result;
+				result.x = readInt(cursor);
+				result.y = readInt(cursor);
+				return result;
+			}
+
+			// Guards list sizes read from a damaged file; every entry takes at least one byte
+			size_t readCount(ReadCursor& cursor) {
+				sf::Uint64 result = readVarUint(cursor);
+				if (result > (cursor.buffer->size() - cursor.position)) {
+					cursor.validFlag = false;
+					result = 0;
+				}
+				return (size_t)result;
+			}
+
+		}
+
+		namespace StoryDefnCacheSerializeUtils {
+
+			void writeSnakeStart(std::vector<sf::Uint8>& buffer, const SnakeStartDefn& snakeStart) {
+				StoryDefnCacheStreamUtils::writeVector(buffer, snakeStart.headPosition);
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)snakeStart.facingDirection);
+				StoryDefnCacheStreamUtils::writeInt(buffer, snakeStart.length);
+			}
+
+			SnakeStartDefn readSnakeStart(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				SnakeStartDefn result;
+				result.headPosition = StoryDefnCacheStreamUtils::readVector(cursor);
+				result.facingDirection = (ObjectDirection)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.length = StoryDefnCacheStreamUtils::readInt(cursor);
+				return result;
+			}
+
+			void writeIntRect(std::vector<sf::Uint8>& buffer, const sf::IntRect& rect) {
+				StoryDefnCacheStreamUtils::writeInt(buffer, rect.left);
+				StoryDefnCacheStreamUtils::writeInt(buffer, rect.top);
+				StoryDefnCacheStreamUtils::writeInt(buffer, rect.width);
+				StoryDefnCacheStreamUtils::writeInt(buffer, rect.height);
+			}
+
+			sf::IntRect readIntRect(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				sf::IntRect result;
+				result.left = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.top = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.width = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.height = StoryDefnCacheStreamUtils::readInt(cursor);
+				return result;
+			}
+
+			void writeSnakePath(std::vector<sf::Uint8>& buffer, const StoryCutsceneDefn& cutsceneDefn, const StoryCutscenePathEventDefn& pathEventDefn) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, pathEventDefn.runCount);
+				for (int runIndex = 0; runIndex < pathEventDefn.runCount; runIndex++) {
+					const StorySnakePathRun& currRun = cutsceneDefn.pathRunList[pathEventDefn.firstRunIndex + runIndex];
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, currRun.stepCount);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, currRun.framesPerStep);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, currRun.direction);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, currRun.growFlag ? 1 : 0);
+				}
+			}
+
+			StoryCutscenePathEventDefn readSnakePath(StoryDefnCacheStreamUtils::ReadCursor& cursor, StoryCutsceneDefn& cutsceneDefn) {
+				StoryCutscenePathEventDefn result;
+				result.firstRunIndex = (int)cutsceneDefn.pathRunList.size();
+				result.runCount = (int)StoryDefnCacheStreamUtils::readCount(cursor);
+				for (int runIndex = 0; (runIndex < result.runCount) && cursor.validFlag; runIndex++) {
+					StorySnakePathRun currRun;
+					currRun.stepCount = (sf::Uint16)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					currRun.framesPerStep = (sf::Uint16)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					currRun.direction = (sf::Uint8)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					currRun.growFlag = (StoryDefnCacheStreamUtils::readVarUint(cursor) != 0);
+					cutsceneDefn.pathRunList.push_back(currRun);
+				}
+
+				// StoryCutscene walks the runs without bounds checks, so an empty or truncated path would not be safe to replay
+				cursor.validFlag =
+					cursor.validFlag &&
+					(result.runCount > 0) &&
+					((int)cutsceneDefn.pathRunList.size() == result.firstRunIndex + result.runCount);
+				return result;
+			}
+
+			// Payloads are written inline after each event, and filenames are interned again as they are read
+			void writeCutsceneEvent(std::vector<sf::Uint8>& buffer, const StoryCutsceneDefn& cutsceneDefn, const StoryCutsceneEventDefn& eventDefn) {
+				StoryDefnCacheStreamUtils::writeInt(buffer, eventDefn.framesSinceLastEvent);
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)eventDefn.eventType);
+
+				switch (eventDefn.eventType) {
+				case StoryCutsceneEventType::COLOR:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.colorEventList[eventDefn.payloadIndex].fadeFrames);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, cutsceneDefn.colorEventList[eventDefn.payloadIndex].color.toInteger());
+					break;
+				case StoryCutsceneEventType::TEXTURE:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.textureEventList[eventDefn.payloadIndex].fadeFrames);
+					StoryDefnCacheStreamUtils::writeString(buffer, cutsceneDefn.filenameList[cutsceneDefn.textureEventList[eventDefn.payloadIndex].filenameIndex]);
+					break;
+				case StoryCutsceneEventType::SHOW_MAP:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.mapEventList[eventDefn.payloadIndex].fadeFrames);
+					StoryDefnCacheStreamUtils::writeString(buffer, cutsceneDefn.filenameList[cutsceneDefn.mapEventList[eventDefn.payloadIndex].filenameIndex]);
+					break;
+				case StoryCutsceneEventType::SHOW_SNAKE:
+					writeSnakeStart(buffer, cutsceneDefn.snakeStartList[eventDefn.payloadIndex]);
+					break;
+				case StoryCutsceneEventType::MOVE_SNAKE:
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)cutsceneDefn.snakeEventList[eventDefn.payloadIndex].snakeDirection);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, cutsceneDefn.snakeEventList[eventDefn.payloadIndex].snakeGrowFlag ? 1 : 0);
+					break;
+				case StoryCutsceneEventType::MOVE_SNAKE_PATH:
+					writeSnakePath(buffer, cutsceneDefn, cutsceneDefn.pathEventList[eventDefn.payloadIndex]);
+					break;
+				case StoryCutsceneEventType::SHOW_FOOD:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.foodEventList[eventDefn.payloadIndex].instanceId);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)cutsceneDefn.foodEventList[eventDefn.payloadIndex].foodType);
+					StoryDefnCacheStreamUtils::writeVector(buffer, cutsceneDefn.foodEventList[eventDefn.payloadIndex].position);
+					break;
+				case StoryCutsceneEventType::HIDE_FOOD:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.foodEventList[eventDefn.payloadIndex].instanceId);
+					break;
+				case StoryCutsceneEventType::SHOW_DANGER:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.dangerEventList[eventDefn.payloadIndex].instanceId);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)cutsceneDefn.dangerEventList[eventDefn.payloadIndex].dangerType);
+					StoryDefnCacheStreamUtils::writeVector(buffer, cutsceneDefn.dangerEventList[eventDefn.payloadIndex].position);
+					break;
+				case StoryCutsceneEventType::HIDE_DANGER:
+					StoryDefnCacheStreamUtils::writeInt(buffer, cutsceneDefn.dangerEventList[eventDefn.payloadIndex].instanceId);
+					break;
+				default:
+					break;
+				}
+			}
+
+			void readCutsceneEvent(StoryDefnCacheStreamUtils::ReadCursor& cursor, StoryCutsceneDefn& cutsceneDefn) {
+				StoryCutsceneEventDefn eventDefn;
+				eventDefn.framesSinceLastEvent = StoryDefnCacheStreamUtils::readInt(cursor);
+				eventDefn.eventType = (StoryCutsceneEventType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				eventDefn.payloadIndex = -1;
+
+				StoryCutsceneColorEventDefn colorEvent;
+				StoryCutsceneTextureEventDefn textureEvent;
+				StoryCutsceneMapEventDefn mapEvent;
+				StoryCutsceneSnakeEventDefn snakeEvent;
+				StoryCutsceneFoodEventDefn foodEvent;
+				StoryCutsceneDangerEventDefn dangerEvent;
+
+				switch (eventDefn.eventType) {
+				case StoryCutsceneEventType::COLOR:
+					colorEvent.fadeFrames = StoryDefnCacheStreamUtils::readInt(cursor);
+					colorEvent.color = sf::Color((sf::Uint32)StoryDefnCacheStreamUtils::readVarUint(cursor));
+					eventDefn.payloadIndex = (int)cutsceneDefn.colorEventList.size();
+					cutsceneDefn.colorEventList.push_back(colorEvent);
+					break;
+				case StoryCutsceneEventType::TEXTURE:
+					textureEvent.fadeFrames = StoryDefnCacheStreamUtils::readInt(cursor);
+					textureEvent.filenameIndex = StoryLoaderUtils::internCutsceneFilename(cutsceneDefn, StoryDefnCacheStreamUtils::readString(cursor));
+					textureEvent.textureHandle = -1;
+					eventDefn.payloadIndex = (int)cutsceneDefn.textureEventList.size();
+					cutsceneDefn.textureEventList.push_back(textureEvent);
+					break;
+				case StoryCutsceneEventType::SHOW_MAP:
+					mapEvent.fadeFrames = StoryDefnCacheStreamUtils::readInt(cursor);
+					mapEvent.filenameIndex = StoryLoaderUtils::internCutsceneFilename(cutsceneDefn, StoryDefnCacheStreamUtils::readString(cursor));
+					mapEvent.mapHandle = -1;
+					eventDefn.payloadIndex = (int)cutsceneDefn.mapEventList.size();
+					cutsceneDefn.mapEventList.push_back(mapEvent);
+					break;
+				case StoryCutsceneEventType::SHOW_SNAKE:
+					eventDefn.payloadIndex = (int)cutsceneDefn.snakeStartList.size();
+					cutsceneDefn.snakeStartList.push_back(readSnakeStart(cursor));
+					break;
+				case StoryCutsceneEventType::MOVE_SNAKE:
+					snakeEvent.snakeDirection = (ObjectDirection)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					snakeEvent.snakeGrowFlag = (StoryDefnCacheStreamUtils::readVarUint(cursor) != 0);
+					eventDefn.payloadIndex = (int)cutsceneDefn.snakeEventList.size();
+					cutsceneDefn.snakeEventList.push_back(snakeEvent);
+					break;
+				case StoryCutsceneEventType::MOVE_SNAKE_PATH:
+					eventDefn.payloadIndex = (int)cutsceneDefn.pathEventList.size();
+					cutsceneDefn.pathEventList.push_back(readSnakePath(cursor, cutsceneDefn));
+					break;
+				case StoryCutsceneEventType::SHOW_FOOD:
+				case StoryCutsceneEventType::HIDE_FOOD:
+					foodEvent.instanceId = StoryDefnCacheStreamUtils::readInt(cursor);
+					if (eventDefn.eventType == StoryCutsceneEventType::SHOW_FOOD) {
+						foodEvent.foodType = (StoryFoodType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+						foodEvent.position = StoryDefnCacheStreamUtils::readVector(cursor);
+					}
+					eventDefn.payloadIndex = (int)cutsceneDefn.foodEventList.size();
+					cutsceneDefn.foodEventList.push_back(foodEvent);
+					break;
+				case StoryCutsceneEventType::SHOW_DANGER:
+				case StoryCutsceneEventType::HIDE_DANGER:
+					dangerEvent.instanceId = StoryDefnCacheStreamUtils::readInt(cursor);
+					if (eventDefn.eventType == StoryCutsceneEventType::SHOW_DANGER) {
+						dangerEvent.dangerType = (StoryDangerType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+						dangerEvent.position = StoryDefnCacheStreamUtils::readVector(cursor);
+					}
+					eventDefn.payloadIndex = (int)cutsceneDefn.dangerEventList.size();
+					cutsceneDefn.dangerEventList.push_back(dangerEvent);
+					break;
+				default:
+					break;
+				}
+
+				cutsceneDefn.eventDefnList.push_back(eventDefn);
+			}
+
+			void writeCutscene(std::vector<sf::Uint8>& buffer, const StoryCutsceneDefn& cutsceneDefn) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, cutsceneDefn.existsFlag ? 1 : 0);
+				if (cutsceneDefn.existsFlag) {
+					StoryDefnCacheStreamUtils::writeString(buffer, cutsceneDefn.soundTrackFilename);
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, cutsceneDefn.eventDefnList.size());
+					for (auto const& currEventDefn : cutsceneDefn.eventDefnList) {
+						writeCutsceneEvent(buffer, cutsceneDefn, currEventDefn);
+					}
+				}
+			}
+
+			StoryCutsceneDefn readCutscene(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryCutsceneDefn result;
+				result.existsFlag = (StoryDefnCacheStreamUtils::readVarUint(cursor) != 0);
+				if (result.existsFlag) {
+					result.soundTrackFilename = StoryDefnCacheStreamUtils::readString(cursor);
+					size_t eventCount = StoryDefnCacheStreamUtils::readCount(cursor);
+					result.eventDefnList.reserve(eventCount);
+					for (size_t eventIndex = 0; (eventIndex < eventCount) && cursor.validFlag; eventIndex++) {
+						readCutsceneEvent(cursor, result);
+					}
+				}
+				return result;
+			}
+
+			void writeWinCondition(std::vector<sf::Uint8>& buffer, const StoryWinCondition& winCondition) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)winCondition.conditionType);
+
+				switch (winCondition.conditionType) {
+				case StoryWinConditionType::ON_FOOD_EATEN:
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)winCondition.foodType);
+					StoryDefnCacheStreamUtils::writeInt(buffer, winCondition.foodCount);
+					break;
+				case StoryWinConditionType::ON_LENGTH_REACHED:
+					StoryDefnCacheStreamUtils::writeInt(buffer, winCondition.snakeLength);
+					break;
+				case StoryWinConditionType::ON_TIME_SURVIVED:
+					StoryDefnCacheStreamUtils::writeInt(buffer, winCondition.timePassed);
+					break;
+				default:
+					break;
+				}
+			}
+
+			StoryWinCondition readWinCondition(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryWinCondition result;
+				result.conditionType = (StoryWinConditionType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+
+				switch (result.conditionType) {
+				case StoryWinConditionType::ON_FOOD_EATEN:
+					result.foodType = (StoryFoodType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					result.foodCount = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryWinConditionType::ON_LENGTH_REACHED:
+					result.snakeLength = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryWinConditionType::ON_TIME_SURVIVED:
+					result.timePassed = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				default:
+					cursor.validFlag = false;
+					break;
+				}
+
+				return result;
+			}
+
+			void writeFood(std::vector<sf::Uint8>& buffer, const StoryFoodDefn& foodDefn) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)foodDefn.foodType);
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)foodDefn.spawnType);
+				StoryDefnCacheStreamUtils::writeFloat(buffer, foodDefn.chancePct);
+				StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.maxSpawnCount);
+				StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.growthRate);
+
+				switch (foodDefn.spawnType) {
+				case StoryObjectSpawnType::ON_LENGTH_REACHED:
+					StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.lengthReached);
+					break;
+				case StoryObjectSpawnType::ON_TIMER:
+					StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.timePassed);
+					StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.interval);
+					break;
+				case StoryObjectSpawnType::ON_HEALTH_FELL:
+					StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.health);
+					break;
+				case StoryObjectSpawnType::ON_SNAKE_POSITION:
+					writeIntRect(buffer, foodDefn.region);
+					break;
+				case StoryObjectSpawnType::ON_FOOD_EATEN:
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)foodDefn.eatenFoodType);
+					StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.eatenFoodCount);
+					break;
+				default:
+					break;
+				}
+
+				StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.minFloorId);
+				StoryDefnCacheStreamUtils::writeInt(buffer, foodDefn.maxFloorId);
+			}
+
+			StoryFoodDefn readFood(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryFoodDefn result;
+				result.foodType = (StoryFoodType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.spawnType = (StoryObjectSpawnType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.chancePct = StoryDefnCacheStreamUtils::readFloat(cursor);
+				result.maxSpawnCount = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.growthRate = StoryDefnCacheStreamUtils::readInt(cursor);
+
+				switch (result.spawnType) {
+				case StoryObjectSpawnType::ON_LENGTH_REACHED:
+					result.lengthReached = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryObjectSpawnType::ON_TIMER:
+					result.timePassed = StoryDefnCacheStreamUtils::readInt(cursor);
+					result.interval = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryObjectSpawnType::ON_HEALTH_FELL:
+					result.health = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryObjectSpawnType::ON_SNAKE_POSITION:
+					result.region = readIntRect(cursor);
+					break;
+				case StoryObjectSpawnType::ON_FOOD_EATEN:
+					result.eatenFoodType = (StoryFoodType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					result.eatenFoodCount = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				default:
+					break;
+				}
+
+				result.minFloorId = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.maxFloorId = StoryDefnCacheStreamUtils::readInt(cursor);
+				return result;
+			}
+
+			void writeDanger(std::vector<sf::Uint8>& buffer, const StoryDangerDefn& dangerDefn) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)dangerDefn.dangerType);
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)dangerDefn.spawnType);
+				StoryDefnCacheStreamUtils::writeFloat(buffer, dangerDefn.chancePct);
+				StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.maxSpawnCount);
+				StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.interval);
+
+				switch (dangerDefn.spawnType) {
+				case StoryObjectSpawnType::ON_TIMER:
+					StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.timePassed);
+					break;
+				case StoryObjectSpawnType::ON_LENGTH_REACHED:
+					StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.lengthReached);
+					break;
+				case StoryObjectSpawnType::ON_SNAKE_POSITION:
+					writeIntRect(buffer, dangerDefn.region);
+					break;
+				default:
+					break;
+				}
+
+				StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.minFloorId);
+				StoryDefnCacheStreamUtils::writeInt(buffer, dangerDefn.maxFloorId);
+			}
+
+			StoryDangerDefn readDanger(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryDangerDefn result;
+				result.dangerType = (StoryDangerType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.spawnType = (StoryObjectSpawnType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.chancePct = StoryDefnCacheStreamUtils::readFloat(cursor);
+				result.maxSpawnCount = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.interval = StoryDefnCacheStreamUtils::readInt(cursor);
+
+				switch (result.spawnType) {
+				case StoryObjectSpawnType::ON_TIMER:
+					result.timePassed = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryObjectSpawnType::ON_LENGTH_REACHED:
+					result.lengthReached = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StoryObjectSpawnType::ON_SNAKE_POSITION:
+					result.region = readIntRect(cursor);
+					break;
+				default:
+					break;
+				}
+
+				result.minFloorId = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.maxFloorId = StoryDefnCacheStreamUtils::readInt(cursor);
+				return result;
+			}
+
+			void writeSoundFx(std::vector<sf::Uint8>& buffer, const StorySoundFxDefn& soundFxDefn) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)soundFxDefn.triggerType);
+				StoryDefnCacheStreamUtils::writeString(buffer, soundFxDefn.soundFilename);
+
+				switch (soundFxDefn.triggerType) {
+				case StorySoundFxTriggerType::ON_TIMER:
+					StoryDefnCacheStreamUtils::writeInt(buffer, soundFxDefn.timePassed);
+					break;
+				case StorySoundFxTriggerType::ON_FIRST_FOOD_SPAWN:
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)soundFxDefn.foodType);
+					break;
+				case StorySoundFxTriggerType::ON_FIRST_DANGER_SPAWN:
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (sf::Uint64)soundFxDefn.dangerType);
+					break;
+				case StorySoundFxTriggerType::ON_LENGTH_REACHED:
+					StoryDefnCacheStreamUtils::writeInt(buffer, soundFxDefn.lengthReached);
+					break;
+				default:
+					break;
+				}
+			}
+
+			StorySoundFxDefn readSoundFx(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StorySoundFxDefn result;
+				result.triggerType = (StorySoundFxTriggerType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+				result.soundFilename = StoryDefnCacheStreamUtils::readString(cursor);
+				result.soundBufferHandle = -1;
+
+				switch (result.triggerType) {
+				case StorySoundFxTriggerType::ON_TIMER:
+					result.timePassed = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				case StorySoundFxTriggerType::ON_FIRST_FOOD_SPAWN:
+					result.foodType = (StoryFoodType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					break;
+				case StorySoundFxTriggerType::ON_FIRST_DANGER_SPAWN:
+					result.dangerType = (StoryDangerType)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					break;
+				case StorySoundFxTriggerType::ON_LENGTH_REACHED:
+					result.lengthReached = StoryDefnCacheStreamUtils::readInt(cursor);
+					break;
+				default:
+					break;
+				}
+
+				return result;
+			}
+
+			void writeLevel(std::vector<sf::Uint8>& buffer, const StoryLevelDefn& levelDefn) {
+				writeCutscene(buffer, levelDefn.openingCutsceneDefn);
+				writeCutscene(buffer, levelDefn.winCutsceneDefn);
+				writeCutscene(buffer, levelDefn.lossCutsceneDefn);
+				StoryDefnCacheStreamUtils::writeString(buffer, levelDefn.musicFilename);
+				StoryDefnCacheStreamUtils::writeString(buffer, levelDefn.mapFilename);
+				writeSnakeStart(buffer, levelDefn.snakeStart);
+				StoryDefnCacheStreamUtils::writeInt(buffer, levelDefn.snakeSpeedTilesPerSecond);
+				StoryDefnCacheStreamUtils::writeInt(buffer, levelDefn.maxSnakeHealth);
+				writeWinCondition(buffer, levelDefn.winCondition);
+
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, levelDefn.foodDefnList.size());
+				for (auto const& currFoodDefn : levelDefn.foodDefnList) {
+					writeFood(buffer, currFoodDefn);
+				}
+
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, levelDefn.dangerDefnList.size());
+				for (auto const& currDangerDefn : levelDefn.dangerDefnList) {
+					writeDanger(buffer, currDangerDefn);
+				}
+
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, levelDefn.soundFxDefnList.size());
+				for (auto const& currSoundFxDefn : levelDefn.soundFxDefnList) {
+					writeSoundFx(buffer, currSoundFxDefn);
+				}
+			}
+
+			StoryLevelDefn readLevel(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryLevelDefn result;
+				result.openingCutsceneDefn = readCutscene(cursor);
+				result.winCutsceneDefn = readCutscene(cursor);
+				result.lossCutsceneDefn = readCutscene(cursor);
+				result.musicFilename = StoryDefnCacheStreamUtils::readString(cursor);
+				result.mapFilename = StoryDefnCacheStreamUtils::readString(cursor);
+				result.snakeStart = readSnakeStart(cursor);
+				result.snakeSpeedTilesPerSecond = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.maxSnakeHealth = StoryDefnCacheStreamUtils::readInt(cursor);
+				result.winCondition = readWinCondition(cursor);
+
+				size_t foodCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t foodIndex = 0; (foodIndex < foodCount) && cursor.validFlag; foodIndex++) {
+					result.foodDefnList.push_back(readFood(cursor));
+				}
+
+				size_t dangerCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t dangerIndex = 0; (dangerIndex < dangerCount) && cursor.validFlag; dangerIndex++) {
+					result.dangerDefnList.push_back(readDanger(cursor));
+				}
+
+				size_t soundFxCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t soundFxIndex = 0; (soundFxIndex < soundFxCount) && cursor.validFlag; soundFxIndex++) {
+					result.soundFxDefnList.push_back(readSoundFx(cursor));
+				}
+
+				return result;
+			}
+
+			void writeTileDefnMap(std::vector<sf::Uint8>& buffer, const std::unordered_map<int, StoryMapTileDefn>& tileDefnMap) {
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, tileDefnMap.size());
+				for (auto const& currTileDefnPair : tileDefnMap) {
+					StoryDefnCacheStreamUtils::writeInt(buffer, currTileDefnPair.second.tileId);
+					StoryDefnCacheStreamUtils::writeString(buffer, currTileDefnPair.second.filename);
+				}
+			}
+
+			void readTileDefnMap(StoryDefnCacheStreamUtils::ReadCursor& cursor, std::unordered_map<int, StoryMapTileDefn>& tileDefnMap) {
+				size_t tileCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t tileIndex = 0; (tileIndex < tileCount) && cursor.validFlag; tileIndex++) {
+					StoryMapTileDefn currTileDefn;
+					currTileDefn.tileId = StoryDefnCacheStreamUtils::readInt(cursor);
+					currTileDefn.filename = StoryDefnCacheStreamUtils::readString(cursor);
+					tileDefnMap[currTileDefn.tileId] = currTileDefn;
+				}
+			}
+
+			void writeTileGrid(std::vector<sf::Uint8>& buffer, const std::shared_ptr<const StoryMapTileGrid>& tileGrid) {
+				size_t tileCount = (tileGrid != nullptr) ? tileGrid->size() : 0;
+				StoryDefnCacheStreamUtils::writeVarUint(buffer, tileCount);
+				for (size_t tileIndex = 0; tileIndex < tileCount; tileIndex++) {
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, (*tileGrid)[tileIndex].floorId);
+					buffer.push_back((*tileGrid)[tileIndex].barrierId);
+				}
+			}
+
+			std::shared_ptr<const StoryMapTileGrid> readTileGrid(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				size_t tileCount = StoryDefnCacheStreamUtils::readCount(cursor);
+
+				StoryMapTileGrid* tileGrid = new StoryMapTileGrid(tileCount);
+				for (size_t tileIndex = 0; (tileIndex < tileCount) && cursor.validFlag; tileIndex++) {
+					(*tileGrid)[tileIndex].floorId = (sf::Uint16)StoryDefnCacheStreamUtils::readVarUint(cursor);
+					(*tileGrid)[tileIndex].barrierId = StoryDefnCacheStreamUtils::readByte(cursor);
+				}
+
+				std::shared_ptr<const StoryMapTileGrid> result(tileGrid);
+				return result;
+			}
+
+			void writeMap(std::vector<sf::Uint8>& buffer, const StoryMapDefn& mapDefn) {
+				StoryDefnCacheStreamUtils::writeVector(buffer, mapDefn.fieldSize);
+				writeTileDefnMap(buffer, mapDefn.floorDefnMap);
+				writeTileDefnMap(buffer, mapDefn.barrierDefnMap);
+				writeTileGrid(buffer, mapDefn.tileGrid);
+			}
+
+			StoryMapDefn readMap(StoryDefnCacheStreamUtils::ReadCursor& cursor) {
+				StoryMapDefn result;
+				result.fieldSize = StoryDefnCacheStreamUtils::readVector(cursor);
+				readTileDefnMap(cursor, result.floorDefnMap);
+				readTileDefnMap(cursor, result.barrierDefnMap);
+				result.tileGrid = readTileGrid(cursor);
+				return result;
+			}
+
+		}
+
+		namespace StoryDefnCacheDependencyUtils {
+
+			typedef struct Snake_StoryDefnCacheDependency {
+				std::string filePath;
+				sf::Uint8 dependencyKind;
+				sf::Uint64 value;
+			} StoryDefnCacheDependency;
+
+			// Every tracked file is hashed on each warm load, music included, so the contents are taken eight bytes at
+			// a time.  Each step is invertible, so a change to any one word always changes the hash.
+			sf::Uint64 hashFileContents(const char* fileData, size_t fileSize) {
+				sf::Uint64 result = StoryDefnCacheConstants::CONTENT_HASH_OFFSET ^ fileSize;
+
+				size_t wordCount = fileSize / sizeof(sf::Uint64);
+				for (size_t wordIndex = 0; wordIndex < wordCount; wordIndex++) {
+					sf::Uint64 word;
+					memcpy(&word, fileData + (wordIndex * sizeof(sf::Uint64)), sizeof(word));
+					result = (result ^ word) * StoryDefnCacheConstants::CONTENT_HASH_PRIME;
+				}
+				for (size_t byteIndex = wordCount * sizeof(sf::Uint64); byteIndex < fileSize; byteIndex++) {
+					result = (result ^ (sf::Uint8)fileData[byteIndex]) * StoryDefnCacheConstants::CONTENT_HASH_PRIME;
+				}
+
+				return result;
+			}
+
+			bool resolveDependencyValue(const std::string& filePath, sf::Uint8 dependencyKind, sf::Uint64& value) {
+				bool result = false;
+
+				if (dependencyKind == StoryDefnCacheConstants::DEPENDENCY_CONTENT_HASH) {
+					StoryFileContents fileContents;
+					result = StoryArchiveUtils::readFile(filePath, fileContents);
+					if (result) {
+						value = hashFileContents(fileContents.getData(), fileContents.getSize());
+					}
+				}
+
+				return result;
+			}
+
+			void addDependency(std::vector<StoryDefnCacheDependency>& dependencyList, std::set<std::string>& filePathSet, const std::string& filePath, sf::Uint8 dependencyKind) {
+				if (filePathSet.insert(filePath).second) {
+					StoryDefnCacheDependency dependency;
+					dependency.filePath = filePath;
+					dependency.dependencyKind = dependencyKind;
+					dependency.value = 0;
+					dependencyList.push_back(dependency);
+				}
+			}
+
+			void addTileDependencies(std::vector<StoryDefnCacheDependency>& dependencyList, std::set<std::string>& filePathSet, const std::string& campaignFolderName, const std::unordered_map<int, StoryMapTileDefn>& tileDefnMap) {
+				for (auto const& currTileDefnPair : tileDefnMap) {
+					std::string imageFilePath = StoryLoaderUtils::resolveImageFilePath(campaignFolderName, currTileDefnPair.second.filename);
+					addDependency(dependencyList, filePathSet, imageFilePath, StoryDefnCacheConstants::DEPENDENCY_CONTENT_HASH);
+				}
+			}
+
+			// Only files whose contents the loader validates are tracked; sound effects and cutscene
+			// textures are checked when a level's assets are loaded, not when the campaign is
+			std::vector<StoryDefnCacheDependency> buildDependencyList(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadResult, const std::unordered_map<std::string, StoryMapDefn>& mapDefnMap) {
+				std::vector<StoryDefnCacheDependency> result;
+				std::set<std::string> filePathSet;
+
+				addDependency(result, filePathSet, StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName), StoryDefnCacheConstants::DEPENDENCY_CONTENT_HASH);
+
+				for (auto const& currLevelResult : loadResult.levelResultList) {
+					if (!currLevelResult.levelDefn.musicFilename.empty()) {
+						std::string musicFilePath = StoryLoaderUtils::resolveMusicFilePath(campaignFolderName, currLevelResult.levelDefn.musicFilename);
+						addDependency(result, filePathSet, musicFilePath, StoryDefnCacheConstants::DEPENDENCY_CONTENT_HASH);
+					}
+				}
+
+				for (auto const& currMapDefnPair : mapDefnMap) {
+					std::string mapFilePath = StoryLoaderUtils::resolveMapFilePath(campaignFolderName, currMapDefnPair.first);
+					addDependency(result, filePathSet, mapFilePath, StoryDefnCacheConstants::DEPENDENCY_CONTENT_HASH);
+					addTileDependencies(result, filePathSet, campaignFolderName, currMapDefnPair.second.floorDefnMap);
+					addTileDependencies(result, filePathSet, campaignFolderName, currMapDefnPair.second.barrierDefnMap);
+				}
+
+				return result;
+			}
+
+		}
+
+		namespace StoryDefnCacheRegistry {
+
+			typedef struct Snake_StoryDefnCacheEntry {
+				bool loadedFromCacheFlag = false;
+				std::unordered_map<std::string, StoryMapDefn> mapDefnMap;
+			} StoryDefnCacheEntry;
+
+			// Maps are looked up from level asset loading threads, so the registry is shared under a mutex
+			sf::Mutex registryMutex;
+			std::unordered_map<std::string, StoryDefnCacheEntry> entryMap;
+
+			void storeEntry(const std::string& campaignFolderName, const StoryDefnCacheEntry& entry) {
+				registryMutex.lock();
+
+				entryMap[campaignFolderName] = entry;
+
+				registryMutex.unlock();
+			}
+
+			void eraseEntry(const std::string& campaignFolderName) {
+				registryMutex.lock();
+
+				entryMap.erase(campaignFolderName);
+
+				registryMutex.unlock();
+			}
+
+		}
+
+		namespace StoryDefnCacheUtils {
+
+			std::set<std::string> resolveMapFilenameSet(const LoadStoryCampaignResult& loadResult) {
+				std::set<std::string> result;
+
+				for (auto const& currLevelResult : loadResult.levelResultList) {
+					const StoryLevelDefn& levelDefn = currLevelResult.levelDefn;
+					result.insert(levelDefn.mapFilename);
+
+					const StoryCutsceneDefn* cutsceneDefnList[] = { &levelDefn.openingCutsceneDefn, &levelDefn.winCutsceneDefn, &levelDefn.lossCutsceneDefn };
+					for (const StoryCutsceneDefn* currCutsceneDefn : cutsceneDefnList) {
+						for (auto const& currMapEventDefn : currCutsceneDefn->mapEventList) {
+							result.insert(currCutsceneDefn->filenameList[currMapEventDefn.filenameIndex]);
+						}
+					}
+				}
+
+				return result;
+			}
+
+			// Everything the cache holds was valid when it was written, so all of the checks are marked as passed
+			LoadStoryLevelResult buildCachedLevelResult(const StoryLevelDefn& levelDefn) {
+				LoadStoryLevelResult result;
+				result.levelDefn = levelDefn;
+
+				LoadStoryCutsceneValidationResult* cutsceneValidationResultList[] = {
+					&result.validationResult.openingCutsceneValidationResult,
+					&result.validationResult.winCutsceneValidationResult,
+					&result.validationResult.lossCutsceneValidationResult,
+				};
+				const StoryCutsceneDefn* cutsceneDefnList[] = { &levelDefn.openingCutsceneDefn, &levelDefn.winCutsceneDefn, &levelDefn.lossCutsceneDefn };
+				for (int cutsceneIndex = 0; cutsceneIndex < 3; cutsceneIndex++) {
+					cutsceneValidationResultList[cutsceneIndex]->existsFlag = cutsceneDefnList[cutsceneIndex]->existsFlag;
+					cutsceneValidationResultList[cutsceneIndex]->rootValid = true;
+					cutsceneValidationResultList[cutsceneIndex]->eventListValid = true;
+				}
+
+				result.validationResult.musicValid = true;
+				result.validationResult.mapValid = true;
+				result.validationResult.snakeStartValid = true;
+				result.validationResult.snakeStartPositionValid = true;
+				result.validationResult.snakeStartDirectionValid = true;
+				result.validationResult.snakeStartLengthValid = true;
+				result.validationResult.snakeSpeedValid = true;
+				result.validationResult.snakeHealthValid = true;
+				result.validationResult.winConditionValid = true;
+				result.validationResult.winConditionTypeValid = true;
+				result.validationResult.foodListValid = true;
+				result.validationResult.dangerListValid = true;
+				result.validationResult.soundFxListValid = true;
+
+				return result;
+			}
+
+			LoadStoryMapResult buildCachedMapResult(const StoryMapDefn& mapDefn) {
+				LoadStoryMapResult result;
+				result.mapDefn = mapDefn;
+				result.validationResult.widthValid = true;
+				result.validationResult.heightValid = true;
+				result.validationResult.floorListValid = true;
+				result.validationResult.barrierListValid = true;
+				result.validationResult.floorGridValid = true;
+				result.validationResult.barrierGridValid = true;
+				return result;
+			}
+
+			std::string resolveCacheFilePath(const std::string& campaignFolderName) {
+				std::string result(StoryLoaderUtils::PATH_CAMPAIGNS);
+				result.append(campaignFolderName);
+				result.append(StoryDefnCacheConstants::CACHE_FILE_EXTENSION);
+				return result;
+			}
+
+			bool loadCachedCampaign(const std::string& campaignFolderName, LoadStoryCampaignResult& loadResult) {
+				// Any miss drops what was remembered, so the maps are parsed again along with the campaign
+				StoryDefnCacheRegistry::eraseEntry(campaignFolderName);
+
+				std::ifstream cacheStream(resolveCacheFilePath(campaignFolderName), std::ios_base::binary);
+				if (!cacheStream.is_open()) {
+					return false;
+				}
+
+				std::vector<sf::Uint8> buffer((std::istreambuf_iterator<char>(cacheStream)), std::istreambuf_iterator<char>());
+
+				StoryDefnCacheStreamUtils::ReadCursor cursor;
+				cursor.buffer = &buffer;
+				cursor.position = 0;
+				cursor.validFlag = true;
+
+				for (int magicIndex = 0; magicIndex < 4; magicIndex++) {
+					cursor.validFlag = cursor.validFlag && (StoryDefnCacheStreamUtils::readByte(cursor) == (sf::Uint8)StoryDefnCacheConstants::CACHE_FILE_MAGIC[magicIndex]);
+				}
+				cursor.validFlag = cursor.validFlag && (StoryDefnCacheStreamUtils::readByte(cursor) == StoryDefnCacheConstants::CACHE_FILE_VERSION);
+
+				// Dependencies come first so a stale cache is rejected before any definitions are decoded
+				size_t dependencyCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t dependencyIndex = 0; (dependencyIndex < dependencyCount) && cursor.validFlag; dependencyIndex++) {
+					std::string filePath = StoryDefnCacheStreamUtils::readString(cursor);
+					sf::Uint8 dependencyKind = StoryDefnCacheStreamUtils::readByte(cursor);
+					sf::Uint64 cachedValue = StoryDefnCacheStreamUtils::readVarUint(cursor);
+
+					sf::Uint64 currValue = 0;
+					cursor.validFlag =
+						cursor.validFlag &&
+						StoryDefnCacheDependencyUtils::resolveDependencyValue(filePath, dependencyKind, currValue) &&
+						(currValue == cachedValue);
+				}
+
+				LoadStoryCampaignResult cachedResult;
+				cachedResult.levelListValid = true;
+
+				size_t levelCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t levelIndex = 0; (levelIndex < levelCount) && cursor.validFlag; levelIndex++) {
+					cachedResult.levelResultList.push_back(buildCachedLevelResult(StoryDefnCacheSerializeUtils::readLevel(cursor)));
+				}
+
+				StoryDefnCacheRegistry::StoryDefnCacheEntry entry;
+				entry.loadedFromCacheFlag = true;
+
+				size_t mapCount = StoryDefnCacheStreamUtils::readCount(cursor);
+				for (size_t mapIndex = 0; (mapIndex < mapCount) && cursor.validFlag; mapIndex++) {
+					std::string mapFilename = StoryDefnCacheStreamUtils::readString(cursor);
+					entry.mapDefnMap[mapFilename] = StoryDefnCacheSerializeUtils::readMap(cursor);
+				}
+
+				bool result =
+					cursor.validFlag &&
+					(cursor.position == buffer.size()) &&
+					(levelCount > 0);
+				if (result) {
+					StoryDefnCacheRegistry::storeEntry(campaignFolderName, entry);
+					loadResult = cachedResult;
+				}
+
+				return result;
+			}
+
+			bool saveCachedCampaign(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadResult) {
+				StoryDefnCacheRegistry::StoryDefnCacheEntry entry;
+
+				bool result = loadResult.valid();
+
+				// A campaign with a broken map is left uncached, so the error still surfaces when the level loads
+				std::set<std::string> mapFilenameSet = resolveMapFilenameSet(loadResult);
+				for (auto const& currMapFilename : mapFilenameSet) {
+					if (result) {
+						LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(campaignFolderName, currMapFilename);
+						result = loadMapResult.validationResult.valid();
+						entry.mapDefnMap[currMapFilename] = loadMapResult.mapDefn;
+					}
+				}
+
+				std::vector<StoryDefnCacheDependencyUtils::StoryDefnCacheDependency> dependencyList;
+				if (result) {
+					dependencyList = StoryDefnCacheDependencyUtils::buildDependencyList(campaignFolderName, loadResult, entry.mapDefnMap);
+					for (auto& currDependency : dependencyList) {
+						result = result && StoryDefnCacheDependencyUtils::resolveDependencyValue(currDependency.filePath, currDependency.dependencyKind, currDependency.value);
+					}
+				}
+
+				if (result) {
+					std::vector<sf::Uint8> buffer;
+					buffer.insert(buffer.end(), StoryDefnCacheConstants::CACHE_FILE_MAGIC, StoryDefnCacheConstants::CACHE_FILE_MAGIC + 4);
+					buffer.push_back(StoryDefnCacheConstants::CACHE_FILE_VERSION);
+
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, dependencyList.size());
+					for (auto const& currDependency : dependencyList) {
+						StoryDefnCacheStreamUtils::writeString(buffer, currDependency.filePath);
+						buffer.push_back(currDependency.dependencyKind);
+						StoryDefnCacheStreamUtils::writeVarUint(buffer, currDependency.value);
+					}
+
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, loadResult.levelResultList.size());
+					for (auto const& currLevelResult : loadResult.levelResultList) {
+						StoryDefnCacheSerializeUtils::writeLevel(buffer, currLevelResult.levelDefn);
+					}
+
+					StoryDefnCacheStreamUtils::writeVarUint(buffer, entry.mapDefnMap.size());
+					for (auto const& currMapDefnPair : entry.mapDefnMap) {
+						StoryDefnCacheStreamUtils::writeString(buffer, currMapDefnPair.first);
+						StoryDefnCacheSerializeUtils::writeMap(buffer, currMapDefnPair.second);
+					}
+
+					std::ofstream cacheStream(resolveCacheFilePath(campaignFolderName), std::ios_base::binary | std::ios_base::trunc);
+					cacheStream.write((const char*)buffer.data(), buffer.size());
+					result = cacheStream.good();
+
+					// The maps were just parsed, so later lookups this session can use them even if the write failed
+					StoryDefnCacheRegistry::storeEntry(campaignFolderName, entry);
+				}
+
+				return result;
+			}
+
+			bool findCachedMap(const std::string& campaignFolderName, const std::string& mapFilename, LoadStoryMapResult& loadResult) {
+				bool result = false;
+
+				StoryDefnCacheRegistry::registryMutex.lock();
+
+				auto entryItr = StoryDefnCacheRegistry::entryMap.find(campaignFolderName);
+				if (entryItr != StoryDefnCacheRegistry::entryMap.end()) {
+					auto mapDefnItr = entryItr->second.mapDefnMap.find(mapFilename);
+					if (mapDefnItr != entryItr->second.mapDefnMap.end()) {
+						loadResult = buildCachedMapResult(mapDefnItr->second);
+						result = true;
+					}
+				}
+
+				StoryDefnCacheRegistry::registryMutex.unlock();
+
+				return result;
+			}
+
+			bool wasLoadedFromCache(const std::string& campaignFolderName) {
+				StoryDefnCacheRegistry::registryMutex.lock();
+
+				auto entryItr = StoryDefnCacheRegistry::entryMap.find(campaignFolderName);
+				bool result =
+					(entryItr != StoryDefnCacheRegistry::entryMap.end()) &&
+					entryItr->second.loadedFromCacheFlag;
+
+				StoryDefnCacheRegistry::registryMutex.unlock();
+
+				return result;
+			}
+
+			void forgetCachedCampaign(const std::string& campaignFolderName) {
+				StoryDefnCacheRegistry::eraseEntry(campaignFolderName);
+			}
+
+			int loadReferencedMaps(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadResult) {
+				int result = 0;
+
+				std::set<std::string> mapFilenameSet = resolveMapFilenameSet(loadResult);
+				for (auto const& currMapFilename : mapFilenameSet) {
+					LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(campaignFolderName, currMapFilename);
+					if (loadMapResult.validationResult.valid()) {
+						result++;
+					}
+				}
+
+				return result;
+			}
+
+			StoryDefnCacheLoadTimes measureLoadTimes(const std::string& campaignFolderName) {
+				StoryDefnCacheLoadTimes result;
+
+				std::string cacheFilePath = resolveCacheFilePath(campaignFolderName);
+				remove(cacheFilePath.c_str());
+				forgetCachedCampaign(campaignFolderName);
+
+				sf::Clock loadClock;
+
+				LoadStoryCampaignResult coldLoadResult = StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				result.mapCount = loadReferencedMaps(campaignFolderName, coldLoadResult);
+				result.coldSeconds = loadClock.getElapsedTime().asSeconds();
+
+				result.campaignValid = coldLoadResult.valid();
+				if (!result.campaignValid) {
+					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildErrorMessages(coldLoadResult));
+				}
+				result.cacheWritten = std::ifstream(cacheFilePath, std::ios_base::binary).is_open();
+
+				// Start the warm run from the file on disk, as a fresh launch of the game would
+				forgetCachedCampaign(campaignFolderName);
+				loadClock.restart();
+
+				LoadStoryCampaignResult warmLoadResult = StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				loadReferencedMaps(campaignFolderName, warmLoadResult);
+				result.warmSeconds = loadClock.getElapsedTime().asSeconds();
+
+				result.warmCacheHit = wasLoadedFromCache(campaignFolderName);
+
+				return result;
+			}
+
+			std::vector<std::string> buildLoadTimeMessages(const StoryDefnCacheLoadTimes& loadTimes) {
+				std::vector<std::string> result;
+
+				if (!loadTimes.campaignValid) {
+					result.push_back("The campaign is not valid, so no definition cache was written (see log.txt for details)");
+				}
+				else {
+					char message[512];
+
+					snprintf(message, sizeof(message), "Cold load (parse and validate): %.2f ms for the campaign and %d maps", loadTimes.coldSeconds * 1000.0f, loadTimes.mapCount);
+					result.push_back(message);
+
+					snprintf(message, sizeof(message), "Warm load (%s): %.2f ms", loadTimes.warmCacheHit ? "definition cache" : "cache missed", loadTimes.warmSeconds * 1000.0f);
+					result.push_back(message);
+
+					if (loadTimes.warmCacheHit && (loadTimes.warmSeconds > 0.0f)) {
+						snprintf(message, sizeof(message), "Speedup: %.1fx", loadTimes.coldSeconds / loadTimes.warmSeconds);
+						result.push_back(message);
+					}
+
+					if (!loadTimes.cacheWritten) {
+						result.push_back("Warning: the definition cache file could not be written");
+					}
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -1,5 +1,6 @@
 
 #include <assert.h>
+#include <algorithm>
 #include "../includes/r3-snake-storymodescene.hpp"
 
 namespace r3 {
@@ -11,6 +12,7 @@ namespace r3 {
 
 			this->chancePctDistribution = std::uniform_real_distribution<float>(0.0f, 100.0f);
 
+			this->foodInstanceCount = 0;
 			this->spawnCount = 0;
 			this->timeOfLastChanceCheck = sf::seconds(-1.0f);
 			this->timeOfLastSpawn = sf::seconds(0.0f);
@@ -20,15 +22,8 @@ namespace r3 {
 			return *this->foodDefn;
 		}
 
-		const std::vector<StoryFoodInstance>& StoryFoodSpawnTracker::getFoodInstanceList() const {
-			return this->foodInstanceList;
-		}
-
-		StoryFoodInstance StoryFoodSpawnTracker::getFoodInstance(int foodInstanceId) const {
-			int index = this->findFoodInstanceIndex(foodInstanceId);
-			assert(index >= 0);
-
-			return( this->foodInstanceList[index] );
+		int StoryFoodSpawnTracker::getFoodInstanceCount() const {
+			return this->foodInstanceCount;
 		}
 
 		bool StoryFoodSpawnTracker::shouldFoodSpawn(const StoryFoodSpawnCheckInput& input) {
@@ -74,39 +69,83 @@ namespace r3 {
 			return result;
 		}
 
-		StoryFoodPositionCheckResult StoryFoodSpawnTracker::occupiesPosition(const sf::Vector2i& position) const {
-			StoryFoodPositionCheckResult result;
-			result.foodExistsFlag = false;
-			result.foodInstanceId = 0;
+		// Only timed food keeps spawning while earlier instances are still uneaten
+		int StoryFoodSpawnTracker::resolveMaxFoodInstanceCount() const {
+			int result = 1;
+			if (this->foodDefn->spawnType == StoryObjectSpawnType::ON_TIMER) {
+				result = this->foodDefn->maxSpawnCount;
+			}
+			return result;
+		}
+
+		bool StoryFoodSpawnTracker::canSpawnAgain() const {
+			bool result = (this->spawnCount < this->foodDefn->maxSpawnCount);
+			return result;
+		}
+
+		bool StoryFoodSpawnTracker::areTimeConditionsMet(const sf::Time& timeSinceLevelStarted) const {
+			sf::Time timeSinceLastChanceCheck = timeSinceLevelStarted - this->timeOfLastChanceCheck;
+			sf::Time timeSinceLastSpawn = timeSinceLevelStarted - this->timeOfLastSpawn;
 
-			for (auto const currFoodInstance : this->foodInstanceList) {
-				if (currFoodInstance.position == position) {
-					result.foodExistsFlag = true;
-					result.foodInstanceId = currFoodInstance.foodInstanceId;
-					break;
+			bool result = (timeSinceLastChanceCheck.asSeconds() >= 1.0f);
+			if (this->foodDefn->spawnType == StoryObjectSpawnType::ON_TIMER) {
+				if (this->spawnCount == 0) {
+					result = result && (timeSinceLastSpawn.asSeconds() >= (float)this->foodDefn->timePassed);
+				}
+				else {
+					result = result && (timeSinceLastSpawn.asSeconds() >= (float)this->foodDefn->interval);
 				}
 			}
 
 			return result;
 		}
 
-		void StoryFoodSpawnTracker::spawnFood(const StoryFoodInstance& foodInstance) {
-			this->foodInstanceList.push_back(foodInstance);
+		sf::Time StoryFoodSpawnTracker::resolveEarliestCheckTime() const {
+			sf::Time result = this->timeOfLastChanceCheck + sf::seconds(1.0f);
+			if (this->foodDefn->spawnType == StoryObjectSpawnType::ON_TIMER) {
+				int secondsToWait = (this->spawnCount == 0) ? this->foodDefn->timePassed : this->foodDefn->interval;
+				result = std::max(result, this->timeOfLastSpawn + sf::seconds((float)secondsToWait));
+			}
+			return result;
+		}
+
+		StorySpawnTrigger StoryFoodSpawnTracker::resolveSpawnTrigger() const {
+			StorySpawnTrigger result = StorySpawnTrigger::NONE;
+
+			switch (this->foodDefn->spawnType) {
+			case StoryObjectSpawnType::ON_LENGTH_REACHED:
+				result = StorySpawnTrigger::LENGTH_CHANGED;
+				break;
+			case StoryObjectSpawnType::ON_HEALTH_FELL:
+				result = StorySpawnTrigger::HEALTH_CHANGED;
+				break;
+			case StoryObjectSpawnType::ON_SNAKE_POSITION:
+				result = StorySpawnTrigger::SNAKE_MOVED;
+				break;
+			case StoryObjectSpawnType::ON_FOOD_EATEN:
+				result = StorySpawnTrigger::FOOD_EATEN;
+				break;
+			}
+
+			return result;
+		}
+
+		void StoryFoodSpawnTracker::spawnFood() {
+			this->foodInstanceCount++;
 			this->spawnCount++;
 		}
 
-		void StoryFoodSpawnTracker::despawnFood(int foodInstanceId) {
-			int index = this->findFoodInstanceIndex(foodInstanceId);
-			assert(index >= 0);
+		void StoryFoodSpawnTracker::despawnFood() {
+			assert(this->foodInstanceCount > 0);
 
-			this->foodInstanceList.erase(this->foodInstanceList.begin() + index);
+			this->foodInstanceCount--;
 		}
 
 		bool StoryFoodSpawnTracker::areDespawnConditionsMet(const StoryFoodSpawnCheckInput& input) {
 			sf::Time timeSinceLastChanceCheck = input.timeSinceLevelStarted - this->timeOfLastChanceCheck;
 
 			bool result =
-				(this->foodInstanceList.empty()) &&
+				(this->foodInstanceCount == 0) &&
 				(this->spawnCount < this->foodDefn->maxSpawnCount) &&
 				(timeSinceLastChanceCheck.asSeconds() >= 1.0f);
 
@@ -139,7 +178,7 @@ namespace r3 {
 
 			bool result =
 				(input.snake->getLength() >= this->foodDefn->lengthReached) &&
-				(this->foodInstanceList.empty()) &&
+				(this->foodInstanceCount == 0) &&
 				(this->spawnCount < this->foodDefn->maxSpawnCount) &&
 				(timeSinceLastChanceCheck.asSeconds() >= 1.0f);
 
@@ -151,7 +190,7 @@ namespace r3 {
 
 			bool result =
 				(input.snakeHealth <= (float)this->foodDefn->health) &&
-				(this->foodInstanceList.empty()) &&
+				(this->foodInstanceCount == 0) &&
 				(this->spawnCount < this->foodDefn->maxSpawnCount) &&
 				(timeSinceLastChanceCheck.asSeconds() >= 1.0f);
 
@@ -163,7 +202,7 @@ namespace r3 {
 
 			bool result =
 				(input.snake->bodyOccupiesRect(this->foodDefn->region)) &&
-				(this->foodInstanceList.empty()) &&
+				(this->foodInstanceCount == 0) &&
 				(this->spawnCount < this->foodDefn->maxSpawnCount) &&
 				(timeSinceLastChanceCheck.asSeconds() >= 1.0f);
 
@@ -175,24 +214,13 @@ namespace r3 {
 
 			bool result =
 				(input.foodEatenCountMap->at(this->foodDefn->eatenFoodType) >= this->foodDefn->eatenFoodCount) &&
-				(this->foodInstanceList.empty()) &&
+				(this->foodInstanceCount == 0) &&
 				(this->spawnCount < this->foodDefn->maxSpawnCount) &&
 				(timeSinceLastChanceCheck.asSeconds() >= 1.0f);
 
 			return result;
 		}
 
-		int StoryFoodSpawnTracker::findFoodInstanceIndex(int foodInstanceId) const {
-			int result = -1;
-			for (size_t index = 0; index < this->foodInstanceList.size(); index++) {
-				if (this->foodInstanceList[index].foodInstanceId == foodInstanceId) {
-					result = index;
-					break;
-				}
-			}
-			return result;
-		}
-
 	}
 
 }
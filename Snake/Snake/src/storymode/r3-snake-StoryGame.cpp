@@ -1,6 +1,9 @@
 
 #include <time.h>
 #include <math.h>
+#include <string.h>
+#include <algorithm>
+#include "../includes/r3-snake-utils.hpp"
 #include "../includes/r3-snake-storymodescene.hpp"
 
 namespace r3 {
@@ -65,29 +68,78 @@ namespace r3 {
 				return result;
 			}
 
-			int calcTotalScore(const std::unordered_map<int, StoryFoodEatenBySnakeScoreResult>& foodEatenBySnakeScoreResultMap) {
+			int calcTotalScore(const std::vector<StoryFoodEatenResult>& foodEatenResultList) {
 				int result = 0;
-				for (const auto& currScoreResultPair : foodEatenBySnakeScoreResultMap) {
-					result += currScoreResultPair.second.totalScore;
+				for (const auto& currFoodEatenResult : foodEatenResultList) {
+					result += currFoodEatenResult.scoreResult.totalScore;
 				}
 				return result;
 			}
 
 		}
 
+		namespace StoryGameTickUtils {
+
+			sf::Time tickToTime(int tick) {
+				sf::Time result = sf::microseconds((sf::Int64)tick * 1000000 / GameLoopUtils::FRAMES_PER_SECOND);
+				return result;
+			}
+
+			int resolveFirstTickNotBefore(const sf::Time& time) {
+				// Deliberately one tick early; callers step forward against the exact float comparison
+				sf::Int64 result = time.asMicroseconds() * GameLoopUtils::FRAMES_PER_SECOND / 1000000 - 1;
+				return (int)std::max((sf::Int64)0, result);
+			}
+
+		}
+
+		namespace StoryGameStateHashUtils {
+
+			const sf::Uint64 STATE_HASH_OFFSET_BASIS = 14695981039346656037ULL;
+			const sf::Uint64 STATE_HASH_PRIME = 1099511628211ULL;
+
+			void hashBytes(sf::Uint64& hash, const void* data, size_t size) {
+				const sf::Uint8* bytes = (const sf::Uint8*)data;
+				for (size_t index = 0; index < size; index++) {
+					hash ^= bytes[index];
+					hash *= STATE_HASH_PRIME;
+				}
+			}
+
+			void hashInt(sf::Uint64& hash, int value) {
+				hashBytes(hash, &value, sizeof(value));
+			}
+
+			void hashFloat(sf::Uint64& hash, float value) {
+				sf::Uint32 bits;
+				memcpy(&bits, &value, sizeof(bits));
+				hashBytes(hash, &bits, sizeof(bits));
+			}
+
+			void hashSnakeSegment(sf::Uint64& hash, const SnakeSegment& segment) {
+				hashInt(hash, (int)segment.segmentType);
+				hashInt(hash, segment.position.x);
+				hashInt(hash, segment.position.y);
+				hashInt(hash, (int)segment.enterDirection);
+				hashInt(hash, (int)segment.exitDirection);
+			}
+
+		}
+
 		StoryGame::StoryGame() {
 			this->randomizer.seed((unsigned int)time(NULL));
+			this->levelSeed = 0;
 			this->status = StoryGameStatus::NOT_STARTED;
-			this->timeElapsedWhenEnded = sf::Time();
+			this->ticksElapsed = 0;
 			this->levelDefn = nullptr;
 			this->map = nullptr;
 			this->snake = nullptr;
+			this->maxSnakeLength = 0;
 			this->snakeHealth = 0.0f;
 			this->framesSinceSnakeMoved = 0;
+			this->snakeMovementQueueFrontIndex = 0;
 			this->queuedSnakeGrowth = 0;
-			this->nextSnakeMovementModifierId = 1;
-			this->nextFoodInstanceId = 1;
-			this->nextDangerInstanceId = 1;
+			this->foodInstanceCapacity = 0;
 			this->score = 0;
 			this->scoreAtLevelStart = 0;
 		}
@@ -102,60 +154,88 @@ namespace r3 {
 		}
 
 		void StoryGame::startNewLevel(const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn) {
+			this->startNewLevel(mapDefn, levelDefn, (unsigned int)this->randomizer());
+		}
+
+		void StoryGame::startNewLevel(const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn, unsigned int levelSeed) {
 			this->freeLevel();
 
+			this->levelSeed = levelSeed;
+			this->randomizer.seed(levelSeed);
+
 			this->status = StoryGameStatus::NOT_STARTED;
+			this->ticksElapsed = 0;
 
 			this->levelDefn = &levelDefn;
 			this->map = new StoryMap(mapDefn);
 			this->snake = new Snake(levelDefn.snakeStart);
+			this->maxSnakeLength = this->resolveMaxSnakeLength();
+			this->snake->reserveLength(this->maxSnakeLength);
 
 			this->snakeHealth = (float)levelDefn.maxSnakeHealth;
 			this->framesSinceSnakeMoved = 0;
-			while (!this->snakeMovementQueue.empty()) {
-				this->snakeMovementQueue.pop();
-			}
+			this->snakeMovementQueue.clear();
+			this->snakeMovementQueue.reserve(64);
+			this->snakeMovementQueueFrontIndex = 0;
 			this->queuedSnakeGrowth = 0;
 
-			this->nextSnakeMovementModifierId = 1;
-			this->snakeMovementModifierMap.clear();
+			this->snakeMovementModifierList.clear();
 
-			this->nextFoodInstanceId = 1;
 			this->foodSpawnTrackerList.clear();
 			for (auto const& currFoodDefn : levelDefn.foodDefnList) {
 				this->foodSpawnTrackerList.push_back(StoryFoodSpawnTracker(currFoodDefn));
 			}
 
-			this->foodTileDistanceTrackingMap.clear();
+			// Reserving for every instance the trackers could have alive at once keeps spawns from allocating mid-level
+			this->foodInstanceCapacity = 0;
+			for (auto const& currFoodSpawnTracker : this->foodSpawnTrackerList) {
+				this->foodInstanceCapacity += currFoodSpawnTracker.resolveMaxFoodInstanceCount();
+			}
+			this->foodSlotMap.clear();
+			this->foodSlotMap.reserve(this->foodInstanceCapacity);
+			this->snakeMovementModifierList.reserve(this->foodInstanceCapacity);
 
 			this->foodEatenCountMap.clear();
 			for (auto const& currFoodDefn : levelDefn.foodDefnList) {
 				this->foodEatenCountMap[currFoodDefn.foodType] = 0;
 			}
 
-			this->nextDangerInstanceId = 1;
 			this->dangerSpawnTrackerList.clear();
 			for (auto const& currDangerDefn : levelDefn.dangerDefnList) {
 				this->dangerSpawnTrackerList.push_back(StoryDangerSpawnTracker(currDangerDefn));
 			}
 
-			this->dangerStruckSnakeMap.clear();
+			this->dangerSlotMap.clear();
+			this->dangerSlotMap.reserve(this->dangerSpawnTrackerList.size());
 
-			this->remainingSoundFxDefnSet.clear();
-			for (auto const& currSoundFxDefn : levelDefn.soundFxDefnList) {
-				this->remainingSoundFxDefnSet.insert(&currSoundFxDefn);
+			this->foodSpawnScheduler.reset(this->foodSpawnTrackerList.size());
+			for (size_t trackerIndex = 0; trackerIndex < this->foodSpawnTrackerList.size(); trackerIndex++) {
+				this->foodSpawnScheduler.schedule(trackerIndex, 1);
+			}
+
+			this->dangerSpawnScheduler.reset(this->dangerSpawnTrackerList.size());
+			for (size_t trackerIndex = 0; trackerIndex < this->dangerSpawnTrackerList.size(); trackerIndex++) {
+				this->dangerSpawnScheduler.schedule(trackerIndex, 1);
+			}
+
+			this->dangerDespawnCheckHeap.clear();
+			this->dangerDespawnCheckHeap.reserve(this->dangerSpawnTrackerList.size());
+			this->dueTrackerIndexList.reserve(std::max(this->foodSpawnTrackerList.size(), this->dangerSpawnTrackerList.size()));
+			this->availablePositionList.reserve(mapDefn.fieldSize.x * mapDefn.fieldSize.y);
+
+			this->remainingSoundFxIndexList.clear();
+			for (size_t soundFxIndex = 0; soundFxIndex < levelDefn.soundFxDefnList.size(); soundFxIndex++) {
+				this->remainingSoundFxIndexList.push_back(soundFxIndex);
 			}
 		}
 
 		void StoryGame::startRunningLevel() {
-			this->clock.restart();
+			this->ticksElapsed = 0;
 			this->status = StoryGameStatus::RUNNING;
-			// printf("Clock restarted, is at %f seconds\n", this->clock.getElapsedTime().asSeconds());
 		}
 
 		void StoryGame::stopRunningLevel() {
 			this->status = StoryGameStatus::ENDED;
-			this->timeElapsedWhenEnded = this->clock.getElapsedTime();
 		}
 
 		void StoryGame::snapshotScoreAtLevelStart() {
@@ -166,6 +246,11 @@ namespace r3 {
 			this->score = this->scoreAtLevelStart;
 		}
 
+		void StoryGame::restoreScoreAtLevelStart(int scoreAtLevelStart) {
+			this->score = scoreAtLevelStart;
+			this->scoreAtLevelStart = scoreAtLevelStart;
+		}
+
 		StoryMap* StoryGame::getMap() const {
 			return this->map;
 		}
@@ -190,6 +275,14 @@ namespace r3 {
 			return this->dangerSpawnTrackerList;
 		}
 
+		const SlotMap<StoryFoodSlot>& StoryGame::getFoodSlotMap() const {
+			return this->foodSlotMap;
+		}
+
+		const SlotMap<StoryDangerSlot>& StoryGame::getDangerSlotMap() const {
+			return this->dangerSlotMap;
+		}
+
 		int StoryGame::getFoodEaten(StoryFoodType foodType) const {
 			int result = this->foodEatenCountMap.at(foodType);
 			return result;
@@ -200,10 +293,8 @@ namespace r3 {
 
 			switch (this->status) {
 			case StoryGameStatus::RUNNING:
-				result = this->clock.getElapsedTime();
-				break;
 			case StoryGameStatus::ENDED:
-				result = this->timeElapsedWhenEnded;
+				result = StoryGameTickUtils::tickToTime(this->ticksElapsed);
 				break;
 			}
 
@@ -218,26 +309,27 @@ namespace r3 {
 			return this->score;
 		}
 
-		StoryGameUpdateResult StoryGame::update(const StoryGameInputRequest& input) {
-			StoryGameUpdateResult result;
-			result.snakeMovementResult = ObjectDirection::NONE;
-			result.snakeHitBarrierFlag = false;
-			result.snakeDiedFlag = false;
-			result.snakeGrewFlag = false;
-			result.snakeShrunkFlag = false;
-			result.snakeShrunkTooSmallFlag = false;
-			result.completedLevelFlag = false;
-			result.spawnedFoodInstanceList = this->checkForFoodSpawns();
-			result.spawnedDangerInstanceList = this->checkForDangerSpawns();
+		unsigned int StoryGame::getLevelSeed() const {
+			return this->levelSeed;
+		}
+
+		int StoryGame::getTicksElapsed() const {
+			return this->ticksElapsed;
+		}
+
+		void StoryGame::update(const StoryGameInputRequest& input, StoryGameUpdateResult& result) {
+			this->ticksElapsed++;
+
+			result.clear();
+			result.reserve(this->foodInstanceCapacity, this->dangerSpawnTrackerList.size(), this->levelDefn->soundFxDefnList.size());
+			this->checkForFoodSpawns(result.spawnedFoodInstanceList);
+			this->checkForDangerSpawns(result.spawnedDangerInstanceList);
 
-			this->updateSnakeMovementModifierMap();
+			this->updateSnakeMovementModifierList();
 			float snakeSpeedTilesPerSecond = this->resolveSnakeSpeedTilesPerSecond();
 
 			this->checkForDangerDespawns();
 
-			this->addNewFoodSpawnsToFoodTileDistanceTrackingMap(result.spawnedFoodInstanceList);
-			this->addNewDangerSpawnsToDangerStruckSnakeMap(result.spawnedDangerInstanceList);
-
 			this->acceptSnakeMovementList(input.snakeMovementList);
 			this->consumeAllUnusableSnakeInputs();
 
@@ -255,12 +347,17 @@ namespace r3 {
 					result.snakeShrunkTooSmallFlag = (result.snakeShrunkFlag && (this->snake->getBodyLength() == 0));
 
 					this->moveSnakeForward(directionToMoveSnake);
-					this->updateFoodTileDistanceTrackingMapAfterSnakeMoved();
+					this->updateFoodTileDistanceTrackingAfterSnakeMoved();
+
+					this->wakeSpawnTrackers(StorySpawnTrigger::SNAKE_MOVED);
+					if (result.snakeGrewFlag || result.snakeShrunkFlag) {
+						this->wakeSpawnTrackers(StorySpawnTrigger::LENGTH_CHANGED);
+					}
 
-					StoryCheckForFoodEatenBySnakeResult eatenResult = this->checkForFoodEatenBySnake();
-					this->queuedSnakeGrowth += eatenResult.snakeGrowth;
+					this->queuedSnakeGrowth += this->checkForFoodEatenBySnake(result.foodEatenResultList);
 
-					for (auto const& currEatenFood : eatenResult.eatenBySnakeFoodInstanceList) {
+					for (auto const& currFoodEatenResult : result.foodEatenResultList) {
+						const StoryFoodInstance& currEatenFood = currFoodEatenResult.foodInstance;
 						this->foodEatenCountMap[currEatenFood.foodType] = this->foodEatenCountMap.at(currEatenFood.foodType) + 1;
 
 						if (currEatenFood.foodType == StoryFoodType::CARROT) {
@@ -274,18 +371,9 @@ namespace r3 {
 						}
 					}
 
-					std::unordered_map<int, StoryFoodEatenBySnakeScoreResult> foodEatenBySnakeScoreResultMap = this->buildFoodEatenBySnakeScoreResultMap(eatenResult.eatenBySnakeFoodInstanceList);
-					this->score += StoryGameScoreUtils::calcTotalScore(foodEatenBySnakeScoreResultMap);
+					this->score += StoryGameScoreUtils::calcTotalScore(result.foodEatenResultList);
 
-					for (auto const& currEatenFood : eatenResult.eatenBySnakeFoodInstanceList) {
-						StoryFoodEatenResult currFoodEatenResult;
-						currFoodEatenResult.foodInstance = currEatenFood;
-						currFoodEatenResult.scoreResult = foodEatenBySnakeScoreResultMap.at(currEatenFood.foodInstanceId);
-
-						result.foodEatenResultList.push_back(currFoodEatenResult);
-					}
-					
-					result.dangerInstanceStruckSnakeList = this->checkForDangersStrikingSnake();
+					this->checkForDangersStrikingSnake(result.dangerInstanceStruckSnakeList);
 					for (auto const& currDangerInstance : result.dangerInstanceStruckSnakeList) {
 						this->updateHealthBy(-1.0f);
 					}
@@ -302,11 +390,95 @@ namespace r3 {
 				this->framesSinceSnakeMoved -= (int)(60.0f / snakeSpeedTilesPerSecond);
 			}
 
-			result.soundFileTriggeredList = this->buildSoundFileTriggeredList(result);
+			this->buildSoundFxIndexTriggeredList(result);
+		}
+
+		sf::Uint64 StoryGame::calcStateHash() const {
+			sf::Uint64 result = StoryGameStateHashUtils::STATE_HASH_OFFSET_BASIS;
+
+			StoryGameStateHashUtils::hashInt(result, this->ticksElapsed);
+
+			StoryGameStateHashUtils::hashSnakeSegment(result, this->snake->getHead());
+			for (int bodyIndex = 0; bodyIndex < this->snake->getBodyLength(); bodyIndex++) {
+				StoryGameStateHashUtils::hashSnakeSegment(result, this->snake->getBody(bodyIndex));
+			}
+			StoryGameStateHashUtils::hashSnakeSegment(result, this->snake->getTail());
+
+			for (auto const& currFoodSlot : this->foodSlotMap) {
+				StoryGameStateHashUtils::hashInt(result, currFoodSlot.foodInstance.foodInstanceId);
+				StoryGameStateHashUtils::hashInt(result, (int)currFoodSlot.foodInstance.foodType);
+				StoryGameStateHashUtils::hashInt(result, currFoodSlot.foodInstance.position.x);
+				StoryGameStateHashUtils::hashInt(result, currFoodSlot.foodInstance.position.y);
+			}
+
+			for (auto const& currDangerSlot : this->dangerSlotMap) {
+				StoryGameStateHashUtils::hashInt(result, currDangerSlot.dangerInstance.dangerInstanceId);
+				StoryGameStateHashUtils::hashInt(result, (int)currDangerSlot.dangerInstance.dangerType);
+				StoryGameStateHashUtils::hashInt(result, currDangerSlot.dangerInstance.position.x);
+				StoryGameStateHashUtils::hashInt(result, currDangerSlot.dangerInstance.position.y);
+			}
+
+			StoryGameStateHashUtils::hashInt(result, this->score);
+			StoryGameStateHashUtils::hashFloat(result, this->snakeHealth);
 
 			return result;
 		}
 
+		StoryGameSnapshot StoryGame::createSnapshot() const {
+			StoryGameSnapshot result;
+			result.randomizer = this->randomizer;
+			result.status = this->status;
+			result.ticksElapsed = this->ticksElapsed;
+			result.snakeHead = this->snake->getHead();
+			for (int bodyIndex = 0; bodyIndex < this->snake->getBodyLength(); bodyIndex++) {
+				result.snakeBodyList.push_back(this->snake->getBody(bodyIndex));
+			}
+			result.snakeTail = this->snake->getTail();
+			result.snakeHealth = this->snakeHealth;
+			result.framesSinceSnakeMoved = this->framesSinceSnakeMoved;
+			result.snakeMovementQueue.assign(this->snakeMovementQueue.begin() + this->snakeMovementQueueFrontIndex, this->snakeMovementQueue.end());
+			result.queuedSnakeGrowth = this->queuedSnakeGrowth;
+			result.snakeMovementModifierList = this->snakeMovementModifierList;
+			result.foodSpawnTrackerList = this->foodSpawnTrackerList;
+			result.foodSlotMap = this->foodSlotMap;
+			result.foodEatenCountMap = this->foodEatenCountMap;
+			result.dangerSpawnTrackerList = this->dangerSpawnTrackerList;
+			result.dangerSlotMap = this->dangerSlotMap;
+			result.foodSpawnScheduler = this->foodSpawnScheduler;
+			result.dangerSpawnScheduler = this->dangerSpawnScheduler;
+			result.dangerDespawnCheckHeap = this->dangerDespawnCheckHeap;
+			result.remainingSoundFxIndexList = this->remainingSoundFxIndexList;
+			result.score = this->score;
+			return result;
+		}
+
+		void StoryGame::restoreSnapshot(const StoryGameSnapshot& snapshot) {
+			this->randomizer = snapshot.randomizer;
+			this->status = snapshot.status;
+			this->ticksElapsed = snapshot.ticksElapsed;
+
+			delete this->snake;
+			this->snake = new Snake(snapshot.snakeHead, snapshot.snakeBodyList, snapshot.snakeTail);
+			this->snake->reserveLength(this->maxSnakeLength);
+
+			this->snakeHealth = snapshot.snakeHealth;
+			this->framesSinceSnakeMoved = snapshot.framesSinceSnakeMoved;
+			this->snakeMovementQueue = snapshot.snakeMovementQueue;
+			this->snakeMovementQueueFrontIndex = 0;
+			this->queuedSnakeGrowth = snapshot.queuedSnakeGrowth;
+			this->snakeMovementModifierList = snapshot.snakeMovementModifierList;
+			this->foodSpawnTrackerList = snapshot.foodSpawnTrackerList;
+			this->foodSlotMap = snapshot.foodSlotMap;
+			this->foodEatenCountMap = snapshot.foodEatenCountMap;
+			this->dangerSpawnTrackerList = snapshot.dangerSpawnTrackerList;
+			this->dangerSlotMap = snapshot.dangerSlotMap;
+			this->foodSpawnScheduler = snapshot.foodSpawnScheduler;
+			this->dangerSpawnScheduler = snapshot.dangerSpawnScheduler;
+			this->dangerDespawnCheckHeap = snapshot.dangerDespawnCheckHeap;
+			this->remainingSoundFxIndexList = snapshot.remainingSoundFxIndexList;
+			this->score = snapshot.score;
+		}
+
 		void StoryGame::freeLevel() {
 			if (this->map != nullptr) {
 				delete this->map;
@@ -318,34 +490,71 @@ namespace r3 {
 			}
 		}
 
+		// The snake can never cover more than the open floor, and a level won on length ends as soon as it is reached
+		int StoryGame::resolveMaxSnakeLength() const {
+			sf::Vector2i fieldSize = this->map->getFieldSize();
+
+			int result = 0;
+			for (int y = 0; y < fieldSize.y; y++) {
+				for (int x = 0; x < fieldSize.x; x++) {
+					if (!this->map->barrierAt(x, y)) {
+						result++;
+					}
+				}
+			}
+
+			if (this->levelDefn->winCondition.conditionType == StoryWinConditionType::ON_LENGTH_REACHED) {
+				result = std::min(result, this->levelDefn->winCondition.snakeLength);
+			}
+			result = std::max(result, this->snake->getLength());
+
+			return result;
+		}
+
 		void StoryGame::acceptSnakeMovementList(const std::vector<ObjectDirection>& snakeMovementList) {
 			for (auto const& currSnakeMovement : snakeMovementList) {
-				this->snakeMovementQueue.push(currSnakeMovement);
+				this->snakeMovementQueue.push_back(currSnakeMovement);
 			}
 		}
 
 		void StoryGame::consumeAllUnusableSnakeInputs() {
 			bool allUnusableInputsPoppedFlag = false;
 			while (!allUnusableInputsPoppedFlag) {
-				allUnusableInputsPoppedFlag = this->snakeMovementQueue.empty();
-				if (!this->snakeMovementQueue.empty()) {
+				bool queueEmptyFlag = (this->snakeMovementQueueFrontIndex >= this->snakeMovementQueue.size());
+				allUnusableInputsPoppedFlag = queueEmptyFlag;
+				if (!queueEmptyFlag) {
+					ObjectDirection frontDirection = this->snakeMovementQueue[this->snakeMovementQueueFrontIndex];
 					allUnusableInputsPoppedFlag =
-						(this->snakeMovementQueue.front() != this->snake->getHead().enterDirection) &&
-						(this->snake->isValidMovementDirection(this->snakeMovementQueue.front()));
+						(frontDirection != this->snake->getHead().enterDirection) &&
+						(this->snake->isValidMovementDirection(frontDirection));
 
 					if (!allUnusableInputsPoppedFlag) {
-						this->snakeMovementQueue.pop();
+						this->popSnakeMovementQueue();
 					}
 				}
 			}
 		}
 
+		void StoryGame::popSnakeMovementQueue() {
+			this->snakeMovementQueueFrontIndex++;
+
+			// Compacting in place keeps the vector's capacity, so the queue stops allocating once it has warmed up
+			if (this->snakeMovementQueueFrontIndex >= this->snakeMovementQueue.size()) {
+				this->snakeMovementQueue.clear();
+				this->snakeMovementQueueFrontIndex = 0;
+			}
+			else if (this->snakeMovementQueueFrontIndex >= 32) {
+				this->snakeMovementQueue.erase(this->snakeMovementQueue.begin(), this->snakeMovementQueue.begin() + this->snakeMovementQueueFrontIndex);
+				this->snakeMovementQueueFrontIndex = 0;
+			}
+		}
+
 		ObjectDirection StoryGame::resolveDirectionToMoveSnake() {
 			ObjectDirection result = ObjectDirection::NONE;
 
-			if (!this->snakeMovementQueue.empty()) {
-				result = this->snakeMovementQueue.front();
-				this->snakeMovementQueue.pop();
+			if (this->snakeMovementQueueFrontIndex < this->snakeMovementQueue.size()) {
+				result = this->snakeMovementQueue[this->snakeMovementQueueFrontIndex];
+				this->popSnakeMovementQueue();
 			}
 
 			if (result == ObjectDirection::NONE) {
@@ -382,30 +591,25 @@ namespace r3 {
 			}
 		}
 
-		void StoryGame::updateSnakeMovementModifierMap() {
-			std::vector<int> modifierIdListToRemove;
-			for (auto const& currSnakeMovementModifierPair : this->snakeMovementModifierMap) {
-				float timeModifierEnds = currSnakeMovementModifierPair.second.timeModifierBegan.asSeconds() + currSnakeMovementModifierPair.second.secondsToModify;
-				if (this->clock.getElapsedTime().asSeconds() > timeModifierEnds) {
-					modifierIdListToRemove.push_back(currSnakeMovementModifierPair.first);
-				}
-			}
-
-			for (int currModifierId : modifierIdListToRemove) {
-				// printf("Removing movement multiplier of %f\n", this->snakeMovementModifierMap[currModifierId].movementMultiplier);
+		void StoryGame::updateSnakeMovementModifierList() {
+			auto modifierItr = this->snakeMovementModifierList.begin();
+			while (modifierItr != this->snakeMovementModifierList.end()) {
+				float timeModifierEnds = modifierItr->timeModifierBegan.asSeconds() + modifierItr->secondsToModify;
+				if (this->getTimeElapsed().asSeconds() > timeModifierEnds) {
+					// printf("Removing movement multiplier of %f\n", modifierItr->movementMultiplier);
 
-				this->snakeMovementModifierMap.erase(currModifierId);
-			}
-
-			if (!modifierIdListToRemove.empty()) {
-				// printf("New speed will be %f\n", this->resolveSnakeSpeedTilesPerSecond());
+					modifierItr = this->snakeMovementModifierList.erase(modifierItr);
+				}
+				else {
+					modifierItr++;
+				}
 			}
 		}
 
 		float StoryGame::resolveSnakeSpeedTilesPerSecond() {
 			float result = (float)this->levelDefn->snakeSpeedTilesPerSecond;
-			for (auto const& currSnakeMovementModifierPair : this->snakeMovementModifierMap) {
-				result *= currSnakeMovementModifierPair.second.movementMultiplier;
+			for (auto const& currSnakeMovementModifier : this->snakeMovementModifierList) {
+				result *= currSnakeMovementModifier.movementMultiplier;
 			}
 			return result;
 		}
@@ -413,69 +617,85 @@ namespace r3 {
 		void StoryGame::addNewSnakeMovementModifier(float movementMultiplier, float secondsToApply) {
 			// printf("Adding movement multiplier of %f\n", movementMultiplier);
 
-			this->snakeMovementModifierMap[this->nextSnakeMovementModifierId] = StorySnakeMovementModifier();
-			this->snakeMovementModifierMap[this->nextSnakeMovementModifierId].movementMultiplier = movementMultiplier;
-			this->snakeMovementModifierMap[this->nextSnakeMovementModifierId].secondsToModify = secondsToApply;
-			this->snakeMovementModifierMap[this->nextSnakeMovementModifierId].timeModifierBegan = this->clock.getElapsedTime();
+			StorySnakeMovementModifier newSnakeMovementModifier;
+			newSnakeMovementModifier.movementMultiplier = movementMultiplier;
+			newSnakeMovementModifier.secondsToModify = secondsToApply;
+			newSnakeMovementModifier.timeModifierBegan = this->getTimeElapsed();
 
-			this->nextSnakeMovementModifierId++;
+			this->snakeMovementModifierList.push_back(newSnakeMovementModifier);
 
 			// printf("New speed will be %f\n", this->resolveSnakeSpeedTilesPerSecond());
 		}
 
-		std::vector<StoryFoodInstance> StoryGame::checkForFoodSpawns() {
-			std::vector<StoryFoodInstance> result;
+		void StoryGame::checkForFoodSpawns(std::vector<StoryFoodInstance>& spawnedFoodInstanceList) {
+			this->foodSpawnScheduler.popDueTrackers(this->ticksElapsed, this->dueTrackerIndexList);
+			for (int currTrackerIndex : this->dueTrackerIndexList) {
+				StoryFoodSpawnTracker& currFoodSpawnTracker = this->foodSpawnTrackerList[currTrackerIndex];
 
-			for (auto& currFoodSpawnTracker : this->foodSpawnTrackerList) {
 				StoryFoodSpawnCheckInput checkInput;
-				checkInput.timeSinceLevelStarted = this->clock.getElapsedTime();
+				checkInput.timeSinceLevelStarted = this->getTimeElapsed();
 				checkInput.randomizer = &this->randomizer;
 				checkInput.snake = this->getSnake();
 				checkInput.snakeHealth = this->snakeHealth;
 				checkInput.foodEatenCountMap = &this->foodEatenCountMap;
 
 				if (currFoodSpawnTracker.shouldFoodSpawn(checkInput)) {
-					std::vector<sf::Vector2i> availablePositionList = this->buildAvailableFoodSpawnPositionList(currFoodSpawnTracker.getFoodDefn());
-					// printf("There are %d positions on the map that the food can spawn\n", availablePositionList.size());
-					if (availablePositionList.size() > 0) {
-						StoryFoodInstance newFoodInstance = this->createFoodInstance(currFoodSpawnTracker.getFoodDefn().foodType, availablePositionList);
-						currFoodSpawnTracker.spawnFood(newFoodInstance);
-						result.push_back(newFoodInstance);
-
-						this->nextFoodInstanceId++;
+					this->buildAvailableFoodSpawnPositionList(currFoodSpawnTracker.getFoodDefn());
+					// printf("There are %d positions on the map that the food can spawn\n", this->availablePositionList.size());
+					if (this->availablePositionList.size() > 0) {
+						StoryFoodSlot newFoodSlot;
+						newFoodSlot.foodInstance = this->createFoodInstance(currFoodSpawnTracker.getFoodDefn().foodType, this->availablePositionList);
+						newFoodSlot.trackerIndex = currTrackerIndex;
+						newFoodSlot.tileDistanceTracking = this->createFoodTileDistanceTracking(newFoodSlot.foodInstance);
+						this->foodSlotMap.insert(newFoodSlot);
+
+						currFoodSpawnTracker.spawnFood();
+						spawnedFoodInstanceList.push_back(newFoodSlot.foodInstance);
 					}
 				}
-			}
 
-			return result;
+				this->rescheduleFoodSpawnCheck(currTrackerIndex);
+			}
 		}
 
-		StoryCheckForFoodEatenBySnakeResult StoryGame::checkForFoodEatenBySnake() {
-			StoryCheckForFoodEatenBySnakeResult result;
-			result.snakeGrowth = 0;
+		int StoryGame::checkForFoodEatenBySnake(std::vector<StoryFoodEatenResult>& foodEatenResultList) {
+			int result = 0;
 
 			sf::Vector2i headPosition = this->snake->getHead().position;
 
-			for (auto& currFoodSpawnTracker : this->foodSpawnTrackerList) {
-				StoryFoodPositionCheckResult checkResult = currFoodSpawnTracker.occupiesPosition(headPosition);
-				if (checkResult.foodExistsFlag) {
-					result.eatenBySnakeFoodInstanceList.push_back(currFoodSpawnTracker.getFoodInstance(checkResult.foodInstanceId));
+			// Food never spawns on an occupied tile, so at most one instance can be under the head
+			for (size_t valueIndex = 0; valueIndex < this->foodSlotMap.size(); valueIndex++) {
+				const StoryFoodSlot& currFoodSlot = this->foodSlotMap.getValue(valueIndex);
+				if (currFoodSlot.foodInstance.position == headPosition) {
+					StoryFoodSpawnTracker& currFoodSpawnTracker = this->foodSpawnTrackerList[currFoodSlot.trackerIndex];
+
+					StoryFoodEatenResult currFoodEatenResult;
+					currFoodEatenResult.foodInstance = currFoodSlot.foodInstance;
+					currFoodEatenResult.scoreResult = StoryGameScoreUtils::calcFoodEatenScore(currFoodSlot.foodInstance.foodType, currFoodSlot.tileDistanceTracking);
+					foodEatenResultList.push_back(currFoodEatenResult);
+
 					if (currFoodSpawnTracker.getFoodDefn().foodType == StoryFoodType::BANANA) {
-						result.snakeGrowth -= currFoodSpawnTracker.getFoodDefn().growthRate;
+						result -= currFoodSpawnTracker.getFoodDefn().growthRate;
 					}
 					else {
-						result.snakeGrowth += currFoodSpawnTracker.getFoodDefn().growthRate;
+						result += currFoodSpawnTracker.getFoodDefn().growthRate;
 					}
 
-					currFoodSpawnTracker.despawnFood(checkResult.foodInstanceId);
+					int trackerIndex = currFoodSlot.trackerIndex;
+					currFoodSpawnTracker.despawnFood();
+					this->foodSlotMap.erase(this->foodSlotMap.getId(valueIndex));
+
+					this->foodSpawnScheduler.wakeTracker(trackerIndex, this->ticksElapsed + 1);
+					this->wakeSpawnTrackers(StorySpawnTrigger::FOOD_EATEN);
+					break;
 				}
 			}
 
 			return result;
 		}
 
-		std::vector<sf::Vector2i> StoryGame::buildAvailableFoodSpawnPositionList(const StoryFoodDefn& foodDefn) {
-			std::vector<sf::Vector2i> result;
+		void StoryGame::buildAvailableFoodSpawnPositionList(const StoryFoodDefn& foodDefn) {
+			this->availablePositionList.clear();
 
 			for (int y = 0; y < this->map->getFieldSize().y; y++) {
 				for (int x = 0; x < this->map->getFieldSize().x; x++) {
@@ -489,20 +709,17 @@ namespace r3 {
 						!this->foodOccupiesPosition(sf::Vector2i(x, y));
 
 					if (positionIsAvailable) {
-						result.push_back(sf::Vector2i(x, y));
+						this->availablePositionList.push_back(sf::Vector2i(x, y));
 					}
 				}
 			}
-
-			return result;
 		}
 
 		bool StoryGame::foodOccupiesPosition(const sf::Vector2i& position) {
 			bool result = false;
 
-			for (auto const& currFoodSpawnTracker : this->foodSpawnTrackerList) {
-				StoryFoodPositionCheckResult checkResult = currFoodSpawnTracker.occupiesPosition(position);
-				if (checkResult.foodExistsFlag) {
+			for (auto const& currFoodSlot : this->foodSlotMap) {
+				if (currFoodSlot.foodInstance.position == position) {
 					result = true;
 					break;
 				}
@@ -516,105 +733,148 @@ namespace r3 {
 			int index = tileDistribution(this->randomizer);
 
 			StoryFoodInstance result;
-			result.foodInstanceId = this->nextFoodInstanceId;
+			result.foodInstanceId = this->foodSlotMap.peekNextId();
 			result.foodType = foodType;
 			result.position = availablePositionList[index];
 			return result;
 		}
 
-		void StoryGame::addNewFoodSpawnsToFoodTileDistanceTrackingMap(const std::vector<StoryFoodInstance>& spawnedFoodInstanceList) {
+		StoryFoodTileDistanceTracking StoryGame::createFoodTileDistanceTracking(const StoryFoodInstance& foodInstance) {
 			sf::Vector2i headPosition = this->getSnake()->getHead().position;
-			for (auto const& currSpawnedFoodInstance : spawnedFoodInstanceList) {
-				StoryFoodTileDistanceTracking currFoodTileDistanceTracking;
-				currFoodTileDistanceTracking.origTileDistanceFromSnake =
-					abs(currSpawnedFoodInstance.position.x - headPosition.x) +
-					abs(currSpawnedFoodInstance.position.y - headPosition.y);
-				currFoodTileDistanceTracking.tileDistanceSnakeTravelled = 0;
 
-				this->foodTileDistanceTrackingMap[currSpawnedFoodInstance.foodInstanceId] = currFoodTileDistanceTracking;
-			}
+			StoryFoodTileDistanceTracking result;
+			result.origTileDistanceFromSnake =
+				abs(foodInstance.position.x - headPosition.x) +
+				abs(foodInstance.position.y - headPosition.y);
+			result.tileDistanceSnakeTravelled = 0;
+			return result;
 		}
 
-		void StoryGame::updateFoodTileDistanceTrackingMapAfterSnakeMoved() {
-			for (auto const& currFoodTileDistanceTrackingPair : this->foodTileDistanceTrackingMap) {
-				StoryFoodTileDistanceTracking currFoodTileDistanceTracking = currFoodTileDistanceTrackingPair.second;
-				currFoodTileDistanceTracking.tileDistanceSnakeTravelled++;
-
-				this->foodTileDistanceTrackingMap[currFoodTileDistanceTrackingPair.first] = currFoodTileDistanceTracking;
+		void StoryGame::updateFoodTileDistanceTrackingAfterSnakeMoved() {
+			for (auto& currFoodSlot : this->foodSlotMap) {
+				currFoodSlot.tileDistanceTracking.tileDistanceSnakeTravelled++;
 			}
 		}
 
-		std::unordered_map<int, StoryFoodEatenBySnakeScoreResult> StoryGame::buildFoodEatenBySnakeScoreResultMap(const std::vector<StoryFoodInstance>& eatenBySnakeFoodInstanceList) {
-			std::unordered_map<int, StoryFoodEatenBySnakeScoreResult> result;
-
-			for (auto const& currFoodInstance : eatenBySnakeFoodInstanceList) {
-				StoryFoodTileDistanceTracking currFoodTileDistanceTracking = this->foodTileDistanceTrackingMap[currFoodInstance.foodInstanceId];
-
-				result[currFoodInstance.foodInstanceId] = StoryGameScoreUtils::calcFoodEatenScore(currFoodInstance.foodType, currFoodTileDistanceTracking);
-			}
-
-			return result;
-		}
+		void StoryGame::checkForDangerSpawns(std::vector<StoryDangerInstance>& spawnedDangerInstanceList) {
+			this->dangerSpawnScheduler.popDueTrackers(this->ticksElapsed, this->dueTrackerIndexList);
+			for (int currTrackerIndex : this->dueTrackerIndexList) {
+				StoryDangerSpawnTracker& currDangerSpawnTracker = this->dangerSpawnTrackerList[currTrackerIndex];
 
-		std::vector<StoryDangerInstance> StoryGame::checkForDangerSpawns() {
-			std::vector<StoryDangerInstance> result;
-
-			for (auto& currDangerSpawnTracker : this->dangerSpawnTrackerList) {
 				StoryDangerSpawnCheckInput checkInput;
 				checkInput.timeSinceLevelStarted = this->getTimeElapsed();
 				checkInput.randomizer = &this->randomizer;
 				checkInput.snake = this->snake;
 
 				if (currDangerSpawnTracker.shouldDangerSpawn(checkInput)) {
-					std::vector<sf::Vector2i> availablePositionList = this->buildAvailableDangerSpawnPositionList(currDangerSpawnTracker.getDangerDefn());
-					// printf("There are %d positions on the map that the danger can spawn\n", availablePositionList.size());
-					if (availablePositionList.size() > 0) {
-						StoryDangerInstance newDangerInstance = this->createDangerInstance(currDangerSpawnTracker.getDangerDefn().dangerType, availablePositionList);
-						currDangerSpawnTracker.spawnDanger(newDangerInstance);
-						result.push_back(newDangerInstance);
-
-						this->nextDangerInstanceId++;
+					this->buildAvailableDangerSpawnPositionList(currDangerSpawnTracker.getDangerDefn());
+					// printf("There are %d positions on the map that the danger can spawn\n", this->availablePositionList.size());
+					if (this->availablePositionList.size() > 0) {
+						StoryDangerSlot newDangerSlot;
+						newDangerSlot.dangerInstance = this->createDangerInstance(currDangerSpawnTracker.getDangerDefn().dangerType, this->availablePositionList);
+						newDangerSlot.trackerIndex = currTrackerIndex;
+						newDangerSlot.struckSnakeFlag = false;
+						this->dangerSlotMap.insert(newDangerSlot);
+
+						currDangerSpawnTracker.spawnDanger();
+						spawnedDangerInstanceList.push_back(newDangerSlot.dangerInstance);
+
+						this->scheduleDangerDespawnCheck(currTrackerIndex, newDangerSlot.dangerInstance);
 					}
 				}
-			}
 
-			return result;
+				this->rescheduleDangerSpawnCheck(currTrackerIndex);
+			}
 		}
 
-		std::vector<StoryDangerInstance> StoryGame::checkForDangersStrikingSnake() {
-			std::vector<StoryDangerInstance> result;
-
-			for (auto& currDangerSpawnTracker : this->dangerSpawnTrackerList) {
-				for (auto const& currDangerInstance : currDangerSpawnTracker.getDangerInstanceList()) {
-					if (
-						!this->dangerStruckSnakeMap[currDangerInstance.dangerInstanceId] &&
-						this->snake->occupiesPosition(currDangerInstance.position)
-					) {
-						this->dangerStruckSnakeMap[currDangerInstance.dangerInstanceId] = true;
-						result.push_back(currDangerInstance);
-					}
+		void StoryGame::checkForDangersStrikingSnake(std::vector<StoryDangerInstance>& dangerInstanceStruckSnakeList) {
+			for (auto& currDangerSlot : this->dangerSlotMap) {
+				if (
+					!currDangerSlot.struckSnakeFlag &&
+					this->snake->occupiesPosition(currDangerSlot.dangerInstance.position)
+				) {
+					currDangerSlot.struckSnakeFlag = true;
+					dangerInstanceStruckSnakeList.push_back(currDangerSlot.dangerInstance);
 				}
 			}
-
-			return result;
 		}
 
 		void StoryGame::checkForDangerDespawns() {
-			for (auto& currDangerSpawnTracker : this->dangerSpawnTrackerList) {
-				for (auto const& currDangerInstance : currDangerSpawnTracker.getDangerInstanceList()) {
+			while (!this->dangerDespawnCheckHeap.empty() && (this->dangerDespawnCheckHeap.front().dueTick <= this->ticksElapsed)) {
+				StoryScheduledCheck check = StorySpawnSchedulerUtils::popCheck(this->dangerDespawnCheckHeap);
+
+				StoryDangerSpawnTracker& currDangerSpawnTracker = this->dangerSpawnTrackerList[check.trackerIndex];
+				if (this->dangerSlotMap.contains(check.instanceId)) {
 					StoryDangerDespawnCheckInput checkInput;
 					checkInput.timeSinceLevelStarted = this->getTimeElapsed();
-					checkInput.dangerInstanceId = currDangerInstance.dangerInstanceId;
+					checkInput.dangerInstanceId = check.instanceId;
 
 					if (currDangerSpawnTracker.shouldDangerDespawn(checkInput)) {
-						currDangerSpawnTracker.despawnDanger(currDangerInstance.dangerInstanceId);
+						currDangerSpawnTracker.despawnDanger();
+						this->dangerSlotMap.erase(check.instanceId);
+						this->dangerSpawnScheduler.wakeTracker(check.trackerIndex, this->ticksElapsed + 1);
 					}
+					else {
+						check.dueTick = this->ticksElapsed + 1;
+						StorySpawnSchedulerUtils::pushCheck(this->dangerDespawnCheckHeap, check);
+					}
+				}
+			}
+		}
+
+		void StoryGame::rescheduleFoodSpawnCheck(int trackerIndex) {
+			const StoryFoodSpawnTracker& tracker = this->foodSpawnTrackerList[trackerIndex];
+			if (!tracker.canSpawnAgain()) {
+				return;
+			}
+
+			if (tracker.areTimeConditionsMet(this->getTimeElapsed())) {
+				this->foodSpawnScheduler.park(trackerIndex, tracker.resolveSpawnTrigger());
+			}
+			else {
+				int dueTick = std::max(this->ticksElapsed + 1, StoryGameTickUtils::resolveFirstTickNotBefore(tracker.resolveEarliestCheckTime()));
+				while (!tracker.areTimeConditionsMet(StoryGameTickUtils::tickToTime(dueTick))) {
+					dueTick++;
 				}
+				this->foodSpawnScheduler.schedule(trackerIndex, dueTick);
 			}
 		}
 
-		std::vector<sf::Vector2i> StoryGame::buildAvailableDangerSpawnPositionList(const StoryDangerDefn& dangerDefn) {
-			std::vector<sf::Vector2i> result;
+		void StoryGame::rescheduleDangerSpawnCheck(int trackerIndex) {
+			const StoryDangerSpawnTracker& tracker = this->dangerSpawnTrackerList[trackerIndex];
+			if (!tracker.canSpawnAgain()) {
+				return;
+			}
+
+			if (tracker.areTimeConditionsMet(this->getTimeElapsed())) {
+				this->dangerSpawnScheduler.park(trackerIndex, tracker.resolveSpawnTrigger());
+			}
+			else {
+				int dueTick = std::max(this->ticksElapsed + 1, StoryGameTickUtils::resolveFirstTickNotBefore(tracker.resolveEarliestCheckTime()));
+				while (!tracker.areTimeConditionsMet(StoryGameTickUtils::tickToTime(dueTick))) {
+					dueTick++;
+				}
+				this->dangerSpawnScheduler.schedule(trackerIndex, dueTick);
+			}
+		}
+
+		void StoryGame::scheduleDangerDespawnCheck(int trackerIndex, const StoryDangerInstance& dangerInstance) {
+			const StoryDangerSpawnTracker& tracker = this->dangerSpawnTrackerList[trackerIndex];
+
+			StoryScheduledCheck check;
+			check.dueTick = std::max(this->ticksElapsed + 1, StoryGameTickUtils::resolveFirstTickNotBefore(tracker.resolveDespawnTime()));
+			check.trackerIndex = trackerIndex;
+			check.instanceId = dangerInstance.dangerInstanceId;
+			StorySpawnSchedulerUtils::pushCheck(this->dangerDespawnCheckHeap, check);
+		}
+
+		void StoryGame::wakeSpawnTrackers(StorySpawnTrigger trigger) {
+			this->foodSpawnScheduler.wakeTrackers(trigger, this->ticksElapsed + 1);
+			this->dangerSpawnScheduler.wakeTrackers(trigger, this->ticksElapsed + 1);
+		}
+
+		void StoryGame::buildAvailableDangerSpawnPositionList(const StoryDangerDefn& dangerDefn) {
+			this->availablePositionList.clear();
 
 			for (int y = 0; y < this->map->getFieldSize().y; y++) {
 				for (int x = 0; x < this->map->getFieldSize().x; x++) {
@@ -628,20 +888,17 @@ namespace r3 {
 						!this->dangerOccupiesPosition(sf::Vector2i(x, y));
 
 					if (positionIsAvailable) {
-						result.push_back(sf::Vector2i(x, y));
+						this->availablePositionList.push_back(sf::Vector2i(x, y));
 					}
 				}
 			}
-
-			return result;
 		}
 
 		bool StoryGame::dangerOccupiesPosition(const sf::Vector2i& position) {
 			bool result = false;
 
-			for (auto const& currDangerSpawnTracker : this->dangerSpawnTrackerList) {
-				StoryDangerPositionCheckResult checkResult = currDangerSpawnTracker.occupiesPosition(position);
-				if (checkResult.dangerExistsFlag) {
+			for (auto const& currDangerSlot : this->dangerSlotMap) {
+				if (currDangerSlot.dangerInstance.position == position) {
 					result = true;
 					break;
 				}
@@ -655,41 +912,34 @@ namespace r3 {
 			int index = tileDistribution(this->randomizer);
 
 			StoryDangerInstance result;
-			result.dangerInstanceId = this->nextDangerInstanceId;
+			result.dangerInstanceId = this->dangerSlotMap.peekNextId();
 			result.dangerType = dangerType;
 			result.position = availablePositionList[index];
 			return result;
 		}
 
-		void StoryGame::addNewDangerSpawnsToDangerStruckSnakeMap(const std::vector<StoryDangerInstance>& spawnedDangerInstanceList) {
-			for (auto const& currDangerInstance : spawnedDangerInstanceList) {
-				this->dangerStruckSnakeMap[currDangerInstance.dangerInstanceId] = false;
-			}
-		}
-
-		std::vector<std::string> StoryGame::buildSoundFileTriggeredList(const StoryGameUpdateResult& updateResult) {
-			std::vector<std::string> result;
-			std::vector<const StorySoundFxDefn*> soundFxDefnToRemove;
-
-			for (auto currSoundFxDefn : this->remainingSoundFxDefnSet) {
+		void StoryGame::buildSoundFxIndexTriggeredList(StoryGameUpdateResult& updateResult) {
+			auto soundFxIndexItr = this->remainingSoundFxIndexList.begin();
+			while (soundFxIndexItr != this->remainingSoundFxIndexList.end()) {
+				const StorySoundFxDefn& currSoundFxDefn = this->levelDefn->soundFxDefnList[*soundFxIndexItr];
 				bool soundTriggeredFlag = false;
 
-				switch (currSoundFxDefn->triggerType) {
+				switch (currSoundFxDefn.triggerType) {
 				case StorySoundFxTriggerType::ON_TIMER:
-					soundTriggeredFlag = (this->clock.getElapsedTime().asSeconds() >= (float)currSoundFxDefn->timePassed);
+					soundTriggeredFlag = (this->getTimeElapsed().asSeconds() >= (float)currSoundFxDefn.timePassed);
 					break;
 				case StorySoundFxTriggerType::ON_FIRST_FOOD_SPAWN:
 					for (auto const& currSpawnedFoodInstance : updateResult.spawnedFoodInstanceList) {
-						soundTriggeredFlag = soundTriggeredFlag || (currSpawnedFoodInstance.foodType == currSoundFxDefn->foodType);
+						soundTriggeredFlag = soundTriggeredFlag || (currSpawnedFoodInstance.foodType == currSoundFxDefn.foodType);
 					}
 					break;
 				case StorySoundFxTriggerType::ON_FIRST_DANGER_SPAWN:
 					for (auto const& currSpawnedDangerInstance : updateResult.spawnedDangerInstanceList) {
-						soundTriggeredFlag = soundTriggeredFlag || (currSpawnedDangerInstance.dangerType == currSoundFxDefn->dangerType);
+						soundTriggeredFlag = soundTriggeredFlag || (currSpawnedDangerInstance.dangerType == currSoundFxDefn.dangerType);
 					}
 					break;
 				case StorySoundFxTriggerType::ON_LENGTH_REACHED:
-					soundTriggeredFlag = (this->snake->getLength() >= currSoundFxDefn->lengthReached);
+					soundTriggeredFlag = (this->snake->getLength() >= currSoundFxDefn.lengthReached);
 					break;
 				case StorySoundFxTriggerType::ON_DAMAGED:
 					soundTriggeredFlag = updateResult.snakeDamaged();
@@ -697,19 +947,18 @@ namespace r3 {
 				}
 
 				if (soundTriggeredFlag) {
-					result.push_back(currSoundFxDefn->soundFilename);
-					soundFxDefnToRemove.push_back(currSoundFxDefn);
+					updateResult.soundFxIndexTriggeredList.push_back(*soundFxIndexItr);
+					soundFxIndexItr = this->remainingSoundFxIndexList.erase(soundFxIndexItr);
+				}
+				else {
+					soundFxIndexItr++;
 				}
 			}
-
-			for (auto currSoundFxDefnToRemove : soundFxDefnToRemove) {
-				this->remainingSoundFxDefnSet.erase(currSoundFxDefnToRemove);
-			}
-
-			return result;
 		}
 
 		void StoryGame::updateHealthBy(float amount) {
+			float prevSnakeHealth = this->snakeHealth;
+
 			this->snakeHealth += amount;
 
 			if (this->snakeHealth < 0.0f) {
@@ -719,6 +968,10 @@ namespace r3 {
 			if (this->snakeHealth > (float)this->levelDefn->maxSnakeHealth) {
 				this->snakeHealth = (float)this->levelDefn->maxSnakeHealth;
 			}
+
+			if (this->snakeHealth != prevSnakeHealth) {
+				this->wakeSpawnTrackers(StorySpawnTrigger::HEALTH_CHANGED);
+			}
 		}
 
 		bool StoryGame::checkLevelCompleted() {
@@ -738,7 +991,7 @@ namespace r3 {
 				}
 				break;
 			case StoryWinConditionType::ON_TIME_SURVIVED:
-				result = (this->clock.getElapsedTime().asSeconds() >= (float)this->levelDefn->winCondition.timePassed);
+				result = (this->getTimeElapsed().asSeconds() >= (float)this->levelDefn->winCondition.timePassed);
 				if (result) {
 					// printf("Survived for %d seconds to win the level!\n", this->levelDefn->winCondition.timePassed);
 				}
@@ -1,21 +1,33 @@
 
+#include <algorithm>
 #include "../includes/r3-snake-utils.hpp"
 #include "../includes/r3-snake-storymodescene.hpp"
 #include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storyreplay.hpp"
 
 namespace r3 {
 
 	namespace snake {
 
+		namespace StoryGameControllerConstants {
+
+			const int MAX_TICKS_PER_FRAME = 4;
+
+		}
+
 		StoryGameController::StoryGameController(sf::RenderWindow& window) {
 			this->window = &window;
 			this->renderer = new StoryGameRenderer();
 
 			this->mode = StoryGameMode::LOAD_CAMPAIGN;
 			this->currLevelIndex = 0;
+			this->assetCache = new StoryAssetCache(StoryAssetCacheConstants::DEFAULT_MEMORY_BUDGET_BYTES);
 			this->levelAssetBundle = nullptr;
+			this->prefetchedLevelAssetBundle = nullptr;
+			this->prefetchedLevelIndex = -1;
 			this->storyGame = new StoryGame();
 			this->storyCutscene = nullptr;
+			this->replayRecorder = new StoryReplayRecorder();
 
 			this->timeSnakeLastDamaged = sf::seconds(-0.5f);
 		}
@@ -26,10 +38,14 @@ namespace r3 {
 			if (this->levelAssetBundle != nullptr) {
 				delete this->levelAssetBundle;
 			}
+			this->discardPrefetchedLevel();
+			this->campaignIndex.flushCachedCampaign();
+			delete this->assetCache;
 			delete this->storyGame;
 			if (this->storyCutscene != nullptr) {
 				delete this->storyCutscene;
 			}
+			delete this->replayRecorder;
 		}
 
 		void StoryGameController::setCampaignFolder(const std::string& campaignFolder) {
@@ -88,6 +104,8 @@ namespace r3 {
 		}
 
 		void StoryGameController::update() {
+			this->updatePrefetchedLevel();
+
 			switch (this->mode) {
 			case StoryGameMode::LOAD_CAMPAIGN:
 				this->loadCampaign();
@@ -197,18 +215,18 @@ namespace r3 {
 		}
 
 		void StoryGameController::loadCampaign() {
-			LoadStoryCampaignResult loadResult = StoryLoaderUtils::loadStoryCampaign(this->campaignFolder);
-			if (!loadResult.valid()) {
-				StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildErrorMessages(loadResult));
+			// A prefetch from an earlier campaign still points into the campaign index
+			this->discardPrefetchedLevel();
+			this->campaignIndex.flushCachedCampaign();
+
+			LoadStoryCampaignIndexResult indexResult = this->campaignIndex.open(this->campaignFolder);
+			if (!indexResult.valid()) {
+				StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildErrorMessages(indexResult));
 
 				this->mode = StoryGameMode::LOAD_CAMPAIGN_ERROR;
 			}
 			else {
 				this->currLevelIndex = 0;
-				this->levelDefnList.clear();
-				for (auto const& currLevelResult : loadResult.levelResultList) {
-					this->levelDefnList.push_back(currLevelResult.levelDefn);
-				}
 
 				this->mode = StoryGameMode::LOAD_LEVEL;
 				this->storyGame->startNewCampaign();
@@ -217,34 +235,69 @@ namespace r3 {
 		}
 
 		void StoryGameController::initiateLoadLevel() {
+			this->renderer->clearBakedPlayingFields();
+			this->renderer->clearCutsceneMapTextures();
+
 			if (this->levelAssetBundle != nullptr) {
 				delete this->levelAssetBundle;
+				this->levelAssetBundle = nullptr;
+			}
+
+			if ((this->prefetchedLevelAssetBundle != nullptr) && (this->prefetchedLevelIndex == this->currLevelIndex)) {
+				this->levelAssetBundle = this->prefetchedLevelAssetBundle;
+				this->levelAssetBundle->setLoadPriority(StoryLevelAssetLoadPriority::FOREGROUND);
+
+				this->prefetchedLevelAssetBundle = nullptr;
+				this->prefetchedLevelIndex = -1;
 			}
+			else {
+				this->discardPrefetchedLevel();
+
+				const LoadStoryLevelResult& levelResult = this->campaignIndex.loadLevel(this->currLevelIndex);
+				if (!levelResult.validationResult.valid()) {
+					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildLevelErrorMessages(this->currLevelIndex, levelResult));
 
-			this->levelAssetBundle = new StoryLevelAssetBundle();
-			this->levelAssetBundle->loadLevelAsync(this->campaignFolder, this->levelDefnList[this->currLevelIndex]);
+					this->mode = StoryGameMode::LOAD_CAMPAIGN_ERROR;
+				}
+				else {
+					this->levelAssetBundle = new StoryLevelAssetBundle(*this->assetCache);
+					this->levelAssetBundle->loadLevelAsync(this->campaignFolder, this->campaignIndex.getLevelDefn(this->currLevelIndex), StoryLevelAssetLoadPriority::FOREGROUND);
+				}
+			}
 		}
 
 		void StoryGameController::updateBasedOnLoadLevelStatus() {
+			this->levelAssetBundle->uploadDecodedTextures();
+
 			StoryLevelAssetLoadingStatus assetLoadingStatus = this->levelAssetBundle->getLoadingStatus();
 			if (assetLoadingStatus.completionStatus == StoryLevelAssetLoadingCompletionStatus::FAILED) {
-				LoadStoryMapValidationResult loadMapValidationResult = this->levelAssetBundle->getLoadMapValidationResult();
-				if (!loadMapValidationResult.valid()) {
-					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryMapValidation::buildErrorMessages(loadMapValidationResult));
-				}
+				// A promoted prefetch also fails when the level itself did not validate
+				const LoadStoryLevelResult& levelResult = this->campaignIndex.loadLevel(this->currLevelIndex);
+				if (!levelResult.validationResult.valid()) {
+					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildLevelErrorMessages(this->currLevelIndex, levelResult));
 
-				std::vector<std::string> failedFilenameList = this->levelAssetBundle->getFailedFilenameList();
-				if (!failedFilenameList.empty()) {
-					StoryLoaderUtils::appendFailedFilenameListToErrorLog(this->levelAssetBundle->getFailedFilenameList());
+					this->mode = StoryGameMode::LOAD_CAMPAIGN_ERROR;
 				}
+				else {
+					LoadStoryMapValidationResult loadMapValidationResult = this->levelAssetBundle->getLoadMapValidationResult();
+					if (!loadMapValidationResult.valid()) {
+						StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryMapValidation::buildErrorMessages(loadMapValidationResult));
+					}
+
+					std::vector<std::string> failedFilenameList = this->levelAssetBundle->getFailedFilenameList();
+					if (!failedFilenameList.empty()) {
+						StoryLoaderUtils::appendFailedFilenameListToErrorLog(this->levelAssetBundle->getFailedFilenameList());
+					}
 
-				this->mode = StoryGameMode::LOAD_LEVEL_ERROR;
+					this->mode = StoryGameMode::LOAD_LEVEL_ERROR;
+				}
 			}
 			else if ( assetLoadingStatus.completionStatus == StoryLevelAssetLoadingCompletionStatus::COMPLETE) {
-				this->storyGame->startNewLevel(this->levelAssetBundle->getMapDefn(), this->levelDefnList[this->currLevelIndex]);
+				this->storyGame->startNewLevel(this->levelAssetBundle->getMapDefn(), this->campaignIndex.getLevelDefn(this->currLevelIndex));
+				this->initiatePrefetchNextLevel();
 
-				if (this->levelDefnList[this->currLevelIndex].openingCutsceneDefn.existsFlag) {
-					this->storyCutscene = new StoryCutscene(this->levelDefnList[this->currLevelIndex].openingCutsceneDefn);
+				if (this->campaignIndex.getLevelDefn(this->currLevelIndex).openingCutsceneDefn.existsFlag) {
+					this->storyCutscene = new StoryCutscene(this->campaignIndex.getLevelDefn(this->currLevelIndex).openingCutsceneDefn);
 
 					this->mode = StoryGameMode::PLAY_OPENING_CUTSCENE;
 				}
@@ -254,6 +307,34 @@ namespace r3 {
 			}
 		}
 
+		void StoryGameController::initiatePrefetchNextLevel() {
+			int nextLevelIndex = this->currLevelIndex + 1;
+			if ((nextLevelIndex < this->campaignIndex.getLevelCount()) && (this->prefetchedLevelIndex != nextLevelIndex)) {
+				this->discardPrefetchedLevel();
+
+				// The level definition is parsed on the bundle's thread too.  A level that fails validation leaves the
+				// bundle FAILED, and its errors are reported once the player reaches it.
+				// Decoding runs on a single worker and uploads one texture per frame, so the level being played never stalls
+				this->prefetchedLevelAssetBundle = new StoryLevelAssetBundle(*this->assetCache);
+				this->prefetchedLevelAssetBundle->loadCampaignLevelAsync(this->campaignFolder, this->campaignIndex, nextLevelIndex, StoryLevelAssetLoadPriority::BACKGROUND);
+				this->prefetchedLevelIndex = nextLevelIndex;
+			}
+		}
+
+		void StoryGameController::updatePrefetchedLevel() {
+			if (this->prefetchedLevelAssetBundle != nullptr) {
+				this->prefetchedLevelAssetBundle->uploadDecodedTextures();
+			}
+		}
+
+		void StoryGameController::discardPrefetchedLevel() {
+			if (this->prefetchedLevelAssetBundle != nullptr) {
+				delete this->prefetchedLevelAssetBundle;
+				this->prefetchedLevelAssetBundle = nullptr;
+			}
+			this->prefetchedLevelIndex = -1;
+		}
+
 		StoryGameSceneClientRequest StoryGameController::processLoadErrorKeyEvent(sf::Event& event) {
 			StoryGameSceneClientRequest result = StoryGameSceneClientRequest::NONE;
 
@@ -292,7 +373,7 @@ namespace r3 {
 
 			switch (event.key.code) {
 			case sf::Keyboard::Key::Enter:
-				this->storyGame->startRunningLevel();
+				this->startRunningLevel();
 				this->timeSnakeLastDamaged = sf::seconds(-0.5f);
 				this->renderer->clearAnimations();
 
@@ -389,8 +470,8 @@ namespace r3 {
 
 			switch (event.key.code) {
 			case sf::Keyboard::Key::Enter:
-				this->storyGame->startNewLevel(this->levelAssetBundle->getMapDefn(), this->levelDefnList[this->currLevelIndex]);
-				this->storyGame->startRunningLevel();
+				this->storyGame->startNewLevel(this->levelAssetBundle->getMapDefn(), this->campaignIndex.getLevelDefn(this->currLevelIndex));
+				this->startRunningLevel();
 				this->timeSnakeLastDamaged = sf::seconds(-0.5f);
 				this->renderer->clearAnimations();
 
@@ -426,7 +507,7 @@ namespace r3 {
 
 		void StoryGameController::updateOpeningCutscene() {
 			if (
-				!this->levelDefnList[this->currLevelIndex].openingCutsceneDefn.soundTrackFilename.empty() &&
+				!this->campaignIndex.getLevelDefn(this->currLevelIndex).openingCutsceneDefn.soundTrackFilename.empty() &&
 				this->storyCutscene->getCurrFrame() == 0
 			) {
 				this->soundManager.stopAllSounds();
@@ -447,7 +528,7 @@ namespace r3 {
 
 		void StoryGameController::updateWinCutscene() {
 			if (
-				!this->levelDefnList[this->currLevelIndex].winCutsceneDefn.soundTrackFilename.empty() &&
+				!this->campaignIndex.getLevelDefn(this->currLevelIndex).winCutsceneDefn.soundTrackFilename.empty() &&
 				this->storyCutscene->getCurrFrame() == 0
 			) {
 				this->soundManager.stopAllSounds();
@@ -468,7 +549,7 @@ namespace r3 {
 
 		void StoryGameController::updateLossCutscene() {
 			if (
-				!this->levelDefnList[this->currLevelIndex].lossCutsceneDefn.soundTrackFilename.empty() &&
+				!this->campaignIndex.getLevelDefn(this->currLevelIndex).lossCutsceneDefn.soundTrackFilename.empty() &&
 				this->storyCutscene->getCurrFrame() == 0
 			) {
 				this->soundManager.stopAllSounds();
@@ -488,9 +569,6 @@ namespace r3 {
 		}
 
 		void StoryGameController::updateGameRunning() {
-			StoryGameInputRequest inputRequest;
-			inputRequest.snakeMovementList = this->snakeMovementInputQueue;
-
 			sf::Music& music = this->levelAssetBundle->getMusic();
 			if (music.getStatus() == sf::SoundSource::Status::Stopped) {
 				music.setLoop(true);
@@ -498,7 +576,32 @@ namespace r3 {
 				music.play();
 			}
 
-			StoryGameUpdateResult updateResult = this->storyGame->update(inputRequest);
+			// Ticks follow the wall clock, so a slow frame runs the ticks it fell behind by rather than slowing the
+			// level down.  A stall longer than the catch-up cap is dropped instead of being run as a burst.
+			this->levelTimeAccumulated += this->levelTickClock.restart();
+
+			int tickCount = 0;
+			while (
+				(this->mode == StoryGameMode::GAME_RUNNING) &&
+				(tickCount < StoryGameControllerConstants::MAX_TICKS_PER_FRAME) &&
+				(this->levelTimeAccumulated >= StoryGameTickUtils::tickToTime(this->storyGame->getTicksElapsed() + 1))
+			) {
+				this->runGameTick();
+				tickCount++;
+			}
+
+			if (tickCount == StoryGameControllerConstants::MAX_TICKS_PER_FRAME) {
+				this->levelTimeAccumulated = std::min(this->levelTimeAccumulated, StoryGameTickUtils::tickToTime(this->storyGame->getTicksElapsed()));
+			}
+		}
+
+		void StoryGameController::runGameTick() {
+			StoryGameInputRequest inputRequest;
+			inputRequest.snakeMovementList = this->snakeMovementInputQueue;
+
+			StoryGameUpdateResult& updateResult = this->storyGameUpdateResult;
+			this->storyGame->update(inputRequest, updateResult);
+			this->replayRecorder->recordTick(inputRequest, *this->storyGame);
 
 			if (!updateResult.spawnedFoodInstanceList.empty()) {
 				this->soundManager.play(this->levelAssetBundle->getFoodSpawnedSoundBuffer());
@@ -526,17 +629,19 @@ namespace r3 {
 				this->timeSnakeLastDamaged = this->storyGame->getTimeElapsed();
 			}
 
-			for (auto const& currSoundFilename : updateResult.soundFileTriggeredList) {
-				this->soundManager.play(this->levelAssetBundle->getSoundBuffer(currSoundFilename));
+			for (int currSoundFxIndex : updateResult.soundFxIndexTriggeredList) {
+				int soundBufferHandle = this->campaignIndex.getLevelDefn(this->currLevelIndex).soundFxDefnList[currSoundFxIndex].soundBufferHandle;
+				this->soundManager.play(this->levelAssetBundle->getSoundBuffer(soundBufferHandle));
 			}
 
 			if (updateResult.snakeDiedFlag) {
+				// The replay's final state hash is taken from the score the run ended with, before it is reset
+				this->stopRunningLevel();
 				this->storyGame->resetScoreToLevelStart();
 				this->foodEatenSummaryMap.clear();
-				this->stopRunningLevel();
 
-				if (this->levelDefnList[this->currLevelIndex].lossCutsceneDefn.existsFlag) {
-					this->storyCutscene = new StoryCutscene(this->levelDefnList[this->currLevelIndex].lossCutsceneDefn);
+				if (this->campaignIndex.getLevelDefn(this->currLevelIndex).lossCutsceneDefn.existsFlag) {
+					this->storyCutscene = new StoryCutscene(this->campaignIndex.getLevelDefn(this->currLevelIndex).lossCutsceneDefn);
 
 					this->mode = StoryGameMode::PLAY_LOSS_CUTSCENE;
 				}
@@ -548,8 +653,8 @@ namespace r3 {
 			if (updateResult.completedLevelFlag) {
 				this->stopRunningLevel();
 
-				if (this->levelDefnList[this->currLevelIndex].winCutsceneDefn.existsFlag) {
-					this->storyCutscene = new StoryCutscene(this->levelDefnList[this->currLevelIndex].winCutsceneDefn);
+				if (this->campaignIndex.getLevelDefn(this->currLevelIndex).winCutsceneDefn.existsFlag) {
+					this->storyCutscene = new StoryCutscene(this->campaignIndex.getLevelDefn(this->currLevelIndex).winCutsceneDefn);
 
 					this->mode = StoryGameMode::PLAY_WIN_CUTSCENE;
 				}
@@ -579,13 +684,24 @@ namespace r3 {
 			this->foodEatenSummaryMap[foodEatenResult.foodInstance.foodType].totalScore += foodEatenResult.scoreResult.totalScore;
 		}
 
+		void StoryGameController::startRunningLevel() {
+			this->storyGame->startRunningLevel();
+			this->levelTickClock.restart();
+			this->levelTimeAccumulated = sf::Time::Zero;
+			this->replayRecorder->startRecording(this->campaignFolder, this->currLevelIndex, *this->storyGame);
+		}
+
 		void StoryGameController::stopRunningLevel() {
 			this->storyGame->stopRunningLevel();
 			this->levelAssetBundle->getMusic().stop();
+
+			this->replayRecorder->stopRecording(*this->storyGame);
+			this->replayRecorder->saveReplayAsync(StoryReplayConstants::LAST_REPLAY_FILENAME);
 		}
 
 		void StoryGameController::moveToNextLevel() {
-			if (this->currLevelIndex == (this->levelDefnList.size() - 1)) {
+			if (this->currLevelIndex == (this->campaignIndex.getLevelCount() - 1)) {
+				this->campaignIndex.flushCachedCampaign();
 				this->mode = StoryGameMode::CAMPAIGN_WON;
 			}
 			else {
@@ -1,4 +1,5 @@
 
+#include <cmath>
 #include <fstream>
 #include <codecvt>
 #include "../includes/r3-snake-utils.hpp"
@@ -53,6 +54,8 @@ namespace r3 {
 			const int FOOD_PIXEL_SIZE = 75;
 			const int DANGER_PIXEL_SIZE = 75;
 
+			const int LEVEL_MAP_HANDLE = -1;
+
 		}
 
 		namespace StoryGameRenderUtils {
@@ -103,42 +106,143 @@ namespace r3 {
 				return result;
 			}
 
-			void setFoodSpriteTextureRect(sf::Sprite& sprite, StoryFoodType foodType) {
+			sf::IntRect resolveFoodTextureRect(StoryFoodType foodType) {
+				sf::IntRect result;
+
 				switch (foodType) {
 				case StoryFoodType::APPLE:
-					sprite.setTextureRect(sf::IntRect(0, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(0, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::CARROT:
-					sprite.setTextureRect(sf::IntRect(75, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(75, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::GREEN_APPLE:
-					sprite.setTextureRect(sf::IntRect(150, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(150, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::CHILI_PEPPER:
-					sprite.setTextureRect(sf::IntRect(225, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(225, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::CHERRIES:
-					sprite.setTextureRect(sf::IntRect(300, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(300, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::ORANGE:
-					sprite.setTextureRect(sf::IntRect(0, 75, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(0, 75, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::PEAR:
-					sprite.setTextureRect(sf::IntRect(375, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(375, 0, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				case StoryFoodType::BANANA:
-					sprite.setTextureRect(sf::IntRect(75, 75, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE));
+					result = sf::IntRect(75, 75, StoryGameRenderConstants::FOOD_PIXEL_SIZE, StoryGameRenderConstants::FOOD_PIXEL_SIZE);
 					break;
 				}
+
+				return result;
+			}
+
+			void setFoodSpriteTextureRect(sf::Sprite& sprite, StoryFoodType foodType) {
+				sprite.setTextureRect(resolveFoodTextureRect(foodType));
 			}
 
-			void setDangerSpriteTextureRect(sf::Sprite& sprite, StoryDangerType dangerType, bool snakeOccupiesPosition) {
+			sf::IntRect resolveDangerTextureRect(StoryDangerType dangerType, bool snakeOccupiesPosition) {
+				sf::IntRect result;
+
 				switch (dangerType) {
 				case StoryDangerType::SPIKE_TRAP:
 					int textureRectXPos = (snakeOccupiesPosition ? 75 : 0);
-					sprite.setTextureRect(sf::IntRect(textureRectXPos, 0, StoryGameRenderConstants::DANGER_PIXEL_SIZE, StoryGameRenderConstants::DANGER_PIXEL_SIZE));
+					result = sf::IntRect(textureRectXPos, 0, StoryGameRenderConstants::DANGER_PIXEL_SIZE, StoryGameRenderConstants::DANGER_PIXEL_SIZE);
 					break;
 				}
+
+				return result;
+			}
+
+			const sf::Texture& resolveFloorTexture(const StoryLevelAssetBundle& levelAssetBundle, int cutsceneMapHandle, int floorId) {
+				const sf::Texture& result = (cutsceneMapHandle == StoryGameRenderConstants::LEVEL_MAP_HANDLE) ?
+					levelAssetBundle.getFloorTexture(floorId) :
+					levelAssetBundle.getCutsceneMapFloorTexture(cutsceneMapHandle, floorId);
+				return result;
+			}
+
+			const sf::Texture& resolveBarrierTexture(const StoryLevelAssetBundle& levelAssetBundle, int cutsceneMapHandle, int barrierId) {
+				const sf::Texture& result = (cutsceneMapHandle == StoryGameRenderConstants::LEVEL_MAP_HANDLE) ?
+					levelAssetBundle.getBarrierTexture(barrierId) :
+					levelAssetBundle.getCutsceneMapBarrierTexture(cutsceneMapHandle, barrierId);
+				return result;
+			}
+
+			const StoryTextureAtlasRegion& resolveTileAtlasRegion(const StoryLevelAssetBundle& levelAssetBundle, int cutsceneMapHandle, int tileId, bool barrierLayerFlag) {
+				const StoryTextureAtlasRegion* result = nullptr;
+
+				if (cutsceneMapHandle == StoryGameRenderConstants::LEVEL_MAP_HANDLE) {
+					result = barrierLayerFlag ? &levelAssetBundle.getBarrierAtlasRegion(tileId) : &levelAssetBundle.getFloorAtlasRegion(tileId);
+				}
+				else {
+					result = barrierLayerFlag ? &levelAssetBundle.getCutsceneMapBarrierAtlasRegion(cutsceneMapHandle, tileId) : &levelAssetBundle.getCutsceneMapFloorAtlasRegion(cutsceneMapHandle, tileId);
+				}
+
+				return *result;
+			}
+
+			const sf::Texture& resolveTileTexture(const StoryLevelAssetBundle& levelAssetBundle, int cutsceneMapHandle, int tileId, bool barrierLayerFlag) {
+				const sf::Texture& result = barrierLayerFlag ?
+					resolveBarrierTexture(levelAssetBundle, cutsceneMapHandle, tileId) :
+					resolveFloorTexture(levelAssetBundle, cutsceneMapHandle, tileId);
+				return result;
+			}
+
+			void appendTileQuad(sf::VertexArray& vertexArray, const sf::Vector2f& position, float tileSize, const sf::IntRect& textureRect) {
+				float textureLeft = (float)textureRect.left;
+				float textureTop = (float)textureRect.top;
+				float textureRight = (float)(textureRect.left + textureRect.width);
+				float textureBottom = (float)(textureRect.top + textureRect.height);
+
+				vertexArray.append(sf::Vertex(sf::Vector2f(position.x, position.y), sf::Vector2f(textureLeft, textureTop)));
+				vertexArray.append(sf::Vertex(sf::Vector2f(position.x + tileSize, position.y), sf::Vector2f(textureRight, textureTop)));
+				vertexArray.append(sf::Vertex(sf::Vector2f(position.x + tileSize, position.y + tileSize), sf::Vector2f(textureRight, textureBottom)));
+				vertexArray.append(sf::Vertex(sf::Vector2f(position.x, position.y + tileSize), sf::Vector2f(textureLeft, textureBottom)));
+			}
+
+			// Tiles packed into the atlas are gathered into one vertex array per atlas page and drawn together once the
+			// whole layer has been walked.  Tiles in one layer never overlap, so the order they reach the target in
+			// does not matter; the barrier layer is rendered as a separate pass so that it stays on top.
+			void renderTileLayer(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryMap& map, int cutsceneMapHandle, bool barrierLayerFlag) {
+				sf::Vector2i fieldSize = map.getFieldSize();
+				float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
+				sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
+
+				std::vector<sf::VertexArray> pageVertexArrayList(levelAssetBundle.getTextureAtlasPageCount(), sf::VertexArray(sf::Quads));
+
+				// Create a generic sprite for drawing a single tile at a time, for tiles that are not in the atlas
+				sf::Sprite tileSprite;
+
+				for (int y = 0; y < fieldSize.y; y++) {
+					for (int x = 0; x < fieldSize.x; x++) {
+						int tileId = barrierLayerFlag ? map.getBarrierId(x, y) : map.getFloorId(x, y);
+
+						// Floor id 0 is the primary grass tile, and barrier id 0 indicates no barrier exists in this location
+						if (tileId > 0) {
+							sf::Vector2f tilePosition(fieldPosition.x + (x * tileSize), fieldPosition.y + (y * tileSize));
+
+							const StoryTextureAtlasRegion& atlasRegion = resolveTileAtlasRegion(levelAssetBundle, cutsceneMapHandle, tileId, barrierLayerFlag);
+							if (atlasRegion.pageIndex >= 0) {
+								appendTileQuad(pageVertexArrayList[atlasRegion.pageIndex], tilePosition, tileSize, atlasRegion.textureRect);
+							}
+							else {
+								const sf::Texture& tileTexture = resolveTileTexture(levelAssetBundle, cutsceneMapHandle, tileId, barrierLayerFlag);
+								tileSprite.setTexture(tileTexture, true);
+								tileSprite.setScale(tileSize / (float)tileTexture.getSize().x, tileSize / (float)tileTexture.getSize().y);
+								tileSprite.setPosition(tilePosition);
+								renderTarget.draw(tileSprite);
+							}
+						}
+					}
+				}
+
+				for (size_t pageIndex = 0; pageIndex < pageVertexArrayList.size(); pageIndex++) {
+					if (pageVertexArrayList[pageIndex].getVertexCount() > 0) {
+						renderTarget.draw(pageVertexArrayList[pageIndex], &levelAssetBundle.getTextureAtlasPage((int)pageIndex));
+					}
+				}
 			}
 
 		}
@@ -193,6 +297,9 @@ namespace r3 {
 		StoryGameRenderer::StoryGameRenderer() {
 			this->uiFont = new sf::Font();
 			this->healthBarTexture = new sf::Texture();
+			this->cutsceneMapTextureCreateCount = 0;
+			this->cutsceneComposeTexture = nullptr;
+			this->cutsceneComposeTextureFailedFlag = false;
 
 			if (!this->uiFont->loadFromFile(StoryGameRenderConstants::UI_FONT_PATH)) {
 				throw "Could not load user interface font";
@@ -204,6 +311,10 @@ namespace r3 {
 		}
 
 		StoryGameRenderer::~StoryGameRenderer() {
+			this->clearBakedPlayingFields();
+			this->clearCutsceneMapTextures();
+			delete this->cutsceneComposeTexture;
+
 			delete this->uiFont;
 			delete this->healthBarTexture;
 		}
@@ -212,6 +323,24 @@ namespace r3 {
 			this->foodEatenAnimationList.clear();
 		}
 
+		void StoryGameRenderer::clearBakedPlayingFields() {
+			for (auto& currBakedPlayingFieldPair : this->bakedPlayingFieldMap) {
+				delete currBakedPlayingFieldPair.second.renderTexture;
+			}
+			this->bakedPlayingFieldMap.clear();
+		}
+
+		void StoryGameRenderer::clearCutsceneMapTextures() {
+			for (auto& currCutsceneMapTexturePair : this->cutsceneMapTextureMap) {
+				delete currCutsceneMapTexturePair.second;
+			}
+			this->cutsceneMapTextureMap.clear();
+		}
+
+		int StoryGameRenderer::getCutsceneMapTextureCreateCount() const {
+			return this->cutsceneMapTextureCreateCount;
+		}
+
 		void StoryGameRenderer::queueFoodEatenAnimations(const std::vector<StoryFoodEatenResult>& foodEatenResultList, const StoryGame* storyGame) {
 			for (auto const& currFoodEaten : foodEatenResultList) {
 				StoryFoodEatenAnimation currAnimation;
@@ -275,7 +404,10 @@ namespace r3 {
 		void StoryGameRenderer::renderCutscene(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState) {
 			renderTarget.clear(StoryGameRenderConstants::BACKGROUND_COLOR);
 
-			for (auto const& currScreenView : renderState.storyCutscene->getActiveScreenViewList()) {
+			const std::vector<StoryCutsceneScreenView>& screenViewList = renderState.storyCutscene->getActiveScreenViewList();
+			bool overlaysRenderedFlag = false;
+
+			for (auto const& currScreenView : screenViewList) {
 				if (currScreenView.screenEventType == StoryCutsceneScreenViewType::COLOR) {
 					// printf("Screen view color %d,%d,%d,%d\n", currScreenView.color.r, currScreenView.color.g, currScreenView.color.b, currScreenView.color.a);
 
@@ -283,88 +415,106 @@ namespace r3 {
 					renderTarget.draw(colorShape);
 				}
 				else if (currScreenView.screenEventType == StoryCutsceneScreenViewType::TEXTURE) {
-					// printf("Screen view texture <%s> at %d alpha\n", currScreenView.textureFilename.c_str(), StoryCutsceneRenderUtils::resolveScreenViewAlpha(currScreenView));
+					// printf("Screen view texture %d at %d alpha\n", currScreenView.textureHandle, StoryCutsceneRenderUtils::resolveScreenViewAlpha(currScreenView));
 
-					const sf::Texture& texture = renderState.levelAssetBundle->getTexture(currScreenView.textureFilename);
+					const sf::Texture& texture = renderState.levelAssetBundle->getTexture(currScreenView.textureHandle);
 					sf::Sprite textureSprite = StoryCutsceneRenderUtils::createScreenViewTextureSprite(currScreenView, texture);
 					renderTarget.draw(textureSprite);
 				}
 				else if ( currScreenView.screenEventType == StoryCutsceneScreenViewType::MAP) {
-					// printf("Screen view map <%s> at %d alpha\n", currScreenView.mapFilename.c_str(), StoryCutsceneRenderUtils::resolveScreenViewAlpha(currScreenView));
+					// printf("Screen view map %d at %d alpha\n", currScreenView.mapHandle, StoryCutsceneRenderUtils::resolveScreenViewAlpha(currScreenView));
 
-					sf::RenderTexture mapTexture;
-					mapTexture.create((unsigned int)ViewUtils::VIEW_SIZE.x, (unsigned int)ViewUtils::VIEW_SIZE.y);
-					mapTexture.clear(StoryGameRenderConstants::BACKGROUND_COLOR);
-					this->renderCutscenePlayingField(mapTexture, *renderState.levelAssetBundle, currScreenView);
+					const sf::RenderTexture* mapTexture = this->resolveCutsceneMapTexture(*renderState.levelAssetBundle, currScreenView);
 
-					sf::Sprite mapSprite = StoryCutsceneRenderUtils::createScreenViewTextureSprite(currScreenView, mapTexture.getTexture());
-					mapSprite.setPosition(0.0f, ViewUtils::VIEW_SIZE.y);
-					mapSprite.setScale(1.0f, -1.0f);
-					renderTarget.draw(mapSprite);
-				}
-			}
+					sf::RenderTexture* composeTexture = nullptr;
+					if ((mapTexture != nullptr) && (&currScreenView == &screenViewList.back()) && (StoryCutsceneRenderUtils::resolveScreenViewAlpha(currScreenView) < 255)) {
+						composeTexture = this->resolveCutsceneComposeTexture();
+					}
 
-			if (!renderState.storyCutscene->getActiveScreenViewList().empty()) {
-				if (renderState.storyCutscene->getSnake() != nullptr) {
-					this->renderCutsceneSnake(renderTarget, renderState);
+					if (composeTexture != nullptr) {
+						this->renderFadingCutsceneMap(renderTarget, renderState, currScreenView, *mapTexture, *composeTexture);
+						overlaysRenderedFlag = true;
+					}
+					else if (mapTexture != nullptr) {
+						sf::Sprite mapSprite = StoryCutsceneRenderUtils::createScreenViewTextureSprite(currScreenView, mapTexture->getTexture());
+						renderTarget.draw(mapSprite);
+					}
+					else {
+						this->renderCutscenePlayingField(renderTarget, *renderState.levelAssetBundle, currScreenView);
+					}
 				}
+			}
 
-				this->renderCutsceneFood(renderTarget, renderState);
-				this->renderCutsceneDangers(renderTarget, renderState);
+			if (!screenViewList.empty() && !overlaysRenderedFlag) {
+				this->renderCutsceneOverlays(renderTarget, renderState);
 			}
 		}
 
-		void StoryGameRenderer::renderCutscenePlayingField(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryCutsceneScreenView& screenView) {
-			const StoryMapDefn& mapDefn = levelAssetBundle.getCutsceneMapDefn(screenView.mapFilename);
-			StoryMap map(mapDefn);
-
-			sf::Vector2i fieldSize = map.getFieldSize();
-			float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
-			sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
+		// The map's texture only holds the playing field, so it never needs rendering again; the snake, food and
+		// dangers are drawn over it each frame.  Each cutscene map filename has a single handle in the bundle.
+		const sf::RenderTexture* StoryGameRenderer::resolveCutsceneMapTexture(const StoryLevelAssetBundle& levelAssetBundle, const StoryCutsceneScreenView& screenView) {
+			const sf::RenderTexture* result = nullptr;
 
-			const sf::Texture& primaryFloorTexture = levelAssetBundle.getCutsceneMapFloorTexture(screenView.mapFilename, 0);
+			auto cutsceneMapTextureItr = this->cutsceneMapTextureMap.find(screenView.mapHandle);
+			if (cutsceneMapTextureItr != this->cutsceneMapTextureMap.end()) {
+				result = cutsceneMapTextureItr->second;
+			}
+			else {
+				sf::RenderTexture* mapTexture = new sf::RenderTexture();
+				this->cutsceneMapTextureCreateCount++;
+
+				if (mapTexture->create((unsigned int)ViewUtils::VIEW_SIZE.x, (unsigned int)ViewUtils::VIEW_SIZE.y)) {
+					mapTexture->clear(StoryGameRenderConstants::BACKGROUND_COLOR);
+					this->renderCutscenePlayingField(*mapTexture, levelAssetBundle, screenView);
+					mapTexture->display();
+				}
+				else {
+					delete mapTexture;
+					mapTexture = nullptr;
+				}
 
-			// Draw primary grass tile (floorId = 0) under entire playing field
-			sf::Sprite grassSprite;
-			grassSprite.setTexture(primaryFloorTexture);
-			grassSprite.setScale(tileSize / (float)primaryFloorTexture.getSize().x, tileSize / (float)primaryFloorTexture.getSize().y);
-			grassSprite.setPosition(fieldPosition.x, fieldPosition.y);
-			grassSprite.setTextureRect(sf::IntRect(0, 0, fieldSize.x * primaryFloorTexture.getSize().x, fieldSize.y * primaryFloorTexture.getSize().y));
-			renderTarget.draw(grassSprite);
+				this->cutsceneMapTextureMap[screenView.mapHandle] = mapTexture;
+				result = mapTexture;
+			}
 
-			// Create a generic sprite for drawing a single tile at a time
-			sf::Sprite tileSprite;
-
-			for (int y = 0; y < fieldSize.y; y++) {
-				for (int x = 0; x < fieldSize.x; x++) {
-					int floorId = map.getFloorId(x, y);
-					int barrierId = map.getBarrierId(x, y);
-
-					// Draw the floor tile if it is not the primary
-					if (floorId > 0) {
-						const sf::Texture& floorTexture = levelAssetBundle.getCutsceneMapFloorTexture(screenView.mapFilename, floorId);
-						tileSprite.setTexture(floorTexture);
-						tileSprite.setScale(tileSize / (float)floorTexture.getSize().x, tileSize / (float)floorTexture.getSize().y);
-						tileSprite.setPosition(fieldPosition.x + (x * tileSize), fieldPosition.y + (y * tileSize));
-						renderTarget.draw(tileSprite);
-					}
+			return result;
+		}
 
-					// Draw the barrier tile if it does not indicate no barrier exists in this location
-					if (barrierId > 0) {
-						const sf::Texture& barrierTexture = levelAssetBundle.getCutsceneMapBarrierTexture(screenView.mapFilename, barrierId);
-						tileSprite.setTexture(barrierTexture);
-						tileSprite.setScale(tileSize / (float)barrierTexture.getSize().x, tileSize / (float)barrierTexture.getSize().y);
-						tileSprite.setPosition(fieldPosition.x + (x * tileSize), fieldPosition.y + (y * tileSize));
-						renderTarget.draw(tileSprite);
-					}
+		sf::RenderTexture* StoryGameRenderer::resolveCutsceneComposeTexture() {
+			if ((this->cutsceneComposeTexture == nullptr) && !this->cutsceneComposeTextureFailedFlag) {
+				this->cutsceneComposeTexture = new sf::RenderTexture();
+				if (!this->cutsceneComposeTexture->create((unsigned int)ViewUtils::VIEW_SIZE.x, (unsigned int)ViewUtils::VIEW_SIZE.y)) {
+					delete this->cutsceneComposeTexture;
+					this->cutsceneComposeTexture = nullptr;
+					this->cutsceneComposeTextureFailedFlag = true;
 				}
 			}
+
+			sf::RenderTexture* result = this->cutsceneComposeTexture;
+			return result;
+		}
+
+		// While the top map fades in or out, the snake, food and dangers on it are drawn into a copy of it first, so
+		// that they fade with the map rather than sitting at full opacity over it
+		void StoryGameRenderer::renderFadingCutsceneMap(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState, const StoryCutsceneScreenView& screenView, const sf::RenderTexture& mapTexture, sf::RenderTexture& composeTexture) {
+			composeTexture.clear(StoryGameRenderConstants::BACKGROUND_COLOR);
+			composeTexture.draw(sf::Sprite(mapTexture.getTexture()));
+			this->renderCutsceneOverlays(composeTexture, renderState);
+			composeTexture.display();
+
+			sf::Sprite composedSprite = StoryCutsceneRenderUtils::createScreenViewTextureSprite(screenView, composeTexture.getTexture());
+			renderTarget.draw(composedSprite);
+		}
+
+		void StoryGameRenderer::renderCutscenePlayingField(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryCutsceneScreenView& screenView) {
+			const StoryMapDefn& mapDefn = levelAssetBundle.getCutsceneMapDefn(screenView.mapHandle);
+			this->renderBakedPlayingField(renderTarget, levelAssetBundle, mapDefn, screenView.mapHandle);
 		}
 
 		void StoryGameRenderer::renderCutsceneSnake(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState) {
 			const StoryCutsceneScreenView& lastScreenView = renderState.storyCutscene->getActiveScreenViewList().back();
 			if (lastScreenView.screenEventType == StoryCutsceneScreenViewType::MAP) {
-				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapFilename);
+				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapHandle);
 
 				RenderUtils::RenderSnakeInput renderSnakeInput;
 				renderSnakeInput.fieldSize = mapDefn.fieldSize;
@@ -372,55 +522,57 @@ namespace r3 {
 				renderSnakeInput.snake = renderState.storyCutscene->getSnake();
 				renderSnakeInput.snakeHurtFlag = false;
 
-				RenderUtils::renderSnake(renderTarget, renderSnakeInput);
+				this->snakeVertexBuffer.render(renderTarget, renderSnakeInput);
 			}
 		}
 
-		void StoryGameRenderer::renderCutsceneFood(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState) {
+		void StoryGameRenderer::renderCutsceneOverlays(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState) {
+			if (renderState.storyCutscene->getSnake() != nullptr) {
+				this->renderCutsceneSnake(renderTarget, renderState);
+			}
+
+			this->appendCutsceneFood(renderState);
+			this->appendCutsceneDangers(renderState);
+			this->spriteBatch.render(renderTarget);
+		}
+
+		void StoryGameRenderer::appendCutsceneFood(const StoryCutsceneRenderState& renderState) {
 			const StoryCutsceneScreenView& lastScreenView = renderState.storyCutscene->getActiveScreenViewList().back();
 			if (lastScreenView.screenEventType == StoryCutsceneScreenViewType::MAP) {
-				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapFilename);
+				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapHandle);
 
 				sf::Vector2i fieldSize = mapDefn.fieldSize;
 				float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
 				sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
 
-				sf::Sprite foodSprite;
-				foodSprite.setTexture(renderState.levelAssetBundle->getFoodTexture());
-				foodSprite.setScale(tileSize / (float)StoryGameRenderConstants::FOOD_PIXEL_SIZE, tileSize / (float)StoryGameRenderConstants::FOOD_PIXEL_SIZE);
-
-				for (auto const& currFoodInstancePair : renderState.storyCutscene->getFoodInstanceMap()) {
-					StoryGameRenderUtils::setFoodSpriteTextureRect(foodSprite, currFoodInstancePair.second.foodType);
-					foodSprite.setPosition(fieldPosition.x + currFoodInstancePair.second.position.x * tileSize, fieldPosition.y + currFoodInstancePair.second.position.y * tileSize);
+				const sf::Texture& foodTexture = renderState.levelAssetBundle->getFoodTexture();
 
-					renderTarget.draw(foodSprite);
+				for (auto const& currFoodInstance : renderState.storyCutscene->getFoodSlotMap()) {
+					sf::Vector2f foodPosition(fieldPosition.x + currFoodInstance.position.x * tileSize, fieldPosition.y + currFoodInstance.position.y * tileSize);
+					this->spriteBatch.appendQuad(foodTexture, foodPosition, tileSize, StoryGameRenderUtils::resolveFoodTextureRect(currFoodInstance.foodType));
 				}
 			}
 		}
 
-		void StoryGameRenderer::renderCutsceneDangers(sf::RenderTarget& renderTarget, const StoryCutsceneRenderState& renderState) {
+		void StoryGameRenderer::appendCutsceneDangers(const StoryCutsceneRenderState& renderState) {
 			const StoryCutsceneScreenView& lastScreenView = renderState.storyCutscene->getActiveScreenViewList().back();
 			if (lastScreenView.screenEventType == StoryCutsceneScreenViewType::MAP) {
-				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapFilename);
+				const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getCutsceneMapDefn(lastScreenView.mapHandle);
 
 				sf::Vector2i fieldSize = mapDefn.fieldSize;
 				float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
 				sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
 
-				sf::Sprite dangerSprite;
-				dangerSprite.setTexture(renderState.levelAssetBundle->getDangerTexture());
-				dangerSprite.setScale(tileSize / (float)StoryGameRenderConstants::DANGER_PIXEL_SIZE, tileSize / (float)StoryGameRenderConstants::DANGER_PIXEL_SIZE);
+				const sf::Texture& dangerTexture = renderState.levelAssetBundle->getDangerTexture();
 
-				for (auto const& currDangerInstancePair : renderState.storyCutscene->getDangerInstanceMap()) {
+				for (auto const& currDangerInstance : renderState.storyCutscene->getDangerSlotMap()) {
 					bool snakeOccupiesPosition = false;
 					if (renderState.storyCutscene->getSnake() != nullptr) {
-						snakeOccupiesPosition = renderState.storyCutscene->getSnake()->occupiesPosition(currDangerInstancePair.second.position);
+						snakeOccupiesPosition = renderState.storyCutscene->getSnake()->occupiesPosition(currDangerInstance.position);
 					}
-					StoryGameRenderUtils::setDangerSpriteTextureRect(dangerSprite, currDangerInstancePair.second.dangerType, snakeOccupiesPosition);
 
-					dangerSprite.setPosition(fieldPosition.x + currDangerInstancePair.second.position.x * tileSize, fieldPosition.y + currDangerInstancePair.second.position.y * tileSize);
-
-					renderTarget.draw(dangerSprite);
+					sf::Vector2f dangerPosition(fieldPosition.x + currDangerInstance.position.x * tileSize, fieldPosition.y + currDangerInstance.position.y * tileSize);
+					this->spriteBatch.appendQuad(dangerTexture, dangerPosition, tileSize, StoryGameRenderUtils::resolveDangerTextureRect(currDangerInstance.dangerType, snakeOccupiesPosition));
 				}
 			}
 		}
@@ -438,8 +590,9 @@ namespace r3 {
 			this->renderGameRunningUi(renderTarget, renderState);
 			this->renderPlayingField(renderTarget, renderState);
 			this->renderSnake(renderTarget, renderState);
-			this->renderFoodSpawns(renderTarget, renderState);
-			this->renderDangerSpawns(renderTarget, renderState);
+			this->appendFoodSpawns(renderState);
+			this->appendDangerSpawns(renderState);
+			this->spriteBatch.render(renderTarget);
 			this->renderFoodEatenAnimations(renderTarget, renderState);
 		}
 
@@ -539,11 +692,31 @@ namespace r3 {
 		}
 
 		void StoryGameRenderer::renderPlayingField(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState) {
-			sf::Vector2i fieldSize = renderState.storyGame->getMap()->getFieldSize();
+			const StoryMapDefn& mapDefn = renderState.levelAssetBundle->getMapDefn();
+			this->renderBakedPlayingField(renderTarget, *renderState.levelAssetBundle, mapDefn, StoryGameRenderConstants::LEVEL_MAP_HANDLE);
+		}
+
+		void StoryGameRenderer::renderBakedPlayingField(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle) {
+			const StoryBakedPlayingField& bakedPlayingField = this->resolveBakedPlayingField(levelAssetBundle, mapDefn, cutsceneMapHandle);
+
+			if (bakedPlayingField.renderTexture != nullptr) {
+				sf::Sprite fieldSprite(bakedPlayingField.renderTexture->getTexture());
+				fieldSprite.setPosition(bakedPlayingField.position);
+				renderTarget.draw(fieldSprite);
+			}
+			else {
+				this->renderPlayingFieldTiles(renderTarget, levelAssetBundle, mapDefn, cutsceneMapHandle);
+			}
+		}
+
+		void StoryGameRenderer::renderPlayingFieldTiles(sf::RenderTarget& renderTarget, const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle) {
+			StoryMap map(mapDefn);
+
+			sf::Vector2i fieldSize = map.getFieldSize();
 			float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
 			sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
 
-			const sf::Texture& primaryFloorTexture = renderState.levelAssetBundle->getFloorTexture(0);
+			const sf::Texture& primaryFloorTexture = StoryGameRenderUtils::resolveFloorTexture(levelAssetBundle, cutsceneMapHandle, 0);
 
 			// Draw primary grass tile (floorId = 0) under entire playing field
 			sf::Sprite grassSprite;
@@ -553,33 +726,8 @@ namespace r3 {
 			grassSprite.setTextureRect(sf::IntRect(0, 0, fieldSize.x * primaryFloorTexture.getSize().x, fieldSize.y * primaryFloorTexture.getSize().y));
 			renderTarget.draw(grassSprite);
 
-			// Create a generic sprite for drawing a single tile at a time
-			sf::Sprite tileSprite;
-
-			for (int y = 0; y < fieldSize.y; y++) {
-				for (int x = 0; x < fieldSize.x; x++) {
-					int floorId = renderState.storyGame->getMap()->getFloorId(x, y);
-					int barrierId = renderState.storyGame->getMap()->getBarrierId(x, y);
-
-					// Draw the floor tile if it is not the primary
-					if (floorId > 0) {
-						const sf::Texture& floorTexture = renderState.levelAssetBundle->getFloorTexture(floorId);
-						tileSprite.setTexture(floorTexture);
-						tileSprite.setScale(tileSize / (float)floorTexture.getSize().x, tileSize / (float)floorTexture.getSize().y);
-						tileSprite.setPosition(fieldPosition.x + (x * tileSize), fieldPosition.y + (y * tileSize));
-						renderTarget.draw(tileSprite);
-					}
-
-					// Draw the barrier tile if it does not indicate no barrier exists in this location
-					if (barrierId > 0) {
-						const sf::Texture& barrierTexture = renderState.levelAssetBundle->getBarrierTexture(barrierId);
-						tileSprite.setTexture(barrierTexture);
-						tileSprite.setScale(tileSize / (float)barrierTexture.getSize().x, tileSize / (float)barrierTexture.getSize().y);
-						tileSprite.setPosition(fieldPosition.x + (x * tileSize), fieldPosition.y + (y * tileSize));
-						renderTarget.draw(tileSprite);
-					}
-				}
-			}
+			StoryGameRenderUtils::renderTileLayer(renderTarget, levelAssetBundle, map, cutsceneMapHandle, false);
+			StoryGameRenderUtils::renderTileLayer(renderTarget, levelAssetBundle, map, cutsceneMapHandle, true);
 		}
 
 		void StoryGameRenderer::renderSnake(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState) {
@@ -589,52 +737,38 @@ namespace r3 {
 			renderSnakeInput.snake = renderState.storyGame->getSnake();
 			renderSnakeInput.snakeHurtFlag = renderState.snakeDamagedFlag;
 
-			RenderUtils::renderSnake(renderTarget, renderSnakeInput);
+			this->snakeVertexBuffer.render(renderTarget, renderSnakeInput);
 		}
 
-		void StoryGameRenderer::renderFoodSpawns(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState) {
+		void StoryGameRenderer::appendFoodSpawns(const StoryGameRenderState& renderState) {
 			sf::Vector2i fieldSize = renderState.storyGame->getMap()->getFieldSize();
 			float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
 			sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
 
-			sf::Sprite foodSprite;
-			foodSprite.setTexture(renderState.levelAssetBundle->getFoodTexture());
-			foodSprite.setScale(tileSize / (float)StoryGameRenderConstants::FOOD_PIXEL_SIZE, tileSize / (float)StoryGameRenderConstants::FOOD_PIXEL_SIZE);
-
-			for (auto const& currFoodSpawnTracker : renderState.storyGame->getFoodSpawnTrackerList()) {
-				const StoryFoodDefn& foodDefn = currFoodSpawnTracker.getFoodDefn();
+			const sf::Texture& foodTexture = renderState.levelAssetBundle->getFoodTexture();
 
-				StoryGameRenderUtils::setFoodSpriteTextureRect(foodSprite, foodDefn.foodType);
+			for (auto const& currFoodSlot : renderState.storyGame->getFoodSlotMap()) {
+				const StoryFoodInstance& currFoodInstance = currFoodSlot.foodInstance;
 
-				for (auto const& currFoodInstance : currFoodSpawnTracker.getFoodInstanceList()) {
-					foodSprite.setPosition(fieldPosition.x + currFoodInstance.position.x * tileSize, fieldPosition.y + currFoodInstance.position.y * tileSize);
-
-					renderTarget.draw(foodSprite);
-				}
+				sf::Vector2f foodPosition(fieldPosition.x + currFoodInstance.position.x * tileSize, fieldPosition.y + currFoodInstance.position.y * tileSize);
+				this->spriteBatch.appendQuad(foodTexture, foodPosition, tileSize, StoryGameRenderUtils::resolveFoodTextureRect(currFoodInstance.foodType));
 			}
 		}
 
-		void StoryGameRenderer::renderDangerSpawns(sf::RenderTarget& renderTarget, const StoryGameRenderState& renderState) {
+		void StoryGameRenderer::appendDangerSpawns(const StoryGameRenderState& renderState) {
 			sf::Vector2i fieldSize = renderState.storyGame->getMap()->getFieldSize();
 			float tileSize = RenderUtils::resolveViewportTileSize(fieldSize);
 			sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(fieldSize, tileSize);
 
-			sf::Sprite dangerSprite;
-			dangerSprite.setTexture(renderState.levelAssetBundle->getDangerTexture());
-			dangerSprite.setScale(tileSize / (float)StoryGameRenderConstants::DANGER_PIXEL_SIZE, tileSize / (float)StoryGameRenderConstants::DANGER_PIXEL_SIZE);
+			const sf::Texture& dangerTexture = renderState.levelAssetBundle->getDangerTexture();
 
-			for (auto const& currDangerSpawnTracker : renderState.storyGame->getDangerSpawnTrackerList()) {
-				const StoryDangerDefn& dangerDefn = currDangerSpawnTracker.getDangerDefn();
-
-				for (auto const& currDangerInstance : currDangerSpawnTracker.getDangerInstanceList()) {
-					bool snakeOccupiesPosition = renderState.storyGame->getSnake()->occupiesPosition(currDangerInstance.position);
-					int textureRectXPos = (snakeOccupiesPosition ? 75 : 0);
+			for (auto const& currDangerSlot : renderState.storyGame->getDangerSlotMap()) {
+				const StoryDangerInstance& currDangerInstance = currDangerSlot.dangerInstance;
 
-					dangerSprite.setTextureRect(sf::IntRect(textureRectXPos, 0, StoryGameRenderConstants::DANGER_PIXEL_SIZE, StoryGameRenderConstants::DANGER_PIXEL_SIZE));
-					dangerSprite.setPosition(fieldPosition.x + currDangerInstance.position.x * tileSize, fieldPosition.y + currDangerInstance.position.y * tileSize);
+				bool snakeOccupiesPosition = renderState.storyGame->getSnake()->occupiesPosition(currDangerInstance.position);
 
-					renderTarget.draw(dangerSprite);
-				}
+				sf::Vector2f dangerPosition(fieldPosition.x + currDangerInstance.position.x * tileSize, fieldPosition.y + currDangerInstance.position.y * tileSize);
+				this->spriteBatch.appendQuad(dangerTexture, dangerPosition, tileSize, StoryGameRenderUtils::resolveDangerTextureRect(currDangerInstance.dangerType, snakeOccupiesPosition));
 			}
 		}
 
@@ -760,6 +894,43 @@ namespace r3 {
 			renderTarget.draw(exitInstructionsText);
 		}
 
+		// The render texture covers the playing field rounded out to whole pixels, with its view set to the same
+		// rectangle so the tiles land exactly where they would if drawn straight to the window.  If one cannot be
+		// created, the entry is left empty and the tiles are drawn every frame as before.
+		const StoryBakedPlayingField& StoryGameRenderer::resolveBakedPlayingField(const StoryLevelAssetBundle& levelAssetBundle, const StoryMapDefn& mapDefn, int cutsceneMapHandle) {
+			auto bakedPlayingFieldIter = this->bakedPlayingFieldMap.find(mapDefn.tileGrid.get());
+			if (bakedPlayingFieldIter != this->bakedPlayingFieldMap.end()) {
+				return bakedPlayingFieldIter->second;
+			}
+
+			float tileSize = RenderUtils::resolveViewportTileSize(mapDefn.fieldSize);
+			sf::Vector2f fieldPosition = RenderUtils::resolveViewportFieldTopLeftPosition(mapDefn.fieldSize, tileSize);
+
+			sf::Vector2f bakedPosition(std::floor(fieldPosition.x), std::floor(fieldPosition.y));
+			sf::Vector2u bakedSize(
+				(unsigned int)(std::ceil(fieldPosition.x + mapDefn.fieldSize.x * tileSize) - bakedPosition.x),
+				(unsigned int)(std::ceil(fieldPosition.y + mapDefn.fieldSize.y * tileSize) - bakedPosition.y)
+			);
+
+			StoryBakedPlayingField bakedPlayingField;
+			bakedPlayingField.tileGrid = mapDefn.tileGrid;
+			bakedPlayingField.renderTexture = new sf::RenderTexture();
+			bakedPlayingField.position = bakedPosition;
+
+			if (bakedPlayingField.renderTexture->create(bakedSize.x, bakedSize.y)) {
+				bakedPlayingField.renderTexture->setView(sf::View(sf::FloatRect(bakedPosition.x, bakedPosition.y, (float)bakedSize.x, (float)bakedSize.y)));
+				bakedPlayingField.renderTexture->clear(sf::Color::Transparent);
+				this->renderPlayingFieldTiles(*bakedPlayingField.renderTexture, levelAssetBundle, mapDefn, cutsceneMapHandle);
+				bakedPlayingField.renderTexture->display();
+			} else {
+				delete bakedPlayingField.renderTexture;
+				bakedPlayingField.renderTexture = nullptr;
+			}
+
+			auto insertResult = this->bakedPlayingFieldMap.insert({ mapDefn.tileGrid.get(), bakedPlayingField });
+			return insertResult.first->second;
+		}
+
 		sf::RectangleShape StoryGameRenderer::createTextBackgroundShape(float width, float height) {
 			sf::RectangleShape result(sf::Vector2f(width, height));
 			result.setPosition((ViewUtils::VIEW_SIZE.x / 2.0f) - (width / 2.0f), (ViewUtils::VIEW_SIZE.y / 2.0f) - (height / 2.0f) + 50.0f);
@@ -0,0 +1,433 @@
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../includes/r3-snake-storyjsonscan.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryJsonScanConstants {
+
+			const int MAX_NESTING_DEPTH = 1000;
+
+		}
+
+		namespace StoryJsonScanUtils {
+
+			bool fail(ScanCursor& cursor, const char* errorDescription) {
+				if (cursor.errorString.empty()) {
+					int lineNumber = 1;
+					size_t lineStartPosition = 0;
+					for (size_t charIndex = 0; (charIndex < cursor.position) && (charIndex < cursor.size); charIndex++) {
+						if (cursor.data[charIndex] == '\n') {
+							lineNumber++;
+							lineStartPosition = charIndex + 1;
+						}
+					}
+
+					char errorStr[200];
+					snprintf(errorStr, sizeof(errorStr), "* Line %d, Column %d\n  Syntax error: %s\n", lineNumber, (int)(cursor.position - lineStartPosition + 1), errorDescription);
+					cursor.errorString = errorStr;
+				}
+				return false;
+			}
+
+			bool atEnd(const ScanCursor& cursor) {
+				bool result = (cursor.position >= cursor.size);
+				return result;
+			}
+
+			char peek(const ScanCursor& cursor) {
+				char result = atEnd(cursor) ? '\0' : cursor.data[cursor.position];
+				return result;
+			}
+
+			void skipWhitespace(ScanCursor& cursor) {
+				while (!atEnd(cursor)) {
+					char currChar = cursor.data[cursor.position];
+					if ((currChar == ' ') || (currChar == '\t') || (currChar == '\n') || (currChar == '\r')) {
+						cursor.position++;
+					}
+					else {
+						break;
+					}
+				}
+			}
+
+			bool expect(ScanCursor& cursor, char expectedChar, const char* errorDescription) {
+				skipWhitespace(cursor);
+
+				bool result = (peek(cursor) == expectedChar);
+				if (result) {
+					cursor.position++;
+				}
+				else {
+					fail(cursor, errorDescription);
+				}
+				return result;
+			}
+
+			bool isHexDigit(char value) {
+				bool result =
+					((value >= '0') && (value <= '9')) ||
+					((value >= 'a') && (value <= 'f')) ||
+					((value >= 'A') && (value <= 'F'));
+				return result;
+			}
+
+			bool isDigit(char value) {
+				bool result = (value >= '0') && (value <= '9');
+				return result;
+			}
+
+			bool scanString(ScanCursor& cursor, const char** rawBegin, size_t* rawLength) {
+				skipWhitespace(cursor);
+				if (peek(cursor) != '"') {
+					return fail(cursor, "string expected.");
+				}
+				cursor.position++;
+
+				size_t beginPosition = cursor.position;
+				while (!atEnd(cursor) && (cursor.data[cursor.position] != '"')) {
+					unsigned char currChar = (unsigned char)cursor.data[cursor.position];
+					if (currChar < 0x20) {
+						return fail(cursor, "control character within a string.");
+					}
+
+					if (currChar == '\\') {
+						cursor.position++;
+						char escapeChar = peek(cursor);
+						if (escapeChar == 'u') {
+							for (int hexIndex = 0; hexIndex < 4; hexIndex++) {
+								cursor.position++;
+								if (!isHexDigit(peek(cursor))) {
+									return fail(cursor, "bad unicode escape sequence in string.");
+								}
+							}
+						}
+						else if ((escapeChar == '\0') || (strchr("\"\\/bfnrt", escapeChar) == nullptr)) {
+							return fail(cursor, "bad escape sequence in string.");
+						}
+					}
+					cursor.position++;
+				}
+
+				if (atEnd(cursor)) {
+					return fail(cursor, "missing '\"' at the end of a string.");
+				}
+
+				if (rawBegin != nullptr) {
+					*rawBegin = cursor.data + beginPosition;
+					*rawLength = cursor.position - beginPosition;
+				}
+				cursor.position++;
+
+				return true;
+			}
+
+			// Numbers are tokenized as leniently as jsoncpp does it; campaigns in the wild contain values like 05
+			bool scanNumber(ScanCursor& cursor) {
+				if (peek(cursor) == '-') {
+					cursor.position++;
+				}
+
+				if (!isDigit(peek(cursor))) {
+					return fail(cursor, "value, object or array expected.");
+				}
+				while (isDigit(peek(cursor))) {
+					cursor.position++;
+				}
+
+				if (peek(cursor) == '.') {
+					cursor.position++;
+					while (isDigit(peek(cursor))) {
+						cursor.position++;
+					}
+				}
+
+				if ((peek(cursor) == 'e') || (peek(cursor) == 'E')) {
+					cursor.position++;
+					if ((peek(cursor) == '+') || (peek(cursor) == '-')) {
+						cursor.position++;
+					}
+					while (isDigit(peek(cursor))) {
+						cursor.position++;
+					}
+				}
+
+				return true;
+			}
+
+			void appendCodePoint(std::string& value, unsigned int codePoint) {
+				if (codePoint <= 0x7F) {
+					value.push_back((char)codePoint);
+				}
+				else if (codePoint <= 0x7FF) {
+					value.push_back((char)(0xC0 | (codePoint >> 6)));
+					value.push_back((char)(0x80 | (codePoint & 0x3F)));
+				}
+				else {
+					value.push_back((char)(0xE0 | (codePoint >> 12)));
+					value.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+					value.push_back((char)(0x80 | (codePoint & 0x3F)));
+				}
+			}
+
+			unsigned int convertHexDigit(char value) {
+				unsigned int result = 0;
+				if ((value >= '0') && (value <= '9')) {
+					result = value - '0';
+				}
+				else if ((value >= 'a') && (value <= 'f')) {
+					result = value - 'a' + 10;
+				}
+				else {
+					result = value - 'A' + 10;
+				}
+				return result;
+			}
+
+			char convertEscapeChar(char escapeChar) {
+				char result = escapeChar;
+				switch (escapeChar) {
+				case 'b':
+					result = '\b';
+					break;
+				case 'f':
+					result = '\f';
+					break;
+				case 'n':
+					result = '\n';
+					break;
+				case 'r':
+					result = '\r';
+					break;
+				case 't':
+					result = '\t';
+					break;
+				}
+				return result;
+			}
+
+			bool scanDecodedString(ScanCursor& cursor, std::string& value) {
+				const char* rawBegin = nullptr;
+				size_t rawLength = 0;
+				if (!scanString(cursor, &rawBegin, &rawLength)) {
+					return false;
+				}
+
+				value.clear();
+				value.reserve(rawLength);
+				for (size_t charIndex = 0; charIndex < rawLength; charIndex++) {
+					if (rawBegin[charIndex] != '\\') {
+						value.push_back(rawBegin[charIndex]);
+					}
+					else if (rawBegin[charIndex + 1] != 'u') {
+						value.push_back(convertEscapeChar(rawBegin[charIndex + 1]));
+						charIndex++;
+					}
+					else {
+						unsigned int codePoint = 0;
+						for (int hexIndex = 0; hexIndex < 4; hexIndex++) {
+							codePoint = (codePoint << 4) | convertHexDigit(rawBegin[charIndex + 2 + hexIndex]);
+						}
+						charIndex += 5;
+
+						// jsoncpp pairs surrogates up in its own particular way; such strings are left to it
+						if ((codePoint >= 0xD800) && (codePoint <= 0xDFFF)) {
+							return fail(cursor, "unicode surrogate pair in string.");
+						}
+						appendCodePoint(value, codePoint);
+					}
+				}
+
+				return true;
+			}
+
+			// Follows jsoncpp's decodeNumber: a token of digits is an integer, anything with a fraction or exponent
+			// is a double, and a double only counts as an int when it is integral and within range
+			bool scanInt(ScanCursor& cursor, int depth, bool* intFlag, int* value) {
+				skipWhitespace(cursor);
+
+				*intFlag = false;
+				*value = 0;
+
+				if ((peek(cursor) != '-') && !isDigit(peek(cursor))) {
+					return scanValue(cursor, depth);
+				}
+
+				size_t tokenPosition = cursor.position;
+				if (!scanNumber(cursor)) {
+					return false;
+				}
+
+				const char* token = cursor.data + tokenPosition;
+				size_t tokenLength = cursor.position - tokenPosition;
+				bool negativeFlag = (token[0] == '-');
+
+				bool integralTokenFlag = true;
+				for (size_t charIndex = 0; charIndex < tokenLength; charIndex++) {
+					integralTokenFlag = integralTokenFlag && (token[charIndex] != '.') && (token[charIndex] != 'e') && (token[charIndex] != 'E');
+				}
+
+				if (integralTokenFlag) {
+					unsigned long long magnitude = 0;
+					unsigned long long maxMagnitude = negativeFlag ? 2147483648ULL : 2147483647ULL;
+					bool inRangeFlag = true;
+					for (size_t charIndex = negativeFlag ? 1 : 0; (charIndex < tokenLength) && inRangeFlag; charIndex++) {
+						magnitude = magnitude * 10 + (token[charIndex] - '0');
+						inRangeFlag = (magnitude <= maxMagnitude);
+					}
+
+					*intFlag = inRangeFlag;
+					if (inRangeFlag) {
+						*value = negativeFlag ? (int)(-(long long)magnitude) : (int)magnitude;
+					}
+				}
+				else {
+					std::string tokenString(token, tokenLength);
+					char* tokenEnd = nullptr;
+					double realValue = strtod(tokenString.c_str(), &tokenEnd);
+					if (tokenEnd != tokenString.c_str() + tokenLength) {
+						return fail(cursor, "number could not be read.");
+					}
+
+					*intFlag =
+						(realValue >= (double)INT_MIN) &&
+						(realValue <= (double)INT_MAX) &&
+						(floor(realValue) == realValue);
+					if (*intFlag) {
+						*value = (int)realValue;
+					}
+				}
+
+				return true;
+			}
+
+			bool scanLiteral(ScanCursor& cursor, const char* literal) {
+				size_t literalLength = strlen(literal);
+				bool result =
+					((cursor.size - cursor.position) >= literalLength) &&
+					(memcmp(cursor.data + cursor.position, literal, literalLength) == 0);
+				if (result) {
+					cursor.position += literalLength;
+				}
+				else {
+					fail(cursor, "value, object or array expected.");
+				}
+				return result;
+			}
+
+
+			bool scanObjectMembers(ScanCursor& cursor, int depth) {
+				skipWhitespace(cursor);
+				if (peek(cursor) == '}') {
+					cursor.position++;
+					return true;
+				}
+
+				bool moreMembersFlag = true;
+				while (moreMembersFlag) {
+					if (!scanString(cursor, nullptr, nullptr) || !expect(cursor, ':', "missing ':' after object member name.") || !scanValue(cursor, depth + 1)) {
+						return false;
+					}
+
+					skipWhitespace(cursor);
+					if (peek(cursor) == ',') {
+						cursor.position++;
+					}
+					else if (peek(cursor) == '}') {
+						cursor.position++;
+						moreMembersFlag = false;
+					}
+					else {
+						return fail(cursor, "missing ',' or '}' in object declaration.");
+					}
+				}
+
+				return true;
+			}
+
+			bool scanArrayElements(ScanCursor& cursor, int depth) {
+				skipWhitespace(cursor);
+				if (peek(cursor) == ']') {
+					cursor.position++;
+					return true;
+				}
+
+				bool moreElementsFlag = true;
+				while (moreElementsFlag) {
+					if (!scanValue(cursor, depth + 1)) {
+						return false;
+					}
+
+					skipWhitespace(cursor);
+					if (peek(cursor) == ',') {
+						cursor.position++;
+					}
+					else if (peek(cursor) == ']') {
+						cursor.position++;
+						moreElementsFlag = false;
+					}
+					else {
+						return fail(cursor, "missing ',' or ']' in array declaration.");
+					}
+				}
+
+				return true;
+			}
+
+			bool scanValue(ScanCursor& cursor, int depth) {
+				if (depth > StoryJsonScanConstants::MAX_NESTING_DEPTH) {
+					return fail(cursor, "values are nested too deeply.");
+				}
+
+				skipWhitespace(cursor);
+
+				bool result = false;
+				switch (peek(cursor)) {
+				case '{':
+					cursor.position++;
+					result = scanObjectMembers(cursor, depth);
+					break;
+				case '[':
+					cursor.position++;
+					result = scanArrayElements(cursor, depth);
+					break;
+				case '"':
+					result = scanString(cursor, nullptr, nullptr);
+					break;
+				case 't':
+					result = scanLiteral(cursor, "true");
+					break;
+				case 'f':
+					result = scanLiteral(cursor, "false");
+					break;
+				case 'n':
+					result = scanLiteral(cursor, "null");
+					break;
+				default:
+					result = scanNumber(cursor);
+					break;
+				}
+
+				return result;
+			}
+
+
+			bool nameMatches(const char* rawBegin, size_t rawLength, const char* name) {
+				bool result =
+					(strlen(name) == rawLength) &&
+					(memcmp(rawBegin, name, rawLength) == 0);
+				return result;
+			}
+
+		}
+
+	}
+
+}
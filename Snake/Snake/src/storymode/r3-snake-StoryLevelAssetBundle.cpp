@@ -1,6 +1,8 @@
 
 #include <assert.h>
 #include <string>
+#include <thread>
+#include <algorithm>
 #include "../includes/r3-snake-storyassets.hpp"
 #include "../includes/r3-snake-storyloader.hpp"
 
@@ -19,6 +21,10 @@ namespace r3 {
 			const char* DEFAULT_HIT_BARRIER_SOUND_PATH = "resources/sounds/hit-barrier.wav";
 			const char* DEFAULT_SNAKE_HISS_SOUND_PATH = "resources/sounds/snake-hiss.wav";
 
+			const int TEXTURE_UPLOAD_BATCH_SIZE = 8;
+			const int BACKGROUND_TEXTURE_UPLOAD_BATCH_SIZE = 1;
+			const int BACKGROUND_DECODE_WORKER_COUNT = 1;
+
 		}
 
 		namespace StoryLevelAssetBundleUtils {
@@ -30,14 +36,8 @@ namespace r3 {
 					result++;
 				}
 
-				for (auto const& currEventDefn : cutsceneDefn.eventDefnList) {
-					if (
-						(currEventDefn.eventType == StoryCutsceneEventType::TEXTURE) ||
-						(currEventDefn.eventType == StoryCutsceneEventType::SHOW_MAP)
-					) {
-						result++;
-					}
-				}
+				result += (int)cutsceneDefn.textureEventList.size();
+				result += (int)cutsceneDefn.mapEventList.size();
 
 				return result;
 			}
@@ -65,25 +65,70 @@ namespace r3 {
 				return result;
 			}
 
+			int resolveDecodeWorkerCount(size_t decodeJobCount, StoryLevelAssetLoadPriority loadPriority) {
+				int result = StoryLevelAssetBundleConstants::BACKGROUND_DECODE_WORKER_COUNT;
+				if (loadPriority == StoryLevelAssetLoadPriority::FOREGROUND) {
+					result = std::max(1, (int)std::thread::hardware_concurrency());
+				}
+				result = std::min(result, std::max(1, (int)decodeJobCount));
+				return result;
+			}
+
 		}
 
-		StoryLevelAssetBundle::StoryLevelAssetBundle() {
+		StoryLevelAssetBundle::StoryLevelAssetBundle(StoryAssetCache& assetCache) {
+			this->campaignIndex = { nullptr };
+			this->campaignLevelIndex = -1;
 			this->levelDefn = { nullptr };
 			this->loadingThread = { nullptr };
+			this->assetCache = &assetCache;
+			this->loadPriority = StoryLevelAssetLoadPriority::FOREGROUND;
+			this->cancelRequestedFlag = false;
 			this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::PENDING;
 			this->totalAssetCount = 0;
 			this->loadedAssetCount = 0;
+			this->nextDecodeJobIndex = 0;
+			this->runningDecodeWorkerCount = 0;
+			this->nextTextureUploadHandle = 0;
+			this->nextTextureAtlasPageUploadIndex = 0;
+			this->snakeTextureHandle = -1;
+			this->foodTextureHandle = -1;
+			this->dangerTextureHandle = -1;
+			this->foodSpawnedSoundBufferHandle = -1;
+			this->eatFoodSoundBufferHandle = -1;
+			this->hitBarrierSoundBufferHandle = -1;
+			this->snakeHissSoundBufferHandle = -1;
 		}
 
 		StoryLevelAssetBundle::~StoryLevelAssetBundle() {
+			// Deleting the thread waits for it, so the decode workers are told to stop after their current file
 			if (this->loadingThread != nullptr) {
+				this->cancelRequestedFlag = true;
 				delete this->loadingThread;
 			}
+
+			for (size_t textureHandle = 0; textureHandle < this->textureList.size(); textureHandle++) {
+				if (this->textureList[textureHandle] != nullptr) {
+					this->assetCache->release(this->textureKeyList[textureHandle]);
+				}
+				this->releaseTileImage(textureHandle);
+			}
+
+			for (size_t soundBufferHandle = 0; soundBufferHandle < this->soundBufferList.size(); soundBufferHandle++) {
+				if (this->soundBufferList[soundBufferHandle] != nullptr) {
+					this->assetCache->release(this->soundBufferKeyList[soundBufferHandle]);
+				}
+			}
+
+			for (auto currTextureAtlasPage : this->textureAtlasPageList) {
+				delete currTextureAtlasPage;
+			}
 		}
 
-		void StoryLevelAssetBundle::loadLevelAsync(const std::string& campaignFolderName, StoryLevelDefn& levelDefn) {
+		void StoryLevelAssetBundle::loadLevelAsync(const std::string& campaignFolderName, StoryLevelDefn& levelDefn, StoryLevelAssetLoadPriority loadPriority) {
 			assert( this->loadingCompletionStatus == StoryLevelAssetLoadingCompletionStatus::PENDING );
 
+			this->loadPriority = loadPriority;
 			this->campaignFolderName = campaignFolderName;
 			this->levelDefn = &levelDefn;
 			this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::LOADING;
@@ -93,13 +138,85 @@ namespace r3 {
 			this->loadingThread->launch();
 		}
 
+		// The level definition is parsed and validated on the loading thread as well.  The campaign index must
+		// not be asked for this level again until the bundle has finished.
+		void StoryLevelAssetBundle::loadCampaignLevelAsync(const std::string& campaignFolderName, StoryCampaignIndex& campaignIndex, int levelIndex, StoryLevelAssetLoadPriority loadPriority) {
+			assert( this->loadingCompletionStatus == StoryLevelAssetLoadingCompletionStatus::PENDING );
+
+			this->loadPriority = loadPriority;
+			this->campaignFolderName = campaignFolderName;
+			this->campaignIndex = &campaignIndex;
+			this->campaignLevelIndex = levelIndex;
+			this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::LOADING;
+
+			this->loadingThread = new sf::Thread(&StoryLevelAssetBundle::loadCampaignLevel, this);
+			this->loadingThread->launch();
+		}
+
+		// Promoting a bundle raises its upload batch size, and if it is still decoding, its decode worker count as well
+		void StoryLevelAssetBundle::setLoadPriority(StoryLevelAssetLoadPriority loadPriority) {
+			{
+				std::lock_guard<std::mutex> decodeWorkerLock(this->decodeWorkerMutex);
+				this->loadPriority = loadPriority;
+			}
+			this->decodeWorkerCondition.notify_one();
+		}
+
+		void StoryLevelAssetBundle::uploadDecodedTextures() {
+			if (this->loadingCompletionStatus == StoryLevelAssetLoadingCompletionStatus::UPLOADING) {
+				int uploadBatchSize = StoryLevelAssetBundleConstants::TEXTURE_UPLOAD_BATCH_SIZE;
+				if (this->loadPriority == StoryLevelAssetLoadPriority::BACKGROUND) {
+					uploadBatchSize = StoryLevelAssetBundleConstants::BACKGROUND_TEXTURE_UPLOAD_BATCH_SIZE;
+				}
+
+				// Textures are uploaded a few at a time so the loading screen keeps drawing between batches.
+				// Textures already resident in the asset cache cost nothing here, so they do not count toward a batch.
+				// Atlased tiles are left to their atlas page, and keep their image in case that page fails to upload.
+				int uploadedCount = 0;
+				while ((this->nextTextureUploadHandle < this->textureList.size()) && (uploadedCount < uploadBatchSize)) {
+					size_t textureHandle = this->nextTextureUploadHandle;
+					switch (this->textureDecodeStatusList[textureHandle]) {
+					case StoryAssetDecodeStatus::CACHED:
+						this->incrementLoadedAssetCount();
+						this->textureImageList[textureHandle] = sf::Image();
+						break;
+					case StoryAssetDecodeStatus::DECODED:
+						if (this->textureAtlasRegionList[textureHandle].pageIndex < 0) {
+							this->uploadDecodedTexture(textureHandle);
+							uploadedCount++;
+						}
+						break;
+					default:
+						break;
+					}
+
+					this->nextTextureUploadHandle++;
+				}
+
+				// Atlas pages are the largest uploads, so each gets a call to itself once the textures are done
+				bool texturesUploadedFlag = (this->nextTextureUploadHandle >= this->textureList.size());
+				if (texturesUploadedFlag && (uploadedCount == 0) && (this->nextTextureAtlasPageUploadIndex < this->textureAtlasPageImageList.size())) {
+					this->uploadNextTextureAtlasPage();
+				}
+
+				if (texturesUploadedFlag && (this->nextTextureAtlasPageUploadIndex >= this->textureAtlasPageImageList.size())) {
+					this->textureAtlasPageImageList.clear();
+					this->indicateLoadingComplete();
+				}
+			}
+		}
+
 		StoryLevelAssetLoadingStatus StoryLevelAssetBundle::getLoadingStatus() {
 			StoryLevelAssetLoadingStatus result;
 
+			result.completionStatus = this->loadingCompletionStatus;
+			result.loadedPct = 0.0f;
+			if (this->totalAssetCount > 0) {
+				result.loadedPct = (float)this->loadedAssetCount / (float)this->totalAssetCount;
+			}
+
 			this->loadingStatusMutex.lock();
 
-			result.completionStatus = this->loadingCompletionStatus;
-			result.loadedPct = (float)this->loadedAssetCount / (float)this->totalAssetCount;
 			result.currFilename = this->currFilenameBeingLoaded;
 
 			this->loadingStatusMutex.unlock();
@@ -120,48 +237,107 @@ namespace r3 {
 			return this->mapAssetBundle.mapDefn;
 		}
 
-		const sf::Texture& StoryLevelAssetBundle::getTexture(const std::string& filename) const {
-			return this->textureMap.at(filename);
+		const sf::Texture& StoryLevelAssetBundle::getTexture(int textureHandle) const {
+			assert( (textureHandle >= 0) && (textureHandle < (int)this->textureList.size()) );
+			assert( this->textureList[textureHandle] != nullptr );
+
+			return *this->textureList[textureHandle];
 		}
 
 		const sf::Texture& StoryLevelAssetBundle::getSnakeTexture() const {
-			return this->snakeTexture;
+			return this->getTexture(this->snakeTextureHandle);
 		}
 
 		const sf::Texture& StoryLevelAssetBundle::getFoodTexture() const {
-			return this->foodTexture;
+			return this->getTexture(this->foodTextureHandle);
 		}
 
 		const sf::Texture& StoryLevelAssetBundle::getDangerTexture() const {
-			return this->dangerTexture;
+			return this->getTexture(this->dangerTextureHandle);
 		}
 
+		// Tiles drawn from an atlas page have no texture of their own
 		const sf::Texture& StoryLevelAssetBundle::getFloorTexture(int floorId) const {
-			assert( this->mapAssetBundle.floorTextureRefMap.count(floorId) == 1 );
+			assert( (floorId >= 0) && (floorId < (int)this->mapAssetBundle.floorTextureHandleList.size()) );
 
-			const sf::Texture& result = *this->mapAssetBundle.floorTextureRefMap.at(floorId);
+			const sf::Texture& result = this->getTexture(this->mapAssetBundle.floorTextureHandleList[floorId]);
 			return result;
 		}
 
 		const sf::Texture& StoryLevelAssetBundle::getBarrierTexture(int barrierId) const {
-			assert( this->mapAssetBundle.barrierTextureRefMap.count(barrierId) == 1 );
+			assert( (barrierId >= 0) && (barrierId < (int)this->mapAssetBundle.barrierTextureHandleList.size()) );
 
-			const sf::Texture& result = *this->mapAssetBundle.barrierTextureRefMap.at(barrierId);
+			const sf::Texture& result = this->getTexture(this->mapAssetBundle.barrierTextureHandleList[barrierId]);
 			return result;
 		}
 
-		const StoryMapDefn& StoryLevelAssetBundle::getCutsceneMapDefn(const std::string& mapFilename) const {
-			const StoryMapDefn& result = this->cutsceneMapAssetBundleMap.at(mapFilename).mapDefn;
+		const StoryMapDefn& StoryLevelAssetBundle::getCutsceneMapDefn(int mapHandle) const {
+			assert( (mapHandle >= 0) && (mapHandle < (int)this->cutsceneMapAssetBundleList.size()) );
+
+			const StoryMapDefn& result = this->cutsceneMapAssetBundleList[mapHandle].mapDefn;
 			return result;
 		}
 
-		const sf::Texture& StoryLevelAssetBundle::getCutsceneMapFloorTexture(const std::string& mapFilename, int floorId) const {
-			const sf::Texture& result = *this->cutsceneMapAssetBundleMap.at(mapFilename).floorTextureRefMap.at(floorId);
+		const sf::Texture& StoryLevelAssetBundle::getCutsceneMapFloorTexture(int mapHandle, int floorId) const {
+			assert( (mapHandle >= 0) && (mapHandle < (int)this->cutsceneMapAssetBundleList.size()) );
+			assert( (floorId >= 0) && (floorId < (int)this->cutsceneMapAssetBundleList[mapHandle].floorTextureHandleList.size()) );
+
+			const sf::Texture& result = this->getTexture(this->cutsceneMapAssetBundleList[mapHandle].floorTextureHandleList[floorId]);
 			return result;
 		}
 
-		const sf::Texture& StoryLevelAssetBundle::getCutsceneMapBarrierTexture(const std::string& mapFilename, int barrierId) const {
-			const sf::Texture& result = *this->cutsceneMapAssetBundleMap.at(mapFilename).barrierTextureRefMap.at(barrierId);
+		const sf::Texture& StoryLevelAssetBundle::getCutsceneMapBarrierTexture(int mapHandle, int barrierId) const {
+			assert( (mapHandle >= 0) && (mapHandle < (int)this->cutsceneMapAssetBundleList.size()) );
+			assert( (barrierId >= 0) && (barrierId < (int)this->cutsceneMapAssetBundleList[mapHandle].barrierTextureHandleList.size()) );
+
+			const sf::Texture& result = this->getTexture(this->cutsceneMapAssetBundleList[mapHandle].barrierTextureHandleList[barrierId]);
+			return result;
+		}
+
+		int StoryLevelAssetBundle::getTextureAtlasPageCount() const {
+			return (int)this->textureAtlasPageList.size();
+		}
+
+		const sf::Texture& StoryLevelAssetBundle::getTextureAtlasPage(int pageIndex) const {
+			assert( (pageIndex >= 0) && (pageIndex < (int)this->textureAtlasPageList.size()) );
+			assert( this->textureAtlasPageList[pageIndex] != nullptr );
+
+			return *this->textureAtlasPageList[pageIndex];
+		}
+
+		const StoryTextureAtlasRegion& StoryLevelAssetBundle::getTextureAtlasRegion(int textureHandle) const {
+			assert( (textureHandle >= 0) && (textureHandle < (int)this->textureAtlasRegionList.size()) );
+
+			return this->textureAtlasRegionList[textureHandle];
+		}
+
+		const StoryTextureAtlasRegion& StoryLevelAssetBundle::getFloorAtlasRegion(int floorId) const {
+			assert( (floorId >= 0) && (floorId < (int)this->mapAssetBundle.floorTextureHandleList.size()) );
+
+			const StoryTextureAtlasRegion& result = this->getTextureAtlasRegion(this->mapAssetBundle.floorTextureHandleList[floorId]);
+			return result;
+		}
+
+		const StoryTextureAtlasRegion& StoryLevelAssetBundle::getBarrierAtlasRegion(int barrierId) const {
+			assert( (barrierId >= 0) && (barrierId < (int)this->mapAssetBundle.barrierTextureHandleList.size()) );
+
+			const StoryTextureAtlasRegion& result = this->getTextureAtlasRegion(this->mapAssetBundle.barrierTextureHandleList[barrierId]);
+			return result;
+		}
+
+		const StoryTextureAtlasRegion& StoryLevelAssetBundle::getCutsceneMapFloorAtlasRegion(int mapHandle, int floorId) const {
+			assert( (mapHandle >= 0) && (mapHandle < (int)this->cutsceneMapAssetBundleList.size()) );
+			assert( (floorId >= 0) && (floorId < (int)this->cutsceneMapAssetBundleList[mapHandle].floorTextureHandleList.size()) );
+
+			const StoryTextureAtlasRegion& result = this->getTextureAtlasRegion(this->cutsceneMapAssetBundleList[mapHandle].floorTextureHandleList[floorId]);
+			return result;
+		}
+
+		const StoryTextureAtlasRegion& StoryLevelAssetBundle::getCutsceneMapBarrierAtlasRegion(int mapHandle, int barrierId) const {
+			assert( (mapHandle >= 0) && (mapHandle < (int)this->cutsceneMapAssetBundleList.size()) );
+			assert( (barrierId >= 0) && (barrierId < (int)this->cutsceneMapAssetBundleList[mapHandle].barrierTextureHandleList.size()) );
+
+			const StoryTextureAtlasRegion& result = this->getTextureAtlasRegion(this->cutsceneMapAssetBundleList[mapHandle].barrierTextureHandleList[barrierId]);
 			return result;
 		}
 
@@ -182,23 +358,40 @@ namespace r3 {
 		}
 
 		const sf::SoundBuffer& StoryLevelAssetBundle::getFoodSpawnedSoundBuffer() const {
-			return this->foodSpawnedSoundBuffer;
+			return this->getSoundBuffer(this->foodSpawnedSoundBufferHandle);
 		}
 
 		const sf::SoundBuffer& StoryLevelAssetBundle::getEatFoodSoundBuffer() const {
-			return this->eatFoodSoundBuffer;
+			return this->getSoundBuffer(this->eatFoodSoundBufferHandle);
 		}
 
 		const sf::SoundBuffer& StoryLevelAssetBundle::getHitBarrierSoundBuffer() const {
-			return this->hitBarrierSoundBuffer;
+			return this->getSoundBuffer(this->hitBarrierSoundBufferHandle);
 		}
 
 		const sf::SoundBuffer& StoryLevelAssetBundle::getSnakeHissSoundBuffer() const {
-			return this->snakeHissSoundBuffer;
+			return this->getSoundBuffer(this->snakeHissSoundBufferHandle);
 		}
 
-		const sf::SoundBuffer& StoryLevelAssetBundle::getSoundBuffer(const std::string& filename) const {
-			return this->soundBufferMap.at(filename);
+		const sf::SoundBuffer& StoryLevelAssetBundle::getSoundBuffer(int soundBufferHandle) const {
+			assert( (soundBufferHandle >= 0) && (soundBufferHandle < (int)this->soundBufferList.size()) );
+			assert( this->soundBufferList[soundBufferHandle] != nullptr );
+
+			return *this->soundBufferList[soundBufferHandle];
+		}
+
+		// A level that fails validation leaves the bundle FAILED with nothing loaded
+		void StoryLevelAssetBundle::loadCampaignLevel() {
+			const LoadStoryLevelResult& levelResult = this->campaignIndex->loadLevel(this->campaignLevelIndex);
+			if (!levelResult.validationResult.valid()) {
+				this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::FAILED;
+			}
+			else {
+				this->levelDefn = &this->campaignIndex->getLevelDefn(this->campaignLevelIndex);
+				this->totalAssetCount = StoryLevelAssetBundleUtils::resolveLevelAssetCount(*this->levelDefn);
+
+				this->loadLevel();
+			}
 		}
 
 		void StoryLevelAssetBundle::loadLevel() {
@@ -206,70 +399,100 @@ namespace r3 {
 			this->mapAssetBundle.mapDefn = loadMainMapResult.mapDefn;
 			this->mapAssetBundle.loadMapValidationResult = loadMainMapResult.validationResult;
 
+			// Every filename is resolved to a handle before anything is decoded, so the texture and sound lists
+			// are sized once and the decode workers can each write to their own slot without locking
 			if (this->levelDefn->openingCutsceneDefn.existsFlag) {
 				this->loadCutsceneSoundTrack(this->openingCutsceneMusic, this->levelDefn->openingCutsceneDefn);
-				this->loadCutsceneTextures(this->levelDefn->openingCutsceneDefn);
-				this->loadCutsceneMaps(this->levelDefn->openingCutsceneDefn);
+				this->resolveCutsceneTextureHandles(this->levelDefn->openingCutsceneDefn);
+				this->resolveCutsceneMapHandles(this->levelDefn->openingCutsceneDefn);
 			}
 
 			if (this->levelDefn->winCutsceneDefn.existsFlag) {
 				this->loadCutsceneSoundTrack(this->winCutsceneMusic, this->levelDefn->winCutsceneDefn);
-				this->loadCutsceneTextures(this->levelDefn->winCutsceneDefn);
-				this->loadCutsceneMaps(this->levelDefn->winCutsceneDefn);
+				this->resolveCutsceneTextureHandles(this->levelDefn->winCutsceneDefn);
+				this->resolveCutsceneMapHandles(this->levelDefn->winCutsceneDefn);
 			}
 
 			if (this->levelDefn->lossCutsceneDefn.existsFlag) {
 				this->loadCutsceneSoundTrack(this->lossCutsceneMusic, this->levelDefn->lossCutsceneDefn);
-				this->loadCutsceneTextures(this->levelDefn->lossCutsceneDefn);
-				this->loadCutsceneMaps(this->levelDefn->lossCutsceneDefn);
+				this->resolveCutsceneTextureHandles(this->levelDefn->lossCutsceneDefn);
+				this->resolveCutsceneMapHandles(this->levelDefn->lossCutsceneDefn);
 			}
 
 			if (loadMainMapResult.validationResult.valid()) {
-				this->loadSnakeTexture();
-				this->loadFoodTexture();
-				this->loadDangerTexture();
-				this->loadFloorTextureMap(this->mapAssetBundle);
-				this->loadBarrierTextureMap(this->mapAssetBundle);
+				this->snakeTextureHandle = this->resolveTextureHandle(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_TEXTURE_PATH, StoryLevelAssetBundleConstants::DEFAULT_SNAKE_TEXTURE_PATH, false);
+				this->foodTextureHandle = this->resolveTextureHandle(StoryLevelAssetBundleConstants::DEFAULT_FOOD_TEXTURE_PATH, StoryLevelAssetBundleConstants::DEFAULT_FOOD_TEXTURE_PATH, false);
+				this->dangerTextureHandle = this->resolveTextureHandle(StoryLevelAssetBundleConstants::DEFAULT_DANGER_TEXTURE_PATH, StoryLevelAssetBundleConstants::DEFAULT_DANGER_TEXTURE_PATH, false);
+				this->resolveFloorTextureHandleList(this->mapAssetBundle);
+				this->resolveBarrierTextureHandleList(this->mapAssetBundle);
 
 				this->loadMusic();
-				this->loadFoodSpawnedSoundBuffer();
-				this->loadEatFoodSoundBuffer();
-				this->loadHitBarrierSoundBuffer();
-				this->loadSnakeHissSoundBuffer();
+				this->foodSpawnedSoundBufferHandle = this->resolveSoundBufferHandle(StoryLevelAssetBundleConstants::DEFAULT_FOOD_SPAWNED_SOUND_PATH, StoryLevelAssetBundleConstants::DEFAULT_FOOD_SPAWNED_SOUND_PATH);
+				this->eatFoodSoundBufferHandle = this->resolveSoundBufferHandle(StoryLevelAssetBundleConstants::DEFAULT_EAT_FOOD_SOUND_PATH, StoryLevelAssetBundleConstants::DEFAULT_EAT_FOOD_SOUND_PATH);
+				this->hitBarrierSoundBufferHandle = this->resolveSoundBufferHandle(StoryLevelAssetBundleConstants::DEFAULT_HIT_BARRIER_SOUND_PATH, StoryLevelAssetBundleConstants::DEFAULT_HIT_BARRIER_SOUND_PATH);
+				this->snakeHissSoundBufferHandle = this->resolveSoundBufferHandle(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_HISS_SOUND_PATH, StoryLevelAssetBundleConstants::DEFAULT_SNAKE_HISS_SOUND_PATH);
+			}
+
+			for (auto& currSoundFxDefn : this->levelDefn->soundFxDefnList) {
+				std::string soundFilePath = r3::snake::StoryLoaderUtils::resolveSoundFilePath(this->campaignFolderName, currSoundFxDefn.soundFilename);
+				currSoundFxDefn.soundBufferHandle = this->resolveSoundBufferHandle(currSoundFxDefn.soundFilename, soundFilePath);
 			}
 
-			for (auto const& currSoundFxDefn : this->levelDefn->soundFxDefnList) {
-				this->loadSoundBuffer(currSoundFxDefn.soundFilename);
+			if (this->cancelRequestedFlag) {
+				return;
 			}
 
-			this->indicateLoadingComplete();
+			this->decodeAssets();
+			if (this->cancelRequestedFlag) {
+				return;
+			}
+
+			this->buildTextureAtlas();
+			this->createSoundBufferList();
+
+			// GL textures belong to the thread that owns the window, so the upload is left to uploadDecodedTextures()
+			this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::UPLOADING;
 		}
 
-		void StoryLevelAssetBundle::loadCutsceneTextures(const StoryCutsceneDefn& cutsceneDefn) {
-			for (auto const& currEventDefn : cutsceneDefn.eventDefnList) {
-				if (currEventDefn.eventType == StoryCutsceneEventType::TEXTURE) {
-					this->loadTexture(currEventDefn.textureEvent.textureFilename, false);
-				}
+		void StoryLevelAssetBundle::resolveCutsceneTextureHandles(StoryCutsceneDefn& cutsceneDefn) {
+			for (auto& currTextureEventDefn : cutsceneDefn.textureEventList) {
+				const std::string& textureFilename = cutsceneDefn.filenameList[currTextureEventDefn.filenameIndex];
+				std::string textureFilePath = r3::snake::StoryLoaderUtils::resolveImageFilePath(this->campaignFolderName, textureFilename);
+				currTextureEventDefn.textureHandle = this->resolveTextureHandle(textureFilename, textureFilePath, false);
 			}
 		}
 
-		void StoryLevelAssetBundle::loadCutsceneMaps(const StoryCutsceneDefn& cutsceneDefn) {
-			for (auto const& currEventDefn : cutsceneDefn.eventDefnList) {
-				if (currEventDefn.eventType == StoryCutsceneEventType::SHOW_MAP) {
-					if (this->cutsceneMapAssetBundleMap.count(currEventDefn.mapEvent.mapFilename) == 0) {
-						LoadStoryMapResult currLoadStoryMapResult = this->loadMap(currEventDefn.mapEvent.mapFilename);
+		void StoryLevelAssetBundle::resolveCutsceneMapHandles(StoryCutsceneDefn& cutsceneDefn) {
+			for (auto& currMapEventDefn : cutsceneDefn.mapEventList) {
+				currMapEventDefn.mapHandle = this->resolveCutsceneMapHandle(cutsceneDefn.filenameList[currMapEventDefn.filenameIndex]);
+			}
+		}
 
-						this->cutsceneMapAssetBundleMap[currEventDefn.mapEvent.mapFilename] = StoryMapAssetBundle();
-						this->cutsceneMapAssetBundleMap[currEventDefn.mapEvent.mapFilename].mapDefn = currLoadStoryMapResult.mapDefn;
-						this->cutsceneMapAssetBundleMap[currEventDefn.mapEvent.mapFilename].loadMapValidationResult = currLoadStoryMapResult.validationResult;
+		int StoryLevelAssetBundle::resolveCutsceneMapHandle(const std::string& filename) {
+			int result = -1;
 
-						if (currLoadStoryMapResult.validationResult.valid()) {
-							this->loadFloorTextureMap(this->cutsceneMapAssetBundleMap[currEventDefn.mapEvent.mapFilename]);
-							this->loadBarrierTextureMap(this->cutsceneMapAssetBundleMap[currEventDefn.mapEvent.mapFilename]);
-						}
-					}
+			auto mapHandleItr = this->cutsceneMapHandleMap.find(filename);
+			if (mapHandleItr == this->cutsceneMapHandleMap.end()) {
+				LoadStoryMapResult loadStoryMapResult = this->loadMap(filename);
+
+				result = (int)this->cutsceneMapAssetBundleList.size();
+				this->cutsceneMapHandleMap[filename] = result;
+				this->cutsceneMapAssetBundleList.push_back(StoryMapAssetBundle());
+
+				StoryMapAssetBundle& cutsceneMapAssetBundle = this->cutsceneMapAssetBundleList.back();
+				cutsceneMapAssetBundle.mapDefn = loadStoryMapResult.mapDefn;
+				cutsceneMapAssetBundle.loadMapValidationResult = loadStoryMapResult.validationResult;
+
+				if (loadStoryMapResult.validationResult.valid()) {
+					this->resolveFloorTextureHandleList(cutsceneMapAssetBundle);
+					this->resolveBarrierTextureHandleList(cutsceneMapAssetBundle);
 				}
 			}
+			else {
+				result = mapHandleItr->second;
+			}
+
+			return result;
 		}
 
 		LoadStoryMapResult StoryLevelAssetBundle::loadMap(const std::string& filename) {
@@ -287,153 +510,328 @@ namespace r3 {
 			return result;
 		}
 
-		void StoryLevelAssetBundle::loadSnakeTexture() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_TEXTURE_PATH);
-
-			if (this->snakeTexture.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_TEXTURE_PATH)) {
-				this->incrementLoadedAssetCount();
+		void StoryLevelAssetBundle::resolveFloorTextureHandleList(StoryMapAssetBundle& mapAssetBundle) {
+			for (auto const& currFloorDefnPair : mapAssetBundle.mapDefn.floorDefnMap) {
+				if (currFloorDefnPair.first >= (int)mapAssetBundle.floorTextureHandleList.size()) {
+					mapAssetBundle.floorTextureHandleList.resize(currFloorDefnPair.first + 1, -1);
+				}
+				std::string textureFilePath = r3::snake::StoryLoaderUtils::resolveImageFilePath(this->campaignFolderName, currFloorDefnPair.second.filename);
+				mapAssetBundle.floorTextureHandleList[currFloorDefnPair.first] = this->resolveTextureHandle(currFloorDefnPair.second.filename, textureFilePath, true);
 			}
-			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_TEXTURE_PATH);
+		}
+
+		void StoryLevelAssetBundle::resolveBarrierTextureHandleList(StoryMapAssetBundle& mapAssetBundle) {
+			for (auto const& currBarrierDefnPair : mapAssetBundle.mapDefn.barrierDefnMap) {
+				if (currBarrierDefnPair.first >= (int)mapAssetBundle.barrierTextureHandleList.size()) {
+					mapAssetBundle.barrierTextureHandleList.resize(currBarrierDefnPair.first + 1, -1);
+				}
+				std::string textureFilePath = r3::snake::StoryLoaderUtils::resolveImageFilePath(this->campaignFolderName, currBarrierDefnPair.second.filename);
+				mapAssetBundle.barrierTextureHandleList[currBarrierDefnPair.first] = this->resolveTextureHandle(currBarrierDefnPair.second.filename, textureFilePath, true);
 			}
 		}
 
-		void StoryLevelAssetBundle::loadFoodTexture() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_FOOD_TEXTURE_PATH);
+		int StoryLevelAssetBundle::resolveTextureHandle(const std::string& filename, const std::string& filePath, bool repeatFlag) {
+			int result = -1;
 
-			if (this->foodTexture.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_FOOD_TEXTURE_PATH)) {
-				this->incrementLoadedAssetCount();
+			auto textureHandleItr = this->textureHandleMap.find(filename);
+			if (textureHandleItr == this->textureHandleMap.end()) {
+				result = (int)this->textureFilenameList.size();
+				this->textureHandleMap[filename] = result;
+				this->textureFilenameList.push_back(filename);
+				this->textureFilePathList.push_back(filePath);
+				this->textureRepeatFlagList.push_back(repeatFlag);
 			}
 			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_FOOD_TEXTURE_PATH);
+				result = textureHandleItr->second;
+				this->incrementLoadedAssetCount();
 			}
-		}
 
-		void StoryLevelAssetBundle::loadDangerTexture() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_DANGER_TEXTURE_PATH);
+			return result;
+		}
 
-			if (this->dangerTexture.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_DANGER_TEXTURE_PATH)) {
+		void StoryLevelAssetBundle::loadMusic() {
+			if (StoryArchiveUtils::openMusic(this->music, r3::snake::StoryLoaderUtils::resolveMusicFilePath(this->campaignFolderName, this->levelDefn->musicFilename))) {
 				this->incrementLoadedAssetCount();
 			}
 			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_DANGER_TEXTURE_PATH);
+				this->failedFilenameList.push_back(this->levelDefn->musicFilename);
 			}
 		}
 
-		void StoryLevelAssetBundle::loadFloorTextureMap(StoryMapAssetBundle& mapAssetBundle) {
-			for (auto const& currFloorDefnPair : mapAssetBundle.mapDefn.floorDefnMap) {
-				this->loadTexture(currFloorDefnPair.second.filename, true);
-				mapAssetBundle.floorTextureRefMap[currFloorDefnPair.first] = &this->textureMap[currFloorDefnPair.second.filename];
+		void StoryLevelAssetBundle::loadCutsceneSoundTrack(sf::Music& targetMusic, const StoryCutsceneDefn& cutsceneDefn) {
+			if (!cutsceneDefn.soundTrackFilename.empty()) {
+				if (StoryArchiveUtils::openMusic(targetMusic, r3::snake::StoryLoaderUtils::resolveSoundFilePath(this->campaignFolderName, cutsceneDefn.soundTrackFilename))) {
+					this->incrementLoadedAssetCount();
+				}
+				else {
+					this->failedFilenameList.push_back(cutsceneDefn.soundTrackFilename);
+				}
 			}
 		}
 
-		void StoryLevelAssetBundle::loadBarrierTextureMap(StoryMapAssetBundle& mapAssetBundle) {
-			for (auto const& currBarrierDefnPair : mapAssetBundle.mapDefn.barrierDefnMap) {
-				this->loadTexture(currBarrierDefnPair.second.filename, true);
-				mapAssetBundle.barrierTextureRefMap[currBarrierDefnPair.first] = &this->textureMap[currBarrierDefnPair.second.filename];
+		int StoryLevelAssetBundle::resolveSoundBufferHandle(const std::string& filename, const std::string& filePath) {
+			int result = -1;
+
+			auto soundBufferHandleItr = this->soundBufferHandleMap.find(filename);
+			if (soundBufferHandleItr == this->soundBufferHandleMap.end()) {
+				result = (int)this->soundBufferFilenameList.size();
+				this->soundBufferHandleMap[filename] = result;
+				this->soundBufferFilenameList.push_back(filename);
+				this->soundBufferFilePathList.push_back(filePath);
 			}
+			else {
+				result = soundBufferHandleItr->second;
+				this->incrementLoadedAssetCount();
+			}
+
+			return result;
 		}
 
-		void StoryLevelAssetBundle::loadTexture(const std::string& filename, bool repeatFlag) {
-			this->indicateLoadingFilename(filename);
+		void StoryLevelAssetBundle::decodeAssets() {
+			this->textureImageList.resize(this->textureFilePathList.size());
+			this->textureDecodeStatusList.assign(this->textureFilePathList.size(), StoryAssetDecodeStatus::FAILED);
+			this->textureKeyList.assign(this->textureFilePathList.size(), 0);
+			this->textureList.assign(this->textureFilePathList.size(), nullptr);
+			this->tileImageKeyList.assign(this->textureFilePathList.size(), 0);
+			this->tileImageList.assign(this->textureFilePathList.size(), nullptr);
+			this->soundSamplesList.resize(this->soundBufferFilePathList.size());
+			this->soundBufferKeyList.assign(this->soundBufferFilePathList.size(), 0);
+			this->soundBufferList.assign(this->soundBufferFilePathList.size(), nullptr);
+
+			this->decodeJobList.clear();
+			for (size_t textureHandle = 0; textureHandle < this->textureFilePathList.size(); textureHandle++) {
+				StoryAssetDecodeJob decodeJob;
+				decodeJob.jobType = StoryAssetDecodeJobType::TEXTURE;
+				decodeJob.assetHandle = (int)textureHandle;
+				this->decodeJobList.push_back(decodeJob);
+			}
+			for (size_t soundBufferHandle = 0; soundBufferHandle < this->soundBufferFilePathList.size(); soundBufferHandle++) {
+				StoryAssetDecodeJob decodeJob;
+				decodeJob.jobType = StoryAssetDecodeJobType::SOUND_BUFFER;
+				decodeJob.assetHandle = (int)soundBufferHandle;
+				this->decodeJobList.push_back(decodeJob);
+			}
+
+			this->nextDecodeJobIndex = 0;
+
+			std::vector<sf::Thread*> workerThreadList;
+			{
+				std::unique_lock<std::mutex> decodeWorkerLock(this->decodeWorkerMutex);
+				this->runningDecodeWorkerCount = 0;
+				this->launchDecodeWorkers(workerThreadList);
+
+				// Woken each time a worker runs out of jobs, and when the bundle is promoted to the foreground part way
+				// through, so that it gets the extra workers it would have started with
+				while (this->runningDecodeWorkerCount > 0) {
+					this->decodeWorkerCondition.wait(decodeWorkerLock);
+					if ((this->nextDecodeJobIndex < (int)this->decodeJobList.size()) && !this->cancelRequestedFlag) {
+						this->launchDecodeWorkers(workerThreadList);
+					}
+				}
+			}
 
-			if (this->textureMap.count(filename) == 0) {
-				std::string fullFilePath = r3::snake::StoryLoaderUtils::resolveImageFilePath(this->campaignFolderName, filename);
+			for (auto currWorkerThread : workerThreadList) {
+				currWorkerThread->wait();
+				delete currWorkerThread;
+			}
 
-				this->textureMap[filename] = sf::Texture();
-				if (this->textureMap[filename].loadFromFile(fullFilePath)) {
-					this->textureMap[filename].setRepeated(repeatFlag);
-					this->incrementLoadedAssetCount();
-				}
-				else {
-					this->failedFilenameList.push_back(filename);
+			for (size_t textureHandle = 0; textureHandle < this->textureFilePathList.size(); textureHandle++) {
+				if (this->textureDecodeStatusList[textureHandle] == StoryAssetDecodeStatus::FAILED) {
+					this->failedFilenameList.push_back(this->textureFilenameList[textureHandle]);
 				}
 			}
-			else {
-				this->incrementLoadedAssetCount();
+		}
+
+		// Called with decodeWorkerMutex held
+		void StoryLevelAssetBundle::launchDecodeWorkers(std::vector<sf::Thread*>& workerThreadList) {
+			int workerCount = StoryLevelAssetBundleUtils::resolveDecodeWorkerCount(this->decodeJobList.size(), this->loadPriority);
+			while ((int)workerThreadList.size() < workerCount) {
+				sf::Thread* workerThread = new sf::Thread(&StoryLevelAssetBundle::runDecodeWorker, this);
+				this->runningDecodeWorkerCount++;
+				workerThread->launch();
+				workerThreadList.push_back(workerThread);
 			}
 		}
 
-		void StoryLevelAssetBundle::loadMusic() {
-			if (this->music.openFromFile(r3::snake::StoryLoaderUtils::resolveMusicFilePath(this->campaignFolderName, this->levelDefn->musicFilename))) {
-				this->incrementLoadedAssetCount();
+		void StoryLevelAssetBundle::runDecodeWorker() {
+			int jobIndex = this->nextDecodeJobIndex++;
+			while ((jobIndex < (int)this->decodeJobList.size()) && !this->cancelRequestedFlag) {
+				const StoryAssetDecodeJob& decodeJob = this->decodeJobList[jobIndex];
+				switch (decodeJob.jobType) {
+				case StoryAssetDecodeJobType::TEXTURE:
+					this->decodeTexture(decodeJob.assetHandle);
+					break;
+				case StoryAssetDecodeJobType::SOUND_BUFFER:
+					this->decodeSoundSamples(decodeJob.assetHandle);
+					break;
+				}
+
+				jobIndex = this->nextDecodeJobIndex++;
 			}
-			else {
-				this->failedFilenameList.push_back(this->levelDefn->musicFilename);
+
+			{
+				std::lock_guard<std::mutex> decodeWorkerLock(this->decodeWorkerMutex);
+				this->runningDecodeWorkerCount--;
 			}
+			this->decodeWorkerCondition.notify_one();
 		}
 
-		void StoryLevelAssetBundle::loadCutsceneSoundTrack(sf::Music& targetMusic, const StoryCutsceneDefn& cutsceneDefn) {
-			if (!cutsceneDefn.soundTrackFilename.empty()) {
-				if (targetMusic.openFromFile(r3::snake::StoryLoaderUtils::resolveSoundFilePath(this->campaignFolderName, cutsceneDefn.soundTrackFilename))) {
-					this->incrementLoadedAssetCount();
+		void StoryLevelAssetBundle::decodeTexture(int textureHandle) {
+			this->indicateLoadingFilename(this->textureFilenameList[textureHandle]);
+
+			StoryFileContents fileContents;
+			if (StoryArchiveUtils::readFile(this->textureFilePathList[textureHandle], fileContents)) {
+				this->textureKeyList[textureHandle] = StoryAssetCacheUtils::buildTextureKey(fileContents.getData(), fileContents.getSize(), this->textureRepeatFlagList[textureHandle]);
+
+				// Map tiles go into this level's atlas, so what the cache keeps for them is their pixels rather than a
+				// texture.  A tile another level already decoded is packed straight from the cached image.
+				if (this->textureRepeatFlagList[textureHandle]) {
+					this->tileImageKeyList[textureHandle] = StoryAssetCacheUtils::buildImageKey(this->textureKeyList[textureHandle]);
+					this->tileImageList[textureHandle] = this->assetCache->acquireImage(this->tileImageKeyList[textureHandle]);
+					if (this->tileImageList[textureHandle] == nullptr) {
+						sf::Image tileImage;
+						if (tileImage.loadFromMemory(fileContents.getData(), fileContents.getSize())) {
+							this->tileImageList[textureHandle] = this->assetCache->insertImage(this->tileImageKeyList[textureHandle], tileImage);
+						}
+					}
+
+					if (this->tileImageList[textureHandle] != nullptr) {
+						this->textureDecodeStatusList[textureHandle] = StoryAssetDecodeStatus::DECODED;
+					}
 				}
 				else {
-					this->failedFilenameList.push_back(cutsceneDefn.soundTrackFilename);
+					this->textureList[textureHandle] = this->assetCache->acquireTexture(this->textureKeyList[textureHandle]);
+					if (this->textureList[textureHandle] != nullptr) {
+						this->textureDecodeStatusList[textureHandle] = StoryAssetDecodeStatus::CACHED;
+					}
+					else if (this->textureImageList[textureHandle].loadFromMemory(fileContents.getData(), fileContents.getSize())) {
+						this->textureDecodeStatusList[textureHandle] = StoryAssetDecodeStatus::DECODED;
+					}
 				}
 			}
 		}
 
-		void StoryLevelAssetBundle::loadFoodSpawnedSoundBuffer() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_FOOD_SPAWNED_SOUND_PATH);
+		// Floor and barrier tiles are the only textures loaded with the repeat flag, so those are the ones packed.
+		// Each map's tiles are drawn from the atlas, apart from any that did not fit, which keep their own texture.
+		void StoryLevelAssetBundle::buildTextureAtlas() {
+			std::vector<sf::Vector2u> imageSizeList(this->textureImageList.size(), sf::Vector2u(0, 0));
+			std::vector<const sf::Image*> imageList(this->textureImageList.size(), nullptr);
 
-			if (this->foodSpawnedSoundBuffer.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_FOOD_SPAWNED_SOUND_PATH)) {
-				this->incrementLoadedAssetCount();
-			}
-			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_FOOD_SPAWNED_SOUND_PATH);
+			for (size_t textureHandle = 0; textureHandle < this->textureImageList.size(); textureHandle++) {
+				if (this->textureRepeatFlagList[textureHandle] && (this->textureDecodeStatusList[textureHandle] != StoryAssetDecodeStatus::FAILED)) {
+					imageSizeList[textureHandle] = this->resolveDecodedImage(textureHandle).getSize();
+					imageList[textureHandle] = &this->resolveDecodedImage(textureHandle);
+				}
 			}
+
+			StoryTextureAtlasLayout atlasLayout = StoryTextureAtlasUtils::packShelves(imageSizeList, StoryTextureAtlasConstants::PAGE_SIZE, StoryTextureAtlasConstants::PADDING);
+
+			this->textureAtlasRegionList = atlasLayout.regionList;
+			this->textureAtlasPageImageList = StoryTextureAtlasUtils::buildPageImageList(atlasLayout, imageList, StoryTextureAtlasConstants::PADDING);
+		}
+
+		const sf::Image& StoryLevelAssetBundle::resolveDecodedImage(size_t textureHandle) const {
+			const sf::Image& result = (this->tileImageList[textureHandle] != nullptr) ? *this->tileImageList[textureHandle] : this->textureImageList[textureHandle];
+			return result;
 		}
 
-		void StoryLevelAssetBundle::loadEatFoodSoundBuffer() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_EAT_FOOD_SOUND_PATH);
+		void StoryLevelAssetBundle::uploadDecodedTexture(size_t textureHandle) {
+			this->indicateLoadingFilename(this->textureFilenameList[textureHandle]);
 
-			if (this->eatFoodSoundBuffer.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_EAT_FOOD_SOUND_PATH)) {
+			this->textureList[textureHandle] = this->assetCache->insertTexture(this->textureKeyList[textureHandle], this->resolveDecodedImage(textureHandle), this->textureRepeatFlagList[textureHandle]);
+			if (this->textureList[textureHandle] != nullptr) {
 				this->incrementLoadedAssetCount();
 			}
 			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_EAT_FOOD_SOUND_PATH);
+				this->failedFilenameList.push_back(this->textureFilenameList[textureHandle]);
 			}
+
+			this->textureImageList[textureHandle] = sf::Image();
+			this->releaseTileImage(textureHandle);
 		}
 
-		void StoryLevelAssetBundle::loadHitBarrierSoundBuffer() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_HIT_BARRIER_SOUND_PATH);
+		// The cached image stays resident after it is released, so the next level can pack it without decoding it
+		void StoryLevelAssetBundle::releaseTileImage(size_t textureHandle) {
+			if (this->tileImageList[textureHandle] != nullptr) {
+				this->assetCache->release(this->tileImageKeyList[textureHandle]);
+				this->tileImageList[textureHandle] = nullptr;
+			}
+		}
 
-			if (this->hitBarrierSoundBuffer.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_HIT_BARRIER_SOUND_PATH)) {
-				this->incrementLoadedAssetCount();
+		// A page that fails to upload is not treated as a load failure.  Its tiles fall back to textures of their own,
+		// uploaded here from the images they kept.
+		void StoryLevelAssetBundle::uploadNextTextureAtlasPage() {
+			size_t pageIndex = this->nextTextureAtlasPageUploadIndex;
+
+			sf::Texture* texture = new sf::Texture();
+			bool pageUploadedFlag = texture->loadFromImage(this->textureAtlasPageImageList[pageIndex]);
+			if (!pageUploadedFlag) {
+				delete texture;
+				texture = nullptr;
 			}
-			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_HIT_BARRIER_SOUND_PATH);
+
+			for (size_t textureHandle = 0; textureHandle < this->textureAtlasRegionList.size(); textureHandle++) {
+				if (this->textureAtlasRegionList[textureHandle].pageIndex == (int)pageIndex) {
+					if (!pageUploadedFlag) {
+						this->textureAtlasRegionList[textureHandle].pageIndex = -1;
+						this->uploadDecodedTexture(textureHandle);
+					}
+					else {
+						this->incrementLoadedAssetCount();
+						this->releaseTileImage(textureHandle);
+					}
+				}
 			}
+			this->textureAtlasPageList.push_back(texture);
+			this->textureAtlasPageImageList[pageIndex] = sf::Image();
+
+			this->nextTextureAtlasPageUploadIndex++;
 		}
 
-		void StoryLevelAssetBundle::loadSnakeHissSoundBuffer() {
-			this->indicateLoadingFilename(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_HISS_SOUND_PATH);
+		void StoryLevelAssetBundle::decodeSoundSamples(int soundBufferHandle) {
+			this->indicateLoadingFilename(this->soundBufferFilenameList[soundBufferHandle]);
 
-			if (this->snakeHissSoundBuffer.loadFromFile(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_HISS_SOUND_PATH)) {
-				this->incrementLoadedAssetCount();
-			}
-			else {
-				this->failedFilenameList.push_back(StoryLevelAssetBundleConstants::DEFAULT_SNAKE_HISS_SOUND_PATH);
+			StoryDecodedSoundSamples& soundSamples = this->soundSamplesList[soundBufferHandle];
+			soundSamples.decodeStatus = StoryAssetDecodeStatus::FAILED;
+
+			StoryFileContents fileContents;
+			if (StoryArchiveUtils::readFile(this->soundBufferFilePathList[soundBufferHandle], fileContents)) {
+				this->soundBufferKeyList[soundBufferHandle] = StoryAssetCacheUtils::buildSoundBufferKey(fileContents.getData(), fileContents.getSize());
+
+				this->soundBufferList[soundBufferHandle] = this->assetCache->acquireSoundBuffer(this->soundBufferKeyList[soundBufferHandle]);
+				if (this->soundBufferList[soundBufferHandle] != nullptr) {
+					soundSamples.decodeStatus = StoryAssetDecodeStatus::CACHED;
+				}
+				else {
+					sf::InputSoundFile soundFile;
+					if (soundFile.openFromMemory(fileContents.getData(), fileContents.getSize())) {
+						soundSamples.sampleList.resize((size_t)soundFile.getSampleCount());
+						sf::Uint64 readSampleCount = soundFile.read(soundSamples.sampleList.data(), soundSamples.sampleList.size());
+						soundSamples.sampleList.resize((size_t)readSampleCount);
+						soundSamples.channelCount = soundFile.getChannelCount();
+						soundSamples.sampleRate = soundFile.getSampleRate();
+						soundSamples.decodeStatus = StoryAssetDecodeStatus::DECODED;
+					}
+				}
 			}
 		}
 
-		void StoryLevelAssetBundle::loadSoundBuffer(const std::string& filename) {
-			this->indicateLoadingFilename(filename);
+		void StoryLevelAssetBundle::createSoundBufferList() {
+			for (size_t soundBufferHandle = 0; soundBufferHandle < this->soundSamplesList.size(); soundBufferHandle++) {
+				StoryDecodedSoundSamples& soundSamples = this->soundSamplesList[soundBufferHandle];
 
-			if (this->soundBufferMap.count(filename) == 0) {
-				std::string fullFilePath = r3::snake::StoryLoaderUtils::resolveSoundFilePath(this->campaignFolderName, filename);
+				if (soundSamples.decodeStatus == StoryAssetDecodeStatus::DECODED) {
+					this->soundBufferList[soundBufferHandle] = this->assetCache->insertSoundBuffer(this->soundBufferKeyList[soundBufferHandle], soundSamples.sampleList, soundSamples.channelCount, soundSamples.sampleRate);
+				}
 
-				this->soundBufferMap[filename] = sf::SoundBuffer();
-				if (this->soundBufferMap[filename].loadFromFile(fullFilePath)) {
+				if (this->soundBufferList[soundBufferHandle] != nullptr) {
 					this->incrementLoadedAssetCount();
 				}
 				else {
-					this->failedFilenameList.push_back(filename);
+					this->failedFilenameList.push_back(this->soundBufferFilenameList[soundBufferHandle]);
 				}
-			}
-			else {
-				this->incrementLoadedAssetCount();
+
+				soundSamples.sampleList = std::vector<sf::Int16>();
 			}
 		}
 
@@ -446,31 +844,19 @@ namespace r3 {
 		}
 
 		void StoryLevelAssetBundle::incrementLoadedAssetCount() {
-			this->loadingStatusMutex.lock();
-
 			this->loadedAssetCount++;
-
-			this->loadingStatusMutex.unlock();
 		}
 
 		void StoryLevelAssetBundle::updateTotalAssetCount(const StoryMapDefn& mapDefn) {
-			this->loadingStatusMutex.lock();
-
-			this->totalAssetCount += ( mapDefn.floorDefnMap.size() + mapDefn.barrierDefnMap.size() );
-
-			this->loadingStatusMutex.unlock();
+			this->totalAssetCount += (int)( mapDefn.floorDefnMap.size() + mapDefn.barrierDefnMap.size() );
 		}
 
 		void StoryLevelAssetBundle::indicateLoadingComplete() {
-			this->loadingStatusMutex.lock();
-
 			if (this->failedFilenameList.size() == 0) {
 				this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::COMPLETE;
 			} else {
 				this->loadingCompletionStatus = StoryLevelAssetLoadingCompletionStatus::FAILED;
 			}
-
-			this->loadingStatusMutex.unlock();
 		}
 
 	}
@@ -0,0 +1,396 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include <stdio.h>
+#include <set>
+#include <algorithm>
+#include <thread>
+#include <SFML/System.hpp>
+#include "../jsoncpp/json/json.h"
+#include "../includes/r3-snake-storybenchmark.hpp"
+#include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storyarchive.hpp"
+#include "../includes/r3-snake-storydefncache.hpp"
+#include "../includes/r3-snake-storyassets.hpp"
+#include "../includes/r3-snake-snakebot.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryLoaderBenchmarkConstants {
+
+			const sf::Time FRAME_DURATION = sf::microseconds(1000000 / 60);
+
+		}
+
+		namespace StoryLoaderBenchmarkUtils {
+
+			float resolveRate(float amount, float seconds) {
+				float result = (seconds > 0.0f) ? (amount / seconds) : 0.0f;
+				return result;
+			}
+
+			float toMegabytes(size_t byteCount) {
+				float result = (float)byteCount / (1024.0f * 1024.0f);
+				return result;
+			}
+
+			int countCutsceneEvents(const StoryLevelDefn& levelDefn) {
+				int result =
+					(int)levelDefn.openingCutsceneDefn.eventDefnList.size() +
+					(int)levelDefn.winCutsceneDefn.eventDefnList.size() +
+					(int)levelDefn.lossCutsceneDefn.eventDefnList.size();
+				return result;
+			}
+
+			void addCutsceneMapFilenames(const StoryCutsceneDefn& cutsceneDefn, std::set<std::string>& mapFilenameSet) {
+				for (auto const& currMapEventDefn : cutsceneDefn.mapEventList) {
+					mapFilenameSet.insert(cutsceneDefn.filenameList[currMapEventDefn.filenameIndex]);
+				}
+			}
+
+			// The campaign is parsed and validated as two separate steps here, on one thread, so that each can be
+			// timed on its own; loadStoryCampaign is timed as a whole afterwards
+			std::vector<LoadStoryLevelResult> parseAndValidateLevels(const std::string& campaignFolderName, StoryLoaderBenchmarkResult& benchmarkResult) {
+				std::vector<LoadStoryLevelResult> result;
+
+				sf::Clock stageClock;
+
+				StoryFileContents campaignContents;
+				StoryArchiveUtils::readFile(StoryLoaderUtils::resolveCampaignFilePath(campaignFolderName), campaignContents);
+
+				Json::Value campaignValue;
+				Json::Reader jsonReader(Json::Features::strictMode());
+				bool parsedFlag = jsonReader.parse(campaignContents.getData(), campaignContents.getData() + campaignContents.getSize(), campaignValue);
+
+				benchmarkResult.parseSeconds = stageClock.getElapsedTime().asSeconds();
+				benchmarkResult.campaignFileBytes = campaignContents.getSize();
+
+				if (parsedFlag && campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST].isArray()) {
+					StoryLoaderUtils::LoadAssetValidation::clearProbeCache();
+					stageClock.restart();
+
+					const Json::Value& levelListValue = campaignValue[StoryLoaderUtils::CampaignListProperties::LEVEL_LIST];
+					for (Json::ArrayIndex index = 0; index < levelListValue.size(); index++) {
+						result.push_back(StoryLoaderUtils::loadStoryLevel(campaignFolderName, levelListValue[index]));
+					}
+
+					benchmarkResult.validationSeconds = stageClock.getElapsedTime().asSeconds();
+				}
+
+				for (auto const& currLevelResult : result) {
+					benchmarkResult.cutsceneEventCount += countCutsceneEvents(currLevelResult.levelDefn);
+				}
+
+				return result;
+			}
+
+			void loadMaps(const std::string& campaignFolderName, const std::vector<LoadStoryLevelResult>& levelResultList, StoryLoaderBenchmarkResult& benchmarkResult) {
+				std::set<std::string> mapFilenameSet;
+				for (auto const& currLevelResult : levelResultList) {
+					if (currLevelResult.validationResult.valid()) {
+						mapFilenameSet.insert(currLevelResult.levelDefn.mapFilename);
+						addCutsceneMapFilenames(currLevelResult.levelDefn.openingCutsceneDefn, mapFilenameSet);
+						addCutsceneMapFilenames(currLevelResult.levelDefn.winCutsceneDefn, mapFilenameSet);
+						addCutsceneMapFilenames(currLevelResult.levelDefn.lossCutsceneDefn, mapFilenameSet);
+					}
+				}
+
+				for (auto const& currMapFilename : mapFilenameSet) {
+					size_t mapFileSize = 0;
+					if (StoryArchiveUtils::probeFileSize(StoryLoaderUtils::resolveMapFilePath(campaignFolderName, currMapFilename), mapFileSize)) {
+						benchmarkResult.mapFileBytes += mapFileSize;
+					}
+				}
+
+				sf::Clock stageClock;
+
+				for (auto const& currMapFilename : mapFilenameSet) {
+					LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(campaignFolderName, currMapFilename);
+					if (loadMapResult.validationResult.valid()) {
+						benchmarkResult.mapCount++;
+					}
+				}
+
+				benchmarkResult.mapLoadSeconds = stageClock.getElapsedTime().asSeconds();
+			}
+
+			// Each level's bundle is decoded in turn, sharing one asset cache as the game does.  The bundle is
+			// dropped once it reaches the upload stage.
+			void loadAssetBundles(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadCampaignResult, StoryLoaderBenchmarkResult& benchmarkResult) {
+				StoryAssetCache assetCache(StoryAssetCacheConstants::DEFAULT_MEMORY_BUDGET_BYTES);
+
+				sf::Clock stageClock;
+
+				for (auto const& currLevelResult : loadCampaignResult.levelResultList) {
+					StoryLevelDefn levelDefn = currLevelResult.levelDefn;
+
+					StoryLevelAssetBundle assetBundle(assetCache);
+					assetBundle.loadLevelAsync(campaignFolderName, levelDefn, StoryLevelAssetLoadPriority::FOREGROUND);
+					while (assetBundle.getLoadingStatus().completionStatus == StoryLevelAssetLoadingCompletionStatus::LOADING) {
+						sf::sleep(sf::milliseconds(1));
+					}
+
+					benchmarkResult.assetBundleCount++;
+					if (!assetBundle.getFailedFilenameList().empty()) {
+						benchmarkResult.assetBundleFailedCount++;
+					}
+
+					if (benchmarkResult.assetBundleCount == 1) {
+						benchmarkResult.firstLevelAssetCacheStats = assetCache.getStats();
+					}
+				}
+
+				benchmarkResult.assetBundleSeconds = stageClock.getElapsedTime().asSeconds();
+				benchmarkResult.assetCacheStats = assetCache.getStats();
+			}
+
+			size_t resolvePeakResidentBytes() {
+				size_t result = 0;
+
+#ifdef _WIN32
+				PROCESS_MEMORY_COUNTERS memoryCounters;
+				if (GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) {
+					result = memoryCounters.PeakWorkingSetSize;
+				}
+#else
+				// Linux reports the high-water mark in kilobytes
+				struct rusage resourceUsage;
+				if (getrusage(RUSAGE_SELF, &resourceUsage) == 0) {
+					result = (size_t)resourceUsage.ru_maxrss * 1024;
+				}
+#endif
+
+				return result;
+			}
+
+			StoryLoaderBenchmarkResult runBenchmark(const std::string& campaignFolderName) {
+				StoryLoaderBenchmarkResult result;
+
+				std::string cacheFilePath = StoryDefnCacheUtils::resolveCacheFilePath(campaignFolderName);
+				remove(cacheFilePath.c_str());
+				StoryDefnCacheUtils::forgetCachedCampaign(campaignFolderName);
+
+				std::vector<LoadStoryLevelResult> levelResultList = parseAndValidateLevels(campaignFolderName, result);
+				loadMaps(campaignFolderName, levelResultList, result);
+				levelResultList.clear();
+
+				sf::Clock stageClock;
+				LoadStoryCampaignResult coldLoadResult = StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				result.coldLoadSeconds = stageClock.getElapsedTime().asSeconds();
+
+				result.campaignValid = coldLoadResult.valid();
+				result.levelCount = (int)coldLoadResult.levelResultList.size();
+				if (!result.campaignValid) {
+					StoryLoaderUtils::appendToErrorLog(StoryLoaderUtils::LoadStoryCampaignValidation::buildErrorMessages(coldLoadResult));
+				}
+
+				StoryDefnCacheUtils::forgetCachedCampaign(campaignFolderName);
+				stageClock.restart();
+				StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				result.warmLoadSeconds = stageClock.getElapsedTime().asSeconds();
+				result.warmCacheHit = StoryDefnCacheUtils::wasLoadedFromCache(campaignFolderName);
+
+				if (result.campaignValid) {
+					loadAssetBundles(campaignFolderName, coldLoadResult, result);
+				}
+
+				result.peakResidentBytes = resolvePeakResidentBytes();
+
+				return result;
+			}
+
+			StoryFrameTimeStats buildFrameTimeStats(std::vector<sf::Int64>& frameMicrosecondsList) {
+				StoryFrameTimeStats result;
+
+				result.frameCount = (int)frameMicrosecondsList.size();
+				if (result.frameCount > 0) {
+					sf::Int64 totalMicroseconds = 0;
+					for (sf::Int64 currFrameMicroseconds : frameMicrosecondsList) {
+						totalMicroseconds += currFrameMicroseconds;
+					}
+					result.avgFrameMicroseconds = (float)totalMicroseconds / (float)result.frameCount;
+
+					std::sort(frameMicrosecondsList.begin(), frameMicrosecondsList.end());
+					result.p99FrameMicroseconds = frameMicrosecondsList[(frameMicrosecondsList.size() * 99) / 100];
+					result.maxFrameMicroseconds = frameMicrosecondsList.back();
+				}
+
+				return result;
+			}
+
+			// Plays the first level with the bot at 60 frames a second, timing the game update on the main thread.
+			// With prefetching on, a background bundle decodes the other levels in turn for the whole run, each into
+			// a cache of its own so that every file is decoded rather than found.  Starting and dropping a bundle
+			// happens once per level in the game, so it is left out of the timed part of the frame.  Nothing is
+			// drawn or uploaded.
+			StoryFrameTimeStats playPrefetchFrames(const std::string& campaignFolderName, const LoadStoryCampaignResult& loadCampaignResult, const StoryMapDefn& mapDefn, int frameCount, bool prefetchFlag, int& prefetchedBundleCount) {
+				std::vector<StoryLevelDefn> levelDefnList;
+				for (auto const& currLevelResult : loadCampaignResult.levelResultList) {
+					levelDefnList.push_back(currLevelResult.levelDefn);
+				}
+				const StoryLevelDefn& levelDefn = levelDefnList[0];
+
+				std::vector<sf::Int64> frameMicrosecondsList;
+				frameMicrosecondsList.reserve(frameCount);
+
+				StoryGame storyGame;
+				SnakeBot* bot = nullptr;
+				StoryGameUpdateResult updateResult;
+
+				StoryAssetCache* prefetchAssetCache = nullptr;
+				StoryLevelAssetBundle* prefetchAssetBundle = nullptr;
+				int prefetchLevelIndex = 0;
+
+				sf::Clock frameClock;
+				sf::Clock updateClock;
+				while ((int)frameMicrosecondsList.size() < frameCount) {
+					frameClock.restart();
+
+					if (prefetchFlag && (prefetchAssetBundle != nullptr) && (prefetchAssetBundle->getLoadingStatus().completionStatus != StoryLevelAssetLoadingCompletionStatus::LOADING)) {
+						delete prefetchAssetBundle;
+						delete prefetchAssetCache;
+						prefetchAssetBundle = nullptr;
+						prefetchAssetCache = nullptr;
+						prefetchedBundleCount++;
+					}
+					if (prefetchFlag && (prefetchAssetBundle == nullptr)) {
+						prefetchLevelIndex = (levelDefnList.size() > 1) ? ((prefetchLevelIndex % ((int)levelDefnList.size() - 1)) + 1) : 0;
+						prefetchAssetCache = new StoryAssetCache(StoryAssetCacheConstants::DEFAULT_MEMORY_BUDGET_BYTES);
+						prefetchAssetBundle = new StoryLevelAssetBundle(*prefetchAssetCache);
+						prefetchAssetBundle->loadLevelAsync(campaignFolderName, levelDefnList[prefetchLevelIndex], StoryLevelAssetLoadPriority::BACKGROUND);
+					}
+
+					if (bot == nullptr) {
+						storyGame.startNewCampaign();
+						storyGame.startNewLevel(mapDefn, levelDefn, (unsigned int)frameMicrosecondsList.size());
+						storyGame.startRunningLevel();
+						bot = SnakeBotUtils::createStoryGameBot(storyGame);
+					}
+
+					updateClock.restart();
+					StoryGameInputRequest inputRequest = SnakeBotUtils::buildStoryGameInputRequest(*bot, storyGame);
+					storyGame.update(inputRequest, updateResult);
+					frameMicrosecondsList.push_back(updateClock.getElapsedTime().asMicroseconds());
+
+					if (updateResult.completedLevelFlag || updateResult.snakeDiedFlag) {
+						storyGame.stopRunningLevel();
+						delete bot;
+						bot = nullptr;
+					}
+
+					sf::Time frameTime = frameClock.getElapsedTime();
+					if (frameTime < StoryLoaderBenchmarkConstants::FRAME_DURATION) {
+						sf::sleep(StoryLoaderBenchmarkConstants::FRAME_DURATION - frameTime);
+					}
+				}
+
+				if (bot != nullptr) {
+					storyGame.stopRunningLevel();
+					delete bot;
+				}
+				if (prefetchAssetBundle != nullptr) {
+					delete prefetchAssetBundle;
+					delete prefetchAssetCache;
+				}
+
+				StoryFrameTimeStats result = buildFrameTimeStats(frameMicrosecondsList);
+				return result;
+			}
+
+			StoryPrefetchFrameTimeResult measurePrefetchFrameTimes(const std::string& campaignFolderName, int frameCount) {
+				StoryPrefetchFrameTimeResult result;
+
+				LoadStoryCampaignResult loadCampaignResult = StoryLoaderUtils::loadStoryCampaign(campaignFolderName);
+				result.campaignValid = loadCampaignResult.valid() && !loadCampaignResult.levelResultList.empty();
+
+				if (result.campaignValid) {
+					LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(campaignFolderName, loadCampaignResult.levelResultList[0].levelDefn.mapFilename);
+					result.campaignValid = loadMapResult.validationResult.valid();
+
+					if (result.campaignValid) {
+						int prefetchedBundleCount = 0;
+						result.prefetchOffStats = playPrefetchFrames(campaignFolderName, loadCampaignResult, loadMapResult.mapDefn, frameCount, false, prefetchedBundleCount);
+						result.prefetchOnStats = playPrefetchFrames(campaignFolderName, loadCampaignResult, loadMapResult.mapDefn, frameCount, true, prefetchedBundleCount);
+						result.prefetchedBundleCount = prefetchedBundleCount;
+					}
+				}
+
+				return result;
+			}
+
+			std::vector<std::string> buildPrefetchFrameTimeMessages(const StoryPrefetchFrameTimeResult& frameTimeResult) {
+				std::vector<std::string> result;
+
+				if (!frameTimeResult.campaignValid) {
+					result.push_back("Campaign or first level map not valid (see log.txt for details)");
+				}
+				else {
+					char message[256];
+
+					snprintf(message, sizeof(message), "Prefetch off: %d frames, avg %.1f us, p99 %lld us, max %lld us", frameTimeResult.prefetchOffStats.frameCount, frameTimeResult.prefetchOffStats.avgFrameMicroseconds, (long long)frameTimeResult.prefetchOffStats.p99FrameMicroseconds, (long long)frameTimeResult.prefetchOffStats.maxFrameMicroseconds);
+					result.push_back(message);
+
+					snprintf(message, sizeof(message), "Prefetch on:  %d frames, avg %.1f us, p99 %lld us, max %lld us (%d level bundles decoded)", frameTimeResult.prefetchOnStats.frameCount, frameTimeResult.prefetchOnStats.avgFrameMicroseconds, (long long)frameTimeResult.prefetchOnStats.p99FrameMicroseconds, (long long)frameTimeResult.prefetchOnStats.maxFrameMicroseconds, frameTimeResult.prefetchedBundleCount);
+					result.push_back(message);
+
+					snprintf(message, sizeof(message), "Bot and game update on the main thread only, textures are not drawn or uploaded, %u hardware threads", std::thread::hardware_concurrency());
+					result.push_back(message);
+				}
+
+				return result;
+			}
+
+			std::vector<std::string> buildReportMessages(const StoryLoaderBenchmarkResult& benchmarkResult) {
+				std::vector<std::string> result;
+
+				char message[512];
+
+				snprintf(message, sizeof(message), "Campaign: %d levels, %d maps, %d cutscene events, %s", benchmarkResult.levelCount, benchmarkResult.mapCount, benchmarkResult.cutsceneEventCount, benchmarkResult.campaignValid ? "valid" : "not valid (see log.txt for details)");
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "Parse campaign.json: %.1f ms for %.1f MB (%.1f MB/s)", benchmarkResult.parseSeconds * 1000.0f, toMegabytes(benchmarkResult.campaignFileBytes), resolveRate(toMegabytes(benchmarkResult.campaignFileBytes), benchmarkResult.parseSeconds));
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "Validate levels (1 thread): %.1f ms (%.0f cutscene events/s)", benchmarkResult.validationSeconds * 1000.0f, resolveRate((float)benchmarkResult.cutsceneEventCount, benchmarkResult.validationSeconds));
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "Load maps: %.1f ms for %.1f MB (%.1f MB/s)", benchmarkResult.mapLoadSeconds * 1000.0f, toMegabytes(benchmarkResult.mapFileBytes), resolveRate(toMegabytes(benchmarkResult.mapFileBytes), benchmarkResult.mapLoadSeconds));
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "loadStoryCampaign, no definition cache: %.1f ms (%.1f MB/s, %.0f cutscene events/s)", benchmarkResult.coldLoadSeconds * 1000.0f, resolveRate(toMegabytes(benchmarkResult.campaignFileBytes), benchmarkResult.coldLoadSeconds), resolveRate((float)benchmarkResult.cutsceneEventCount, benchmarkResult.coldLoadSeconds));
+				result.push_back(message);
+
+				snprintf(message, sizeof(message), "loadStoryCampaign, %s: %.1f ms", benchmarkResult.warmCacheHit ? "definition cache" : "cache missed", benchmarkResult.warmLoadSeconds * 1000.0f);
+				result.push_back(message);
+
+				if (benchmarkResult.assetBundleCount > 0) {
+					snprintf(message, sizeof(message), "Asset bundles: %d levels decoded in %.1f ms, %d with files that failed to load (textures not uploaded)", benchmarkResult.assetBundleCount, benchmarkResult.assetBundleSeconds * 1000.0f, benchmarkResult.assetBundleFailedCount);
+					result.push_back(message);
+
+					result.push_back(StoryAssetCacheUtils::buildStatsMessage(benchmarkResult.assetCacheStats));
+
+					// Every level after the first is loaded with the tiles of the levels before it still resident
+					int laterTileHitCount = benchmarkResult.assetCacheStats.imageHitCount - benchmarkResult.firstLevelAssetCacheStats.imageHitCount;
+					int laterTileMissCount = benchmarkResult.assetCacheStats.imageMissCount - benchmarkResult.firstLevelAssetCacheStats.imageMissCount;
+					snprintf(message, sizeof(message), "Map tiles: %d decoded for level 1; %d of %d found in the asset cache for the %d levels after it", benchmarkResult.firstLevelAssetCacheStats.imageMissCount, laterTileHitCount, laterTileHitCount + laterTileMissCount, benchmarkResult.assetBundleCount - 1);
+					result.push_back(message);
+				}
+
+				snprintf(message, sizeof(message), "Peak resident memory: %.1f MB", toMegabytes(benchmarkResult.peakResidentBytes));
+				result.push_back(message);
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
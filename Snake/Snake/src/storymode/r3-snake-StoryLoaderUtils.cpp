@@ -1,11 +1,16 @@
 
+#include <stdio.h>
+#include <algorithm>
 #include <fstream>
 #include <codecvt>
 #include <ctime>
 #include <set>
+#include <thread>
 #include "../jsoncpp/json/json.h"
 #include "../includes/r3-json-JsonValidationUtils.hpp"
 #include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storyarchive.hpp"
+#include "../includes/r3-snake-storydefncache.hpp"
 #pragma once
 
 namespace r3 {
@@ -50,6 +55,8 @@ namespace r3 {
 				const char* TEXTURE = "texture";
 				const char* SNAKE_MOVEMENT = "snakeMovement";
 				const char* SNAKE_MOVEMENT_GROW = "grow";
+				const char* SNAKE_PATH = "path";
+				const char* SNAKE_PATH_FRAMES_PER_STEP = "framesPerStep";
 				const char* SHOW_OBJECT = "showObject";
 				const char* HIDE_OBJECT = "hideObject";
 				const char* OBJECT_INSTANCE_ID = "instanceId";
@@ -113,6 +120,21 @@ namespace r3 {
 
 			}
 
+			namespace SnakePathStepValues {
+
+				const char UP = 'U';
+				const char DOWN = 'D';
+				const char LEFT = 'L';
+				const char RIGHT = 'R';
+				const char UP_GROW = 'u';
+				const char DOWN_GROW = 'd';
+				const char LEFT_GROW = 'l';
+				const char RIGHT_GROW = 'r';
+
+				const int MAX_RUN_VALUE = 65535;
+
+			}
+
 			namespace CutsceneEventTypeValues {
 
 				const char* COLOR = "color";
@@ -120,6 +142,7 @@ namespace r3 {
 				const char* SHOW_MAP = "showMap";
 				const char* SHOW_SNAKE = "showSnake";
 				const char* MOVE_SNAKE = "moveSnake";
+				const char* MOVE_SNAKE_PATH = "moveSnakePath";
 				const char* HIDE_SNAKE = "hideSnake";
 				const char* SHOW_FOOD = "showFood";
 				const char* HIDE_FOOD = "hideFood";
@@ -190,13 +213,13 @@ namespace r3 {
 			} LoadJsonFromFileResult;
 
 			LoadJsonFromFileResult loadFromJsonFile(const char* filePath) {
-				std::ifstream inputStream(filePath);
+				StoryFileContents fileContents;
+				StoryArchiveUtils::readFile(filePath, fileContents);
 
 				LoadJsonFromFileResult result;
 
-				Json::Value jsonValue;
 				Json::Reader jsonReader(Json::Features::strictMode());
-				jsonReader.parse(inputStream, result.jsonValue);
+				jsonReader.parse(fileContents.getData(), fileContents.getData() + fileContents.getSize(), result.jsonValue);
 
 				result.parseErrorString = jsonReader.getFormattedErrorMessages();
 
@@ -326,31 +349,41 @@ namespace r3 {
 				}
 			}
 
-			void updateStoryMapGrid(std::vector<std::vector<int>>& grid, const Json::Value& jsonValue) {
+			void updateStoryMapGrid(std::vector<int>& grid, const Json::Value& jsonValue, const sf::Vector2i& fieldSize) {
+				grid.reserve(fieldSize.x * fieldSize.y);
 				for (Json::ArrayIndex rowIndex = 0; rowIndex < jsonValue.size(); rowIndex++) {
-					std::vector<int> currGridRow;
-					Json::Value currRowValue = jsonValue[rowIndex];
-
+					const Json::Value& currRowValue = jsonValue[rowIndex];
 					for (Json::ArrayIndex cellIndex = 0; cellIndex < currRowValue.size(); cellIndex++) {
-						Json::Value currCellValue = currRowValue[cellIndex];
-						currGridRow.push_back(currCellValue.asInt());
+						grid.push_back(currRowValue[cellIndex].asInt());
 					}
+				}
+			}
 
-					grid.push_back(currGridRow);
+			std::shared_ptr<const StoryMapTileGrid> buildStoryMapTileGrid(const std::vector<int>& floorGrid, const std::vector<int>& barrierGrid) {
+				StoryMapTileGrid* tileGrid = new StoryMapTileGrid(floorGrid.size());
+				for (size_t tileIndex = 0; tileIndex < floorGrid.size(); tileIndex++) {
+					(*tileGrid)[tileIndex].floorId = (sf::Uint16)floorGrid[tileIndex];
+					(*tileGrid)[tileIndex].barrierId = (sf::Uint8)barrierGrid[tileIndex];
 				}
+
+				std::shared_ptr<const StoryMapTileGrid> result(tileGrid);
+				return result;
 			}
 
-			LoadStoryMapResult loadStoryMap(const std::string& campaignFolderName, const std::string& mapFilename) {
-				std::string mapFilePath = resolveMapFilePath(campaignFolderName, mapFilename);
-				LoadJsonFromFileResult loadResult = loadFromJsonFile(mapFilePath.c_str());
+			LoadStoryMapResult parseStoryMapDocument(const std::string& campaignFolderName, const StoryFileContents& fileContents) {
+				LoadJsonFromFileResult loadResult;
+
+				Json::Reader jsonReader(Json::Features::strictMode());
+				jsonReader.parse(fileContents.getData(), fileContents.getData() + fileContents.getSize(), loadResult.jsonValue);
+				loadResult.parseErrorString = jsonReader.getFormattedErrorMessages();
 
 				LoadStoryMapResult result;
 
 				result.validationResult.parseErrorString = loadResult.parseErrorString;
 				result.validationResult.widthValid = r3::json::ValidationUtils::requiredInt(loadResult.jsonValue, StoryMapProperties::WIDTH);
 				result.validationResult.heightValid = r3::json::ValidationUtils::requiredInt(loadResult.jsonValue, StoryMapProperties::HEIGHT);
-				result.validationResult.floorListValid = LoadStoryMapValidation::tileListValid(loadResult.jsonValue, StoryMapProperties::FLOOR_LIST, 0);
-				result.validationResult.barrierListValid = LoadStoryMapValidation::tileListValid(loadResult.jsonValue, StoryMapProperties::BARRIER_LIST, 1);
+				result.validationResult.floorListValid = LoadStoryMapValidation::tileListValid(loadResult.jsonValue, StoryMapProperties::FLOOR_LIST, 0, LoadStoryMapValidation::MAX_FLOOR_ID);
+				result.validationResult.barrierListValid = LoadStoryMapValidation::tileListValid(loadResult.jsonValue, StoryMapProperties::BARRIER_LIST, 1, LoadStoryMapValidation::MAX_BARRIER_ID);
 				result.validationResult.floorGridValid = LoadStoryMapValidation::tileGridValid(loadResult.jsonValue, StoryMapProperties::FLOOR_GRID);
 				result.validationResult.barrierGridValid = LoadStoryMapValidation::tileGridValid(loadResult.jsonValue, StoryMapProperties::BARRIER_GRID);
 
@@ -378,23 +411,44 @@ namespace r3 {
 					LoadStoryMapValidation::updateTextureFileInvalidList(result.validationResult.barrierTextureFileInvalidList, campaignFolderName, result.mapDefn.barrierDefnMap);
 				}
 
-				if (
+				bool floorGridStored =
 					result.validationResult.floorGridValid &&
-					result.validationResult.floorGridSizeValid
-				) {
-					updateStoryMapGrid(result.mapDefn.floorGrid, loadResult.jsonValue[StoryMapProperties::FLOOR_GRID]);
-					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentFloorIdRefList, result.mapDefn.floorDefnMap, result.mapDefn.floorGrid);
+					result.validationResult.floorGridSizeValid;
+
+				std::vector<int> floorGrid;
+				if (floorGridStored) {
+					updateStoryMapGrid(floorGrid, loadResult.jsonValue[StoryMapProperties::FLOOR_GRID], result.mapDefn.fieldSize);
+					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentFloorIdRefList, result.mapDefn.floorDefnMap, floorGrid);
 				}
 
-				if (
+				bool barrierGridStored =
 					result.validationResult.barrierGridValid &&
-					result.validationResult.barrierGridSizeValid
-				) {
-					updateStoryMapGrid(result.mapDefn.barrierGrid, loadResult.jsonValue[StoryMapProperties::BARRIER_GRID]);
-					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentBarrierIdRefList, result.mapDefn.barrierDefnMap, result.mapDefn.barrierGrid);
+					result.validationResult.barrierGridSizeValid;
+
+				std::vector<int> barrierGrid;
+				if (barrierGridStored) {
+					updateStoryMapGrid(barrierGrid, loadResult.jsonValue[StoryMapProperties::BARRIER_GRID], result.mapDefn.fieldSize);
+					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentBarrierIdRefList, result.mapDefn.barrierDefnMap, barrierGrid);
 					result.validationResult.nonExistentBarrierIdRefList.erase(0);
 				}
 
+				if (floorGridStored && barrierGridStored) {
+					result.mapDefn.tileGrid = buildStoryMapTileGrid(floorGrid, barrierGrid);
+				}
+
+				return result;
+			}
+
+			LoadStoryMapResult parseStoryMap(const std::string& campaignFolderName, const std::string& mapFilename) {
+				std::string mapFilePath = resolveMapFilePath(campaignFolderName, mapFilename);
+
+				StoryFileContents fileContents;
+				StoryArchiveUtils::readFile(mapFilePath, fileContents);
+
+				LoadStoryMapResult result;
+				if (!streamStoryMapDocument(campaignFolderName, fileContents, result)) {
+					result = parseStoryMapDocument(campaignFolderName, fileContents);
+				}
 				return result;
 			}
 
@@ -607,6 +661,7 @@ namespace r3 {
 
 				result.triggerType = convertJsonValueToSoundFxTriggerType(jsonValue[StoryLevelProperties::SOUND_FX_TRIGGER_TYPE]);
 				result.soundFilename = jsonValue[StoryLevelProperties::SOUND_FILENAME].asString();
+				result.soundBufferHandle = -1;
 
 				if (result.triggerType == StorySoundFxTriggerType::ON_TIMER) {
 					result.timePassed = jsonValue[StoryLevelProperties::TIME_PASSED].asInt();
@@ -661,82 +716,239 @@ namespace r3 {
 				else if (jsonValueStr.compare(CutsceneEventTypeValues::HIDE_DANGER) == 0) {
 					result = StoryCutsceneEventType::HIDE_DANGER;
 				}
+				else if (jsonValueStr.compare(CutsceneEventTypeValues::MOVE_SNAKE_PATH) == 0) {
+					result = StoryCutsceneEventType::MOVE_SNAKE_PATH;
+				}
 
 				return result;
 			}
 
-			StoryCutsceneEventDefn loadStoryCutsceneEvent(const Json::Value& jsonValue) {
-				StoryCutsceneEventDefn result;
+			ObjectDirection convertPathStepToObjectDirection(char stepChar) {
+				ObjectDirection result = ObjectDirection::NONE;
 
-				result.framesSinceLastEvent = jsonValue[StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT].asInt();
-				result.eventType = convertJsonValueToCutsceneEventType(jsonValue[StoryCutsceneProperties::EVENT_TYPE]);
+				switch (stepChar) {
+				case SnakePathStepValues::UP:
+				case SnakePathStepValues::UP_GROW:
+					result = ObjectDirection::UP;
+					break;
+				case SnakePathStepValues::DOWN:
+				case SnakePathStepValues::DOWN_GROW:
+					result = ObjectDirection::DOWN;
+					break;
+				case SnakePathStepValues::LEFT:
+				case SnakePathStepValues::LEFT_GROW:
+					result = ObjectDirection::LEFT;
+					break;
+				case SnakePathStepValues::RIGHT:
+				case SnakePathStepValues::RIGHT_GROW:
+					result = ObjectDirection::RIGHT;
+					break;
+				}
+
+				return result;
+			}
+
+			void appendSnakePathStep(std::vector<StorySnakePathRun>& runList, size_t firstRunIndex, ObjectDirection direction, bool growFlag, int framesPerStep) {
+				bool extendsLastRun =
+					(runList.size() > firstRunIndex) &&
+					(runList.back().direction == (sf::Uint8)direction) &&
+					(runList.back().growFlag == growFlag) &&
+					(runList.back().framesPerStep == framesPerStep) &&
+					(runList.back().stepCount < SnakePathStepValues::MAX_RUN_VALUE);
+
+				if (extendsLastRun) {
+					runList.back().stepCount++;
+				}
+				else {
+					StorySnakePathRun newRun;
+					newRun.stepCount = 1;
+					newRun.framesPerStep = (sf::Uint16)framesPerStep;
+					newRun.direction = (sf::Uint8)direction;
+					newRun.growFlag = growFlag;
+					runList.push_back(newRun);
+				}
+			}
+
+			bool parseSnakePath(const std::string& pathString, int framesPerStep, std::vector<StorySnakePathRun>& runList) {
+				size_t firstRunIndex = runList.size();
+
+				bool result =
+					(framesPerStep >= 0) &&
+					(framesPerStep <= SnakePathStepValues::MAX_RUN_VALUE);
+
+				// The first step waits for the event's own framesSinceLastEvent, so it cannot carry a frame count
+				int stepFrames = -1;
+				for (size_t charIndex = 0; result && (charIndex < pathString.size()); charIndex++) {
+					char currChar = pathString[charIndex];
+
+					if ((currChar >= '0') && (currChar <= '9')) {
+						stepFrames = (stepFrames < 0) ? 0 : stepFrames;
+						stepFrames = stepFrames * 10 + (currChar - '0');
+						result =
+							(runList.size() > firstRunIndex) &&
+							(stepFrames <= SnakePathStepValues::MAX_RUN_VALUE);
+					}
+					else if (currChar == ' ') {
+						result = (stepFrames < 0);
+					}
+					else {
+						ObjectDirection direction = convertPathStepToObjectDirection(currChar);
+						result = (direction != ObjectDirection::NONE);
+						if (result) {
+							bool growFlag = (currChar >= 'a') && (currChar <= 'z');
+							appendSnakePathStep(runList, firstRunIndex, direction, growFlag, (stepFrames >= 0) ? stepFrames : framesPerStep);
+							stepFrames = -1;
+						}
+					}
+				}
+
+				result =
+					result &&
+					(stepFrames < 0) &&
+					(runList.size() > firstRunIndex);
+				return result;
+			}
+
+			int internCutsceneFilename(StoryCutsceneDefn& cutsceneDefn, const std::string& filename) {
+				auto filenameItr = std::find(cutsceneDefn.filenameList.begin(), cutsceneDefn.filenameList.end(), filename);
+
+				int result = (int)(filenameItr - cutsceneDefn.filenameList.begin());
+				if (filenameItr == cutsceneDefn.filenameList.end()) {
+					cutsceneDefn.filenameList.push_back(filename);
+				}
+
+				return result;
+			}
+
+			void loadStoryCutsceneEvent(StoryCutsceneDefn& cutsceneDefn, const Json::Value& jsonValue) {
+				StoryCutsceneEventDefn eventDefn;
+
+				eventDefn.framesSinceLastEvent = jsonValue[StoryCutsceneProperties::FRAMES_SINCE_LAST_EVENT].asInt();
+				eventDefn.eventType = convertJsonValueToCutsceneEventType(jsonValue[StoryCutsceneProperties::EVENT_TYPE]);
+				eventDefn.payloadIndex = -1;
 				
-				if (result.eventType == StoryCutsceneEventType::COLOR) {
-					result.colorEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
+				if (eventDefn.eventType == StoryCutsceneEventType::COLOR) {
+					StoryCutsceneColorEventDefn colorEvent;
+					colorEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
 
 					Json::Value colorValue = jsonValue[StoryCutsceneProperties::COLOR];
 					int red = colorValue[StoryCutsceneProperties::COLOR_RED].asInt();
 					int green = colorValue[StoryCutsceneProperties::COLOR_GREEN].asInt();
 					int blue = colorValue[StoryCutsceneProperties::COLOR_BLUE].asInt();
 
-					result.colorEvent.color = sf::Color(red, green, blue, 255);
+					colorEvent.color = sf::Color(red, green, blue, 255);
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.colorEventList.size();
+					cutsceneDefn.colorEventList.push_back(colorEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::TEXTURE) {
-					result.textureEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
-					result.textureEvent.textureFilename = jsonValue[StoryCutsceneProperties::TEXTURE].asString();
+				else if (eventDefn.eventType == StoryCutsceneEventType::TEXTURE) {
+					StoryCutsceneTextureEventDefn textureEvent;
+					textureEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
+					textureEvent.filenameIndex = internCutsceneFilename(cutsceneDefn, jsonValue[StoryCutsceneProperties::TEXTURE].asString());
+					textureEvent.textureHandle = -1;
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.textureEventList.size();
+					cutsceneDefn.textureEventList.push_back(textureEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::SHOW_MAP) {
-					result.mapEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
-					result.mapEvent.mapFilename = jsonValue[StoryLevelProperties::MAP_FILENAME].asString();
+				else if (eventDefn.eventType == StoryCutsceneEventType::SHOW_MAP) {
+					StoryCutsceneMapEventDefn mapEvent;
+					mapEvent.fadeFrames = jsonValue[StoryCutsceneProperties::FADE_FRAMES].asInt();
+					mapEvent.filenameIndex = internCutsceneFilename(cutsceneDefn, jsonValue[StoryLevelProperties::MAP_FILENAME].asString());
+					mapEvent.mapHandle = -1;
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.mapEventList.size();
+					cutsceneDefn.mapEventList.push_back(mapEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::SHOW_SNAKE) {
+				else if (eventDefn.eventType == StoryCutsceneEventType::SHOW_SNAKE) {
 					Json::Value snakeStartValue = jsonValue[StoryLevelProperties::SNAKE_START];
 
+					SnakeStartDefn snakeStart;
+
 					Json::Value snakeStartPositionValue = snakeStartValue[StoryLevelProperties::POSITION];
-					result.snakeEvent.snakeStart.headPosition.x = snakeStartPositionValue[StoryLevelProperties::POSITION_X].asInt();
-					result.snakeEvent.snakeStart.headPosition.y = snakeStartPositionValue[StoryLevelProperties::POSITION_Y].asInt();
+					snakeStart.headPosition.x = snakeStartPositionValue[StoryLevelProperties::POSITION_X].asInt();
+					snakeStart.headPosition.y = snakeStartPositionValue[StoryLevelProperties::POSITION_Y].asInt();
 
-					result.snakeEvent.snakeStart.facingDirection = convertJsonValueToObjectDirection(snakeStartValue[StoryLevelProperties::SNAKE_START_DIRECTION]);
+					snakeStart.facingDirection = convertJsonValueToObjectDirection(snakeStartValue[StoryLevelProperties::SNAKE_START_DIRECTION]);
 
-					result.snakeEvent.snakeStart.length = snakeStartValue[StoryLevelProperties::SNAKE_START_LENGTH].asInt();
+					snakeStart.length = snakeStartValue[StoryLevelProperties::SNAKE_START_LENGTH].asInt();
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.snakeStartList.size();
+					cutsceneDefn.snakeStartList.push_back(snakeStart);
 				}
-				else if (result.eventType == StoryCutsceneEventType::MOVE_SNAKE) {
+				else if (eventDefn.eventType == StoryCutsceneEventType::MOVE_SNAKE) {
+					StoryCutsceneSnakeEventDefn snakeEvent;
+
 					Json::Value snakeMovementValue = jsonValue[StoryCutsceneProperties::SNAKE_MOVEMENT];
-					result.snakeEvent.snakeDirection = convertJsonValueToObjectDirection(snakeMovementValue[StoryLevelProperties::SNAKE_START_DIRECTION]);
-					result.snakeEvent.snakeGrowFlag = snakeMovementValue[StoryCutsceneProperties::SNAKE_MOVEMENT_GROW].asBool();
+					snakeEvent.snakeDirection = convertJsonValueToObjectDirection(snakeMovementValue[StoryLevelProperties::SNAKE_START_DIRECTION]);
+					snakeEvent.snakeGrowFlag = snakeMovementValue[StoryCutsceneProperties::SNAKE_MOVEMENT_GROW].asBool();
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.snakeEventList.size();
+					cutsceneDefn.snakeEventList.push_back(snakeEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::SHOW_FOOD) {
-					Json::Value showObjectValue = jsonValue[StoryCutsceneProperties::SHOW_OBJECT];
+				else if (eventDefn.eventType == StoryCutsceneEventType::MOVE_SNAKE_PATH) {
+					StoryCutscenePathEventDefn pathEvent;
+					pathEvent.firstRunIndex = (int)cutsceneDefn.pathRunList.size();
 
-					result.foodEvent.instanceId = showObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+					int framesPerStep = jsonValue.get(StoryCutsceneProperties::SNAKE_PATH_FRAMES_PER_STEP, eventDefn.framesSinceLastEvent).asInt();
+					parseSnakePath(jsonValue[StoryCutsceneProperties::SNAKE_PATH].asString(), framesPerStep, cutsceneDefn.pathRunList);
 
-					result.foodEvent.foodType = convertJsonValueToFoodType(showObjectValue[StoryLevelProperties::FOOD_TYPE]);
+					pathEvent.runCount = (int)cutsceneDefn.pathRunList.size() - pathEvent.firstRunIndex;
 
-					Json::Value positionValue = showObjectValue[StoryLevelProperties::POSITION];
-					result.foodEvent.position.x = positionValue[StoryLevelProperties::POSITION_X].asInt();
-					result.foodEvent.position.y = positionValue[StoryLevelProperties::POSITION_Y].asInt();
-				}
-				else if (result.eventType == StoryCutsceneEventType::HIDE_FOOD) {
-					Json::Value hideObjectValue = jsonValue[StoryCutsceneProperties::HIDE_OBJECT];
-					result.foodEvent.instanceId = hideObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+					eventDefn.payloadIndex = (int)cutsceneDefn.pathEventList.size();
+					cutsceneDefn.pathEventList.push_back(pathEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::SHOW_DANGER) {
-					Json::Value showObjectValue = jsonValue[StoryCutsceneProperties::SHOW_OBJECT];
+				else if (
+					(eventDefn.eventType == StoryCutsceneEventType::SHOW_FOOD) ||
+					(eventDefn.eventType == StoryCutsceneEventType::HIDE_FOOD)
+				) {
+					StoryCutsceneFoodEventDefn foodEvent;
 
-					result.dangerEvent.instanceId = showObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+					if (eventDefn.eventType == StoryCutsceneEventType::SHOW_FOOD) {
+						Json::Value showObjectValue = jsonValue[StoryCutsceneProperties::SHOW_OBJECT];
 
-					result.dangerEvent.dangerType = convertJsonValueToDangerType(showObjectValue[StoryLevelProperties::DANGER_TYPE]);
+						foodEvent.instanceId = showObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
 
-					Json::Value positionValue = showObjectValue[StoryLevelProperties::POSITION];
-					result.dangerEvent.position.x = positionValue[StoryLevelProperties::POSITION_X].asInt();
-					result.dangerEvent.position.y = positionValue[StoryLevelProperties::POSITION_Y].asInt();
+						foodEvent.foodType = convertJsonValueToFoodType(showObjectValue[StoryLevelProperties::FOOD_TYPE]);
+
+						Json::Value positionValue = showObjectValue[StoryLevelProperties::POSITION];
+						foodEvent.position.x = positionValue[StoryLevelProperties::POSITION_X].asInt();
+						foodEvent.position.y = positionValue[StoryLevelProperties::POSITION_Y].asInt();
+					}
+					else {
+						Json::Value hideObjectValue = jsonValue[StoryCutsceneProperties::HIDE_OBJECT];
+						foodEvent.instanceId = hideObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+					}
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.foodEventList.size();
+					cutsceneDefn.foodEventList.push_back(foodEvent);
 				}
-				else if (result.eventType == StoryCutsceneEventType::HIDE_DANGER) {
-					Json::Value hideObjectValue = jsonValue[StoryCutsceneProperties::HIDE_OBJECT];
-					result.dangerEvent.instanceId = hideObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+				else if (
+					(eventDefn.eventType == StoryCutsceneEventType::SHOW_DANGER) ||
+					(eventDefn.eventType == StoryCutsceneEventType::HIDE_DANGER)
+				) {
+					StoryCutsceneDangerEventDefn dangerEvent;
+
+					if (eventDefn.eventType == StoryCutsceneEventType::SHOW_DANGER) {
+						Json::Value showObjectValue = jsonValue[StoryCutsceneProperties::SHOW_OBJECT];
+
+						dangerEvent.instanceId = showObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+
+						dangerEvent.dangerType = convertJsonValueToDangerType(showObjectValue[StoryLevelProperties::DANGER_TYPE]);
+
+						Json::Value positionValue = showObjectValue[StoryLevelProperties::POSITION];
+						dangerEvent.position.x = positionValue[StoryLevelProperties::POSITION_X].asInt();
+						dangerEvent.position.y = positionValue[StoryLevelProperties::POSITION_Y].asInt();
+					}
+					else {
+						Json::Value hideObjectValue = jsonValue[StoryCutsceneProperties::HIDE_OBJECT];
+						dangerEvent.instanceId = hideObjectValue[StoryCutsceneProperties::OBJECT_INSTANCE_ID].asInt();
+					}
+
+					eventDefn.payloadIndex = (int)cutsceneDefn.dangerEventList.size();
+					cutsceneDefn.dangerEventList.push_back(dangerEvent);
 				}
 
-				return result;
+				cutsceneDefn.eventDefnList.push_back(eventDefn);
 			}
 
 			StoryCutsceneDefn loadStoryCutscene(const Json::Value& jsonValue) {
@@ -746,9 +958,10 @@ namespace r3 {
 				result.soundTrackFilename = jsonValue.get(StoryCutsceneProperties::SOUND_TRACK, "").asString();
 
 				Json::Value eventListValue = jsonValue[StoryCutsceneProperties::EVENT_LIST];
+				result.eventDefnList.reserve(eventListValue.size());
 				for (Json::ArrayIndex index = 0; index < eventListValue.size(); index++) {
 					Json::Value currEventValue = eventListValue[index];
-					result.eventDefnList.push_back(loadStoryCutsceneEvent(currEventValue));
+					loadStoryCutsceneEvent(result, currEventValue);
 				}
 
 				return result;
@@ -917,7 +1130,44 @@ namespace r3 {
 				return result;
 			}
 
-			LoadStoryCampaignResult loadStoryCampaign(const std::string& campaignFolderName) {
+			// Level entries do not depend on each other, so they are handed out one at a time to a pool of workers.
+			// Each result lands in its own slot of the pre-sized list, which keeps the report in level order.
+			typedef struct Snake_LevelValidationJobs {
+				const std::string* campaignFolderName;
+				const Json::Value* levelListValue;
+				std::vector<LoadStoryLevelResult>* levelResultList;
+				sf::Mutex jobMutex;
+				int nextLevelIndex = 0;
+			} LevelValidationJobs;
+
+			bool claimLevelValidationJob(LevelValidationJobs* jobs, int* levelIndex) {
+				jobs->jobMutex.lock();
+				bool result = (jobs->nextLevelIndex < (int)jobs->levelResultList->size());
+				if (result) {
+					*levelIndex = jobs->nextLevelIndex;
+					jobs->nextLevelIndex++;
+				}
+				jobs->jobMutex.unlock();
+				return result;
+			}
+
+			void runLevelValidationWorker(LevelValidationJobs* jobs) {
+				int levelIndex = 0;
+				while (claimLevelValidationJob(jobs, &levelIndex)) {
+					const Json::Value& levelValue = (*jobs->levelListValue)[(Json::ArrayIndex)levelIndex];
+					(*jobs->levelResultList)[levelIndex] = loadStoryLevel(*jobs->campaignFolderName, levelValue);
+				}
+			}
+
+			int resolveLevelValidationThreadCount() {
+				int result = std::max(1, (int)std::thread::hardware_concurrency());
+				return result;
+			}
+
+			LoadStoryCampaignResult parseStoryCampaign(const std::string& campaignFolderName, int threadCount) {
+				// Asset probes are shared for the length of one campaign load, so edited assets are seen on the next one
+				LoadAssetValidation::clearProbeCache();
+
 				std::string campaignFilename = resolveCampaignFilePath(campaignFolderName);
 				LoadJsonFromFileResult loadResult = loadFromJsonFile(campaignFilename.c_str());
 
@@ -930,16 +1180,113 @@ namespace r3 {
 				}
 
 				if (result.levelListValid) {
-					Json::Value levelListValue = loadResult.jsonValue[CampaignListProperties::LEVEL_LIST];
-					for (Json::ArrayIndex index = 0; index < levelListValue.size(); index++) {
-						LoadStoryLevelResult currLevelResult = loadStoryLevel(campaignFolderName, levelListValue[index]);
-						result.levelResultList.push_back(currLevelResult);
+					const Json::Value& levelListValue = loadResult.jsonValue[CampaignListProperties::LEVEL_LIST];
+					result.levelResultList.resize(levelListValue.size());
+
+					LevelValidationJobs jobs;
+					jobs.campaignFolderName = &campaignFolderName;
+					jobs.levelListValue = &levelListValue;
+					jobs.levelResultList = &result.levelResultList;
+
+					// More workers than hardware threads only adds contention
+					int workerCount = std::min(std::min(std::max(1, threadCount), resolveLevelValidationThreadCount()), (int)levelListValue.size());
+
+					std::vector<sf::Thread*> workerThreadList;
+					for (int workerIndex = 1; workerIndex < workerCount; workerIndex++) {
+						sf::Thread* currWorkerThread = new sf::Thread(&runLevelValidationWorker, &jobs);
+						currWorkerThread->launch();
+						workerThreadList.push_back(currWorkerThread);
+					}
+
+					runLevelValidationWorker(&jobs);
+
+					for (auto& currWorkerThread : workerThreadList) {
+						currWorkerThread->wait();
+						delete currWorkerThread;
 					}
 				}
 
 				return result;
 			}
 
+			LoadStoryMapResult loadStoryMap(const std::string& campaignFolderName, const std::string& mapFilename) {
+				LoadStoryMapResult result;
+				if (!StoryDefnCacheUtils::findCachedMap(campaignFolderName, mapFilename, result)) {
+					result = parseStoryMap(campaignFolderName, mapFilename);
+				}
+				return result;
+			}
+
+			LoadStoryCampaignResult loadStoryCampaign(const std::string& campaignFolderName) {
+				LoadStoryCampaignResult result;
+				if (!StoryDefnCacheUtils::loadCachedCampaign(campaignFolderName, result)) {
+					result = parseStoryCampaign(campaignFolderName, resolveLevelValidationThreadCount());
+					if (result.valid()) {
+						StoryDefnCacheUtils::saveCachedCampaign(campaignFolderName, result);
+					}
+				}
+				return result;
+			}
+
+			StoryCampaignValidationTimes measureCampaignValidationTimes(const std::string& campaignFolderName, const std::vector<int>& threadCountList) {
+				StoryCampaignValidationTimes result;
+
+				result.hardwareThreadCount = resolveLevelValidationThreadCount();
+
+				std::vector<std::string> firstErrorMessages;
+				for (int currThreadCount : threadCountList) {
+					if (currThreadCount > result.hardwareThreadCount) {
+						result.skippedThreadCountList.push_back(currThreadCount);
+					}
+					else {
+						StoryCampaignValidationTiming currTiming;
+						currTiming.threadCount = currThreadCount;
+
+						sf::Clock validationClock;
+						LoadStoryCampaignResult currLoadResult = parseStoryCampaign(campaignFolderName, currTiming.threadCount);
+						currTiming.seconds = validationClock.getElapsedTime().asSeconds();
+						result.timingList.push_back(currTiming);
+
+						std::vector<std::string> currErrorMessages = LoadStoryCampaignValidation::buildErrorMessages(currLoadResult);
+						if (result.timingList.size() == 1) {
+							result.campaignValid = currLoadResult.valid();
+							result.levelCount = (int)currLoadResult.levelResultList.size();
+							firstErrorMessages = currErrorMessages;
+						}
+						else if (currErrorMessages != firstErrorMessages) {
+							result.resultsMatch = false;
+						}
+					}
+				}
+
+				return result;
+			}
+
+			std::vector<std::string> buildCampaignValidationTimeMessages(const StoryCampaignValidationTimes& validationTimes) {
+				std::vector<std::string> result;
+
+				char message[512];
+
+				snprintf(message, sizeof(message), "Campaign: %d levels, %s, %d hardware thread(s)", validationTimes.levelCount, validationTimes.campaignValid ? "valid" : "not valid", validationTimes.hardwareThreadCount);
+				result.push_back(message);
+
+				for (auto const& currTiming : validationTimes.timingList) {
+					snprintf(message, sizeof(message), "%d thread(s): %.1f ms", currTiming.threadCount, currTiming.seconds * 1000.0f);
+					result.push_back(message);
+				}
+
+				for (int currThreadCount : validationTimes.skippedThreadCountList) {
+					snprintf(message, sizeof(message), "%d thread(s): not timed, more than the hardware has", currThreadCount);
+					result.push_back(message);
+				}
+
+				if (!validationTimes.resultsMatch) {
+					result.push_back("Warning: the validation report changed with the thread count");
+				}
+
+				return result;
+			}
+
 			std::string resolveCurrTimeStr() {
 				time_t currTime;
 				struct tm* timeInfo;
@@ -7,32 +7,7 @@ namespace r3 {
 
 		StoryMap::StoryMap(const StoryMapDefn& mapDefn) {
 			this->fieldSize = mapDefn.fieldSize;
-
-			this->allocatedFloorArray = new int[mapDefn.fieldSize.x * mapDefn.fieldSize.y];
-			this->floorGrid = new int* [mapDefn.fieldSize.y];
-			for (int rowIndex = 0; rowIndex < mapDefn.fieldSize.y; rowIndex++) {
-				this->floorGrid[rowIndex] = &this->allocatedFloorArray[rowIndex * mapDefn.fieldSize.x];
-				for (int colIndex = 0; colIndex < mapDefn.fieldSize.x; colIndex++) {
-					this->floorGrid[rowIndex][colIndex] = mapDefn.floorGrid[rowIndex][colIndex];
-				}
-			}
-
-			this->allocatedBarrierArray = new int[mapDefn.fieldSize.x * mapDefn.fieldSize.y];
-			this->barrierGrid = new int* [mapDefn.fieldSize.y];
-			for (int rowIndex = 0; rowIndex < mapDefn.fieldSize.y; rowIndex++) {
-				this->barrierGrid[rowIndex] = &this->allocatedBarrierArray[rowIndex * mapDefn.fieldSize.x];
-				for (int colIndex = 0; colIndex < mapDefn.fieldSize.x; colIndex++) {
-					this->barrierGrid[rowIndex][colIndex] = mapDefn.barrierGrid[rowIndex][colIndex];
-				}
-			}
-		}
-
-		StoryMap::~StoryMap() {
-			delete[] this->floorGrid;
-			delete[] this->allocatedFloorArray;
-
-			delete[] this->barrierGrid;
-			delete[] this->allocatedBarrierArray;
+			this->tileGrid = mapDefn.tileGrid;
 		}
 
 		sf::Vector2i StoryMap::getFieldSize() const {
@@ -40,17 +15,17 @@ namespace r3 {
 		}
 
 		int StoryMap::getFloorId(int x, int y) const {
-			int result = this->floorGrid[y][x];
+			int result = (*this->tileGrid)[y * this->fieldSize.x + x].floorId;
 			return result;
 		}
 
 		int StoryMap::getBarrierId(int x, int y) const {
-			int result = this->barrierGrid[y][x];
+			int result = (*this->tileGrid)[y * this->fieldSize.x + x].barrierId;
 			return result;
 		}
 
 		bool StoryMap::barrierAt(int x, int y) const {
-			int barrierId = this->barrierGrid[y][x];
+			int barrierId = (*this->tileGrid)[y * this->fieldSize.x + x].barrierId;
 			bool result = barrierId > 0;
 			return result;
 		}
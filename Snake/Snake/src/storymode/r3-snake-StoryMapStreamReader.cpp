@@ -0,0 +1,486 @@
+
+#include <stdio.h>
+#include <string.h>
+#include <set>
+#include "../includes/r3-snake-storyloader.hpp"
+#include "../includes/r3-snake-storyjsonscan.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryMapStreamUtils {
+
+			typedef struct Snake_StreamedTileList {
+				bool presentFlag = false;
+				bool validFlag = false;
+				std::vector<StoryMapTileDefn> tileDefnList;
+			} StreamedTileList;
+
+			typedef struct Snake_StreamedTileGrid {
+				bool presentFlag = false;
+				bool validFlag = false;
+				int rowCount = 0;
+				int firstRowLength = 0;
+				bool rowLengthsMatch = true;
+				std::vector<int> tileList;
+			} StreamedTileGrid;
+
+			typedef struct Snake_StreamedMap {
+				bool widthValid = false;
+				bool heightValid = false;
+				int width = 0;
+				int height = 0;
+				StreamedTileList floorList;
+				StreamedTileList barrierList;
+				StreamedTileGrid floorGrid;
+				StreamedTileGrid barrierGrid;
+			} StreamedMap;
+
+			// Member names are compared as raw bytes, so a name with an escape in it is left to jsoncpp
+			bool scanMemberName(StoryJsonScanUtils::ScanCursor& cursor, const char** nameBegin, size_t* nameLength) {
+				bool result =
+					StoryJsonScanUtils::scanString(cursor, nameBegin, nameLength) &&
+					(memchr(*nameBegin, '\\', *nameLength) == nullptr) &&
+					StoryJsonScanUtils::expect(cursor, ':', "missing ':' after object member name.");
+				return result;
+			}
+
+			bool beginContainer(StoryJsonScanUtils::ScanCursor& cursor, char openChar, char closeChar, bool* moreEntriesFlag) {
+				StoryJsonScanUtils::skipWhitespace(cursor);
+
+				bool result = (StoryJsonScanUtils::peek(cursor) == openChar);
+				if (result) {
+					cursor.position++;
+					StoryJsonScanUtils::skipWhitespace(cursor);
+					*moreEntriesFlag = (StoryJsonScanUtils::peek(cursor) != closeChar);
+					if (!*moreEntriesFlag) {
+						cursor.position++;
+					}
+				}
+				return result;
+			}
+
+			bool scanEntrySeparator(StoryJsonScanUtils::ScanCursor& cursor, char closeChar, bool* moreEntriesFlag) {
+				StoryJsonScanUtils::skipWhitespace(cursor);
+
+				bool result = true;
+				if (StoryJsonScanUtils::peek(cursor) == ',') {
+					cursor.position++;
+				}
+				else if (StoryJsonScanUtils::peek(cursor) == closeChar) {
+					cursor.position++;
+					*moreEntriesFlag = false;
+				}
+				else {
+					result = StoryJsonScanUtils::fail(cursor, "missing separator in object or array declaration.");
+				}
+				return result;
+			}
+
+			bool readTile(StoryJsonScanUtils::ScanCursor& cursor, int minTileId, int maxTileId, StoryMapTileDefn& tileDefn, bool* tileValid) {
+				bool moreMembersFlag = false;
+				if (!beginContainer(cursor, '{', '}', &moreMembersFlag)) {
+					return false;
+				}
+
+				bool idValid = false;
+				bool filenameValid = false;
+				tileDefn.tileId = 0;
+				tileDefn.filename.clear();
+
+				while (moreMembersFlag) {
+					const char* nameBegin = nullptr;
+					size_t nameLength = 0;
+					if (!scanMemberName(cursor, &nameBegin, &nameLength)) {
+						return false;
+					}
+
+					bool valueValid = false;
+					if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::TILE_ID)) {
+						valueValid = StoryJsonScanUtils::scanInt(cursor, 3, &idValid, &tileDefn.tileId);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::TILE_FILENAME)) {
+						StoryJsonScanUtils::skipWhitespace(cursor);
+						filenameValid = (StoryJsonScanUtils::peek(cursor) == '"');
+						if (filenameValid) {
+							valueValid = StoryJsonScanUtils::scanDecodedString(cursor, tileDefn.filename);
+						}
+						else {
+							tileDefn.filename.clear();
+							valueValid = StoryJsonScanUtils::scanValue(cursor, 3);
+						}
+					}
+					else {
+						valueValid = StoryJsonScanUtils::scanValue(cursor, 3);
+					}
+
+					if (!valueValid || !scanEntrySeparator(cursor, '}', &moreMembersFlag)) {
+						return false;
+					}
+				}
+
+				*tileValid =
+					idValid &&
+					(tileDefn.tileId >= minTileId) &&
+					(tileDefn.tileId <= maxTileId) &&
+					filenameValid;
+				return true;
+			}
+
+			bool readTileList(StoryJsonScanUtils::ScanCursor& cursor, int minTileId, int maxTileId, StreamedTileList& tileList) {
+				tileList.presentFlag = true;
+				tileList.validFlag = true;
+				tileList.tileDefnList.clear();
+
+				bool moreTilesFlag = false;
+				if (!beginContainer(cursor, '[', ']', &moreTilesFlag)) {
+					return false;
+				}
+
+				while (moreTilesFlag) {
+					StoryMapTileDefn currTileDefn;
+					bool currTileValid = false;
+					if (!readTile(cursor, minTileId, maxTileId, currTileDefn, &currTileValid)) {
+						return false;
+					}
+
+					tileList.validFlag = tileList.validFlag && currTileValid;
+					tileList.tileDefnList.push_back(currTileDefn);
+
+					if (!scanEntrySeparator(cursor, ']', &moreTilesFlag)) {
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			// Tiles are appended row after row, so once every row turns out to be "width" tiles long the list
+			// already is the flat grid.  The list is sized up front whenever the dimensions came first in the file.
+			bool readTileGrid(StoryJsonScanUtils::ScanCursor& cursor, const StreamedMap& streamedMap, StreamedTileGrid& tileGrid) {
+				tileGrid.presentFlag = true;
+				tileGrid.validFlag = true;
+				tileGrid.rowCount = 0;
+				tileGrid.firstRowLength = 0;
+				tileGrid.rowLengthsMatch = true;
+				tileGrid.tileList.clear();
+
+				bool fieldSizeKnown =
+					streamedMap.widthValid &&
+					streamedMap.heightValid &&
+					(streamedMap.width > 0) &&
+					(streamedMap.width <= StoryLoaderUtils::LoadStoryMapValidation::MAX_WIDTH) &&
+					(streamedMap.height > 0) &&
+					(streamedMap.height <= StoryLoaderUtils::LoadStoryMapValidation::MAX_HEIGHT);
+				if (fieldSizeKnown) {
+					tileGrid.tileList.reserve(streamedMap.width * streamedMap.height);
+				}
+
+				bool moreRowsFlag = false;
+				if (!beginContainer(cursor, '[', ']', &moreRowsFlag)) {
+					return false;
+				}
+
+				while (moreRowsFlag) {
+					bool moreTilesFlag = false;
+					if (!beginContainer(cursor, '[', ']', &moreTilesFlag)) {
+						return false;
+					}
+
+					int currRowLength = 0;
+					while (moreTilesFlag) {
+						bool tileIdValid = false;
+						int tileId = 0;
+						if (!StoryJsonScanUtils::scanInt(cursor, 3, &tileIdValid, &tileId)) {
+							return false;
+						}
+
+						tileGrid.validFlag = tileGrid.validFlag && tileIdValid;
+						tileGrid.tileList.push_back(tileId);
+						currRowLength++;
+
+						if (!scanEntrySeparator(cursor, ']', &moreTilesFlag)) {
+							return false;
+						}
+					}
+
+					if (tileGrid.rowCount == 0) {
+						tileGrid.firstRowLength = currRowLength;
+					}
+					tileGrid.rowLengthsMatch = tileGrid.rowLengthsMatch && (currRowLength == tileGrid.firstRowLength);
+					tileGrid.rowCount++;
+
+					if (!scanEntrySeparator(cursor, ']', &moreRowsFlag)) {
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			bool readMap(StoryJsonScanUtils::ScanCursor& cursor, StreamedMap& streamedMap) {
+				bool moreMembersFlag = false;
+				if (!beginContainer(cursor, '{', '}', &moreMembersFlag)) {
+					return false;
+				}
+
+				while (moreMembersFlag) {
+					const char* nameBegin = nullptr;
+					size_t nameLength = 0;
+					if (!scanMemberName(cursor, &nameBegin, &nameLength)) {
+						return false;
+					}
+
+					bool valueValid = false;
+					if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::WIDTH)) {
+						valueValid = StoryJsonScanUtils::scanInt(cursor, 1, &streamedMap.widthValid, &streamedMap.width);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::HEIGHT)) {
+						valueValid = StoryJsonScanUtils::scanInt(cursor, 1, &streamedMap.heightValid, &streamedMap.height);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::FLOOR_LIST)) {
+						valueValid = readTileList(cursor, 0, StoryLoaderUtils::LoadStoryMapValidation::MAX_FLOOR_ID, streamedMap.floorList);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::BARRIER_LIST)) {
+						valueValid = readTileList(cursor, 1, StoryLoaderUtils::LoadStoryMapValidation::MAX_BARRIER_ID, streamedMap.barrierList);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::FLOOR_GRID)) {
+						valueValid = readTileGrid(cursor, streamedMap, streamedMap.floorGrid);
+					}
+					else if (StoryJsonScanUtils::nameMatches(nameBegin, nameLength, StoryLoaderUtils::StoryMapProperties::BARRIER_GRID)) {
+						valueValid = readTileGrid(cursor, streamedMap, streamedMap.barrierGrid);
+					}
+					else {
+						valueValid = StoryJsonScanUtils::scanValue(cursor, 1);
+					}
+
+					if (!valueValid || !scanEntrySeparator(cursor, '}', &moreMembersFlag)) {
+						return false;
+					}
+				}
+
+				StoryJsonScanUtils::skipWhitespace(cursor);
+				bool result = StoryJsonScanUtils::atEnd(cursor);
+				return result;
+			}
+
+			bool tileGridSizeValid(const StreamedTileGrid& tileGrid, const sf::Vector2i& fieldSize) {
+				bool result =
+					(tileGrid.rowCount == fieldSize.y) &&
+					(
+						(tileGrid.rowCount == 0) ||
+						(tileGrid.rowLengthsMatch && (tileGrid.firstRowLength == fieldSize.x))
+					);
+				return result;
+			}
+
+			void updateStoryMapTileDefnMap(std::unordered_map<int, StoryMapTileDefn>& tileDefnMap, const StreamedTileList& tileList) {
+				for (auto const& currTileDefn : tileList.tileDefnList) {
+					tileDefnMap[currTileDefn.tileId] = currTileDefn;
+				}
+			}
+
+			void updateDuplicateTileIdList(std::vector<int>& duplicateTileIdList, const StreamedTileList& tileList) {
+				std::set<int> tileIdSet;
+				for (auto const& currTileDefn : tileList.tileDefnList) {
+					if (tileIdSet.count(currTileDefn.tileId) == 0) {
+						tileIdSet.insert(currTileDefn.tileId);
+					}
+					else {
+						duplicateTileIdList.push_back(currTileDefn.tileId);
+					}
+				}
+			}
+
+			bool tileGridsMatch(const std::shared_ptr<const StoryMapTileGrid>& leftTileGrid, const std::shared_ptr<const StoryMapTileGrid>& rightTileGrid) {
+				bool result = (leftTileGrid == nullptr) == (rightTileGrid == nullptr);
+				if (result && (leftTileGrid != nullptr)) {
+					result = (leftTileGrid->size() == rightTileGrid->size());
+					for (size_t tileIndex = 0; result && (tileIndex < leftTileGrid->size()); tileIndex++) {
+						result =
+							((*leftTileGrid)[tileIndex].floorId == (*rightTileGrid)[tileIndex].floorId) &&
+							((*leftTileGrid)[tileIndex].barrierId == (*rightTileGrid)[tileIndex].barrierId);
+					}
+				}
+				return result;
+			}
+
+			bool resultsMatch(const LoadStoryMapResult& leftResult, const LoadStoryMapResult& rightResult) {
+				const LoadStoryMapValidationResult& leftValidation = leftResult.validationResult;
+				const LoadStoryMapValidationResult& rightValidation = rightResult.validationResult;
+
+				bool result =
+					(leftValidation.parseErrorString == rightValidation.parseErrorString) &&
+					(leftValidation.widthValid == rightValidation.widthValid) &&
+					(leftValidation.heightValid == rightValidation.heightValid) &&
+					(leftValidation.floorListValid == rightValidation.floorListValid) &&
+					(leftValidation.barrierListValid == rightValidation.barrierListValid) &&
+					(leftValidation.floorGridValid == rightValidation.floorGridValid) &&
+					(leftValidation.barrierGridValid == rightValidation.barrierGridValid) &&
+					(leftValidation.floorGridSizeValid == rightValidation.floorGridSizeValid) &&
+					(leftValidation.barrierGridSizeValid == rightValidation.barrierGridSizeValid) &&
+					(leftValidation.floorTextureFileInvalidList == rightValidation.floorTextureFileInvalidList) &&
+					(leftValidation.barrierTextureFileInvalidList == rightValidation.barrierTextureFileInvalidList) &&
+					(leftValidation.duplicateFloorIdList == rightValidation.duplicateFloorIdList) &&
+					(leftValidation.duplicateBarrierIdList == rightValidation.duplicateBarrierIdList) &&
+					(leftValidation.nonExistentFloorIdRefList == rightValidation.nonExistentFloorIdRefList) &&
+					(leftValidation.nonExistentBarrierIdRefList == rightValidation.nonExistentBarrierIdRefList) &&
+					(leftResult.mapDefn.fieldSize == rightResult.mapDefn.fieldSize) &&
+					tileGridsMatch(leftResult.mapDefn.tileGrid, rightResult.mapDefn.tileGrid) &&
+					(leftResult.mapDefn.floorDefnMap.size() == rightResult.mapDefn.floorDefnMap.size()) &&
+					(leftResult.mapDefn.barrierDefnMap.size() == rightResult.mapDefn.barrierDefnMap.size());
+
+				for (auto const& currTileDefnPair : leftResult.mapDefn.floorDefnMap) {
+					auto rightTileDefnItr = rightResult.mapDefn.floorDefnMap.find(currTileDefnPair.first);
+					result = result && (rightTileDefnItr != rightResult.mapDefn.floorDefnMap.end()) && (rightTileDefnItr->second.filename == currTileDefnPair.second.filename);
+				}
+				for (auto const& currTileDefnPair : leftResult.mapDefn.barrierDefnMap) {
+					auto rightTileDefnItr = rightResult.mapDefn.barrierDefnMap.find(currTileDefnPair.first);
+					result = result && (rightTileDefnItr != rightResult.mapDefn.barrierDefnMap.end()) && (rightTileDefnItr->second.filename == currTileDefnPair.second.filename);
+				}
+
+				return result;
+			}
+
+		}
+
+		namespace StoryLoaderUtils {
+
+			bool streamStoryMapDocument(const std::string& campaignFolderName, const StoryFileContents& fileContents, LoadStoryMapResult& loadResult) {
+				StoryJsonScanUtils::ScanCursor cursor;
+				cursor.data = fileContents.getData();
+				cursor.size = fileContents.getSize();
+				cursor.position = 0;
+
+				StoryMapStreamUtils::StreamedMap streamedMap;
+				if (!StoryMapStreamUtils::readMap(cursor, streamedMap)) {
+					return false;
+				}
+
+				LoadStoryMapResult result;
+
+				result.validationResult.widthValid = streamedMap.widthValid;
+				result.validationResult.heightValid = streamedMap.heightValid;
+				result.validationResult.floorListValid = streamedMap.floorList.presentFlag && streamedMap.floorList.validFlag;
+				result.validationResult.barrierListValid = streamedMap.barrierList.presentFlag && streamedMap.barrierList.validFlag;
+				result.validationResult.floorGridValid = streamedMap.floorGrid.presentFlag && streamedMap.floorGrid.validFlag;
+				result.validationResult.barrierGridValid = streamedMap.barrierGrid.presentFlag && streamedMap.barrierGrid.validFlag;
+
+				bool fieldSizeValid =
+					result.validationResult.widthValid &&
+					result.validationResult.heightValid;
+
+				result.validationResult.floorGridSizeValid = true;
+				result.validationResult.barrierGridSizeValid = true;
+				if (fieldSizeValid) {
+					result.mapDefn.fieldSize = sf::Vector2i(streamedMap.width, streamedMap.height);
+					result.validationResult.floorGridSizeValid = StoryMapStreamUtils::tileGridSizeValid(streamedMap.floorGrid, result.mapDefn.fieldSize);
+					result.validationResult.barrierGridSizeValid = StoryMapStreamUtils::tileGridSizeValid(streamedMap.barrierGrid, result.mapDefn.fieldSize);
+				}
+
+				if (result.validationResult.floorListValid) {
+					StoryMapStreamUtils::updateStoryMapTileDefnMap(result.mapDefn.floorDefnMap, streamedMap.floorList);
+					StoryMapStreamUtils::updateDuplicateTileIdList(result.validationResult.duplicateFloorIdList, streamedMap.floorList);
+					LoadStoryMapValidation::updateTextureFileInvalidList(result.validationResult.floorTextureFileInvalidList, campaignFolderName, result.mapDefn.floorDefnMap);
+				}
+
+				if (result.validationResult.barrierListValid) {
+					StoryMapStreamUtils::updateStoryMapTileDefnMap(result.mapDefn.barrierDefnMap, streamedMap.barrierList);
+					StoryMapStreamUtils::updateDuplicateTileIdList(result.validationResult.duplicateBarrierIdList, streamedMap.barrierList);
+					LoadStoryMapValidation::updateTextureFileInvalidList(result.validationResult.barrierTextureFileInvalidList, campaignFolderName, result.mapDefn.barrierDefnMap);
+				}
+
+				bool floorGridStored =
+					result.validationResult.floorGridValid &&
+					result.validationResult.floorGridSizeValid;
+				if (floorGridStored) {
+					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentFloorIdRefList, result.mapDefn.floorDefnMap, streamedMap.floorGrid.tileList);
+				}
+
+				bool barrierGridStored =
+					result.validationResult.barrierGridValid &&
+					result.validationResult.barrierGridSizeValid;
+				if (barrierGridStored) {
+					LoadStoryMapValidation::updateNonExistentTileIdRefSet(result.validationResult.nonExistentBarrierIdRefList, result.mapDefn.barrierDefnMap, streamedMap.barrierGrid.tileList);
+					result.validationResult.nonExistentBarrierIdRefList.erase(0);
+				}
+
+				if (floorGridStored && barrierGridStored) {
+					result.mapDefn.tileGrid = buildStoryMapTileGrid(streamedMap.floorGrid.tileList, streamedMap.barrierGrid.tileList);
+				}
+
+				loadResult = std::move(result);
+				return true;
+			}
+
+			StoryMapParseTimes measureMapParseTimes(const std::string& campaignFolderName, const std::string& mapFilename, int iterationCount) {
+				StoryMapParseTimes result;
+				result.iterationCount = iterationCount;
+
+				StoryFileContents fileContents;
+				StoryArchiveUtils::readFile(resolveMapFilePath(campaignFolderName, mapFilename), fileContents);
+				result.fileSize = fileContents.getSize();
+
+				LoadStoryMapResult domResult;
+				LoadStoryMapResult streamResult;
+
+				sf::Clock parseClock;
+				for (int iterationIndex = 0; iterationIndex < iterationCount; iterationIndex++) {
+					domResult = parseStoryMapDocument(campaignFolderName, fileContents);
+				}
+				result.domSeconds = parseClock.getElapsedTime().asSeconds();
+
+				parseClock.restart();
+				for (int iterationIndex = 0; iterationIndex < iterationCount; iterationIndex++) {
+					result.streamedFlag = streamStoryMapDocument(campaignFolderName, fileContents, streamResult);
+				}
+				result.streamSeconds = parseClock.getElapsedTime().asSeconds();
+
+				result.resultsMatch = !result.streamedFlag || StoryMapStreamUtils::resultsMatch(domResult, streamResult);
+				result.mapValid = domResult.validationResult.valid();
+				result.fieldSize = domResult.mapDefn.fieldSize;
+
+				return result;
+			}
+
+			std::vector<std::string> buildMapParseTimeMessages(const StoryMapParseTimes& parseTimes) {
+				std::vector<std::string> result;
+
+				char message[512];
+
+				snprintf(message, sizeof(message), "Map: %d x %d tiles, %.1f KB, %s", parseTimes.fieldSize.x, parseTimes.fieldSize.y, (float)parseTimes.fileSize / 1024.0f, parseTimes.mapValid ? "valid" : "not valid");
+				result.push_back(message);
+
+				if (parseTimes.iterationCount > 0) {
+					float megabytes = (float)parseTimes.fileSize * (float)parseTimes.iterationCount / (1024.0f * 1024.0f);
+
+					snprintf(message, sizeof(message), "DOM reader: %.3f ms per parse (%.1f MB/s)", parseTimes.domSeconds * 1000.0f / (float)parseTimes.iterationCount, megabytes / parseTimes.domSeconds);
+					result.push_back(message);
+
+					if (parseTimes.streamedFlag) {
+						snprintf(message, sizeof(message), "Streaming reader: %.3f ms per parse (%.1f MB/s)", parseTimes.streamSeconds * 1000.0f / (float)parseTimes.iterationCount, megabytes / parseTimes.streamSeconds);
+						result.push_back(message);
+
+						if (parseTimes.streamSeconds > 0.0f) {
+							snprintf(message, sizeof(message), "Speedup: %.1fx", parseTimes.domSeconds / parseTimes.streamSeconds);
+							result.push_back(message);
+						}
+					}
+					else {
+						result.push_back("Streaming reader: the map is handed to the DOM reader");
+					}
+				}
+
+				if (!parseTimes.resultsMatch) {
+					result.push_back("Warning: the streaming reader's result differs from the DOM reader's");
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,616 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include "../includes/r3-snake-storyreplay.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryReplayConstants {
+
+			const char* LAST_REPLAY_FILENAME = "last-replay.r3replay";
+			const char* USER_DATA_FOLDER_NAME = "r3-snake";
+
+			const int DEFAULT_HASH_INTERVAL_TICKS = 30;
+			const int DEFAULT_KEYFRAME_INTERVAL_TICKS = 120;
+
+			const char REPLAY_FILE_MAGIC[4] = { 'R', '3', 'R', 'P' };
+			const sf::Uint8 REPLAY_FILE_VERSION = 3;
+			const sf::Uint8 REPLAY_FILE_VERSION_WITHOUT_TICK_HASHES = 2;
+			const sf::Uint8 REPLAY_FILE_VERSION_WITHOUT_SCORE = 1;
+
+		}
+
+		namespace StoryReplayStreamUtils {
+
+			void writeVarUint(std::vector<sf::Uint8>& buffer, sf::Uint64 value) {
+				while (value >= 0x80) {
+					buffer.push_back((sf::Uint8)(value & 0x7F) | 0x80);
+					value >>= 7;
+				}
+				buffer.push_back((sf::Uint8)value);
+			}
+
+			void writeUint32(std::vector<sf::Uint8>& buffer, sf::Uint32 value) {
+				for (int byteIndex = 0; byteIndex < 4; byteIndex++) {
+					buffer.push_back((sf::Uint8)(value >> (byteIndex * 8)));
+				}
+			}
+
+			void writeUint16(std::vector<sf::Uint8>& buffer, sf::Uint16 value) {
+				buffer.push_back((sf::Uint8)value);
+				buffer.push_back((sf::Uint8)(value >> 8));
+			}
+
+			void writeUint64(std::vector<sf::Uint8>& buffer, sf::Uint64 value) {
+				for (int byteIndex = 0; byteIndex < 8; byteIndex++) {
+					buffer.push_back((sf::Uint8)(value >> (byteIndex * 8)));
+				}
+			}
+
+			void writeString(std::vector<sf::Uint8>& buffer, const std::string& value) {
+				writeVarUint(buffer, value.size());
+				buffer.insert(buffer.end(), value.begin(), value.end());
+			}
+
+			// Movements are packed two to a byte, since ObjectDirection fits in a nibble
+			void writeMovementList(std::vector<sf::Uint8>& buffer, const std::vector<ObjectDirection>& movementList) {
+				writeVarUint(buffer, movementList.size());
+				for (size_t movementIndex = 0; movementIndex < movementList.size(); movementIndex += 2) {
+					sf::Uint8 packedByte = (sf::Uint8)movementList[movementIndex] & 0x0F;
+					if ((movementIndex + 1) < movementList.size()) {
+						packedByte |= ((sf::Uint8)movementList[movementIndex + 1] & 0x0F) << 4;
+					}
+					buffer.push_back(packedByte);
+				}
+			}
+
+			typedef struct Snake_ReadCursor {
+				const std::vector<sf::Uint8>* buffer;
+				size_t position;
+				bool validFlag;
+			} ReadCursor;
+
+			sf::Uint8 readByte(ReadCursor& cursor) {
+				sf::Uint8 result = 0;
+				if (cursor.position < cursor.buffer->size()) {
+					result = (*cursor.buffer)[cursor.position];
+					cursor.position++;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			sf::Uint64 readVarUint(ReadCursor& cursor) {
+				sf::Uint64 result = 0;
+				int shift = 0;
+				bool moreBytesFlag = true;
+				while (moreBytesFlag && cursor.validFlag && (shift < 64)) {
+					sf::Uint8 currByte = readByte(cursor);
+					result |= (sf::Uint64)(currByte & 0x7F) << shift;
+					shift += 7;
+					moreBytesFlag = ((currByte & 0x80) != 0);
+				}
+				return result;
+			}
+
+			sf::Uint16 readUint16(ReadCursor& cursor) {
+				sf::Uint16 result = readByte(cursor);
+				result |= (sf::Uint16)readByte(cursor) << 8;
+				return result;
+			}
+
+			sf::Uint32 readUint32(ReadCursor& cursor) {
+				sf::Uint32 result = 0;
+				for (int byteIndex = 0; byteIndex < 4; byteIndex++) {
+					result |= (sf::Uint32)readByte(cursor) << (byteIndex * 8);
+				}
+				return result;
+			}
+
+			sf::Uint64 readUint64(ReadCursor& cursor) {
+				sf::Uint64 result = 0;
+				for (int byteIndex = 0; byteIndex < 8; byteIndex++) {
+					result |= (sf::Uint64)readByte(cursor) << (byteIndex * 8);
+				}
+				return result;
+			}
+
+			std::string readString(ReadCursor& cursor) {
+				std::string result;
+				sf::Uint64 length = readVarUint(cursor);
+				if (cursor.validFlag && (length <= (cursor.buffer->size() - cursor.position))) {
+					result.assign((const char*)cursor.buffer->data() + cursor.position, (size_t)length);
+					cursor.position += (size_t)length;
+				}
+				else {
+					cursor.validFlag = false;
+				}
+				return result;
+			}
+
+			std::vector<ObjectDirection> readMovementList(ReadCursor& cursor) {
+				std::vector<ObjectDirection> result;
+				sf::Uint64 movementCount = readVarUint(cursor);
+				for (sf::Uint64 movementIndex = 0; (movementIndex < movementCount) && cursor.validFlag; movementIndex += 2) {
+					sf::Uint8 packedByte = readByte(cursor);
+					result.push_back((ObjectDirection)(packedByte & 0x0F));
+					if ((movementIndex + 1) < movementCount) {
+						result.push_back((ObjectDirection)(packedByte >> 4));
+					}
+				}
+				return result;
+			}
+
+		}
+
+		StoryReplayRecorder::StoryReplayRecorder() {
+			this->recordingFlag = false;
+			this->saveThread = nullptr;
+			this->replay.levelIndex = 0;
+			this->replay.levelSeed = 0;
+			this->replay.levelStartScore = 0;
+			this->replay.hashIntervalTicks = StoryReplayConstants::DEFAULT_HASH_INTERVAL_TICKS;
+			this->replay.tickCount = 0;
+			this->replay.finalStateHash = 0;
+		}
+
+		StoryReplayRecorder::~StoryReplayRecorder() {
+			if (this->saveThread != nullptr) {
+				delete this->saveThread;
+			}
+		}
+
+		bool StoryReplayRecorder::isRecording() const {
+			return this->recordingFlag;
+		}
+
+		const StoryReplay& StoryReplayRecorder::getReplay() const {
+			return this->replay;
+		}
+
+		void StoryReplayRecorder::startRecording(const std::string& campaignFolderName, int levelIndex, const StoryGame& storyGame) {
+			this->recordingFlag = true;
+
+			this->replay.campaignFolderName = campaignFolderName;
+			this->replay.levelIndex = levelIndex;
+			this->replay.levelSeed = storyGame.getLevelSeed();
+			this->replay.levelStartScore = storyGame.getScore();
+			this->replay.hashIntervalTicks = StoryReplayConstants::DEFAULT_HASH_INTERVAL_TICKS;
+			this->replay.tickCount = 0;
+			this->replay.inputTickList.clear();
+			this->replay.stateHashList.clear();
+			this->replay.tickHashList.clear();
+			this->replay.finalStateHash = 0;
+		}
+
+		void StoryReplayRecorder::recordTick(const StoryGameInputRequest& input, const StoryGame& storyGame) {
+			if (this->recordingFlag) {
+				this->replay.tickCount = storyGame.getTicksElapsed();
+
+				if (!input.snakeMovementList.empty()) {
+					StoryReplayInputTick inputTick;
+					inputTick.tick = this->replay.tickCount;
+					inputTick.snakeMovementList = input.snakeMovementList;
+					this->replay.inputTickList.push_back(inputTick);
+				}
+
+				// Every tick keeps a folded hash as well, so the verifier can narrow a failed check down to the exact tick
+				sf::Uint64 stateHash = storyGame.calcStateHash();
+				this->replay.tickHashList.push_back(StoryReplayUtils::foldTickHash(stateHash));
+				if ((this->replay.tickCount % this->replay.hashIntervalTicks) == 0) {
+					this->replay.stateHashList.push_back(stateHash);
+				}
+			}
+		}
+
+		void StoryReplayRecorder::stopRecording(const StoryGame& storyGame) {
+			if (this->recordingFlag) {
+				this->replay.finalStateHash = storyGame.calcStateHash();
+				this->recordingFlag = false;
+			}
+		}
+
+		// The replay is copied out so the next level can start recording while the previous one is still being written
+		void StoryReplayRecorder::saveReplayAsync(const std::string& replayFilename) {
+			if (this->saveThread != nullptr) {
+				delete this->saveThread;
+			}
+
+			this->savedReplay = this->replay;
+			this->savedReplayFilename = replayFilename;
+
+			this->saveThread = new sf::Thread(&StoryReplayRecorder::runSaveReplay, this);
+			this->saveThread->launch();
+		}
+
+		void StoryReplayRecorder::runSaveReplay() {
+			StoryReplayUtils::saveReplay(StoryReplayUtils::resolveUserDataFilePath(this->savedReplayFilename), this->savedReplay);
+		}
+
+		StoryReplayPlayer::StoryReplayPlayer(const StoryReplay& replay, const StoryMapDefn& mapDefn, const StoryLevelDefn& levelDefn) {
+			this->replay = &replay;
+			this->storyGame = new StoryGame();
+			this->mapDefn = &mapDefn;
+			this->levelDefn = &levelDefn;
+			this->nextInputTickIndex = 0;
+			this->keyframeIntervalTicks = StoryReplayConstants::DEFAULT_KEYFRAME_INTERVAL_TICKS;
+
+			this->restart();
+		}
+
+		StoryReplayPlayer::~StoryReplayPlayer() {
+			delete this->storyGame;
+		}
+
+		const StoryGame& StoryReplayPlayer::getStoryGame() const {
+			return *this->storyGame;
+		}
+
+		int StoryReplayPlayer::getCurrTick() const {
+			return this->storyGame->getTicksElapsed();
+		}
+
+		bool StoryReplayPlayer::isFinished() const {
+			bool result = (this->storyGame->getTicksElapsed() >= this->replay->tickCount);
+			return result;
+		}
+
+		void StoryReplayPlayer::setKeyframeIntervalTicks(int keyframeIntervalTicks) {
+			this->keyframeIntervalTicks = keyframeIntervalTicks;
+			this->restart();
+		}
+
+		// The score carried into the level is part of the state hash, so it has to be in place before any tick runs
+		void StoryReplayPlayer::restart() {
+			this->storyGame->restoreScoreAtLevelStart(this->replay->levelStartScore);
+			this->storyGame->startNewLevel(*this->mapDefn, *this->levelDefn, this->replay->levelSeed);
+			this->storyGame->startRunningLevel();
+
+			this->nextInputTickIndex = 0;
+			this->keyframeList.clear();
+			this->captureKeyframe();
+		}
+
+		const StoryGameUpdateResult& StoryReplayPlayer::stepTick() {
+			int tick = this->storyGame->getTicksElapsed() + 1;
+
+			StoryGameInputRequest inputRequest;
+			if (
+				(this->nextInputTickIndex < this->replay->inputTickList.size()) &&
+				(this->replay->inputTickList[this->nextInputTickIndex].tick == tick)
+			) {
+				inputRequest.snakeMovementList = this->replay->inputTickList[this->nextInputTickIndex].snakeMovementList;
+				this->nextInputTickIndex++;
+			}
+
+			this->storyGame->update(inputRequest, this->updateResult);
+
+			if (
+				((tick % this->keyframeIntervalTicks) == 0) &&
+				(this->keyframeList.back().tick < tick)
+			) {
+				this->captureKeyframe();
+			}
+
+			return this->updateResult;
+		}
+
+		// Stepping forward captures keyframes as it goes.  Walking the whole replay once up front means any later seek,
+		// backward or forward, starts from a keyframe no more than one interval before its target.
+		void StoryReplayPlayer::buildKeyframes() {
+			int currTick = this->storyGame->getTicksElapsed();
+			this->seekToTick(this->replay->tickCount);
+			this->seekToTick(currTick);
+		}
+
+		void StoryReplayPlayer::seekToTick(int tick) {
+			int targetTick = std::max(0, std::min(tick, this->replay->tickCount));
+
+			auto keyframeAfterTarget = std::upper_bound(
+				this->keyframeList.begin(),
+				this->keyframeList.end(),
+				targetTick,
+				[](int currTick, const StoryReplayKeyframe& keyframe) { return currTick < keyframe.tick; }
+			);
+			const StoryReplayKeyframe& keyframe = *(keyframeAfterTarget - 1);
+
+			int currTick = this->storyGame->getTicksElapsed();
+			if ((currTick > targetTick) || (currTick < keyframe.tick)) {
+				this->storyGame->restoreSnapshot(keyframe.snapshot);
+				this->nextInputTickIndex = keyframe.nextInputTickIndex;
+			}
+
+			while (this->storyGame->getTicksElapsed() < targetTick) {
+				this->stepTick();
+			}
+		}
+
+		void StoryReplayPlayer::captureKeyframe() {
+			StoryReplayKeyframe keyframe;
+			keyframe.tick = this->storyGame->getTicksElapsed();
+			keyframe.nextInputTickIndex = this->nextInputTickIndex;
+			keyframe.snapshot = this->storyGame->createSnapshot();
+
+			this->keyframeList.push_back(keyframe);
+		}
+
+		namespace StoryReplayUtils {
+
+			// Replays go under the per-user data folder rather than the working directory, falling back to the
+			// working directory when no such folder can be found or created
+			std::string resolveUserDataFilePath(const std::string& filename) {
+				std::string result = filename;
+
+#ifdef _WIN32
+				const char* userDataRoot = getenv("LOCALAPPDATA");
+				if (userDataRoot != nullptr) {
+					std::string userDataFolder = std::string(userDataRoot) + "\\" + StoryReplayConstants::USER_DATA_FOLDER_NAME;
+					CreateDirectoryA(userDataFolder.c_str(), nullptr);
+					if (GetFileAttributesA(userDataFolder.c_str()) != INVALID_FILE_ATTRIBUTES) {
+						result = userDataFolder + "\\" + filename;
+					}
+				}
+#else
+				std::string userDataRoot;
+				if (getenv("XDG_DATA_HOME") != nullptr) {
+					userDataRoot = getenv("XDG_DATA_HOME");
+				}
+				else if (getenv("HOME") != nullptr) {
+					userDataRoot = std::string(getenv("HOME")) + "/.local/share";
+				}
+				if (!userDataRoot.empty()) {
+					std::string userDataFolder = userDataRoot + "/" + StoryReplayConstants::USER_DATA_FOLDER_NAME;
+					mkdir(userDataRoot.c_str(), 0755);
+					mkdir(userDataFolder.c_str(), 0755);
+
+					struct stat folderStat;
+					if ((stat(userDataFolder.c_str(), &folderStat) == 0) && S_ISDIR(folderStat.st_mode)) {
+						result = userDataFolder + "/" + filename;
+					}
+				}
+#endif
+
+				return result;
+			}
+
+			sf::Uint16 foldTickHash(sf::Uint64 stateHash) {
+				sf::Uint16 result = (sf::Uint16)(stateHash ^ (stateHash >> 16) ^ (stateHash >> 32) ^ (stateHash >> 48));
+				return result;
+			}
+
+			bool saveReplay(const std::string& replayFilename, const StoryReplay& replay) {
+				std::vector<sf::Uint8> buffer;
+				buffer.insert(buffer.end(), StoryReplayConstants::REPLAY_FILE_MAGIC, StoryReplayConstants::REPLAY_FILE_MAGIC + 4);
+				buffer.push_back(StoryReplayConstants::REPLAY_FILE_VERSION);
+
+				StoryReplayStreamUtils::writeString(buffer, replay.campaignFolderName);
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.levelIndex);
+				StoryReplayStreamUtils::writeUint32(buffer, replay.levelSeed);
+				StoryReplayStreamUtils::writeUint32(buffer, (sf::Uint32)replay.levelStartScore);
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.hashIntervalTicks);
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.tickCount);
+
+				// Only ticks with input are stored, each as a tick delta from the previous one
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.inputTickList.size());
+				int prevTick = 0;
+				for (auto const& currInputTick : replay.inputTickList) {
+					StoryReplayStreamUtils::writeVarUint(buffer, currInputTick.tick - prevTick);
+					StoryReplayStreamUtils::writeMovementList(buffer, currInputTick.snakeMovementList);
+					prevTick = currInputTick.tick;
+				}
+
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.stateHashList.size());
+				for (sf::Uint64 currStateHash : replay.stateHashList) {
+					StoryReplayStreamUtils::writeUint64(buffer, currStateHash);
+				}
+				StoryReplayStreamUtils::writeUint64(buffer, replay.finalStateHash);
+
+				StoryReplayStreamUtils::writeVarUint(buffer, replay.tickHashList.size());
+				for (sf::Uint16 currTickHash : replay.tickHashList) {
+					StoryReplayStreamUtils::writeUint16(buffer, currTickHash);
+				}
+
+				std::ofstream replayStream(replayFilename, std::ios_base::binary | std::ios_base::trunc);
+				replayStream.write((const char*)buffer.data(), buffer.size());
+
+				bool result = replayStream.good();
+				return result;
+			}
+
+			bool loadReplay(const std::string& replayFilename, StoryReplay& replay) {
+				std::ifstream replayStream(replayFilename, std::ios_base::binary);
+				if (!replayStream.is_open()) {
+					return false;
+				}
+
+				std::vector<sf::Uint8> buffer((std::istreambuf_iterator<char>(replayStream)), std::istreambuf_iterator<char>());
+
+				StoryReplayStreamUtils::ReadCursor cursor;
+				cursor.buffer = &buffer;
+				cursor.position = 0;
+				cursor.validFlag = true;
+
+				for (int magicIndex = 0; magicIndex < 4; magicIndex++) {
+					cursor.validFlag = cursor.validFlag && (StoryReplayStreamUtils::readByte(cursor) == (sf::Uint8)StoryReplayConstants::REPLAY_FILE_MAGIC[magicIndex]);
+				}
+				// Version 1 replays predate the level start score, and are only correct for a level started with no score.
+				// Version 2 replays have no per-tick hashes, so a divergence is only placed to within a hash interval.
+				sf::Uint8 version = StoryReplayStreamUtils::readByte(cursor);
+				cursor.validFlag = cursor.validFlag && (version >= StoryReplayConstants::REPLAY_FILE_VERSION_WITHOUT_SCORE) && (version <= StoryReplayConstants::REPLAY_FILE_VERSION);
+
+				replay.campaignFolderName = StoryReplayStreamUtils::readString(cursor);
+				replay.levelIndex = (int)StoryReplayStreamUtils::readVarUint(cursor);
+				replay.levelSeed = StoryReplayStreamUtils::readUint32(cursor);
+				replay.levelStartScore = 0;
+				if (version >= StoryReplayConstants::REPLAY_FILE_VERSION_WITHOUT_TICK_HASHES) {
+					replay.levelStartScore = (int)StoryReplayStreamUtils::readUint32(cursor);
+				}
+				replay.hashIntervalTicks = (int)StoryReplayStreamUtils::readVarUint(cursor);
+				replay.tickCount = (int)StoryReplayStreamUtils::readVarUint(cursor);
+
+				replay.inputTickList.clear();
+				sf::Uint64 inputTickCount = StoryReplayStreamUtils::readVarUint(cursor);
+				int prevTick = 0;
+				for (sf::Uint64 inputTickIndex = 0; (inputTickIndex < inputTickCount) && cursor.validFlag; inputTickIndex++) {
+					StoryReplayInputTick inputTick;
+					inputTick.tick = prevTick + (int)StoryReplayStreamUtils::readVarUint(cursor);
+					inputTick.snakeMovementList = StoryReplayStreamUtils::readMovementList(cursor);
+					replay.inputTickList.push_back(inputTick);
+
+					prevTick = inputTick.tick;
+				}
+
+				replay.stateHashList.clear();
+				sf::Uint64 stateHashCount = StoryReplayStreamUtils::readVarUint(cursor);
+				for (sf::Uint64 stateHashIndex = 0; (stateHashIndex < stateHashCount) && cursor.validFlag; stateHashIndex++) {
+					replay.stateHashList.push_back(StoryReplayStreamUtils::readUint64(cursor));
+				}
+				replay.finalStateHash = StoryReplayStreamUtils::readUint64(cursor);
+
+				replay.tickHashList.clear();
+				if (version == StoryReplayConstants::REPLAY_FILE_VERSION) {
+					sf::Uint64 tickHashCount = StoryReplayStreamUtils::readVarUint(cursor);
+					for (sf::Uint64 tickHashIndex = 0; (tickHashIndex < tickHashCount) && cursor.validFlag; tickHashIndex++) {
+						replay.tickHashList.push_back(StoryReplayStreamUtils::readUint16(cursor));
+					}
+				}
+
+				bool result =
+					cursor.validFlag &&
+					(replay.hashIntervalTicks > 0);
+				return result;
+			}
+
+			StoryReplayVerificationResult verifyReplay(const std::string& replayFilename) {
+				StoryReplayVerificationResult result;
+
+				StoryReplay replay;
+				result.replayFileValid = loadReplay(replayFilename, replay);
+				if (!result.replayFileValid) {
+					return result;
+				}
+
+				LoadStoryCampaignResult loadCampaignResult = StoryLoaderUtils::loadStoryCampaign(replay.campaignFolderName);
+				result.campaignValid = loadCampaignResult.valid();
+				if (!result.campaignValid) {
+					return result;
+				}
+
+				result.levelIndexValid = (replay.levelIndex >= 0) && (replay.levelIndex < (int)loadCampaignResult.levelResultList.size());
+				if (!result.levelIndexValid) {
+					return result;
+				}
+
+				const StoryLevelDefn& levelDefn = loadCampaignResult.levelResultList[replay.levelIndex].levelDefn;
+				LoadStoryMapResult loadMapResult = StoryLoaderUtils::loadStoryMap(replay.campaignFolderName, levelDefn.mapFilename);
+				result.mapValid = loadMapResult.validationResult.valid();
+				if (!result.mapValid) {
+					return result;
+				}
+
+				sf::Clock clock;
+
+				StoryReplayPlayer player(replay, loadMapResult.mapDefn, levelDefn);
+				result.matchedFlag = true;
+				while (result.matchedFlag && !player.isFinished()) {
+					player.stepTick();
+
+					int currTick = player.getCurrTick();
+					if ((currTick % replay.hashIntervalTicks) == 0) {
+						size_t stateHashIndex = (currTick / replay.hashIntervalTicks) - 1;
+						if (
+							(stateHashIndex < replay.stateHashList.size()) &&
+							(player.getStoryGame().calcStateHash() != replay.stateHashList[stateHashIndex])
+						) {
+							result.matchedFlag = false;
+							result.firstDivergentTick = currTick;
+						}
+						else {
+							result.lastMatchingTick = currTick;
+						}
+					}
+				}
+
+				if (result.matchedFlag && (player.getStoryGame().calcStateHash() != replay.finalStateHash)) {
+					result.matchedFlag = false;
+					result.firstDivergentTick = player.getCurrTick();
+				}
+
+				result.ticksReplayed = player.getCurrTick();
+
+				// The full hashes only show which interval went wrong.  The interval is stepped through again from the
+				// last matching check, comparing the per-tick hashes, to find the tick where the state first differs.
+				if (!result.matchedFlag && !replay.tickHashList.empty()) {
+					player.seekToTick(result.lastMatchingTick);
+
+					bool tickMatchedFlag = true;
+					while (tickMatchedFlag && (player.getCurrTick() < result.firstDivergentTick)) {
+						player.stepTick();
+
+						size_t tickHashIndex = (size_t)player.getCurrTick() - 1;
+						tickMatchedFlag =
+							(tickHashIndex >= replay.tickHashList.size()) ||
+							(foldTickHash(player.getStoryGame().calcStateHash()) == replay.tickHashList[tickHashIndex]);
+					}
+
+					if (!tickMatchedFlag) {
+						result.firstDivergentTick = player.getCurrTick();
+						result.lastMatchingTick = result.firstDivergentTick - 1;
+					}
+				}
+
+				result.secondsElapsed = clock.getElapsedTime().asSeconds();
+
+				return result;
+			}
+
+			std::vector<std::string> buildVerificationMessages(const StoryReplayVerificationResult& verificationResult) {
+				std::vector<std::string> result;
+
+				if (!verificationResult.replayFileValid) {
+					result.push_back("The replay file could not be read");
+				}
+				else if (!verificationResult.campaignValid) {
+					result.push_back("The campaign referenced by the replay could not be loaded");
+				}
+				else if (!verificationResult.levelIndexValid) {
+					result.push_back("The level referenced by the replay does not exist in the campaign");
+				}
+				else if (!verificationResult.mapValid) {
+					result.push_back("The map for the level referenced by the replay could not be loaded");
+				}
+				else {
+					char message[256];
+					if (verificationResult.matchedFlag) {
+						snprintf(message, sizeof(message), "Replay matched for all %d ticks", verificationResult.ticksReplayed);
+					}
+					else {
+						snprintf(message, sizeof(message), "Replay diverged at tick %d (last matching tick was %d)", verificationResult.firstDivergentTick, verificationResult.lastMatchingTick);
+					}
+					result.push_back(message);
+
+					snprintf(message, sizeof(message), "Replayed %d ticks in %.3f seconds", verificationResult.ticksReplayed, verificationResult.secondsElapsed);
+					result.push_back(message);
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <algorithm>
+#include "../includes/r3-snake-storymodescene.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StorySpawnSchedulerUtils {
+
+			bool isCheckDueLater(const StoryScheduledCheck& check1, const StoryScheduledCheck& check2) {
+				bool result =
+					(check1.dueTick > check2.dueTick) ||
+					((check1.dueTick == check2.dueTick) && (check1.trackerIndex > check2.trackerIndex));
+				return result;
+			}
+
+			void pushCheck(std::vector<StoryScheduledCheck>& checkHeap, const StoryScheduledCheck& check) {
+				checkHeap.push_back(check);
+				std::push_heap(checkHeap.begin(), checkHeap.end(), isCheckDueLater);
+			}
+
+			StoryScheduledCheck popCheck(std::vector<StoryScheduledCheck>& checkHeap) {
+				assert(!checkHeap.empty());
+
+				std::pop_heap(checkHeap.begin(), checkHeap.end(), isCheckDueLater);
+				StoryScheduledCheck result = checkHeap.back();
+				checkHeap.pop_back();
+				return result;
+			}
+
+		}
+
+		StorySpawnScheduler::StorySpawnScheduler() {
+			this->parkedTrackerIndexListByTrigger.resize((int)StorySpawnTrigger::FOOD_EATEN + 1);
+		}
+
+		void StorySpawnScheduler::reset(int trackerCount) {
+			this->checkHeap.clear();
+			this->checkHeap.reserve(trackerCount);
+			this->trackerStatusList.assign(trackerCount, StoryScheduledCheckStatus::IDLE);
+			this->trackerParkedOnTriggerList.assign(trackerCount, false);
+			for (auto& currParkedTrackerIndexList : this->parkedTrackerIndexListByTrigger) {
+				currParkedTrackerIndexList.clear();
+				currParkedTrackerIndexList.reserve(trackerCount);
+			}
+		}
+
+		void StorySpawnScheduler::schedule(int trackerIndex, int dueTick) {
+			assert(this->trackerStatusList[trackerIndex] != StoryScheduledCheckStatus::SCHEDULED);
+
+			StoryScheduledCheck check;
+			check.dueTick = dueTick;
+			check.trackerIndex = trackerIndex;
+			check.instanceId = 0;
+			StorySpawnSchedulerUtils::pushCheck(this->checkHeap, check);
+
+			this->trackerStatusList[trackerIndex] = StoryScheduledCheckStatus::SCHEDULED;
+		}
+
+		void StorySpawnScheduler::park(int trackerIndex, StorySpawnTrigger trigger) {
+			assert(this->trackerStatusList[trackerIndex] != StoryScheduledCheckStatus::SCHEDULED);
+
+			this->trackerStatusList[trackerIndex] = StoryScheduledCheckStatus::PARKED;
+
+			if ((trigger != StorySpawnTrigger::NONE) && !this->trackerParkedOnTriggerList[trackerIndex]) {
+				this->parkedTrackerIndexListByTrigger[(int)trigger].push_back(trackerIndex);
+				this->trackerParkedOnTriggerList[trackerIndex] = true;
+			}
+		}
+
+		void StorySpawnScheduler::wakeTracker(int trackerIndex, int dueTick) {
+			if (this->trackerStatusList[trackerIndex] == StoryScheduledCheckStatus::PARKED) {
+				this->schedule(trackerIndex, dueTick);
+			}
+		}
+
+		void StorySpawnScheduler::wakeTrackers(StorySpawnTrigger trigger, int dueTick) {
+			std::vector<int>& parkedTrackerIndexList = this->parkedTrackerIndexListByTrigger[(int)trigger];
+			for (int currTrackerIndex : parkedTrackerIndexList) {
+				this->trackerParkedOnTriggerList[currTrackerIndex] = false;
+				this->wakeTracker(currTrackerIndex, dueTick);
+			}
+			parkedTrackerIndexList.clear();
+		}
+
+		void StorySpawnScheduler::popDueTrackers(int currTick, std::vector<int>& dueTrackerIndexList) {
+			dueTrackerIndexList.clear();
+
+			while (!this->checkHeap.empty() && (this->checkHeap.front().dueTick <= currTick)) {
+				StoryScheduledCheck check = StorySpawnSchedulerUtils::popCheck(this->checkHeap);
+				this->trackerStatusList[check.trackerIndex] = StoryScheduledCheckStatus::IDLE;
+				dueTrackerIndexList.push_back(check.trackerIndex);
+			}
+
+			// Trackers share the level's randomizer, so they must roll in definition order
+			std::sort(dueTrackerIndexList.begin(), dueTrackerIndexList.end());
+		}
+
+	}
+
+}
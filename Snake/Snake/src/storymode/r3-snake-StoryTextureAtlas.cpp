@@ -0,0 +1,126 @@
+#include <algorithm>
+#include "../includes/r3-snake-storyassets.hpp"
+
+namespace r3 {
+
+	namespace snake {
+
+		namespace StoryTextureAtlasConstants {
+
+			const unsigned int PAGE_SIZE = 2048;
+			const unsigned int PADDING = 2;
+
+		}
+
+		namespace StoryTextureAtlasUtils {
+
+			bool imageFitsPage(const sf::Vector2u& imageSize, unsigned int pageSize, unsigned int padding) {
+				bool result =
+					(imageSize.x > 0) &&
+					(imageSize.y > 0) &&
+					(imageSize.x + (padding * 2) <= pageSize) &&
+					(imageSize.y + (padding * 2) <= pageSize);
+				return result;
+			}
+
+			StoryTextureAtlasLayout packShelves(const std::vector<sf::Vector2u>& imageSizeList, unsigned int pageSize, unsigned int padding) {
+				StoryTextureAtlasLayout result;
+
+				StoryTextureAtlasRegion unpackedRegion;
+				unpackedRegion.pageIndex = -1;
+				result.regionList.assign(imageSizeList.size(), unpackedRegion);
+
+				std::vector<size_t> packOrderList;
+				for (size_t imageIndex = 0; imageIndex < imageSizeList.size(); imageIndex++) {
+					if (imageFitsPage(imageSizeList[imageIndex], pageSize, padding)) {
+						packOrderList.push_back(imageIndex);
+					}
+				}
+
+				std::stable_sort(packOrderList.begin(), packOrderList.end(), [&imageSizeList](size_t leftIndex, size_t rightIndex) {
+					return imageSizeList[leftIndex].y > imageSizeList[rightIndex].y;
+				});
+
+				int pageIndex = -1;
+				unsigned int shelfX = 0;
+				unsigned int shelfY = 0;
+				unsigned int shelfHeight = 0;
+
+				for (size_t imageIndex : packOrderList) {
+					unsigned int paddedWidth = imageSizeList[imageIndex].x + (padding * 2);
+					unsigned int paddedHeight = imageSizeList[imageIndex].y + (padding * 2);
+
+					if ((pageIndex >= 0) && (shelfX + paddedWidth > pageSize)) {
+						shelfY += shelfHeight;
+						shelfX = 0;
+						shelfHeight = 0;
+					}
+
+					if ((pageIndex < 0) || (shelfY + paddedHeight > pageSize)) {
+						pageIndex++;
+						result.pageSizeList.push_back(sf::Vector2u(0, 0));
+						shelfX = 0;
+						shelfY = 0;
+						shelfHeight = 0;
+					}
+
+					StoryTextureAtlasRegion& region = result.regionList[imageIndex];
+					region.pageIndex = pageIndex;
+					region.textureRect = sf::IntRect((int)(shelfX + padding), (int)(shelfY + padding), (int)imageSizeList[imageIndex].x, (int)imageSizeList[imageIndex].y);
+
+					shelfX += paddedWidth;
+					shelfHeight = std::max(shelfHeight, paddedHeight);
+
+					sf::Vector2u& usedPageSize = result.pageSizeList[pageIndex];
+					usedPageSize.x = std::max(usedPageSize.x, shelfX);
+					usedPageSize.y = std::max(usedPageSize.y, shelfY + shelfHeight);
+				}
+
+				return result;
+			}
+
+			// The border is filled by copying the region's outermost columns, then its outermost rows including the
+			// columns just written, so the corners take the corner pixel.  Source and destination never overlap.
+			void copyRegionWithPadding(sf::Image& pageImage, const sf::Image& image, const sf::IntRect& textureRect, unsigned int padding) {
+				int left = textureRect.left;
+				int top = textureRect.top;
+				int right = textureRect.left + textureRect.width - 1;
+				int bottom = textureRect.top + textureRect.height - 1;
+				int paddedLeft = left - (int)padding;
+				int paddedWidth = textureRect.width + (int)(padding * 2);
+
+				pageImage.copy(image, (unsigned int)left, (unsigned int)top);
+
+				for (int offset = 1; offset <= (int)padding; offset++) {
+					pageImage.copy(pageImage, (unsigned int)(left - offset), (unsigned int)top, sf::IntRect(left, top, 1, textureRect.height));
+					pageImage.copy(pageImage, (unsigned int)(right + offset), (unsigned int)top, sf::IntRect(right, top, 1, textureRect.height));
+				}
+
+				for (int offset = 1; offset <= (int)padding; offset++) {
+					pageImage.copy(pageImage, (unsigned int)paddedLeft, (unsigned int)(top - offset), sf::IntRect(paddedLeft, top, paddedWidth, 1));
+					pageImage.copy(pageImage, (unsigned int)paddedLeft, (unsigned int)(bottom + offset), sf::IntRect(paddedLeft, bottom, paddedWidth, 1));
+				}
+			}
+
+			std::vector<sf::Image> buildPageImageList(const StoryTextureAtlasLayout& layout, const std::vector<const sf::Image*>& imageList, unsigned int padding) {
+				std::vector<sf::Image> result(layout.pageSizeList.size());
+
+				for (size_t pageIndex = 0; pageIndex < layout.pageSizeList.size(); pageIndex++) {
+					result[pageIndex].create(layout.pageSizeList[pageIndex].x, layout.pageSizeList[pageIndex].y, sf::Color::Transparent);
+				}
+
+				for (size_t imageIndex = 0; imageIndex < layout.regionList.size(); imageIndex++) {
+					const StoryTextureAtlasRegion& region = layout.regionList[imageIndex];
+					if (region.pageIndex >= 0) {
+						copyRegionWithPadding(result[region.pageIndex], *imageList[imageIndex], region.textureRect, padding);
+					}
+				}
+
+				return result;
+			}
+
+		}
+
+	}
+
+}